@@ -10,9 +10,44 @@
 #include <string.h>
 
 #include "aes.h"
+#include "aes_fast.h"
+#include "aes_session.h"
 #include "crypto.h"
 #include "svdpi.h"
 
+// Key schedule of the fast C model, kept across c_dpi_aes_crypt_message()
+// calls. Tests typically encrypt many messages with the same key, so the key
+// is only expanded again if it changes.
+static aes_key_schedule_t aes_model_dpi_ks;
+static unsigned char aes_model_dpi_ks_key[32];
+static int aes_model_dpi_ks_valid = 0;
+
+static const aes_key_schedule_t *aes_model_dpi_get_ks(const unsigned char *key,
+                                                      int key_len) {
+  if (!aes_model_dpi_ks_valid || aes_model_dpi_ks.key_len != key_len ||
+      aes_model_dpi_ks.impl != aes_fast_get_impl() ||
+      memcmp(aes_model_dpi_ks_key, key, key_len)) {
+    aes_key_schedule_init(&aes_model_dpi_ks, key, key_len);
+    memcpy(aes_model_dpi_ks_key, key, key_len);
+    aes_model_dpi_ks_valid = 1;
+  }
+  return &aes_model_dpi_ks;
+}
+
+// Open model sessions, indexed by the handle returned to the simulator.
+// Closed slots are set to NULL and reused by the next open.
+static aes_model_session_t **aes_model_dpi_sessions = NULL;
+static int aes_model_dpi_num_sessions = 0;
+
+static aes_model_session_t *aes_model_dpi_session_get(int handle) {
+  if (handle < 0 || handle >= aes_model_dpi_num_sessions ||
+      !aes_model_dpi_sessions[handle]) {
+    printf("ERROR: Invalid AES model session handle %d\n", handle);
+    return NULL;
+  }
+  return aes_model_dpi_sessions[handle];
+}
+
 void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
                            const svBitVecVal *mode_i, const svBitVecVal *iv_i,
                            const svBitVecVal *key_len_i,
@@ -144,14 +179,6 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
     key_len = 32;
   }
 
-  if (impl == 0) {
-    // The C model is currently not supported.
-    printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
-    return;
-  }
-
   // Get key from simulator.
   unsigned char *key = aes_key_get(key_i);
 
@@ -183,19 +210,22 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
       (unsigned char *)malloc(data_len * sizeof(unsigned char));
   assert(ref_out);
 
-  // OpenSSL/BoringSSL
   if ((int)data_len % 16) {
     printf(
         "ERROR: Message length must be a multiple of 16 bytes (the block "
         "size).\n");
+    free(ref_out);
+    free(ref_in);
+    free(iv);
+    free(key);
     return;
   }
 
   if (impl == 0) {
-    // The C model is currently not supported.
-    printf(
-        "ERROR: c_dpi_aes_crypt_message() currently supports OpenSSL/BoringSSL "
-        "only\n");
+    // Fast C model with a cached key schedule, processes the whole message
+    // without per-block allocations.
+    aes_fast_crypt_message(aes_model_dpi_get_ks(key, key_len), op, mode, iv,
+                           ref_in, ref_out, data_len);
   } else {  // OpenSSL/BoringSSL
     if (!op) {
       crypto_encrypt(ref_out, iv, ref_in, data_len, key, key_len, mode);
@@ -208,10 +238,119 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
   aes_data_unpacked_put(data_o, ref_out);
 
   // Free memory.
+  free(ref_in);
   free(iv);
   free(key);
 }
 
+int c_dpi_aes_session_open(unsigned char impl_i, unsigned char op_i,
+                           const svBitVecVal *mode_i, const svBitVecVal *iv_i,
+                           const svBitVecVal *key_len_i,
+                           const svBitVecVal *key_i) {
+  // Mask out unused bits as their value is undetermined.
+  const unsigned char impl = impl_i & impl_mask;
+  const unsigned char op = op_i & op_mask;
+  const crypto_mode_t mode = (crypto_mode_t)(*mode_i & mode_mask);
+  if (mode == kCryptoAesNone) {
+    printf("ERROR: Mode kCryptoAesNone not supported by c_dpi_aes_session_open");
+    return -1;
+  }
+
+  // key_len_i is one-hot encoded.
+  int key_len;
+  if ((*key_len_i & key_len_mask) == 0x1) {
+    key_len = 16;
+  } else if ((*key_len_i & key_len_mask) == 0x2) {
+    key_len = 24;
+  } else {  // 0x4
+    key_len = 32;
+  }
+
+  // Get key from simulator.
+  unsigned char *key = aes_key_get(key_i);
+
+  // iv_i is a 1D array of words (4x32bit), but we need 16 bytes.
+  unsigned char iv[16] = {0};
+  if (mode != kCryptoAesEcb) {
+    svBitVecVal value;
+    for (int i = 0; i < 4; ++i) {
+      value = iv_i[i];
+      iv[4 * i + 0] = (unsigned char)(value >> 0);
+      iv[4 * i + 1] = (unsigned char)(value >> 8);
+      iv[4 * i + 2] = (unsigned char)(value >> 16);
+      iv[4 * i + 3] = (unsigned char)(value >> 24);
+    }
+  }
+
+  aes_model_session_t *session =
+      aes_model_session_open(impl, op, mode, key, key_len, iv);
+  free(key);
+  if (!session) {
+    return -1;
+  }
+
+  // Find a free slot, growing the table if there is none.
+  int handle;
+  for (handle = 0; handle < aes_model_dpi_num_sessions; ++handle) {
+    if (!aes_model_dpi_sessions[handle]) {
+      break;
+    }
+  }
+  if (handle == aes_model_dpi_num_sessions) {
+    int num_sessions =
+        aes_model_dpi_num_sessions ? 2 * aes_model_dpi_num_sessions : 8;
+    aes_model_session_t **sessions = (aes_model_session_t **)realloc(
+        aes_model_dpi_sessions, num_sessions * sizeof(aes_model_session_t *));
+    assert(sessions);
+    for (int i = aes_model_dpi_num_sessions; i < num_sessions; ++i) {
+      sessions[i] = NULL;
+    }
+    aes_model_dpi_sessions = sessions;
+    aes_model_dpi_num_sessions = num_sessions;
+  }
+  aes_model_dpi_sessions[handle] = session;
+
+  return handle;
+}
+
+int c_dpi_aes_session_update(int handle, const svOpenArrayHandle data_i,
+                             svOpenArrayHandle data_o) {
+  aes_model_session_t *session = aes_model_dpi_session_get(handle);
+  if (!session) {
+    return -1;
+  }
+
+  // Get message length.
+  int data_len = svSize(data_i, 1);
+  if (data_len % 16 || svSize(data_o, 1) != data_len) {
+    printf(
+        "ERROR: Data length must be a multiple of 16 bytes (the block size) "
+        "and match for input and output.\n");
+    return -1;
+  }
+
+  // Get input data from simulator, process it in place.
+  unsigned char *data = aes_data_unpacked_get(data_i);
+  if (aes_model_session_update(session, data, data, data_len) != data_len) {
+    free(data);
+    return -1;
+  }
+
+  // Write output data back to simulator, free data.
+  aes_data_unpacked_put(data_o, data);
+
+  return 0;
+}
+
+void c_dpi_aes_session_close(int handle) {
+  aes_model_session_t *session = aes_model_dpi_session_get(handle);
+  if (!session) {
+    return;
+  }
+  aes_model_session_close(session);
+  aes_model_dpi_sessions[handle] = NULL;
+}
+
 void c_dpi_aes_sub_bytes(const unsigned char op_i, const svBitVecVal *data_i,
                          svBitVecVal *data_o) {
   // get input data from simulator
@@ -41,7 +41,10 @@ void c_dpi_aes_crypt_block(const unsigned char impl_i, const unsigned char op_i,
                            svBitVecVal *data_o);
 
 /**
- * Perform encryption/decryption of an entire message using OpenSSL/BoringSSL.
+ * Perform encryption/decryption of an entire message.
+ *
+ * The C model used here is the fast model from aes_fast.h (T-tables or
+ * AES-NI) rather than the cycle-level model used by c_dpi_aes_crypt_block().
  *
  * @param  impl_i    Select reference impl.: 0 = C model, 1 = OpenSSL/BoringSSL
  * @param  op_i      Operation: 0 = encrypt, 1 = decrypt
@@ -62,6 +65,50 @@ void c_dpi_aes_crypt_message(unsigned char impl_i, unsigned char op_i,
                              const svOpenArrayHandle data_i,
                              svOpenArrayHandle data_o);
 
+/**
+ * Open a stateful encryption/decryption session.
+ *
+ * Unlike c_dpi_aes_crypt_message(), a session does not need the whole message
+ * up front: the chaining state is kept in the model between calls to
+ * c_dpi_aes_session_update(). Any number of sessions can be open at once,
+ * e.g., one per outstanding message in the scoreboard.
+ *
+ * @param  impl_i    Select reference impl.: 0 = C model, 1 = OpenSSL/BoringSSL
+ * @param  op_i      Operation: 0 = encrypt, 1 = decrypt
+ * @param  mode_i    Cipher mode: 6'b00_0001 = ECB, 6'00_b0010 = CBC,
+ *                                6'b00_0100 = CFB, 6'b00_1000 = OFB,
+ *                                6'b01_0000 = CTR
+ * @param  iv_i      Initialization vector: 1D array of words (2D packed array
+ *                   in SV)
+ * @param  key_len_i Key length: 3'b001 = 128b, 3'b010 = 192b, 3'b100 = 256b
+ * @param  key_i     Full input key, 1D array of words (2D packed array in SV)
+ * @return Session handle, -1 in case of error
+ */
+int c_dpi_aes_session_open(unsigned char impl_i, unsigned char op_i,
+                           const svBitVecVal *mode_i, const svBitVecVal *iv_i,
+                           const svBitVecVal *key_len_i,
+                           const svBitVecVal *key_i);
+
+/**
+ * Encrypt/decrypt the next blocks of a session's message.
+ *
+ * @param  handle Session handle returned by c_dpi_aes_session_open()
+ * @param  data_i Input data, 1D byte array (open array in SV), must be a
+ *                multiple of 16 bytes
+ * @param  data_o Output data, 1D byte array (open array in SV), same size as
+ *                data_i
+ * @return 0 on success, -1 in case of error
+ */
+int c_dpi_aes_session_update(int handle, const svOpenArrayHandle data_i,
+                             svOpenArrayHandle data_o);
+
+/**
+ * Close a session and free its handle for reuse.
+ *
+ * @param  handle Session handle returned by c_dpi_aes_session_open()
+ */
+void c_dpi_aes_session_close(int handle);
+
 /**
  * Perform sub bytes operation for forward/inverse cipher operation.
  *
@@ -30,6 +30,26 @@ package aes_model_dpi_pkg;
     output bit        [7:0] data_o[]
   );
 
+  import "DPI-C" context function int c_dpi_aes_session_open(
+    input  bit              impl_i,    // 0 = C model, 1 = OpenSSL/BoringSSL
+    input  bit              op_i,      // 0 = encrypt, 1 = decrypt
+    input  bit        [5:0] mode_i,    // 6'b00_0001 = ECB, 6'00_b0010 = CBC, 6'b00_0100 = CFB,
+                                       // 6'b00_1000 = OFB, 6'b01_0000 = CTR
+    input  bit  [3:0][31:0] iv_i,
+    input  bit        [2:0] key_len_i, // 3'b001 = 128b, 3'b010 = 192b, 3'b100 = 256b
+    input  bit  [7:0][31:0] key_i
+  );
+
+  import "DPI-C" context function int c_dpi_aes_session_update(
+    input  int              handle,
+    input  bit        [7:0] data_i[],
+    output bit        [7:0] data_o[]
+  );
+
+  import "DPI-C" context function void c_dpi_aes_session_close(
+    input  int              handle
+  );
+
   import "DPI-C" context function void c_dpi_aes_sub_bytes(
     input  bit                op_i, // 0 = encrypt, 1 = decrypt
     input  bit[3:0][3:0][7:0] data_i,
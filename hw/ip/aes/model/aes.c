@@ -19,12 +19,7 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
   unsigned char rcon;
   unsigned char state[16];
   unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
+  unsigned char full_key[32];
 
   // init
   for (int i = 0; i < 16; i++) {
@@ -55,8 +50,6 @@ int aes_encrypt_block(const unsigned char *plain_text, const unsigned char *key,
     cipher_text[i] = state[i];
   }
 
-  free(full_key);
-
   return 0;
 }
 
@@ -72,12 +65,7 @@ int aes_decrypt_block(const unsigned char *cipher_text,
   unsigned char rcon;
   unsigned char state[16];
   unsigned char round_key[16];
-  unsigned char *full_key =
-      (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (full_key == NULL) {
-    printf("ERROR: malloc() failed\n");
-    return -ENOMEM;
-  }
+  unsigned char full_key[32];
 
   // init
   for (int i = 0; i < 16; i++) {
@@ -117,7 +105,6 @@ int aes_decrypt_block(const unsigned char *cipher_text,
     plain_text[i] = state[i];
   }
 
-  free(full_key);
   return 0;
 }
 
@@ -352,11 +339,7 @@ void aes_key_expand(unsigned char *round_key, unsigned char *key, int key_len,
   //       for key_len == 16, key == round_key
 
   unsigned char temp[4];
-  unsigned char *old_key;
-  old_key = (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (!old_key) {
-    printf("ERROR: malloc() failed.");
-  }
+  unsigned char old_key[32];
 
   // copy key to temp
   for (int i = 0; i < key_len; i++) {
@@ -648,8 +631,6 @@ void aes_key_expand(unsigned char *round_key, unsigned char *key, int key_len,
     round_key[i] = key[key_len - 16 + i];
   }
 
-  free(old_key);
-
   return;
 }
 
@@ -663,11 +644,7 @@ void aes_inv_key_expand(unsigned char *round_key, unsigned char *key,
   //       for key_len == 16, key == round_key
 
   unsigned char temp[4];
-  unsigned char *old_key;
-  old_key = (unsigned char *)malloc(key_len * sizeof(unsigned char));
-  if (!old_key) {
-    printf("ERROR: malloc() failed.");
-  }
+  unsigned char old_key[32];
 
   // copy key to temp
   for (int i = 0; i < key_len; i++) {
@@ -951,8 +928,6 @@ void aes_inv_key_expand(unsigned char *round_key, unsigned char *key,
     round_key[i] = key[i];
   }
 
-  free(old_key);
-
   return;
 }
 
@@ -0,0 +1,338 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "aes_fast.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "aes.h"
+#include "aes_fast_aesni.h"
+
+static aes_fast_impl_t aes_fast_impl = kAesFastImplAuto;
+
+// T-tables, generated from the S-Boxes in aes.h on first use.
+static int aes_fast_tables_ready = 0;
+static uint32_t te[4][256];
+static uint32_t td[4][256];
+
+static const unsigned char aes_fast_rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10,
+                                                0x20, 0x40, 0x80, 0x1b, 0x36};
+
+static inline uint32_t aes_fast_get_u32(const unsigned char *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void aes_fast_put_u32(unsigned char *p, uint32_t x) {
+  p[0] = (unsigned char)(x >> 24);
+  p[1] = (unsigned char)(x >> 16);
+  p[2] = (unsigned char)(x >> 8);
+  p[3] = (unsigned char)x;
+}
+
+static inline uint32_t aes_fast_ror32(uint32_t x, int n) {
+  return n ? (x >> n) | (x << (32 - n)) : x;
+}
+
+static unsigned char aes_fast_gf_mul(unsigned char a, unsigned char b) {
+  unsigned char p = 0;
+  while (b) {
+    if (b & 1) {
+      p ^= a;
+    }
+    a = (unsigned char)((a << 1) ^ ((a & 0x80) ? 0x1b : 0));
+    b >>= 1;
+  }
+  return p;
+}
+
+static void aes_fast_init_tables(void) {
+  if (aes_fast_tables_ready) {
+    return;
+  }
+
+  for (int x = 0; x < 256; ++x) {
+    unsigned char s = sbox[x];
+    uint32_t e = ((uint32_t)aes_fast_gf_mul(s, 2) << 24) | ((uint32_t)s << 16) |
+                 ((uint32_t)s << 8) | aes_fast_gf_mul(s, 3);
+    unsigned char is = inv_sbox[x];
+    uint32_t d = ((uint32_t)aes_fast_gf_mul(is, 0xe) << 24) |
+                 ((uint32_t)aes_fast_gf_mul(is, 0x9) << 16) |
+                 ((uint32_t)aes_fast_gf_mul(is, 0xd) << 8) |
+                 aes_fast_gf_mul(is, 0xb);
+    for (int i = 0; i < 4; ++i) {
+      te[i][x] = aes_fast_ror32(e, 8 * i);
+      td[i][x] = aes_fast_ror32(d, 8 * i);
+    }
+  }
+
+  aes_fast_tables_ready = 1;
+}
+
+int aes_fast_set_impl(aes_fast_impl_t impl) {
+  if (impl == kAesFastImplAesNi && !aes_fast_aesni_supported()) {
+    printf("ERROR: AES-NI is not supported by this CPU\n");
+    return -ENOTSUP;
+  }
+  aes_fast_impl = impl;
+  return 0;
+}
+
+aes_fast_impl_t aes_fast_get_impl(void) {
+  if (aes_fast_impl == kAesFastImplAuto) {
+    return aes_fast_aesni_supported() ? kAesFastImplAesNi : kAesFastImplTTable;
+  }
+  return aes_fast_impl;
+}
+
+static uint32_t aes_fast_sub_word(uint32_t x) {
+  return ((uint32_t)sbox[x >> 24] << 24) |
+         ((uint32_t)sbox[(x >> 16) & 0xff] << 16) |
+         ((uint32_t)sbox[(x >> 8) & 0xff] << 8) | sbox[x & 0xff];
+}
+
+// InvMixColumns applied to a single column, using InvSubBytes o SubBytes = id.
+static uint32_t aes_fast_inv_mix_column(uint32_t x) {
+  return td[0][sbox[x >> 24]] ^ td[1][sbox[(x >> 16) & 0xff]] ^
+         td[2][sbox[(x >> 8) & 0xff]] ^ td[3][sbox[x & 0xff]];
+}
+
+int aes_key_schedule_init(aes_key_schedule_t *ks, const unsigned char *key,
+                          int key_len) {
+  int num_rounds = aes_get_num_rounds(key_len);
+  if (num_rounds < 0) {
+    return -EINVAL;
+  }
+
+  aes_fast_init_tables();
+
+  ks->key_len = key_len;
+  ks->num_rounds = num_rounds;
+  ks->impl = aes_fast_get_impl();
+
+  // Key expansion (FIPS 197, section 5.2).
+  const int nk = key_len / 4;
+  const int num_words = 4 * (num_rounds + 1);
+  uint32_t *w = ks->enc_rk;
+  for (int i = 0; i < nk; ++i) {
+    w[i] = aes_fast_get_u32(&key[4 * i]);
+  }
+  for (int i = nk; i < num_words; ++i) {
+    uint32_t temp = w[i - 1];
+    if (i % nk == 0) {
+      temp = aes_fast_sub_word((temp << 8) | (temp >> 24)) ^
+             ((uint32_t)aes_fast_rcon[i / nk - 1] << 24);
+    } else if (nk > 6 && i % nk == 4) {
+      temp = aes_fast_sub_word(temp);
+    }
+    w[i] = w[i - nk] ^ temp;
+  }
+
+  // Equivalent Inverse Cipher round keys: reverse the round order and apply
+  // InvMixColumns to all but the first and last round key.
+  uint32_t *dw = ks->dec_rk;
+  for (int r = 0; r <= num_rounds; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      uint32_t x = w[4 * (num_rounds - r) + c];
+      dw[4 * r + c] =
+          (r == 0 || r == num_rounds) ? x : aes_fast_inv_mix_column(x);
+    }
+  }
+
+  for (int i = 0; i < num_words; ++i) {
+    aes_fast_put_u32(&ks->enc_rk_bytes[4 * i], w[i]);
+    aes_fast_put_u32(&ks->dec_rk_bytes[4 * i], dw[i]);
+  }
+
+  return 0;
+}
+
+void aes_key_schedule_clear(aes_key_schedule_t *ks) {
+  memset(ks, 0, sizeof(*ks));
+}
+
+static void aes_fast_ttable_encrypt(const aes_key_schedule_t *ks,
+                                    const unsigned char *in,
+                                    unsigned char *out) {
+  const uint32_t *rk = ks->enc_rk;
+  uint32_t s0 = aes_fast_get_u32(&in[0]) ^ rk[0];
+  uint32_t s1 = aes_fast_get_u32(&in[4]) ^ rk[1];
+  uint32_t s2 = aes_fast_get_u32(&in[8]) ^ rk[2];
+  uint32_t s3 = aes_fast_get_u32(&in[12]) ^ rk[3];
+  uint32_t t0, t1, t2, t3;
+
+  for (int r = 1; r < ks->num_rounds; ++r) {
+    rk += 4;
+    t0 = te[0][s0 >> 24] ^ te[1][(s1 >> 16) & 0xff] ^
+         te[2][(s2 >> 8) & 0xff] ^ te[3][s3 & 0xff] ^ rk[0];
+    t1 = te[0][s1 >> 24] ^ te[1][(s2 >> 16) & 0xff] ^
+         te[2][(s3 >> 8) & 0xff] ^ te[3][s0 & 0xff] ^ rk[1];
+    t2 = te[0][s2 >> 24] ^ te[1][(s3 >> 16) & 0xff] ^
+         te[2][(s0 >> 8) & 0xff] ^ te[3][s1 & 0xff] ^ rk[2];
+    t3 = te[0][s3 >> 24] ^ te[1][(s0 >> 16) & 0xff] ^
+         te[2][(s1 >> 8) & 0xff] ^ te[3][s2 & 0xff] ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  // Last round: no MixColumns.
+  rk += 4;
+  const uint32_t s[4] = {s0, s1, s2, s3};
+  for (int c = 0; c < 4; ++c) {
+    uint32_t x = ((uint32_t)sbox[s[c] >> 24] << 24) |
+                 ((uint32_t)sbox[(s[(c + 1) % 4] >> 16) & 0xff] << 16) |
+                 ((uint32_t)sbox[(s[(c + 2) % 4] >> 8) & 0xff] << 8) |
+                 sbox[s[(c + 3) % 4] & 0xff];
+    aes_fast_put_u32(&out[4 * c], x ^ rk[c]);
+  }
+}
+
+static void aes_fast_ttable_decrypt(const aes_key_schedule_t *ks,
+                                    const unsigned char *in,
+                                    unsigned char *out) {
+  const uint32_t *rk = ks->dec_rk;
+  uint32_t s0 = aes_fast_get_u32(&in[0]) ^ rk[0];
+  uint32_t s1 = aes_fast_get_u32(&in[4]) ^ rk[1];
+  uint32_t s2 = aes_fast_get_u32(&in[8]) ^ rk[2];
+  uint32_t s3 = aes_fast_get_u32(&in[12]) ^ rk[3];
+  uint32_t t0, t1, t2, t3;
+
+  for (int r = 1; r < ks->num_rounds; ++r) {
+    rk += 4;
+    t0 = td[0][s0 >> 24] ^ td[1][(s3 >> 16) & 0xff] ^
+         td[2][(s2 >> 8) & 0xff] ^ td[3][s1 & 0xff] ^ rk[0];
+    t1 = td[0][s1 >> 24] ^ td[1][(s0 >> 16) & 0xff] ^
+         td[2][(s3 >> 8) & 0xff] ^ td[3][s2 & 0xff] ^ rk[1];
+    t2 = td[0][s2 >> 24] ^ td[1][(s1 >> 16) & 0xff] ^
+         td[2][(s0 >> 8) & 0xff] ^ td[3][s3 & 0xff] ^ rk[2];
+    t3 = td[0][s3 >> 24] ^ td[1][(s2 >> 16) & 0xff] ^
+         td[2][(s1 >> 8) & 0xff] ^ td[3][s0 & 0xff] ^ rk[3];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+
+  // Last round: no InvMixColumns.
+  rk += 4;
+  const uint32_t s[4] = {s0, s1, s2, s3};
+  for (int c = 0; c < 4; ++c) {
+    uint32_t x = ((uint32_t)inv_sbox[s[c] >> 24] << 24) |
+                 ((uint32_t)inv_sbox[(s[(c + 3) % 4] >> 16) & 0xff] << 16) |
+                 ((uint32_t)inv_sbox[(s[(c + 2) % 4] >> 8) & 0xff] << 8) |
+                 inv_sbox[s[(c + 1) % 4] & 0xff];
+    aes_fast_put_u32(&out[4 * c], x ^ rk[c]);
+  }
+}
+
+void aes_fast_encrypt_block(const aes_key_schedule_t *ks,
+                            const unsigned char *plain_text,
+                            unsigned char *cipher_text) {
+  if (ks->impl == kAesFastImplAesNi) {
+    aes_fast_aesni_encrypt_block(ks->enc_rk_bytes, ks->num_rounds, plain_text,
+                                 cipher_text);
+  } else {
+    aes_fast_ttable_encrypt(ks, plain_text, cipher_text);
+  }
+}
+
+void aes_fast_decrypt_block(const aes_key_schedule_t *ks,
+                            const unsigned char *cipher_text,
+                            unsigned char *plain_text) {
+  if (ks->impl == kAesFastImplAesNi) {
+    aes_fast_aesni_decrypt_block(ks->dec_rk_bytes, ks->num_rounds, cipher_text,
+                                 plain_text);
+  } else {
+    aes_fast_ttable_decrypt(ks, cipher_text, plain_text);
+  }
+}
+
+static inline void aes_fast_xor_block(unsigned char *out,
+                                      const unsigned char *a,
+                                      const unsigned char *b) {
+  for (int i = 0; i < 16; ++i) {
+    out[i] = a[i] ^ b[i];
+  }
+}
+
+static inline void aes_fast_ctr_inc(unsigned char *ctr) {
+  for (int i = 15; i >= 0; --i) {
+    if (++ctr[i]) {
+      break;
+    }
+  }
+}
+
+int aes_fast_crypt_message(const aes_key_schedule_t *ks, int op,
+                           crypto_mode_t mode, unsigned char *iv,
+                           const unsigned char *input, unsigned char *output,
+                           int len) {
+  if (len < 0 || len % 16) {
+    printf("ERROR: Message length must be a multiple of 16 bytes\n");
+    return -EINVAL;
+  }
+
+  unsigned char buf[16];
+  for (int i = 0; i < len; i += 16) {
+    const unsigned char *in = &input[i];
+    unsigned char *out = &output[i];
+
+    switch (mode) {
+      case kCryptoAesEcb:
+        if (!op) {
+          aes_fast_encrypt_block(ks, in, out);
+        } else {
+          aes_fast_decrypt_block(ks, in, out);
+        }
+        break;
+
+      case kCryptoAesCbc:
+        if (!op) {
+          aes_fast_xor_block(buf, in, iv);
+          aes_fast_encrypt_block(ks, buf, out);
+          memcpy(iv, out, 16);
+        } else {
+          // Input and output may alias, keep the cipher text for chaining.
+          aes_fast_decrypt_block(ks, in, buf);
+          aes_fast_xor_block(buf, buf, iv);
+          memcpy(iv, in, 16);
+          memcpy(out, buf, 16);
+        }
+        break;
+
+      case kCryptoAesCfb:
+        aes_fast_encrypt_block(ks, iv, buf);
+        if (!op) {
+          aes_fast_xor_block(out, in, buf);
+          memcpy(iv, out, 16);
+        } else {
+          memcpy(iv, in, 16);
+          aes_fast_xor_block(out, in, buf);
+        }
+        break;
+
+      case kCryptoAesOfb:
+        aes_fast_encrypt_block(ks, iv, iv);
+        aes_fast_xor_block(out, in, iv);
+        break;
+
+      case kCryptoAesCtr:
+        aes_fast_encrypt_block(ks, iv, buf);
+        aes_fast_xor_block(out, in, buf);
+        aes_fast_ctr_inc(iv);
+        break;
+
+      default:
+        printf("ERROR: Unsupported mode %d\n", mode);
+        return -EINVAL;
+    }
+  }
+
+  memset(buf, 0, sizeof(buf));
+  return len;
+}
@@ -0,0 +1,134 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_AES_MODEL_AES_FAST_H_
+#define OPENTITAN_HW_IP_AES_MODEL_AES_FAST_H_
+
+#include <stdint.h>
+
+#include "crypto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fast AES golden model for whole-message checks.
+//
+// Unlike the cycle-level model in aes.h, which recomputes the key schedule
+// round by round and works byte by byte, this model expands the key once into
+// an aes_key_schedule_t and then processes entire messages with either 32-bit
+// T-tables or AES-NI instructions. No memory is allocated per block or per
+// message.
+
+/**
+ * Implementation used for the block cipher.
+ */
+typedef enum aes_fast_impl {
+  // Fastest implementation supported by the host CPU.
+  kAesFastImplAuto = 0,
+  // Portable 32-bit T-table implementation.
+  kAesFastImplTTable = 1,
+  // x86 AES-NI instructions.
+  kAesFastImplAesNi = 2,
+} aes_fast_impl_t;
+
+/**
+ * Pre-expanded key schedule.
+ *
+ * The round keys are stored both as big-endian words (for the T-table
+ * implementation) and as bytes (for AES-NI). The decryption round keys are
+ * those of the Equivalent Inverse Cipher (FIPS 197, section 5.3.5).
+ */
+typedef struct aes_key_schedule {
+  int key_len;
+  int num_rounds;
+  aes_fast_impl_t impl;
+  uint32_t enc_rk[60];
+  uint32_t dec_rk[60];
+  unsigned char enc_rk_bytes[240] __attribute__((aligned(16)));
+  unsigned char dec_rk_bytes[240] __attribute__((aligned(16)));
+} aes_key_schedule_t;
+
+/**
+ * Select the implementation used by key schedules initialized from now on.
+ *
+ * @param  impl Implementation, kAesFastImplAuto picks AES-NI if available
+ * @return 0 on success, -ENOTSUP if the host CPU does not support impl
+ */
+int aes_fast_set_impl(aes_fast_impl_t impl);
+
+/**
+ * Get the implementation that aes_fast_set_impl() resolved to.
+ *
+ * @return kAesFastImplTTable or kAesFastImplAesNi
+ */
+aes_fast_impl_t aes_fast_get_impl(void);
+
+/**
+ * Expand a key into a key schedule.
+ *
+ * @param  ks      Key schedule to initialize
+ * @param  key     Encryption key
+ * @param  key_len Key length in bytes (16, 24, 32)
+ * @return 0 on success, -EINVAL for unsupported key lengths
+ */
+int aes_key_schedule_init(aes_key_schedule_t *ks, const unsigned char *key,
+                          int key_len);
+
+/**
+ * Clear a key schedule.
+ *
+ * @param  ks Key schedule to clear
+ */
+void aes_key_schedule_clear(aes_key_schedule_t *ks);
+
+/**
+ * Encrypt one data block (16 Bytes) in ECB mode.
+ *
+ * @param  ks          Key schedule
+ * @param  plain_text  Input block
+ * @param  cipher_text Output block, may alias plain_text
+ */
+void aes_fast_encrypt_block(const aes_key_schedule_t *ks,
+                            const unsigned char *plain_text,
+                            unsigned char *cipher_text);
+
+/**
+ * Decrypt one data block (16 Bytes) in ECB mode.
+ *
+ * @param  ks          Key schedule
+ * @param  cipher_text Input block
+ * @param  plain_text  Output block, may alias cipher_text
+ */
+void aes_fast_decrypt_block(const aes_key_schedule_t *ks,
+                            const unsigned char *cipher_text,
+                            unsigned char *plain_text);
+
+/**
+ * Encrypt/decrypt a message in ECB, CBC, CFB-128, OFB or CTR mode.
+ *
+ * The chaining value is updated in place, so a message can be processed in
+ * several calls: after returning, iv holds the previous cipher text block
+ * (CBC, CFB), the last keystream block (OFB) or the next counter value (CTR).
+ * The counter is incremented as a 128-bit big-endian integer, matching both
+ * the AES unit and OpenSSL/BoringSSL.
+ *
+ * @param  ks     Key schedule
+ * @param  op     Operation: 0 = encrypt, 1 = decrypt
+ * @param  mode   AES cipher mode @see crypto_mode.
+ * @param  iv     16-byte chaining value, ignored for ECB
+ * @param  input  Input data, must be a multiple of 16 bytes
+ * @param  output Output data, may alias input
+ * @param  len    Length of the data in bytes, must be a multiple of 16
+ * @return len on success, -EINVAL for unsupported modes or lengths
+ */
+int aes_fast_crypt_message(const aes_key_schedule_t *ks, int op,
+                           crypto_mode_t mode, unsigned char *iv,
+                           const unsigned char *input, unsigned char *output,
+                           int len);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // OPENTITAN_HW_IP_AES_MODEL_AES_FAST_H_
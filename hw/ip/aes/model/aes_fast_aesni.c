@@ -0,0 +1,80 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "aes_fast_aesni.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+int aes_fast_aesni_supported(void) {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("aes") != 0;
+}
+
+// Compile the functions below with AES-NI enabled without requiring -maes for
+// the whole model. They are only called if aes_fast_aesni_supported().
+#ifdef __clang__
+#pragma clang attribute push(__attribute__((target("aes,sse2"))), \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("aes,sse2")
+#endif
+
+void aes_fast_aesni_encrypt_block(const unsigned char *rk, int num_rounds,
+                                  const unsigned char *plain_text,
+                                  unsigned char *cipher_text) {
+  const __m128i *k = (const __m128i *)rk;
+  __m128i s = _mm_loadu_si128((const __m128i *)plain_text);
+  s = _mm_xor_si128(s, _mm_load_si128(&k[0]));
+  for (int r = 1; r < num_rounds; ++r) {
+    s = _mm_aesenc_si128(s, _mm_load_si128(&k[r]));
+  }
+  s = _mm_aesenclast_si128(s, _mm_load_si128(&k[num_rounds]));
+  _mm_storeu_si128((__m128i *)cipher_text, s);
+}
+
+void aes_fast_aesni_decrypt_block(const unsigned char *rk, int num_rounds,
+                                  const unsigned char *cipher_text,
+                                  unsigned char *plain_text) {
+  const __m128i *k = (const __m128i *)rk;
+  __m128i s = _mm_loadu_si128((const __m128i *)cipher_text);
+  s = _mm_xor_si128(s, _mm_load_si128(&k[0]));
+  for (int r = 1; r < num_rounds; ++r) {
+    s = _mm_aesdec_si128(s, _mm_load_si128(&k[r]));
+  }
+  s = _mm_aesdeclast_si128(s, _mm_load_si128(&k[num_rounds]));
+  _mm_storeu_si128((__m128i *)plain_text, s);
+}
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#else  // !x86
+
+int aes_fast_aesni_supported(void) { return 0; }
+
+void aes_fast_aesni_encrypt_block(const unsigned char *rk, int num_rounds,
+                                  const unsigned char *plain_text,
+                                  unsigned char *cipher_text) {
+  printf("ERROR: AES-NI is only available on x86\n");
+  abort();
+}
+
+void aes_fast_aesni_decrypt_block(const unsigned char *rk, int num_rounds,
+                                  const unsigned char *cipher_text,
+                                  unsigned char *plain_text) {
+  printf("ERROR: AES-NI is only available on x86\n");
+  abort();
+}
+
+#endif
@@ -0,0 +1,44 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_AES_MODEL_AES_FAST_AESNI_H_
+#define OPENTITAN_HW_IP_AES_MODEL_AES_FAST_AESNI_H_
+
+// AES-NI backend of the fast AES model (aes_fast.h). On hosts other than x86,
+// aes_fast_aesni_supported() returns 0 and the block functions must not be
+// called.
+
+/**
+ * Check whether the host CPU supports AES-NI.
+ *
+ * @return 1 if supported, 0 otherwise
+ */
+int aes_fast_aesni_supported(void);
+
+/**
+ * Encrypt one block using AES-NI.
+ *
+ * @param  rk          Encryption round keys, (num_rounds + 1) * 16 bytes
+ * @param  num_rounds  Number of cipher rounds (10, 12, 14)
+ * @param  plain_text  Input block
+ * @param  cipher_text Output block, may alias plain_text
+ */
+void aes_fast_aesni_encrypt_block(const unsigned char *rk, int num_rounds,
+                                  const unsigned char *plain_text,
+                                  unsigned char *cipher_text);
+
+/**
+ * Decrypt one block using AES-NI.
+ *
+ * @param  rk          Equivalent Inverse Cipher round keys,
+ *                     (num_rounds + 1) * 16 bytes
+ * @param  num_rounds  Number of cipher rounds (10, 12, 14)
+ * @param  cipher_text Input block
+ * @param  plain_text  Output block, may alias cipher_text
+ */
+void aes_fast_aesni_decrypt_block(const unsigned char *rk, int num_rounds,
+                                  const unsigned char *cipher_text,
+                                  unsigned char *plain_text);
+
+#endif  // OPENTITAN_HW_IP_AES_MODEL_AES_FAST_AESNI_H_
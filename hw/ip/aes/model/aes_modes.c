@@ -10,6 +10,8 @@
 #include <string.h>
 
 #include "aes.h"
+#include "aes_fast.h"
+#include "aes_session.h"
 #include "crypto.h"
 
 #ifdef USE_BORING_SSL
@@ -118,6 +120,116 @@ static int crypto_compare(const unsigned char *cipher_text,
   return 0;
 }
 
+static int aes_fast_compare(const unsigned char *cipher_text,
+                            const unsigned char *iv,
+                            const unsigned char *plain_text, int len,
+                            const unsigned char *key, int key_len,
+                            crypto_mode_t mode) {
+  const aes_fast_impl_t impls[2] = {kAesFastImplTTable, kAesFastImplAesNi};
+  const char *impl_names[2] = {"T-table", "AES-NI"};
+  unsigned char data_out[64];
+  unsigned char iv_buf[16];
+  aes_key_schedule_t ks;
+
+  if (len > (int)sizeof(data_out)) {
+    printf("ERROR: len = %i too large. Aborting now\n", len);
+    return 1;
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    if (aes_fast_set_impl(impls[i])) {
+      printf("SKIPPED: %s not supported\n", impl_names[i]);
+      continue;
+    }
+    aes_key_schedule_init(&ks, key, key_len);
+
+    // Encrypt in two calls to also check the chaining value update.
+    memcpy(iv_buf, iv, 16);
+    aes_fast_crypt_message(&ks, 0, mode, iv_buf, plain_text, data_out, 16);
+    aes_fast_crypt_message(&ks, 0, mode, iv_buf, &plain_text[16],
+                           &data_out[16], len - 16);
+    if (memcmp(data_out, cipher_text, len)) {
+      printf("ERROR: %s encrypt output does not match NIST example cipher "
+             "text\n",
+             impl_names[i]);
+      return 1;
+    }
+    printf("SUCCESS: %s encrypt output matches NIST example cipher text\n",
+           impl_names[i]);
+
+    // Decrypt in place.
+    memcpy(iv_buf, iv, 16);
+    aes_fast_crypt_message(&ks, 1, mode, iv_buf, data_out, data_out, len);
+    if (memcmp(data_out, plain_text, len)) {
+      printf("ERROR: %s decrypt output does not match NIST example plain "
+             "text\n",
+             impl_names[i]);
+      return 1;
+    }
+    printf("SUCCESS: %s decrypt output matches NIST example plain text\n",
+           impl_names[i]);
+  }
+
+  aes_key_schedule_clear(&ks);
+  aes_fast_set_impl(kAesFastImplAuto);
+
+  return 0;
+}
+
+static int aes_session_compare(const unsigned char *cipher_text,
+                               const unsigned char *iv,
+                               const unsigned char *plain_text, int len,
+                               const unsigned char *key, int key_len,
+                               crypto_mode_t mode) {
+  const char *impl_names[2] = {"Fast model session", "Crypto lib session"};
+  unsigned char enc_out[64];
+  unsigned char dec_out[64];
+
+  if (len > (int)sizeof(enc_out)) {
+    printf("ERROR: len = %i too large. Aborting now\n", len);
+    return 1;
+  }
+
+  for (int impl = 0; impl < 2; ++impl) {
+    // Interleave an encrypt and a decrypt session block by block to check
+    // that sessions keep their chaining state independently.
+    aes_model_session_t *enc =
+        aes_model_session_open(impl, 0, mode, key, key_len, iv);
+    aes_model_session_t *dec =
+        aes_model_session_open(impl, 1, mode, key, key_len, iv);
+    if (!enc || !dec) {
+      printf("ERROR: %s open failed\n", impl_names[impl]);
+      aes_model_session_close(enc);
+      aes_model_session_close(dec);
+      return 1;
+    }
+    int ret = 0;
+    for (int j = 0; j < len / 16 && !ret; ++j) {
+      if (aes_model_session_update(enc, &plain_text[j * 16], &enc_out[j * 16],
+                                   16) != 16 ||
+          aes_model_session_update(dec, &cipher_text[j * 16], &dec_out[j * 16],
+                                   16) != 16) {
+        ret = 1;
+      }
+    }
+    if (aes_model_session_num_blocks(enc) != (unsigned long)len / 16) {
+      ret = 1;
+    }
+    aes_model_session_close(enc);
+    aes_model_session_close(dec);
+
+    if (ret || memcmp(enc_out, cipher_text, len) ||
+        memcmp(dec_out, plain_text, len)) {
+      printf("ERROR: %s output does not match NIST example\n",
+             impl_names[impl]);
+      return 1;
+    }
+    printf("SUCCESS: %s output matches NIST example\n", impl_names[impl]);
+  }
+
+  return 0;
+}
+
 int main(int argc, char *argv[]) {
   const int len = 64;
   int key_len;
@@ -151,7 +263,11 @@ int main(int argc, char *argv[]) {
     }
 
     if (crypto_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
-                       mode)) {
+                       mode) ||
+        aes_fast_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                         key_len, mode) ||
+        aes_session_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                            key_len, mode)) {
       return 1;
     }
   }
@@ -181,7 +297,11 @@ int main(int argc, char *argv[]) {
     }
 
     if (crypto_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
-                       mode)) {
+                       mode) ||
+        aes_fast_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                         key_len, mode) ||
+        aes_session_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                            key_len, mode)) {
       return 1;
     }
   }
@@ -212,7 +332,11 @@ int main(int argc, char *argv[]) {
     }
 
     if (crypto_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
-                       mode)) {
+                       mode) ||
+        aes_fast_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                         key_len, mode) ||
+        aes_session_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                            key_len, mode)) {
       return 1;
     }
   }
@@ -242,7 +366,11 @@ int main(int argc, char *argv[]) {
     }
 
     if (crypto_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
-                       mode)) {
+                       mode) ||
+        aes_fast_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                         key_len, mode) ||
+        aes_session_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                            key_len, mode)) {
       return 1;
     }
   }
@@ -272,7 +400,11 @@ int main(int argc, char *argv[]) {
     }
 
     if (crypto_compare(cipher_text, iv, kAesModesPlainText, len, key, key_len,
-                       mode)) {
+                       mode) ||
+        aes_fast_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                         key_len, mode) ||
+        aes_session_compare(cipher_text, iv, kAesModesPlainText, len, key,
+                            key_len, mode)) {
       return 1;
     }
   }
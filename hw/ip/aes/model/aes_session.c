@@ -0,0 +1,101 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "aes_session.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "aes_fast.h"
+
+struct aes_model_session {
+  int impl;
+  int op;
+  crypto_mode_t mode;
+  unsigned long num_blocks;
+  // Fast C model state (impl == 0).
+  aes_key_schedule_t ks;
+  unsigned char iv[16];
+  // OpenSSL/BoringSSL state (impl == 1).
+  crypto_stream_t *stream;
+};
+
+aes_model_session_t *aes_model_session_open(int impl, int op,
+                                            crypto_mode_t mode,
+                                            const unsigned char *key,
+                                            int key_len,
+                                            const unsigned char *iv) {
+  if (mode != kCryptoAesEcb && mode != kCryptoAesCbc &&
+      mode != kCryptoAesCfb && mode != kCryptoAesOfb &&
+      mode != kCryptoAesCtr) {
+    printf("ERROR: Unsupported mode %d\n", mode);
+    return NULL;
+  }
+
+  aes_model_session_t *session =
+      (aes_model_session_t *)calloc(1, sizeof(aes_model_session_t));
+  if (!session) {
+    printf("ERROR: calloc() failed\n");
+    return NULL;
+  }
+  session->impl = impl;
+  session->op = op;
+  session->mode = mode;
+  if (iv) {
+    memcpy(session->iv, iv, 16);
+  }
+
+  if (impl == 0) {
+    if (aes_key_schedule_init(&session->ks, key, key_len)) {
+      aes_model_session_close(session);
+      return NULL;
+    }
+  } else {
+    session->stream = crypto_stream_new(op, session->iv, key, key_len, mode);
+    if (!session->stream) {
+      aes_model_session_close(session);
+      return NULL;
+    }
+  }
+
+  return session;
+}
+
+int aes_model_session_update(aes_model_session_t *session,
+                             const unsigned char *input, unsigned char *output,
+                             int len) {
+  if (len < 0 || len % 16) {
+    printf("ERROR: Length must be a multiple of 16 bytes (the block size)\n");
+    return -1;
+  }
+
+  int ret;
+  if (session->impl == 0) {
+    ret = aes_fast_crypt_message(&session->ks, session->op, session->mode,
+                                 session->iv, input, output, len);
+  } else {
+    ret = crypto_stream_update(session->stream, output, input, len);
+  }
+  if (ret != len) {
+    return -1;
+  }
+
+  session->num_blocks += len / 16;
+  return len;
+}
+
+unsigned long aes_model_session_num_blocks(const aes_model_session_t *session) {
+  return session->num_blocks;
+}
+
+void aes_model_session_close(aes_model_session_t *session) {
+  if (!session) {
+    return;
+  }
+  crypto_stream_free(session->stream);
+  aes_key_schedule_clear(&session->ks);
+  memset(session->iv, 0, sizeof(session->iv));
+  free(session);
+}
@@ -0,0 +1,76 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_AES_MODEL_AES_SESSION_H_
+#define OPENTITAN_HW_IP_AES_MODEL_AES_SESSION_H_
+
+#include "crypto.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Stateful AES reference model sessions.
+//
+// A session encrypts or decrypts one message in as many pieces as the caller
+// likes. The chaining state (CBC IV, CFB/OFB feedback, CTR counter) is kept
+// in the session between updates, so a scoreboard can check every block as
+// it leaves the DUT without buffering the whole message. Sessions are
+// independent of each other and any number of them can be open at once.
+
+/**
+ * Opaque session handle.
+ */
+typedef struct aes_model_session aes_model_session_t;
+
+/**
+ * Open a new session.
+ *
+ * @param  impl    Reference impl.: 0 = fast C model (aes_fast.h),
+ *                 1 = OpenSSL/BoringSSL
+ * @param  op      Operation: 0 = encrypt, 1 = decrypt
+ * @param  mode    AES cipher mode @see crypto_mode.
+ * @param  key     Encryption key
+ * @param  key_len Key length in bytes (16, 24, 32)
+ * @param  iv      16-byte initialization vector, may be NULL for ECB
+ * @return New session, NULL in case of error
+ */
+aes_model_session_t *aes_model_session_open(int impl, int op,
+                                            crypto_mode_t mode,
+                                            const unsigned char *key,
+                                            int key_len,
+                                            const unsigned char *iv);
+
+/**
+ * Process the next blocks of the message.
+ *
+ * @param  session Session returned by aes_model_session_open()
+ * @param  input   Input data, must be a multiple of 16 bytes
+ * @param  output  Output data, may alias input
+ * @param  len     Length of the data in bytes, must be a multiple of 16
+ * @return len on success, -1 in case of error
+ */
+int aes_model_session_update(aes_model_session_t *session,
+                             const unsigned char *input, unsigned char *output,
+                             int len);
+
+/**
+ * Get the number of blocks processed so far.
+ *
+ * @param  session Session returned by aes_model_session_open()
+ * @return Number of 16-byte blocks passed to aes_model_session_update()
+ */
+unsigned long aes_model_session_num_blocks(const aes_model_session_t *session);
+
+/**
+ * Close a session, clearing key material.
+ *
+ * @param  session Session returned by aes_model_session_open(), may be NULL
+ */
+void aes_model_session_close(aes_model_session_t *session);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+#endif  // OPENTITAN_HW_IP_AES_MODEL_AES_SESSION_H_
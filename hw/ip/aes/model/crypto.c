@@ -6,6 +6,13 @@
 
 #include <openssl/conf.h>
 #include <openssl/evp.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct crypto_stream {
+  EVP_CIPHER_CTX *ctx;
+  int op;
+};
 
 /**
  * Get EVP_CIPHER type pointer defined by key_len and mode.
@@ -162,3 +169,69 @@ int crypto_decrypt(unsigned char *output, const unsigned char *iv,
 
   return output_len;
 }
+
+crypto_stream_t *crypto_stream_new(int op, const unsigned char *iv,
+                                   const unsigned char *key, int key_len,
+                                   crypto_mode_t mode) {
+  crypto_stream_t *stream = (crypto_stream_t *)malloc(sizeof(crypto_stream_t));
+  if (!stream) {
+    printf("ERROR: malloc() failed\n");
+    return NULL;
+  }
+  stream->op = op;
+
+  // Create new cipher context
+  stream->ctx = EVP_CIPHER_CTX_new();
+  if (!stream->ctx) {
+    printf("ERROR: Creation of cipher context failed\n");
+    free(stream);
+    return NULL;
+  }
+
+  // Get cipher
+  const EVP_CIPHER *cipher = crypto_get_EVP_cipher(key_len, mode);
+
+  // Init encryption/decryption context
+  int ret;
+  if (!op) {
+    ret = EVP_EncryptInit_ex(stream->ctx, cipher, NULL, key, iv);
+  } else {
+    ret = EVP_DecryptInit_ex(stream->ctx, cipher, NULL, key, iv);
+  }
+  if (ret != 1) {
+    printf("ERROR: Initialization of cipher context failed\n");
+    crypto_stream_free(stream);
+    return NULL;
+  }
+
+  // Disable padding - we only ever process multiples of 16 bytes, and the
+  // context is never finalized.
+  EVP_CIPHER_CTX_set_padding(stream->ctx, 0);
+
+  return stream;
+}
+
+int crypto_stream_update(crypto_stream_t *stream, unsigned char *output,
+                         const unsigned char *input, int input_len) {
+  int ret, output_len;
+
+  if (!stream->op) {
+    ret = EVP_EncryptUpdate(stream->ctx, output, &output_len, input, input_len);
+  } else {
+    ret = EVP_DecryptUpdate(stream->ctx, output, &output_len, input, input_len);
+  }
+  if (ret != 1) {
+    printf("ERROR: Stream update failed\n");
+    return -1;
+  }
+
+  return output_len;
+}
+
+void crypto_stream_free(crypto_stream_t *stream) {
+  if (!stream) {
+    return;
+  }
+  EVP_CIPHER_CTX_free(stream->ctx);
+  free(stream);
+}
@@ -51,4 +51,47 @@ int crypto_decrypt(unsigned char *output, const unsigned char *iv,
                    const unsigned char *input, int input_len,
                    const unsigned char *key, int key_len, crypto_mode_t mode);
 
+/**
+ * Streaming BoringSSL/OpenSSL cipher context, see crypto_stream_new().
+ */
+typedef struct crypto_stream crypto_stream_t;
+
+/**
+ * Create a streaming encryption/decryption context using BoringSSL/OpenSSL.
+ *
+ * Unlike crypto_encrypt()/crypto_decrypt(), the context keeps the chaining
+ * state (e.g. the CBC IV or the CTR counter) between calls to
+ * crypto_stream_update(), so a message can be processed in pieces.
+ *
+ * @param  op      Operation: 0 = encrypt, 1 = decrypt
+ * @param  iv      16-byte initialization vector
+ * @param  key     Encryption key, decryption key is derived internally
+ * @param  key_len Encryption key length in bytes (16, 24, 32)
+ * @param  mode    AES cipher mode @see crypto_mode.
+ * @return Pointer to the new context, NULL in case of error
+ */
+crypto_stream_t *crypto_stream_new(int op, const unsigned char *iv,
+                                   const unsigned char *key, int key_len,
+                                   crypto_mode_t mode);
+
+/**
+ * Encrypt/decrypt the next part of a message.
+ *
+ * @param  stream    Context created by crypto_stream_new()
+ * @param  output    Output data, must be a multiple of 16 bytes
+ * @param  input     Input data, must be a multiple of 16 bytes
+ * @param  input_len Length of the input data in bytes, must be a multiple of
+ *                   16
+ * @return Length of the output data in bytes, -1 in case of error
+ */
+int crypto_stream_update(crypto_stream_t *stream, unsigned char *output,
+                         const unsigned char *input, int input_len);
+
+/**
+ * Free a streaming context.
+ *
+ * @param  stream Context created by crypto_stream_new(), may be NULL
+ */
+void crypto_stream_free(crypto_stream_t *stream);
+
 #endif  // OPENTITAN_HW_IP_AES_MODEL_CRYPTO_H_
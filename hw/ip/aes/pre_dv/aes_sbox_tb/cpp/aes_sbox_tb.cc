@@ -2,59 +2,59 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
-#include <functional>
 #include <iostream>
-#include <signal.h>
 
-#include "Vaes_sbox_tb.h"
-#include "sim_ctrl_extension.h"
+#include "aes_shard_runner.h"
 #include "verilated_toplevel.h"
-#include "verilator_sim_ctrl.h"
 
-class AESSBoxTB : public SimCtrlExtension {
-  using SimCtrlExtension::SimCtrlExtension;
+// Every stimulus vector is {op, input mask, input data}, see aes_sbox_tb.sv.
+static const unsigned int kNumVectors = 2 * 256 * 256;
 
- public:
-  AESSBoxTB(aes_sbox_tb *top);
+// Upper bound for the number of cycles per vector (the DOM S-Box is the
+// slowest implementation).
+static const unsigned int kMaxCyclesPerVector = 16;
 
-  void OnClock(unsigned long sim_time);
-
- private:
-  aes_sbox_tb *top_;
-};
+// Check one contiguous range of the vectors.
+static bool RunShard(AESShardSim<VERILATED_TOPLEVEL_NAME> &sim) {
+  const unsigned int per_shard =
+      (kNumVectors + sim.num_shards() - 1) / sim.num_shards();
+  const unsigned int start = sim.shard() * per_shard;
+  if (start >= kNumVectors) {
+    return true;
+  }
+  unsigned int end = start + per_shard - 1;
+  if (end >= kNumVectors) {
+    end = kNumVectors - 1;
+  }
 
-// Constructor:
-// - Set up top_ ptr
-AESSBoxTB::AESSBoxTB(aes_sbox_tb *top) : SimCtrlExtension{}, top_(top) {}
+  VERILATED_TOPLEVEL_NAME &top = sim.model();
+  top.count_start_i = start;
+  top.count_end_i = end;
+  top.prd_seed_i = 0x4321 + sim.shard();
+  sim.Reset();
 
-// Function called once every clock cycle from SimCtrl
-void AESSBoxTB::OnClock(unsigned long sim_time) {
-  if (top_->test_done_o) {
-    VerilatorSimCtrl::GetInstance().RequestStop(top_->test_passed_o);
-  }
+  sim.CountVectors(end - start + 1);
+  return sim.RunToDone((end - start + 1) * kMaxCyclesPerVector);
 }
 
 int main(int argc, char **argv) {
   int ret_code;
 
-  // Init verilog instance
-  aes_sbox_tb top;
-
-  // Init sim
-  VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
-  simctrl.SetTop(&top, &top.clk_i, &top.rst_ni,
-                 VerilatorSimCtrlFlags::ResetPolarityNegative);
-
-  // Create and register VerilatorSimCtrl extension
-  AESSBoxTB aessboxtb(&top);
-  simctrl.RegisterExtension(&aessboxtb);
+  AESShardRunner<VERILATED_TOPLEVEL_NAME> runner("aes_sbox_tb", 64, RunShard);
+  if (!runner.ParseCommandArgs(argc, argv, ret_code)) {
+    return ret_code;
+  }
 
   std::cout << "Simulation of AES SBox" << std::endl
             << "======================" << std::endl
             << std::endl;
 
-  // Get pass / fail from Verilator
-  ret_code = simctrl.Exec(argc, argv).first;
+  ret_code = runner.Run();
+  if (!ret_code) {
+    std::cout << std::endl
+              << "SUCCESS: Outputs of all S-Box implementations match."
+              << std::endl;
+  }
 
   return ret_code;
 }
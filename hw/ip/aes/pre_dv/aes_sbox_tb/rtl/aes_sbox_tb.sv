@@ -3,19 +3,28 @@
 // SPDX-License-Identifier: Apache-2.0
 //
 // AES SBox testbench
+//
+// Every stimulus vector is a combination of {op, input mask, input data}. The
+// testbench checks vectors count_start_i up to and including count_end_i,
+// which allows the C++ harness to split the exhaustive sweep across several
+// independent instances.
 
 module aes_sbox_tb #(
 ) (
-  input  logic clk_i,
-  input  logic rst_ni,
+  input  logic        clk_i,
+  input  logic        rst_ni,
+
+  input  logic [16:0] count_start_i,
+  input  logic [16:0] count_end_i,
+  input  logic [31:0] prd_seed_i,
 
-  output logic test_done_o,
-  output logic test_passed_o
+  output logic        test_done_o,
+  output logic        test_passed_o
 );
 
   import aes_pkg::*;
 
-  logic [8:0] count_d, count_q;
+  logic [16:0] count_d, count_q;
   logic [7:0] stimulus;
   ciph_op_e   op;
 
@@ -25,16 +34,16 @@ module aes_sbox_tb #(
   logic [7:0] responses[NumSBoxImplsTotal];
 
   // Generate the stimuli
-  assign count_d = count_q + 9'h1;
+  assign count_d = count_q + 17'h1;
   always_ff @(posedge clk_i or negedge rst_ni) begin : reg_count
     if (!rst_ni) begin
-      count_q <= '0;
+      count_q <= count_start_i;
     end else if (dom_done) begin
       count_q <= count_d;
     end
   end
 
-  assign op = count_q[8] ? CIPH_FWD : CIPH_INV;
+  assign op = count_q[16] ? CIPH_FWD : CIPH_INV;
   assign stimulus = count_q[7:0];
 
   // Instantiate SBox Implementations
@@ -57,22 +66,20 @@ module aes_sbox_tb #(
   logic  [7:0] masked_response [NUM_SBOX_IMPLS_MASKED];
   logic  [7:0] out_mask [NUM_SBOX_IMPLS_MASKED];
 
-  logic [31:0] mask;
-  logic [23:0] unused_mask;
-
-  always_ff @(posedge clk_i or negedge rst_ni) begin : reg_mask
-    if (!rst_ni) begin
-      mask <= 32'hAAFF;
-    end else if (dom_done) begin
-      mask <= $random;
-    end
-  end
-  assign in_mask     = mask[7:0];
-  assign unused_mask = mask[31:8];
+  assign in_mask = count_q[15:8];
 
   assign masked_stimulus = stimulus ^ in_mask;
 
   // PRD Generation
+  //
+  // Use a xorshift generator instead of $random such that every sub-range of
+  // the sweep is reproducible independent of the simulator thread it runs on.
+  function automatic logic [31:0] xorshift32(logic [31:0] x);
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+  endfunction
   localparam int unsigned WidthPRDSBoxCanrightMasked        = 8;
   localparam int unsigned WidthPRDSBoxCanrightMaskedNoreuse = 18;
   localparam int unsigned WidthPRDSBoxDOM                   = 28;
@@ -82,9 +89,9 @@ module aes_sbox_tb #(
 
   always_ff @(posedge clk_i or negedge rst_ni) begin : reg_prd
     if (!rst_ni) begin
-      prd <= 32'h4321;
+      prd <= (prd_seed_i != '0) ? prd_seed_i : 32'h4321;
     end else begin
-      prd <= {$random};
+      prd <= xorshift32(prd);
     end
   end
   assign unused_prd = prd[31:WidthPRDSBoxDOM];
@@ -142,15 +149,15 @@ module aes_sbox_tb #(
     for (int i=1; i<NumSBoxImplsTotal; i++) begin
       if (rst_ni && dom_done && (responses[i] != responses[0])) begin
         $display("\nERROR: Mismatch between LUT-based S-Box and Implementation %0d found.", i);
-        $display("op = %s, stimulus = 8'h%h, expected resp = 8'h%h, actual resp = 8'h%h\n",
-            (op == CIPH_FWD) ? "CIPH_FWD" : "CIPH_INV", stimulus, responses[0], responses[i]);
+        $display("op = %s, stimulus = 8'h%h, mask = 8'h%h, expected resp = 8'h%h, actual resp = 8'h%h\n",
+            (op == CIPH_FWD) ? "CIPH_FWD" : "CIPH_INV", stimulus, in_mask, responses[0],
+            responses[i]);
         test_passed_o <= 1'b0;
         test_done_o   <= 1'b1;
       end
     end
 
-    if (count_q == 9'h1FF) begin
-      $display("\nSUCCESS: Outputs of all S-Box implementations match.");
+    if (rst_ni && dom_done && count_q == count_end_i) begin
       test_done_o <= 1'b1;
     end
   end
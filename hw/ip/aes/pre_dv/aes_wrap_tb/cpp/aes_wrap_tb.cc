@@ -2,59 +2,86 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
-#include <functional>
 #include <iostream>
-#include <signal.h>
+#include <random>
 
-#include "Vaes_wrap_tb.h"
-#include "sim_ctrl_extension.h"
+#include "aes_shard_runner.h"
 #include "verilated_toplevel.h"
-#include "verilator_sim_ctrl.h"
 
-class AESWrapTB : public SimCtrlExtension {
-  using SimCtrlExtension::SimCtrlExtension;
+extern "C" {
+#include "aes.h"
+}
+
+// Number of random key/message pairs checked per shard. The DUT is reset
+// before every vector.
+static const unsigned int kVectorsPerShard = 16;
+
+// Must be larger than the time out of aes_wrap_tb.sv.
+static const unsigned int kMaxCyclesPerVector = 512;
 
- public:
-  AESWrapTB(aes_wrap_tb *top);
+// Pack 16 or 32 bytes into a Verilator wide signal, byte i at [8*i +: 8].
+template <class Wide>
+static void PackBytes(Wide &dst, const unsigned char *src, int num_words) {
+  for (int i = 0; i < num_words; ++i) {
+    dst[i] = (uint32_t)src[4 * i] | ((uint32_t)src[4 * i + 1] << 8) |
+             ((uint32_t)src[4 * i + 2] << 16) |
+             ((uint32_t)src[4 * i + 3] << 24);
+  }
+}
 
-  void OnClock(unsigned long sim_time);
+// Check kVectorsPerShard random vectors. The first vector of shard 0 is the
+// all-zero key and message.
+static bool RunShard(AESShardSim<VERILATED_TOPLEVEL_NAME> &sim) {
+  std::mt19937 rng(sim.shard());
+  std::uniform_int_distribution<int> dist(0, 255);
+  VERILATED_TOPLEVEL_NAME &top = sim.model();
 
- private:
-  aes_wrap_tb *top_;
-};
+  for (unsigned int v = 0; v < kVectorsPerShard; ++v) {
+    unsigned char input[16] = {0};
+    unsigned char key[32] = {0};
+    unsigned char output[16];
+    if (sim.shard() != 0 || v != 0) {
+      for (int i = 0; i < 16; ++i) {
+        input[i] = dist(rng);
+      }
+      // aes_wrap uses AES-128, the upper key half is ignored.
+      for (int i = 0; i < 16; ++i) {
+        key[i] = dist(rng);
+      }
+    }
+    aes_encrypt_block(input, key, 16, output);
 
-// Constructor:
-// - Set up top_ ptr
-AESWrapTB::AESWrapTB(aes_wrap_tb *top) : SimCtrlExtension{}, top_(top) {}
+    PackBytes(top.aes_input_i, input, 4);
+    PackBytes(top.aes_key_i, key, 8);
+    PackBytes(top.aes_output_exp_i, output, 4);
+    sim.Reset();
 
-// Function called once every clock cycle from SimCtrl
-void AESWrapTB::OnClock(unsigned long sim_time) {
-  if (top_->test_done_o) {
-    VerilatorSimCtrl::GetInstance().RequestStop(top_->test_passed_o);
+    sim.CountVectors(1);
+    if (!sim.RunToDone(kMaxCyclesPerVector)) {
+      return false;
+    }
   }
+
+  return true;
 }
 
 int main(int argc, char **argv) {
   int ret_code;
 
-  // Init verilog instance
-  aes_wrap_tb top;
-
-  // Init sim
-  VerilatorSimCtrl &simctrl = VerilatorSimCtrl::GetInstance();
-  simctrl.SetTop(&top, &top.clk_i, &top.rst_ni,
-                 VerilatorSimCtrlFlags::ResetPolarityNegative);
-
-  // Create and register VerilatorSimCtrl extension
-  AESWrapTB aeswraptb(&top);
-  simctrl.RegisterExtension(&aeswraptb);
+  AESShardRunner<VERILATED_TOPLEVEL_NAME> runner("aes_wrap_tb", 16, RunShard);
+  if (!runner.ParseCommandArgs(argc, argv, ret_code)) {
+    return ret_code;
+  }
 
   std::cout << "Simulation of AES Wrap" << std::endl
             << "======================" << std::endl
             << std::endl;
 
-  // Get pass / fail from Verilator
-  ret_code = simctrl.Exec(argc, argv).first;
+  ret_code = runner.Run();
+  if (!ret_code) {
+    std::cout << std::endl
+              << "SUCCESS: AES output matches expected value." << std::endl;
+  }
 
   return ret_code;
 }
@@ -0,0 +1,333 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_HW_IP_AES_PRE_DV_COMMON_CPP_AES_SHARD_RUNNER_H_
+#define OPENTITAN_HW_IP_AES_PRE_DV_COMMON_CPP_AES_SHARD_RUNNER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "verilated_toplevel.h"
+
+/**
+ * One simulation instance of a sharded pre-DV testbench
+ *
+ * Every shard owns its own VerilatedContext and model, so shards can run on
+ * different threads without sharing any simulator state. Tracing is only set
+ * up if requested for this shard.
+ */
+template <class Model>
+class AESShardSim {
+ public:
+  AESShardSim(unsigned int shard, unsigned int num_shards,
+              const std::string &trace_file)
+      : shard_(shard),
+        num_shards_(num_shards),
+        context_(new VerilatedContext),
+        cycles_(0),
+        num_vectors_(0) {
+    if (!trace_file.empty()) {
+      context_->traceEverOn(true);
+    }
+    model_.reset(new Model(context_.get(), "TOP"));
+#if VM_TRACE == 1
+    if (!trace_file.empty()) {
+      tracer_.reset(new VM_TRACE_CLASS_NAME);
+      model_->trace(tracer_.get(), 99);
+      tracer_->open(trace_file.c_str());
+    }
+#endif
+  }
+
+  ~AESShardSim() {
+#if VM_TRACE == 1
+    if (tracer_) {
+      tracer_->close();
+    }
+#endif
+    model_->final();
+  }
+
+  Model &model() { return *model_; }
+  unsigned int shard() const { return shard_; }
+  unsigned int num_shards() const { return num_shards_; }
+  uint64_t cycles() const { return cycles_; }
+  uint64_t num_vectors() const { return num_vectors_; }
+
+  /**
+   * Account for stimulus vectors checked by this shard (for statistics only)
+   */
+  void CountVectors(uint64_t n) { num_vectors_ += n; }
+
+  /**
+   * Advance the model by one clock cycle
+   *
+   * Only two evaluations per cycle are needed as the testbenches have a single
+   * clock and all inputs are driven between cycles. The trace is only flushed
+   * when the shard ends.
+   */
+  void Tick() {
+    model_->clk_i = 0;
+    model_->eval();
+    Dump(2 * cycles_);
+    model_->clk_i = 1;
+    model_->eval();
+    Dump(2 * cycles_ + 1);
+    ++cycles_;
+  }
+
+  /**
+   * Apply an active-low reset for two cycles
+   */
+  void Reset() {
+    model_->rst_ni = 1;
+    Tick();
+    model_->rst_ni = 0;
+    Tick();
+    Tick();
+    model_->rst_ni = 1;
+  }
+
+  /**
+   * Run until the testbench signals test_done_o or max_cycles elapsed
+   *
+   * @return Value of test_passed_o, false on timeout
+   */
+  bool RunToDone(uint64_t max_cycles) {
+    for (uint64_t i = 0; i < max_cycles; ++i) {
+      Tick();
+      if (model_->test_done_o) {
+        return model_->test_passed_o;
+      }
+      if (context_->gotFinish()) {
+        break;
+      }
+    }
+    std::cout << "ERROR: Shard " << shard_ << " timed out." << std::endl;
+    return false;
+  }
+
+ private:
+  void Dump(uint64_t time) {
+#if VM_TRACE == 1
+    if (tracer_) {
+      tracer_->dump(time);
+    }
+#endif
+  }
+
+  unsigned int shard_;
+  unsigned int num_shards_;
+  std::unique_ptr<VerilatedContext> context_;
+  std::unique_ptr<Model> model_;
+#if VM_TRACE == 1
+  std::unique_ptr<VM_TRACE_CLASS_NAME> tracer_;
+#endif
+  uint64_t cycles_;
+  uint64_t num_vectors_;
+};
+
+/**
+ * Parallel driver for sharded pre-DV testbenches
+ *
+ * The stimulus space of a testbench is split into a number of independent
+ * shards. The testbench-specific shard function drives one shard on a fresh
+ * AESShardSim and returns whether it passed. Shards are handed out to a pool
+ * of worker threads; afterwards, failing shards are re-run one by one with
+ * tracing enabled so that only they produce waveforms. Shard functions must
+ * therefore be deterministic in the shard index.
+ */
+template <class Model>
+class AESShardRunner {
+ public:
+  using ShardFn = std::function<bool(AESShardSim<Model> &sim)>;
+
+  AESShardRunner(const std::string &name, unsigned int num_shards,
+                 ShardFn shard_fn)
+      : name_(name),
+        num_shards_(num_shards),
+        num_threads_(std::thread::hardware_concurrency()),
+        trace_all_(false),
+        trace_failing_(VM_TRACE == 1),
+        shard_fn_(shard_fn) {
+    if (num_threads_ == 0) {
+      num_threads_ = 1;
+    }
+  }
+
+  /**
+   * Parse --shards, --threads, --trace and --no-trace-failing
+   *
+   * @return false if the application should exit
+   */
+  bool ParseCommandArgs(int argc, char **argv, int &ret_code) {
+    const struct option long_options[] = {
+        {"shards", required_argument, nullptr, 's'},
+        {"threads", required_argument, nullptr, 'j'},
+        {"trace", no_argument, nullptr, 't'},
+        {"no-trace-failing", no_argument, nullptr, 'n'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, no_argument, nullptr, 0}};
+
+    ret_code = 0;
+    while (1) {
+      int c = getopt_long(argc, argv, "s:j:th", long_options, nullptr);
+      if (c == -1) {
+        break;
+      }
+      switch (c) {
+        case 's':
+          num_shards_ = std::stoul(optarg);
+          break;
+        case 'j':
+          num_threads_ = std::stoul(optarg);
+          break;
+        case 't':
+          if (VM_TRACE != 1) {
+            std::cerr << "ERROR: Tracing has not been enabled at compile time."
+                      << std::endl;
+            ret_code = 1;
+            return false;
+          }
+          trace_all_ = true;
+          break;
+        case 'n':
+          trace_failing_ = false;
+          break;
+        case 'h':
+          std::cout << "Usage: " << argv[0] << " [OPTIONS]" << std::endl
+                    << "  -s, --shards=N        Split the stimulus into N "
+                       "shards (default: "
+                    << num_shards_ << ")" << std::endl
+                    << "  -j, --threads=N       Run up to N shards in "
+                       "parallel (default: "
+                    << num_threads_ << ")" << std::endl
+                    << "  -t, --trace           Trace all shards" << std::endl
+                    << "      --no-trace-failing  Do not re-run failing "
+                       "shards with tracing"
+                    << std::endl;
+          return false;
+        default:
+          std::cerr << "ERROR: Unknown argument." << std::endl;
+          ret_code = 1;
+          return false;
+      }
+    }
+    if (num_shards_ == 0 || num_threads_ == 0) {
+      std::cerr << "ERROR: Number of shards and threads must be at least 1."
+                << std::endl;
+      ret_code = 1;
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Run all shards and print a summary
+   *
+   * @return 0 if all shards passed, 1 otherwise
+   */
+  int Run() {
+    std::vector<Result> results(num_shards_);
+    std::atomic<unsigned int> next_shard(0);
+    unsigned int num_threads =
+        num_threads_ < num_shards_ ? num_threads_ : num_shards_;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < num_threads; ++t) {
+      workers.emplace_back([&]() {
+        for (unsigned int shard = next_shard++; shard < num_shards_;
+             shard = next_shard++) {
+          results[shard] = RunShard(shard, trace_all_);
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    uint64_t cycles = 0;
+    uint64_t num_vectors = 0;
+    std::vector<unsigned int> failing;
+    for (unsigned int shard = 0; shard < num_shards_; ++shard) {
+      cycles += results[shard].cycles;
+      num_vectors += results[shard].num_vectors;
+      if (!results[shard].passed) {
+        failing.push_back(shard);
+      }
+    }
+
+    std::cout << std::endl
+              << name_ << ": " << num_shards_ - failing.size() << "/"
+              << num_shards_ << " shards passed (" << num_threads
+              << " threads)" << std::endl
+              << "Simulated " << cycles << " cycles, " << num_vectors
+              << " vectors in " << elapsed.count() << " s ("
+              << cycles / elapsed.count() / 1e3 << " kHz, "
+              << num_vectors / elapsed.count() << " vectors/s)" << std::endl;
+
+    if (trace_failing_ && !trace_all_) {
+      for (unsigned int shard : failing) {
+        std::cout << "Re-running failing shard " << shard << " with tracing"
+                  << std::endl;
+        RunShard(shard, true);
+      }
+    }
+    for (unsigned int shard : failing) {
+      std::cout << "ERROR: Shard " << shard << " failed.";
+      if (trace_failing_ || trace_all_) {
+        std::cout << " See " << TraceFileName(shard);
+      }
+      std::cout << std::endl;
+    }
+
+    return failing.empty() ? 0 : 1;
+  }
+
+ private:
+  struct Result {
+    bool passed;
+    uint64_t cycles;
+    uint64_t num_vectors;
+  };
+
+  std::string TraceFileName(unsigned int shard) const {
+#ifdef VM_TRACE_FMT_FST
+    const char *ext = ".fst";
+#else
+    const char *ext = ".vcd";
+#endif
+    return name_ + "_shard" + std::to_string(shard) + ext;
+  }
+
+  Result RunShard(unsigned int shard, bool trace) {
+    AESShardSim<Model> sim(shard, num_shards_,
+                           trace ? TraceFileName(shard) : "");
+    Result result;
+    result.passed = shard_fn_(sim);
+    result.cycles = sim.cycles();
+    result.num_vectors = sim.num_vectors();
+    return result;
+  }
+
+  std::string name_;
+  unsigned int num_shards_;
+  unsigned int num_threads_;
+  bool trace_all_;
+  bool trace_failing_;
+  ShardFn shard_fn_;
+};
+
+#endif  // OPENTITAN_HW_IP_AES_PRE_DV_COMMON_CPP_AES_SHARD_RUNNER_H_
@@ -8,6 +8,8 @@
 #include <cstring>
 #include <list>
 
+#include "keccak_backend.h"
+#include "keccak_sponge.h"
 #include "svdpi.h"
 #include "vendor/kerukuro_digestpp/algorithm/kmac.hpp"
 #include "vendor/kerukuro_digestpp/algorithm/sha3.hpp"
@@ -17,10 +19,31 @@ extern "C" {
 
 // TODO(udi) might need to implement endian conversion
 
+// Digests are computed with the Keccak backend from keccak_backend.h. If
+// cross-checking is enabled, they are also recomputed with the vendored
+// digestpp model and compared.
+static bool digestpp_cross_check = false;
+
 //////////////////////
 // HELPER FUNCTIONS //
 //////////////////////
 
+/**
+ * Abort the simulation if the digest computed by the Keccak backend differs
+ * from the one computed by digestpp.
+ */
+static void check_digest(const char *alg, const uint8_t *actual,
+                         const uint8_t *expected, uint64_t len) {
+  if (memcmp(actual, expected, len) == 0) {
+    return;
+  }
+  fprintf(stderr,
+          "ERROR: %s digest from Keccak backend `%s' does not match "
+          "digestpp.\n",
+          alg, keccak_backend_name());
+  abort();
+}
+
 /**
  * Generic function to load an unsized array from SV memory into C memory.
  */
@@ -65,9 +88,15 @@ static void get_sha3_digest(uint64_t sha_len, const svOpenArrayHandle msg,
   load_arr_from_simulator(msg, msg_arr, msg_len);
 
   // Compute the digest
-  digestpp::sha3 sha3(sha_len);
-  sha3.absorb(msg_arr, msg_len);
-  sha3.digest(digest_arr, sizeof(digest_arr));
+  keccak_sha3(sha_len, msg_arr, msg_len, digest_arr);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[digest_len];
+    digestpp::sha3 sha3(sha_len);
+    sha3.absorb(msg_arr, msg_len);
+    sha3.digest(ref_arr, sizeof(ref_arr));
+    check_digest("SHA3", digest_arr, ref_arr, digest_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -77,6 +106,23 @@ static void get_sha3_digest(uint64_t sha_len, const svOpenArrayHandle msg,
   write_array_to_simulator(digest, digest_arr);
 }
 
+////////////////////
+// KECCAK BACKEND //
+////////////////////
+extern svBit c_dpi_keccak_backend_config(const char *backend,
+                                         svBit cross_check) {
+  if (!keccak_backend_select(backend)) {
+    return 0;
+  }
+  keccak_backend_set_cross_check(cross_check);
+  digestpp_cross_check = cross_check;
+  return 1;
+}
+
+extern const char *c_dpi_keccak_backend_name() {
+  return keccak_backend_name();
+}
+
 //////////////
 // SHA3-224 //
 //////////////
@@ -121,9 +167,15 @@ extern void c_dpi_shake128(const svOpenArrayHandle msg, uint64_t msg_len,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::shake128 shake;
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
+  keccak_cshake(128, "", "", msg_arr, msg_len, digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::shake128 shake;
+    shake.absorb(msg_arr, msg_len);
+    shake.squeeze(ref_arr, output_len);
+    check_digest("SHAKE128", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -145,9 +197,15 @@ extern void c_dpi_shake256(const svOpenArrayHandle msg, uint64_t msg_len,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::shake256 shake;
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
+  keccak_cshake(256, "", "", msg_arr, msg_len, digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::shake256 shake;
+    shake.absorb(msg_arr, msg_len);
+    shake.squeeze(ref_arr, output_len);
+    check_digest("SHAKE256", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -171,11 +229,18 @@ extern void c_dpi_cshake128(const svOpenArrayHandle msg,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::cshake128 shake;
-  shake.set_function_name(function_name, strlen(function_name));
-  shake.set_customization(customization_str, strlen(customization_str));
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
+  keccak_cshake(128, function_name, customization_str, msg_arr, msg_len,
+                digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::cshake128 shake;
+    shake.set_function_name(function_name, strlen(function_name));
+    shake.set_customization(customization_str, strlen(customization_str));
+    shake.absorb(msg_arr, msg_len);
+    shake.squeeze(ref_arr, output_len);
+    check_digest("cSHAKE128", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -199,11 +264,18 @@ extern void c_dpi_cshake256(const svOpenArrayHandle msg,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::cshake256 shake;
-  shake.set_function_name(function_name, strlen(function_name));
-  shake.set_customization(customization_str, strlen(customization_str));
-  shake.absorb(msg_arr, msg_len);
-  shake.squeeze(digest_arr, output_len);
+  keccak_cshake(256, function_name, customization_str, msg_arr, msg_len,
+                digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::cshake256 shake;
+    shake.set_function_name(function_name, strlen(function_name));
+    shake.set_customization(customization_str, strlen(customization_str));
+    shake.absorb(msg_arr, msg_len);
+    shake.squeeze(ref_arr, output_len);
+    check_digest("cSHAKE256", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -233,11 +305,18 @@ extern void c_dpi_kmac128(const svOpenArrayHandle msg, uint64_t msg_len,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::kmac128 kmac(output_len_bits);
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.digest(digest_arr, sizeof(digest_arr));
+  keccak_kmac(128, false, key_arr, key_len, customization_str, msg_arr,
+              msg_len, digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::kmac128 kmac(output_len_bits);
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr, key_len);
+    kmac.absorb(msg_arr, msg_len);
+    kmac.digest(ref_arr, sizeof(ref_arr));
+    check_digest("KMAC128", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -269,11 +348,18 @@ extern void c_dpi_kmac128_xof(const svOpenArrayHandle msg, uint64_t msg_len,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::kmac128_xof kmac;
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.squeeze(digest_arr, sizeof(digest_arr));
+  keccak_kmac(128, true, key_arr, key_len, customization_str, msg_arr,
+              msg_len, digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::kmac128_xof kmac;
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr, key_len);
+    kmac.absorb(msg_arr, msg_len);
+    kmac.squeeze(ref_arr, sizeof(ref_arr));
+    check_digest("KMACXOF128", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -307,11 +393,18 @@ extern void c_dpi_kmac256(const svOpenArrayHandle msg, uint64_t msg_len,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::kmac256 kmac(output_len_bits);
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.digest(digest_arr, sizeof(digest_arr));
+  keccak_kmac(256, false, key_arr, key_len, customization_str, msg_arr,
+              msg_len, digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::kmac256 kmac(output_len_bits);
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr, key_len);
+    kmac.absorb(msg_arr, msg_len);
+    kmac.digest(ref_arr, sizeof(ref_arr));
+    check_digest("KMAC256", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -343,11 +436,18 @@ extern void c_dpi_kmac256_xof(const svOpenArrayHandle msg, uint64_t msg_len,
   uint8_t digest_arr[output_len];
 
   // Compute the digest
-  digestpp::kmac256_xof kmac;
-  kmac.set_customization(customization_str, strlen(customization_str));
-  kmac.set_key(key_arr, key_len);
-  kmac.absorb(msg_arr, msg_len);
-  kmac.squeeze(digest_arr, sizeof(digest_arr));
+  keccak_kmac(256, true, key_arr, key_len, customization_str, msg_arr,
+              msg_len, digest_arr, output_len);
+
+  if (digestpp_cross_check) {
+    uint8_t ref_arr[output_len];
+    digestpp::kmac256_xof kmac;
+    kmac.set_customization(customization_str, strlen(customization_str));
+    kmac.set_key(key_arr, key_len);
+    kmac.absorb(msg_arr, msg_len);
+    kmac.squeeze(ref_arr, sizeof(ref_arr));
+    check_digest("KMACXOF256", digest_arr, ref_arr, output_len);
+  }
 
   if (msg_arr != nullptr) {
     free(msg_arr);
@@ -11,6 +11,18 @@ package digestpp_dpi_pkg;
   // parameters
 
   // DPI-C imports
+
+  // Select the Keccak permutation backend used by the digest functions below ("auto", "ref",
+  // "lc64", "avx2" or "avx512"). If cross_check is set, every permutation is checked against
+  // the scalar reference and every digest against the vendored digestpp model.
+  // Returns 0 if the backend is unknown or not supported by the host CPU.
+  import "DPI-C" context function bit c_dpi_keccak_backend_config(
+    input string            backend,
+    input bit               cross_check
+  );
+
+  import "DPI-C" context function string c_dpi_keccak_backend_name();
+
   import "DPI-C" context function void c_dpi_sha3_224(
     input bit[7:0]          msg[],
     input longint unsigned  msg_len,
@@ -0,0 +1,87 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "keccak_backend.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+// Compile everything below for AVX-512F/VL without requiring -mavx512* for
+// the whole model. keccak_backend_select only picks this backend if the CPU
+// supports both extensions.
+#ifdef __clang__
+#pragma clang attribute push( \
+    __attribute__((target("avx2,avx512f,avx512vl"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,avx512f,avx512vl")
+#endif
+
+#include "keccak_x4_impl.h"
+
+namespace {
+
+// Truth tables for _mm256_ternarylogic_epi64, indexed by (a << 2 | b << 1 |
+// c).
+const int kTernXor3 = 0x96;  // a ^ b ^ c
+const int kTernChi = 0xd2;   // a ^ (~b & c)
+
+struct Avx512Ops {
+  typedef __m256i Vec;
+
+  static inline Vec Load(const uint64_t *const states[4], int lane) {
+    return _mm256_set_epi64x(states[3][lane], states[2][lane], states[1][lane],
+                             states[0][lane]);
+  }
+
+  static inline void Store(uint64_t *const states[4], int lane, Vec v) {
+    alignas(32) uint64_t tmp[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(tmp), v);
+    for (int i = 0; i < 4; ++i) {
+      states[i][lane] = tmp[i];
+    }
+  }
+
+  static inline Vec Set1(uint64_t x) { return _mm256_set1_epi64x(x); }
+
+  static inline Vec Xor(Vec a, Vec b) { return _mm256_xor_si256(a, b); }
+
+  static inline Vec Xor5(Vec a, Vec b, Vec c, Vec d, Vec e) {
+    return _mm256_ternarylogic_epi64(
+        _mm256_ternarylogic_epi64(a, b, c, kTernXor3), d, e, kTernXor3);
+  }
+
+  static inline Vec Rol(Vec a, unsigned n) {
+    return _mm256_rolv_epi64(a, _mm256_set1_epi64x(n));
+  }
+
+  static inline Vec Chi(Vec a, Vec b, Vec c) {
+    return _mm256_ternarylogic_epi64(a, b, c, kTernChi);
+  }
+};
+
+}  // namespace
+
+void keccak_f1600_x4_avx512(uint64_t *const states[4]) {
+  keccak_x4_permute<Avx512Ops>(states);
+}
+
+#ifdef __clang__
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#else  // !x86
+
+void keccak_f1600_x4_avx512(uint64_t *const states[4]) {
+  fprintf(stderr, "The avx512 Keccak backend is only available on x86.\n");
+  abort();
+}
+
+#endif
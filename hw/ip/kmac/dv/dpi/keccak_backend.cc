@@ -0,0 +1,311 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "keccak_backend.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "keccak_consts.h"
+
+namespace {
+
+const char *const backend_names[] = {"ref", "lc64", "avx2", "avx512"};
+
+// The backends that "auto" picks from, in order of preference.
+const keccak_backend_t auto_prefs[] = {kKeccakBackendAvx512, kKeccakBackendAvx2,
+                                       kKeccakBackendLc64};
+
+keccak_backend_t auto_backend() {
+  for (keccak_backend_t backend : auto_prefs) {
+    if (keccak_backend_supported(backend)) {
+      return backend;
+    }
+  }
+  return kKeccakBackendRef;
+}
+
+keccak_backend_t cur_backend = auto_backend();
+bool cross_check = false;
+
+inline uint64_t rol64(uint64_t x, unsigned n) {
+  return n ? (x << n) | (x >> (64 - n)) : x;
+}
+
+// Lanes that are stored complemented by the lc64 backend.
+const unsigned lc_lanes[] = {1, 2, 8, 12, 17, 20};
+
+void complement_lanes(uint64_t *A) {
+  for (unsigned idx : lc_lanes) {
+    A[idx] = ~A[idx];
+  }
+}
+
+// Compare the result of a permutation against the ref backend, run on a
+// copy of the input state.
+void check_against_ref(const uint64_t *input, const uint64_t *output) {
+  uint64_t expected[kKeccakNumLanes];
+  memcpy(expected, input, kKeccakStateBytes);
+  keccak_f1600_ref(expected);
+  if (memcmp(expected, output, kKeccakStateBytes) != 0) {
+    fprintf(stderr,
+            "ERROR: Keccak backend `%s' disagrees with the ref backend.\n",
+            keccak_backend_name());
+    for (size_t i = 0; i < kKeccakNumLanes; ++i) {
+      if (expected[i] != output[i]) {
+        fprintf(stderr, "  lane %2zu: expected 0x%016llx, got 0x%016llx\n", i,
+                (unsigned long long)expected[i],
+                (unsigned long long)output[i]);
+      }
+    }
+    abort();
+  }
+}
+
+}  // namespace
+
+void keccak_f1600_ref(uint64_t *A) {
+  for (int round = 0; round < 24; ++round) {
+    // Theta
+    uint64_t C[5], D[5];
+    for (int x = 0; x < 5; ++x) {
+      C[x] = A[x] ^ A[x + 5] ^ A[x + 10] ^ A[x + 15] ^ A[x + 20];
+    }
+    for (int x = 0; x < 5; ++x) {
+      D[x] = C[(x + 4) % 5] ^ rol64(C[(x + 1) % 5], 1);
+    }
+    for (int i = 0; i < 25; ++i) {
+      A[i] ^= D[i % 5];
+    }
+
+    // Rho and Pi: B[y, 2x + 3y] = rot(A[x, y], r[x, y])
+    uint64_t B[25];
+    for (int x = 0; x < 5; ++x) {
+      for (int y = 0; y < 5; ++y) {
+        B[y + 5 * ((2 * x + 3 * y) % 5)] =
+            rol64(A[x + 5 * y], kKeccakRhoOffsets[x + 5 * y]);
+      }
+    }
+
+    // Chi
+    for (int y = 0; y < 5; ++y) {
+      for (int x = 0; x < 5; ++x) {
+        A[x + 5 * y] = B[x + 5 * y] ^
+                       (~B[(x + 1) % 5 + 5 * y] & B[(x + 2) % 5 + 5 * y]);
+      }
+    }
+
+    // Iota
+    A[0] ^= kKeccakRoundConstants[round];
+  }
+}
+
+void keccak_f1600_lc64(uint64_t *A) {
+  // The lane-complementing transform (see "Keccak implementation overview",
+  // section 2.2) stores lanes 1, 2, 8, 12, 17 and 20 inverted. With that
+  // representation chi only needs one NOT per row instead of five.
+  complement_lanes(A);
+
+  for (int round = 0; round < 24; ++round) {
+    uint64_t C[5], D[5];
+    C[0] = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];
+    C[1] = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+    C[2] = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+    C[3] = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+    C[4] = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+
+    D[0] = C[4] ^ rol64(C[1], 1);
+    D[1] = C[0] ^ rol64(C[2], 1);
+    D[2] = C[1] ^ rol64(C[3], 1);
+    D[3] = C[2] ^ rol64(C[4], 1);
+    D[4] = C[3] ^ rol64(C[0], 1);
+
+    // Each row of the output is computed from the five lanes that rho and pi
+    // move into it.
+    uint64_t b0, b1, b2, b3, b4;
+
+    b0 = A[0] ^ D[0];
+    b1 = rol64(A[6] ^ D[1], 44);
+    b2 = rol64(A[12] ^ D[2], 43);
+    b3 = rol64(A[18] ^ D[3], 21);
+    b4 = rol64(A[24] ^ D[4], 14);
+    uint64_t e0 = b0 ^ (b1 | b2);
+    uint64_t e1 = b1 ^ (~b2 | b3);
+    uint64_t e2 = b2 ^ (b3 & b4);
+    uint64_t e3 = b3 ^ (b4 | b0);
+    uint64_t e4 = b4 ^ (b0 & b1);
+
+    b0 = rol64(A[3] ^ D[3], 28);
+    b1 = rol64(A[9] ^ D[4], 20);
+    b2 = rol64(A[10] ^ D[0], 3);
+    b3 = rol64(A[16] ^ D[1], 45);
+    b4 = rol64(A[22] ^ D[2], 61);
+    uint64_t e5 = b0 ^ (b1 | b2);
+    uint64_t e6 = b1 ^ (b2 & b3);
+    uint64_t e7 = b2 ^ (b3 | ~b4);
+    uint64_t e8 = b3 ^ (b4 | b0);
+    uint64_t e9 = b4 ^ (b0 & b1);
+
+    b0 = rol64(A[1] ^ D[1], 1);
+    b1 = rol64(A[7] ^ D[2], 6);
+    b2 = rol64(A[13] ^ D[3], 25);
+    b3 = rol64(A[19] ^ D[4], 8);
+    b4 = rol64(A[20] ^ D[0], 18);
+    uint64_t e10 = b0 ^ (b1 | b2);
+    uint64_t e11 = b1 ^ (b2 & b3);
+    uint64_t e12 = b2 ^ (~b3 & b4);
+    uint64_t e13 = ~b3 ^ (b4 | b0);
+    uint64_t e14 = b4 ^ (b0 & b1);
+
+    b0 = rol64(A[4] ^ D[4], 27);
+    b1 = rol64(A[5] ^ D[0], 36);
+    b2 = rol64(A[11] ^ D[1], 10);
+    b3 = rol64(A[17] ^ D[2], 15);
+    b4 = rol64(A[23] ^ D[3], 56);
+    uint64_t e15 = b0 ^ (b1 & b2);
+    uint64_t e16 = b1 ^ (b2 | b3);
+    uint64_t e17 = b2 ^ (~b3 | b4);
+    uint64_t e18 = ~b3 ^ (b4 & b0);
+    uint64_t e19 = b4 ^ (b0 | b1);
+
+    b0 = rol64(A[2] ^ D[2], 62);
+    b1 = rol64(A[8] ^ D[3], 55);
+    b2 = rol64(A[14] ^ D[4], 39);
+    b3 = rol64(A[15] ^ D[0], 41);
+    b4 = rol64(A[21] ^ D[1], 2);
+    uint64_t e20 = b0 ^ (~b1 & b2);
+    uint64_t e21 = ~b1 ^ (b2 | b3);
+    uint64_t e22 = b2 ^ (b3 & b4);
+    uint64_t e23 = b3 ^ (b4 | b0);
+    uint64_t e24 = b4 ^ (b0 & b1);
+
+    A[0] = e0 ^ kKeccakRoundConstants[round];
+    A[1] = e1;
+    A[2] = e2;
+    A[3] = e3;
+    A[4] = e4;
+    A[5] = e5;
+    A[6] = e6;
+    A[7] = e7;
+    A[8] = e8;
+    A[9] = e9;
+    A[10] = e10;
+    A[11] = e11;
+    A[12] = e12;
+    A[13] = e13;
+    A[14] = e14;
+    A[15] = e15;
+    A[16] = e16;
+    A[17] = e17;
+    A[18] = e18;
+    A[19] = e19;
+    A[20] = e20;
+    A[21] = e21;
+    A[22] = e22;
+    A[23] = e23;
+    A[24] = e24;
+  }
+
+  complement_lanes(A);
+}
+
+bool keccak_backend_supported(keccak_backend_t backend) {
+  switch (backend) {
+    case kKeccakBackendRef:
+    case kKeccakBackendLc64:
+      return true;
+#if defined(__x86_64__) || defined(__i386__)
+    // This may run from a static initializer, before libgcc has probed the
+    // CPU, so make sure the feature bits are valid.
+    case kKeccakBackendAvx2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2");
+    case kKeccakBackendAvx512:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512vl");
+#endif
+    default:
+      return false;
+  }
+}
+
+bool keccak_backend_select(const char *name) {
+  if (!strcmp(name, "auto")) {
+    cur_backend = auto_backend();
+    return true;
+  }
+
+  for (int i = 0; i <= kKeccakBackendAvx512; ++i) {
+    if (!strcmp(name, backend_names[i])) {
+      keccak_backend_t backend = static_cast<keccak_backend_t>(i);
+      if (!keccak_backend_supported(backend)) {
+        fprintf(stderr, "Keccak backend `%s' is not supported by this CPU.\n",
+                name);
+        return false;
+      }
+      cur_backend = backend;
+      return true;
+    }
+  }
+
+  fprintf(stderr, "Unknown Keccak backend: `%s'.\n", name);
+  return false;
+}
+
+const char *keccak_backend_name() { return backend_names[cur_backend]; }
+
+void keccak_backend_set_cross_check(bool enable) { cross_check = enable; }
+
+void keccak_f1600(uint64_t *state) {
+  uint64_t input[kKeccakNumLanes];
+  if (cross_check) {
+    memcpy(input, state, kKeccakStateBytes);
+  }
+
+  if (cur_backend == kKeccakBackendRef) {
+    keccak_f1600_ref(state);
+  } else {
+    keccak_f1600_lc64(state);
+  }
+
+  if (cross_check) {
+    check_against_ref(input, state);
+  }
+}
+
+void keccak_f1600_x4(uint64_t *const states[4]) {
+  uint64_t inputs[4][kKeccakNumLanes];
+  if (cross_check) {
+    for (int i = 0; i < 4; ++i) {
+      memcpy(inputs[i], states[i], kKeccakStateBytes);
+    }
+  }
+
+  switch (cur_backend) {
+    case kKeccakBackendAvx2:
+      keccak_f1600_x4_avx2(states);
+      break;
+    case kKeccakBackendAvx512:
+      keccak_f1600_x4_avx512(states);
+      break;
+    case kKeccakBackendLc64:
+      for (int i = 0; i < 4; ++i) {
+        keccak_f1600_lc64(states[i]);
+      }
+      break;
+    default:
+      for (int i = 0; i < 4; ++i) {
+        keccak_f1600_ref(states[i]);
+      }
+      break;
+  }
+
+  if (cross_check) {
+    for (int i = 0; i < 4; ++i) {
+      check_against_ref(inputs[i], states[i]);
+    }
+  }
+}
@@ -0,0 +1,70 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_BACKEND_H_
+#define OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_BACKEND_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Pluggable Keccak-f[1600] permutation used by the SHA-3/SHAKE/cSHAKE/KMAC
+// DPI model.
+//
+// A state is 25 little-endian 64-bit lanes, indexed as A[x + 5 * y] (the same
+// layout as the vendored digestpp code and FIPS 202).
+//
+// Backends:
+//
+//   ref     Plain scalar implementation. This is the reference that every
+//           other backend is cross-checked against.
+//   lc64    Scalar implementation using the lane-complementing transform,
+//           which removes most of the NOT operations from chi.
+//   avx2    4-way interleaved implementation using AVX2. Single-state
+//           permutations fall back to lc64.
+//   avx512  4-way interleaved implementation using AVX-512VL rotates and
+//           ternary logic. Single-state permutations fall back to lc64.
+//   auto    The fastest of the above that the host CPU supports. This is the
+//           default.
+
+static const size_t kKeccakNumLanes = 25;
+static const size_t kKeccakStateBytes = kKeccakNumLanes * sizeof(uint64_t);
+
+enum keccak_backend_t {
+  kKeccakBackendRef,
+  kKeccakBackendLc64,
+  kKeccakBackendAvx2,
+  kKeccakBackendAvx512,
+};
+
+// Select the permutation backend by name (see above). Returns true on
+// success. Returns false (and leaves the current backend unchanged) if the
+// name is unknown or the backend is not supported by this CPU.
+bool keccak_backend_select(const char *name);
+
+// Return the name of the currently selected backend.
+const char *keccak_backend_name();
+
+// Return true if the host CPU can run the given backend.
+bool keccak_backend_supported(keccak_backend_t backend);
+
+// When enabled, every permutation is recomputed with the ref backend and a
+// mismatch aborts the process with a message on stderr.
+void keccak_backend_set_cross_check(bool enable);
+
+// Apply the 24-round Keccak-f[1600] permutation to a single state.
+void keccak_f1600(uint64_t *state);
+
+// Apply the permutation to four independent states. With the avx2 and
+// avx512 backends this runs all four in lockstep in vector registers;
+// otherwise it permutes each state in turn.
+void keccak_f1600_x4(uint64_t *const states[4]);
+
+// The individual implementations. These are exposed so that tests and host
+// tooling can call a specific variant; normal users should go through
+// keccak_f1600 / keccak_f1600_x4.
+void keccak_f1600_ref(uint64_t *state);
+void keccak_f1600_lc64(uint64_t *state);
+void keccak_f1600_x4_avx2(uint64_t *const states[4]);
+void keccak_f1600_x4_avx512(uint64_t *const states[4]);
+
+#endif  // OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_BACKEND_H_
@@ -0,0 +1,216 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "hw/ip/kmac/dv/dpi/keccak_backend.h"
+#include "hw/ip/kmac/dv/dpi/keccak_sponge.h"
+#include "hw/ip/kmac/dv/dpi/vendor/kerukuro_digestpp/algorithm/sha3.hpp"
+#include "hw/ip/kmac/dv/dpi/vendor/kerukuro_digestpp/algorithm/shake.hpp"
+
+namespace keccak_backend_unittest {
+namespace {
+
+struct Backend {
+  const char *name;
+  keccak_backend_t backend;
+};
+
+const Backend kBackends[] = {
+    {"ref", kKeccakBackendRef},
+    {"lc64", kKeccakBackendLc64},
+    {"avx2", kKeccakBackendAvx2},
+    {"avx512", kKeccakBackendAvx512},
+};
+
+class KeccakBackendTest : public testing::TestWithParam<Backend> {
+ protected:
+  void SetUp() override {
+    if (!keccak_backend_supported(GetParam().backend)) {
+      GTEST_SKIP() << GetParam().name << " is not supported by this CPU";
+    }
+    ASSERT_TRUE(keccak_backend_select(GetParam().name));
+  }
+
+  void TearDown() override { keccak_backend_select("auto"); }
+
+  // Fill `len` bytes with pseudo-random data.
+  std::vector<uint8_t> RandomBytes(size_t len) {
+    std::vector<uint8_t> bytes(len);
+    for (auto &b : bytes) {
+      b = rng_();
+    }
+    return bytes;
+  }
+
+  std::mt19937_64 rng_{0x6b656363616b};
+};
+
+TEST_P(KeccakBackendTest, SingleStateMatchesRef) {
+  uint64_t state[kKeccakNumLanes];
+  for (auto &lane : state) {
+    lane = rng_();
+  }
+  uint64_t expected[kKeccakNumLanes];
+  memcpy(expected, state, sizeof(state));
+
+  for (int i = 0; i < 16; ++i) {
+    keccak_f1600(state);
+    keccak_f1600_ref(expected);
+    ASSERT_EQ(memcmp(state, expected, sizeof(state)), 0) << "iteration " << i;
+  }
+}
+
+TEST_P(KeccakBackendTest, FourStatesMatchRef) {
+  uint64_t states[4][kKeccakNumLanes];
+  uint64_t expected[4][kKeccakNumLanes];
+  for (auto &state : states) {
+    for (auto &lane : state) {
+      lane = rng_();
+    }
+  }
+  memcpy(expected, states, sizeof(states));
+  uint64_t *const ptrs[4] = {states[0], states[1], states[2], states[3]};
+
+  for (int i = 0; i < 16; ++i) {
+    keccak_f1600_x4(ptrs);
+    for (auto &state : expected) {
+      keccak_f1600_ref(state);
+    }
+    ASSERT_EQ(memcmp(states, expected, sizeof(states)), 0)
+        << "iteration " << i;
+  }
+}
+
+TEST_P(KeccakBackendTest, FourStatesDirectMatchRef) {
+  // Call the vector implementation directly rather than through the
+  // dispatcher, so that avx2 and avx512 are tested even if `auto` would pick
+  // the other one.
+  void (*x4)(uint64_t *const[4]) = nullptr;
+  switch (GetParam().backend) {
+    case kKeccakBackendAvx2:
+      x4 = &keccak_f1600_x4_avx2;
+      break;
+    case kKeccakBackendAvx512:
+      x4 = &keccak_f1600_x4_avx512;
+      break;
+    default:
+      GTEST_SKIP() << GetParam().name << " has no 4-way implementation";
+  }
+
+  // All-zero, all-ones and random states in different lanes of the vector.
+  uint64_t states[4][kKeccakNumLanes];
+  memset(states[0], 0, sizeof(states[0]));
+  memset(states[1], 0xff, sizeof(states[1]));
+  for (size_t i = 2; i < 4; ++i) {
+    for (auto &lane : states[i]) {
+      lane = rng_();
+    }
+  }
+  uint64_t expected[4][kKeccakNumLanes];
+  memcpy(expected, states, sizeof(states));
+  uint64_t *const ptrs[4] = {states[0], states[1], states[2], states[3]};
+
+  x4(ptrs);
+  for (auto &state : expected) {
+    keccak_f1600_ref(state);
+  }
+  EXPECT_EQ(memcmp(states, expected, sizeof(states)), 0);
+}
+
+TEST_P(KeccakBackendTest, AbsorbParallelMatchesDigestpp) {
+  // SHAKE128 has a 168 byte rate. The lengths cover groups that run in
+  // lockstep for several blocks, groups that are limited by a short message,
+  // and a trailing group of fewer than four sponges.
+  const size_t kLens[] = {0,   1,   167, 168, 169, 336, 500, 1000,
+                          672, 671, 673, 168, 336, 504, 200, 3};
+  const size_t kNumMsgs = sizeof(kLens) / sizeof(kLens[0]);
+
+  for (size_t n = 0; n <= kNumMsgs; ++n) {
+    std::vector<std::vector<uint8_t>> msgs;
+    std::vector<const uint8_t *> msg_ptrs;
+    std::vector<KeccakSponge> sponges;
+    std::vector<KeccakSponge *> sponge_ptrs;
+    msgs.reserve(n);
+    sponges.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      msgs.push_back(RandomBytes(kLens[i]));
+      msg_ptrs.push_back(msgs.back().data());
+      sponges.emplace_back(168);
+      sponge_ptrs.push_back(&sponges.back());
+    }
+
+    keccak_absorb_parallel(sponge_ptrs.data(), msg_ptrs.data(), kLens, n);
+
+    for (size_t i = 0; i < n; ++i) {
+      uint8_t actual[64];
+      sponges[i].Finalize(0x1f);
+      sponges[i].Squeeze(actual, sizeof(actual));
+
+      uint8_t expected[64];
+      digestpp::shake128 shake;
+      shake.absorb(msgs[i].data(), msgs[i].size());
+      shake.squeeze(expected, sizeof(expected));
+
+      EXPECT_EQ(memcmp(actual, expected, sizeof(actual)), 0)
+          << "message " << i << " of " << n;
+    }
+  }
+}
+
+TEST_P(KeccakBackendTest, AbsorbParallelUnalignedSponges) {
+  // Sponges that already hold a partial block or use a different rate must
+  // not be permuted in lockstep with the rest of their group.
+  const size_t kRates[] = {136, 136, 72, 136, 136, 136, 136, 136};
+  const size_t kPrefixLens[] = {0, 0, 0, 0, 0, 0, 5, 0};
+  const size_t kLens[] = {600, 600, 600, 600, 600, 600, 600, 600};
+  const size_t kNumMsgs = sizeof(kLens) / sizeof(kLens[0]);
+
+  std::vector<std::vector<uint8_t>> prefixes;
+  std::vector<std::vector<uint8_t>> msgs;
+  std::vector<const uint8_t *> msg_ptrs;
+  std::vector<KeccakSponge> sponges;
+  std::vector<KeccakSponge *> sponge_ptrs;
+  sponges.reserve(kNumMsgs);
+  for (size_t i = 0; i < kNumMsgs; ++i) {
+    prefixes.push_back(RandomBytes(kPrefixLens[i]));
+    msgs.push_back(RandomBytes(kLens[i]));
+    msg_ptrs.push_back(msgs.back().data());
+    sponges.emplace_back(kRates[i]);
+    sponges.back().Absorb(prefixes.back().data(), prefixes.back().size());
+    sponge_ptrs.push_back(&sponges.back());
+  }
+
+  keccak_absorb_parallel(sponge_ptrs.data(), msg_ptrs.data(), kLens, kNumMsgs);
+
+  for (size_t i = 0; i < kNumMsgs; ++i) {
+    // A rate of 136 bytes is SHA3-256, 72 bytes is SHA3-512.
+    size_t sha_len = (200 - kRates[i]) * 4;
+    uint8_t actual[64];
+    sponges[i].Finalize(0x06);
+    sponges[i].Squeeze(actual, sha_len / 8);
+
+    uint8_t expected[64];
+    digestpp::sha3 sha3(sha_len);
+    sha3.absorb(prefixes[i].data(), prefixes[i].size());
+    sha3.absorb(msgs[i].data(), msgs[i].size());
+    sha3.digest(expected, sha_len / 8);
+
+    EXPECT_EQ(memcmp(actual, expected, sha_len / 8), 0) << "message " << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllBackends, KeccakBackendTest,
+                         testing::ValuesIn(kBackends),
+                         [](const testing::TestParamInfo<Backend> &info) {
+                           return std::string(info.param.name);
+                         });
+
+}  // namespace
+}  // namespace keccak_backend_unittest
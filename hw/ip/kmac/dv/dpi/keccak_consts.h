@@ -0,0 +1,31 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_CONSTS_H_
+#define OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_CONSTS_H_
+
+#include <cstdint>
+
+// Constants shared by the Keccak-f[1600] backends (FIPS 202, section 3.2).
+
+// Iota round constants.
+static const uint64_t kKeccakRoundConstants[24] = {
+    0x0000000000000001ull, 0x0000000000008082ull, 0x800000000000808Aull,
+    0x8000000080008000ull, 0x000000000000808Bull, 0x0000000080000001ull,
+    0x8000000080008081ull, 0x8000000000008009ull, 0x000000000000008Aull,
+    0x0000000000000088ull, 0x0000000080008009ull, 0x000000008000000Aull,
+    0x000000008000808Bull, 0x800000000000008Bull, 0x8000000000008089ull,
+    0x8000000000008003ull, 0x8000000000008002ull, 0x8000000000000080ull,
+    0x000000000000800Aull, 0x800000008000000Aull, 0x8000000080008081ull,
+    0x8000000000008080ull, 0x0000000080000001ull, 0x8000000080008008ull};
+
+// Rho rotation offsets, indexed by x + 5 * y.
+static const unsigned kKeccakRhoOffsets[25] = {
+    0,  1,  62, 28, 27,  // y = 0
+    36, 44, 6,  55, 20,  // y = 1
+    3,  10, 43, 25, 39,  // y = 2
+    41, 45, 15, 21, 8,   // y = 3
+    18, 2,  61, 56, 14,  // y = 4
+};
+
+#endif  // OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_CONSTS_H_
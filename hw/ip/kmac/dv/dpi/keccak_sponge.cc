@@ -0,0 +1,230 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "keccak_sponge.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+inline uint64_t load64_le(const uint8_t *p) {
+  uint64_t x = 0;
+  for (int i = 7; i >= 0; --i) {
+    x = (x << 8) | p[i];
+  }
+  return x;
+}
+
+// Append left_encode(x) (SP 800-185, section 2.3.1) to buf.
+void left_encode(uint64_t x, std::vector<uint8_t> *buf) {
+  uint8_t bytes[8];
+  int n = 0;
+  do {
+    bytes[n++] = x & 0xff;
+    x >>= 8;
+  } while (x);
+  buf->push_back(n);
+  while (n) {
+    buf->push_back(bytes[--n]);
+  }
+}
+
+// Append right_encode(x) to buf.
+void right_encode(uint64_t x, std::vector<uint8_t> *buf) {
+  uint8_t bytes[8];
+  int n = 0;
+  do {
+    bytes[n++] = x & 0xff;
+    x >>= 8;
+  } while (x);
+  for (int i = n; i; --i) {
+    buf->push_back(bytes[i - 1]);
+  }
+  buf->push_back(n);
+}
+
+// Append encode_string(s) to buf.
+void encode_string(const uint8_t *s, size_t len, std::vector<uint8_t> *buf) {
+  left_encode(uint64_t(len) * 8, buf);
+  buf->insert(buf->end(), s, s + len);
+}
+
+// Absorb bytepad(x, w) where w is the sponge rate.
+void absorb_bytepad(KeccakSponge *sponge, const std::vector<uint8_t> &x) {
+  std::vector<uint8_t> buf;
+  left_encode(sponge->rate(), &buf);
+  buf.insert(buf.end(), x.begin(), x.end());
+  buf.resize((buf.size() + sponge->rate() - 1) / sponge->rate() *
+                 sponge->rate(),
+             0);
+  sponge->Absorb(buf.data(), buf.size());
+}
+
+size_t rate_for_capacity(size_t capacity_bits) {
+  return (1600 - capacity_bits) / 8;
+}
+
+// Absorb the cSHAKE prefix for function name N and customization S.
+void absorb_cshake_prefix(KeccakSponge *sponge, const std::string &N,
+                          const std::string &S) {
+  std::vector<uint8_t> prefix;
+  encode_string(reinterpret_cast<const uint8_t *>(N.data()), N.size(),
+                &prefix);
+  encode_string(reinterpret_cast<const uint8_t *>(S.data()), S.size(),
+                &prefix);
+  absorb_bytepad(sponge, prefix);
+}
+
+}  // namespace
+
+KeccakSponge::KeccakSponge(size_t rate_bytes)
+    : rate_(rate_bytes), pos_(0), squeezing_(false) {
+  assert(rate_bytes > 0 && rate_bytes < kKeccakStateBytes &&
+         rate_bytes % 8 == 0);
+  memset(state_, 0, sizeof(state_));
+}
+
+KeccakSponge::~KeccakSponge() { memset(state_, 0, sizeof(state_)); }
+
+void KeccakSponge::XorBlock(const uint8_t *block) {
+  for (size_t i = 0; i < rate_ / 8; ++i) {
+    state_[i] ^= load64_le(block + 8 * i);
+  }
+}
+
+void KeccakSponge::Absorb(const uint8_t *data, size_t len) {
+  assert(!squeezing_);
+
+  // Finish off a partial block byte by byte.
+  while (len && pos_) {
+    state_[pos_ / 8] ^= uint64_t(*data++) << (8 * (pos_ % 8));
+    --len;
+    if (++pos_ == rate_) {
+      keccak_f1600(state_);
+      pos_ = 0;
+    }
+  }
+
+  // Then whole blocks a lane at a time.
+  while (len >= rate_) {
+    XorBlock(data);
+    keccak_f1600(state_);
+    data += rate_;
+    len -= rate_;
+  }
+
+  for (; len; --len, ++pos_) {
+    state_[pos_ / 8] ^= uint64_t(*data++) << (8 * (pos_ % 8));
+  }
+}
+
+void KeccakSponge::Finalize(uint8_t suffix) {
+  assert(!squeezing_);
+  state_[pos_ / 8] ^= uint64_t(suffix) << (8 * (pos_ % 8));
+  state_[(rate_ - 1) / 8] ^= uint64_t(0x80) << (8 * ((rate_ - 1) % 8));
+  keccak_f1600(state_);
+  pos_ = 0;
+  squeezing_ = true;
+}
+
+void KeccakSponge::Squeeze(uint8_t *out, size_t len) {
+  assert(squeezing_);
+  while (len) {
+    if (pos_ == rate_) {
+      keccak_f1600(state_);
+      pos_ = 0;
+    }
+    size_t n = std::min(len, rate_ - pos_);
+    for (size_t i = 0; i < n; ++i, ++pos_) {
+      *out++ = state_[pos_ / 8] >> (8 * (pos_ % 8));
+    }
+    len -= n;
+  }
+}
+
+void keccak_absorb_parallel(KeccakSponge *const sponges[],
+                            const uint8_t *const msgs[], const size_t lens[],
+                            size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    KeccakSponge *const *group = sponges + i;
+    size_t rate = group[0]->rate_;
+    bool lockstep = true;
+    size_t num_blocks = lens[i] / rate;
+    for (size_t j = 0; j < 4; ++j) {
+      lockstep &= !group[j]->squeezing_ && group[j]->pos_ == 0 &&
+                  group[j]->rate_ == rate;
+      num_blocks = std::min(num_blocks, lens[i + j] / rate);
+    }
+    if (!lockstep) {
+      num_blocks = 0;
+    }
+
+    uint64_t *const states[4] = {group[0]->state_, group[1]->state_,
+                                 group[2]->state_, group[3]->state_};
+    for (size_t blk = 0; blk < num_blocks; ++blk) {
+      for (size_t j = 0; j < 4; ++j) {
+        group[j]->XorBlock(msgs[i + j] + blk * rate);
+      }
+      keccak_f1600_x4(states);
+    }
+
+    for (size_t j = 0; j < 4; ++j) {
+      size_t done = num_blocks * rate;
+      group[j]->Absorb(msgs[i + j] + done, lens[i + j] - done);
+    }
+  }
+
+  for (; i < n; ++i) {
+    sponges[i]->Absorb(msgs[i], lens[i]);
+  }
+}
+
+void keccak_sha3(size_t sha_len, const uint8_t *msg, size_t msg_len,
+                 uint8_t *digest) {
+  KeccakSponge sponge(rate_for_capacity(2 * sha_len));
+  sponge.Absorb(msg, msg_len);
+  sponge.Finalize(0x06);
+  sponge.Squeeze(digest, sha_len / 8);
+}
+
+void keccak_cshake(size_t strength, const std::string &function_name,
+                   const std::string &customization, const uint8_t *msg,
+                   size_t msg_len, uint8_t *digest, size_t digest_len) {
+  KeccakSponge sponge(rate_for_capacity(2 * strength));
+
+  // cSHAKE with empty N and S is defined to be plain SHAKE.
+  bool plain_shake = function_name.empty() && customization.empty();
+  if (!plain_shake) {
+    absorb_cshake_prefix(&sponge, function_name, customization);
+  }
+  sponge.Absorb(msg, msg_len);
+  sponge.Finalize(plain_shake ? 0x1f : 0x04);
+  sponge.Squeeze(digest, digest_len);
+}
+
+void keccak_kmac(size_t strength, bool xof, const uint8_t *key,
+                 size_t key_len, const std::string &customization,
+                 const uint8_t *msg, size_t msg_len, uint8_t *digest,
+                 size_t digest_len) {
+  KeccakSponge sponge(rate_for_capacity(2 * strength));
+  absorb_cshake_prefix(&sponge, "KMAC", customization);
+
+  std::vector<uint8_t> encoded_key;
+  encode_string(key, key_len, &encoded_key);
+  absorb_bytepad(&sponge, encoded_key);
+
+  sponge.Absorb(msg, msg_len);
+
+  // KMACXOF uses an output length of 0 in the right_encode suffix.
+  std::vector<uint8_t> suffix;
+  right_encode(xof ? 0 : uint64_t(digest_len) * 8, &suffix);
+  sponge.Absorb(suffix.data(), suffix.size());
+
+  sponge.Finalize(0x04);
+  sponge.Squeeze(digest, digest_len);
+}
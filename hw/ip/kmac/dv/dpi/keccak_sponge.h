@@ -0,0 +1,74 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_SPONGE_H_
+#define OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_SPONGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "keccak_backend.h"
+
+// A Keccak[c] sponge on top of the pluggable permutation in
+// keccak_backend.h, plus the SHA-3 derived functions (FIPS 202 and NIST SP
+// 800-185) that the KMAC DPI model needs.
+class KeccakSponge {
+ public:
+  // rate_bytes is the sponge rate r / 8, e.g. 168 for SHAKE128.
+  explicit KeccakSponge(size_t rate_bytes);
+  ~KeccakSponge();
+
+  size_t rate() const { return rate_; }
+
+  // Absorb len bytes of input. Must not be called after Finalize.
+  void Absorb(const uint8_t *data, size_t len);
+
+  // Append the domain separation bits and pad10*1, then switch to the
+  // squeezing phase. suffix holds the domain separation bits followed by the
+  // first padding bit (e.g. 0x06 for SHA-3, 0x1f for SHAKE, 0x04 for
+  // cSHAKE).
+  void Finalize(uint8_t suffix);
+
+  // Squeeze len bytes of output. Can be called repeatedly.
+  void Squeeze(uint8_t *out, size_t len);
+
+ private:
+  friend void keccak_absorb_parallel(KeccakSponge *const sponges[],
+                                     const uint8_t *const msgs[],
+                                     const size_t lens[], size_t n);
+
+  void XorBlock(const uint8_t *block);
+
+  uint64_t state_[kKeccakNumLanes];
+  size_t rate_;
+  // Byte offset into the current block (for both absorbing and squeezing).
+  size_t pos_;
+  bool squeezing_;
+};
+
+// Absorb n independent messages into n sponges. Sponges are processed in
+// groups of four: while all four in a group are block-aligned and have a
+// full block of input left, they are permuted together with
+// keccak_f1600_x4. Everything else goes through KeccakSponge::Absorb.
+void keccak_absorb_parallel(KeccakSponge *const sponges[],
+                            const uint8_t *const msgs[], const size_t lens[],
+                            size_t n);
+
+// SHA3-224/256/384/512. digest must hold sha_len / 8 bytes.
+void keccak_sha3(size_t sha_len, const uint8_t *msg, size_t msg_len,
+                 uint8_t *digest);
+
+// cSHAKE128/256 (strength is 128 or 256). With empty function_name and
+// customization this is SHAKE128/256.
+void keccak_cshake(size_t strength, const std::string &function_name,
+                   const std::string &customization, const uint8_t *msg,
+                   size_t msg_len, uint8_t *digest, size_t digest_len);
+
+// KMAC128/256 and KMACXOF128/256 (strength is 128 or 256).
+void keccak_kmac(size_t strength, bool xof, const uint8_t *key,
+                 size_t key_len, const std::string &customization,
+                 const uint8_t *msg, size_t msg_len, uint8_t *digest,
+                 size_t digest_len);
+
+#endif  // OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_SPONGE_H_
@@ -0,0 +1,87 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+#ifndef OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_X4_IMPL_H_
+#define OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_X4_IMPL_H_
+
+#include <cstdint>
+
+#include "keccak_backend.h"
+#include "keccak_consts.h"
+
+// Generic 4-way interleaved Keccak-f[1600], shared by the AVX2 and AVX-512
+// backends.
+//
+// Vector element i of lane L holds lane L of state i. The Ops class provides
+// the vector type and these primitives:
+//
+//   Vec Load(const uint64_t *const states[4], int lane)
+//   void Store(uint64_t *const states[4], int lane, Vec v)
+//   Vec Set1(uint64_t x)
+//   Vec Xor(Vec a, Vec b)
+//   Vec Xor5(Vec a, Vec b, Vec c, Vec d, Vec e)
+//   Vec Rol(Vec a, unsigned n)
+//   Vec Chi(Vec a, Vec b, Vec c)       // a ^ (~b & c)
+//
+// This header must be included after the target pragma of the translation
+// unit that instantiates it, so that the code is compiled with the right
+// instruction set enabled.
+
+// The inner loops must be fully unrolled so that the rotation amounts become
+// immediates and the state stays in registers.
+#if defined(__clang__)
+#define KECCAK_X4_UNROLL _Pragma("unroll")
+#elif defined(__GNUC__)
+#define KECCAK_X4_UNROLL _Pragma("GCC unroll 25")
+#else
+#define KECCAK_X4_UNROLL
+#endif
+
+template <class Ops>
+inline void keccak_x4_permute(uint64_t *const states[4]) {
+  typedef typename Ops::Vec Vec;
+
+  Vec A[25];
+  for (int i = 0; i < 25; ++i) {
+    A[i] = Ops::Load(states, i);
+  }
+
+  for (int round = 0; round < 24; ++round) {
+    Vec C[5], D[5], B[25];
+
+    KECCAK_X4_UNROLL
+    for (int x = 0; x < 5; ++x) {
+      C[x] = Ops::Xor5(A[x], A[x + 5], A[x + 10], A[x + 15], A[x + 20]);
+    }
+    KECCAK_X4_UNROLL
+    for (int x = 0; x < 5; ++x) {
+      D[x] = Ops::Xor(C[(x + 4) % 5], Ops::Rol(C[(x + 1) % 5], 1));
+    }
+
+    KECCAK_X4_UNROLL
+    for (int x = 0; x < 5; ++x) {
+      KECCAK_X4_UNROLL
+      for (int y = 0; y < 5; ++y) {
+        B[y + 5 * ((2 * x + 3 * y) % 5)] =
+            Ops::Rol(Ops::Xor(A[x + 5 * y], D[x]), kKeccakRhoOffsets[x + 5 * y]);
+      }
+    }
+
+    KECCAK_X4_UNROLL
+    for (int y = 0; y < 5; ++y) {
+      KECCAK_X4_UNROLL
+      for (int x = 0; x < 5; ++x) {
+        A[x + 5 * y] = Ops::Chi(B[x + 5 * y], B[(x + 1) % 5 + 5 * y],
+                                B[(x + 2) % 5 + 5 * y]);
+      }
+    }
+
+    A[0] = Ops::Xor(A[0], Ops::Set1(kKeccakRoundConstants[round]));
+  }
+
+  for (int i = 0; i < 25; ++i) {
+    Ops::Store(states, i, A[i]);
+  }
+}
+
+#endif  // OPENTITAN_HW_IP_KMAC_DV_DPI_KECCAK_X4_IMPL_H_
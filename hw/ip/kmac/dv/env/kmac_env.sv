@@ -34,6 +34,15 @@ class kmac_env extends cip_base_env #(
     if (!uvm_config_db#(kmac_vif)::get(this, "", "kmac_vif", cfg.kmac_vif)) begin
       `uvm_fatal(`gfn, "failed to get kmac_vif from uvm_config_db")
     end
+
+    // configure the Keccak backend of the DPI digest model
+    if (!digestpp_dpi_pkg::c_dpi_keccak_backend_config(cfg.keccak_backend,
+                                                       cfg.keccak_cross_check)) begin
+      `uvm_fatal(`gfn, $sformatf("unsupported keccak_backend: %0s", cfg.keccak_backend))
+    end
+    `uvm_info(`gfn, $sformatf("DPI Keccak backend: %0s (cross_check = %0b)",
+                              digestpp_dpi_pkg::c_dpi_keccak_backend_name(),
+                              cfg.keccak_cross_check), UVM_LOW)
   endfunction
 
   function void connect_phase(uvm_phase phase);
@@ -21,6 +21,11 @@ class kmac_env_cfg extends cip_base_env_cfg #(.RAL_T(kmac_reg_block));
   int sha3_variant;
   int shake_variant;
 
+  // Keccak permutation backend used by the DPI digest model, and whether to cross-check it
+  // against the scalar reference and digestpp (see digestpp_dpi_pkg).
+  string keccak_backend = "auto";
+  bit keccak_cross_check = 0;
+
   `uvm_object_utils_begin(kmac_env_cfg)
   `uvm_object_utils_end
 
@@ -52,6 +57,8 @@ class kmac_env_cfg extends cip_base_env_cfg #(.RAL_T(kmac_reg_block));
     void'($value$plusargs("enable_masking=%0d", enable_masking));
     void'($value$plusargs("test_vectors_sha3_variant=%0d", sha3_variant));
     void'($value$plusargs("test_vectors_shake_variant=%0d", shake_variant));
+    void'($value$plusargs("keccak_backend=%s", keccak_backend));
+    void'($value$plusargs("keccak_cross_check=%0b", keccak_cross_check));
 
     // set num_interrupts & num_alerts
     begin
@@ -30,6 +30,11 @@ void OtbnMemUtil::LoadElf(const std::string &elf_path) {
   LoadElfToMemories(false, elf_path);
 }
 
+void OtbnMemUtil::ClearMemories() {
+  imem_.Write(0, std::vector<uint8_t>(imem_.GetSizeBytes(), 0));
+  dmem_.Write(0, std::vector<uint8_t>(dmem_.GetSizeBytes(), 0));
+}
+
 const StagedMem::SegMap &OtbnMemUtil::GetSegs(bool is_imem) const {
   return GetMemoryData(is_imem ? "imem" : "dmem").GetSegs();
 }
@@ -25,6 +25,13 @@ class OtbnMemUtil : public DpiMemUtil {
   // If something goes wrong, throws a std::exception.
   void LoadElf(const std::string &elf_path);
 
+  // Zero the contents of IMEM and DMEM (with valid scrambling and integrity
+  // bits). This is used to run several ELF files in one simulation without
+  // one program seeing data left behind by the previous one.
+  //
+  // If something goes wrong, throws a std::exception.
+  void ClearMemories();
+
   // Get access to the segments currently staged for imem/dmem
   const StagedMem::SegMap &GetSegs(bool is_imem) const;
 
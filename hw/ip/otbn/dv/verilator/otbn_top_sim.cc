@@ -2,13 +2,23 @@
 // Licensed under the Apache License, Version 2.0, see LICENSE for details.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
 #include <fstream>
 #include <getopt.h>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <poll.h>
+#include <sstream>
 #include <string>
 #include <svdpi.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
 
 #include "Votbn_top_sim__Syms.h"
 #include "log_trace_listener.h"
@@ -99,7 +109,513 @@ class OtbnTraceUtil : public SimCtrlExtension {
 static otbn_top_sim *verilator_top;
 static OtbnMemUtil otbn_memutil("TOP.otbn_top_sim");
 
+// Loop iteration counts of the active loops, tracked by OtbnTopApplyLoopWarp.
+// This is cleared when the design is reset between programs in batch mode.
+static std::vector<uint32_t> loop_count_stack;
+
+/**
+ * Options for batch mode, in which a single simulator process runs many ELF
+ * files one after the other (see RunBatch).
+ */
+struct BatchOptions {
+  bool enabled = false;
+  std::vector<std::string> elfs;
+  unsigned long jobs = 1;
+  unsigned long max_cycles = 0;
+  std::string log_dir;
+};
+
+static void PrintBatchHelp() {
+  std::cout << "Batch mode:\n\n"
+               "--otbn-batch ELF...\n"
+               "  Run each ELF in turn, resetting the design and model in "
+               "between\n\n"
+               "--otbn-batch-manifest=FILE\n"
+               "  Run the ELF files listed in FILE (one per line, relative to "
+               "FILE)\n\n"
+               "--otbn-batch-jobs=N\n"
+               "  Run up to N ELF files in parallel in forked workers\n\n"
+               "--otbn-batch-max-cycles=N\n"
+               "  Fail a program if it runs for more than N cycles (0: no "
+               "limit)\n\n"
+               "--otbn-batch-log-dir=DIR\n"
+               "  Write the simulation output of each program to DIR/NAME.log\n"
+               "  (otherwise it is discarded)\n\n"
+               "In batch mode, one JSON object per program is written to "
+               "stdout.\n\n";
+}
+
+static bool ReadBatchManifest(const std::string &path,
+                              std::vector<std::string> &elfs) {
+  std::ifstream manifest(path);
+  if (!manifest) {
+    std::cerr << "ERROR: Cannot open batch manifest `" << path << "'.\n";
+    return false;
+  }
+
+  size_t slash = path.rfind('/');
+  std::string dir = (slash == std::string::npos) ? "" : path.substr(0, slash);
+
+  std::string line;
+  while (std::getline(manifest, line)) {
+    size_t start = line.find_first_not_of(" \t");
+    size_t end = line.find_last_not_of(" \t\r");
+    if (start == std::string::npos || line[start] == '#') {
+      continue;
+    }
+    std::string elf = line.substr(start, end - start + 1);
+    if (elf[0] != '/' && !dir.empty()) {
+      elf = dir + "/" + elf;
+    }
+    elfs.push_back(elf);
+  }
+  return true;
+}
+
+// Parse the batch mode arguments. Returns false on a bad command line.
+//
+// Without batch mode, other arguments are ignored, in the same way as the
+// SimCtrlExtension parsers do. Batch mode does not use VerilatorSimCtrl or
+// its extensions, so there they are rejected: their values could not be told
+// apart from ELF files otherwise.
+static bool ParseBatchArgs(int argc, char **argv, BatchOptions &opts) {
+  const struct option long_options[] = {
+      {"otbn-batch", no_argument, nullptr, 'b'},
+      {"otbn-batch-manifest", required_argument, nullptr, 'M'},
+      {"otbn-batch-jobs", required_argument, nullptr, 'j'},
+      {"otbn-batch-max-cycles", required_argument, nullptr, 'C'},
+      {"otbn-batch-log-dir", required_argument, nullptr, 'L'},
+      {"help", no_argument, nullptr, 'h'},
+      {nullptr, no_argument, nullptr, 0}};
+
+  std::vector<std::string> positional;
+  std::string unknown_option;
+  optind = 1;
+  opterr = 0;
+  while (1) {
+    int c = getopt_long(argc, argv, "-:h", long_options, nullptr);
+    if (c == -1) {
+      break;
+    }
+
+    switch (c) {
+      case 1:
+        positional.push_back(optarg);
+        break;
+      case 'b':
+        opts.enabled = true;
+        break;
+      case 'M':
+        opts.enabled = true;
+        if (!ReadBatchManifest(optarg, opts.elfs)) {
+          return false;
+        }
+        break;
+      case 'j':
+        opts.jobs = strtoul(optarg, nullptr, 0);
+        if (opts.jobs == 0) {
+          std::cerr << "ERROR: --otbn-batch-jobs must be at least 1.\n";
+          return false;
+        }
+        break;
+      case 'C':
+        opts.max_cycles = strtoul(optarg, nullptr, 0);
+        break;
+      case 'L':
+        opts.log_dir = optarg;
+        break;
+      case 'h':
+        PrintBatchHelp();
+        break;
+      case ':':  // missing argument
+        std::cerr << "ERROR: Missing argument for `" << argv[optind - 1]
+                  << "'.\n";
+        return false;
+      case '?':
+      default:
+        // Unrecognized options might be consumed by VerilatorSimCtrl or its
+        // extensions; they are only an error in batch mode.
+        if (unknown_option.empty()) {
+          unknown_option = argv[optind - 1];
+        }
+        break;
+    }
+  }
+  optind = 1;
+
+  if (opts.enabled) {
+    if (!unknown_option.empty()) {
+      std::cerr << "ERROR: Unknown option `" << unknown_option
+                << "' in batch mode.\n";
+      return false;
+    }
+    opts.elfs.insert(opts.elfs.end(), positional.begin(), positional.end());
+    if (opts.elfs.empty()) {
+      std::cerr << "ERROR: Batch mode needs at least one ELF file.\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::string JsonEscape(const std::string &str) {
+  std::ostringstream oss;
+  for (char c : str) {
+    switch (c) {
+      case '"':
+        oss << "\\\"";
+        break;
+      case '\\':
+        oss << "\\\\";
+        break;
+      case '\n':
+        oss << "\\n";
+        break;
+      default:
+        if ((unsigned char)c < 0x20) {
+          oss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+              << (int)c;
+        } else {
+          oss << c;
+        }
+    }
+  }
+  return oss.str();
+}
+
+static std::string BatchResultJson(const std::string &elf, bool passed,
+                                   unsigned long cycles, double seconds,
+                                   const std::string &error) {
+  std::ostringstream oss;
+  oss << "{\"elf\": \"" << JsonEscape(elf) << "\", \"passed\": "
+      << (passed ? "true" : "false") << ", \"cycles\": " << cycles
+      << ", \"seconds\": " << seconds;
+  if (!error.empty()) {
+    oss << ", \"error\": \"" << JsonEscape(error) << "\"";
+  }
+  oss << "}";
+  return oss.str();
+}
+
+// Advance the simulation by half a clock period.
+static void BatchHalfCycle(otbn_top_sim &top) {
+  top.IO_CLK = !top.IO_CLK;
+  top.eval();
+}
+
+// Run a single ELF file on an already-elaborated design and return its
+// result as a JSON object. The design and the model are reset first, so the
+// program sees the same state as in a fresh simulation except that IMEM and
+// DMEM are zeroed through the scrambling and integrity logic.
+static std::string RunBatchProgram(otbn_top_sim &top, const std::string &elf,
+                                   const BatchOptions &opts) {
+  auto start = std::chrono::steady_clock::now();
+  unsigned long cycles = 0;
+  auto result = [&](bool passed, const std::string &error) {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return BatchResultJson(elf, passed, cycles, elapsed.count(), error);
+  };
+
+  try {
+    otbn_memutil.ClearMemories();
+    otbn_memutil.LoadElf(elf);
+  } catch (const std::exception &err) {
+    return result(false, std::string("Failed to load ELF: ") + err.what());
+  }
+
+  // Reset the design. The model resets itself and its ISS on the reset edge
+  // and OtbnTopInstallLoopWarps picks up the loop warps of the new program
+  // after reset.
+  Verilated::gotFinish(false);
+  loop_count_stack.clear();
+  top.IO_RST_N = 1;
+  for (int i = 0; i < 4; ++i) {
+    BatchHalfCycle(top);
+  }
+  top.IO_RST_N = 0;
+  for (int i = 0; i < 4; ++i) {
+    BatchHalfCycle(top);
+  }
+  top.IO_RST_N = 1;
+
+  // Run until otbn_top_sim calls $finish, which it does a few cycles after
+  // OTBN signals done.
+  while (!Verilated::gotFinish()) {
+    if (opts.max_cycles && cycles >= opts.max_cycles) {
+      return result(false, "Timeout");
+    }
+    BatchHalfCycle(top);
+    BatchHalfCycle(top);
+    ++cycles;
+  }
+  std::cout.flush();
+  fflush(stdout);
+
+  svSetScope(svGetScopeFromName("TOP.otbn_top_sim"));
+  if (otbn_err_get()) {
+    return result(false, "Mismatch or model error (see log)");
+  }
+
+  int exp_stop_pc = otbn_memutil.GetExpEndAddr();
+  if (exp_stop_pc >= 0) {
+    SVScoped core_scope("TOP.otbn_top_sim.u_otbn_core_model");
+    int act_stop_pc = otbn_core_get_stop_pc();
+    if (exp_stop_pc != act_stop_pc) {
+      std::ostringstream oss;
+      oss << "Expected stop PC from ELF file was 0x" << std::hex << exp_stop_pc
+          << ", but simulation actually stopped at 0x" << act_stop_pc << ".";
+      return result(false, oss.str());
+    }
+  }
+
+  return result(true, "");
+}
+
+// Send the simulation output of the current program to the log file for elf
+// (or discard it).
+static void RedirectBatchOutput(const BatchOptions &opts,
+                                const std::string &elf) {
+  std::string log_path = "/dev/null";
+  if (!opts.log_dir.empty()) {
+    size_t slash = elf.rfind('/');
+    std::string name = elf.substr(slash == std::string::npos ? 0 : slash + 1);
+    size_t dot = name.rfind('.');
+    if (dot != std::string::npos && dot > 0) {
+      name = name.substr(0, dot);
+    }
+    log_path = opts.log_dir + "/" + name + ".log";
+  }
+
+  std::cout.flush();
+  fflush(stdout);
+  fflush(stderr);
+  int fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return;
+  }
+  dup2(fd, STDOUT_FILENO);
+  if (!opts.log_dir.empty()) {
+    dup2(fd, STDERR_FILENO);
+  }
+  close(fd);
+}
+
+// Worker process: receive indices into opts.elfs on task_fd, run the program
+// and send a JSON line back on result_fd. Exits when task_fd is closed.
+static void RunBatchWorker(otbn_top_sim &top, const BatchOptions &opts,
+                           int task_fd, int result_fd) {
+  uint32_t idx;
+  while (read(task_fd, &idx, sizeof(idx)) == sizeof(idx)) {
+    RedirectBatchOutput(opts, opts.elfs[idx]);
+    std::string line = RunBatchProgram(top, opts.elfs[idx], opts) + "\n";
+    if (write(result_fd, line.data(), line.size()) != (ssize_t)line.size()) {
+      break;
+    }
+  }
+  top.final();
+  exit(0);
+}
+
+/**
+ * Run all ELF files in opts.elfs
+ *
+ * The design has been elaborated (initial blocks have run) before this is
+ * called, but the ISS has not been started yet. Every worker is forked from
+ * this pristine state and then runs programs one after the other, resetting
+ * the design and the model in between, so process startup, ISS startup and
+ * model construction are paid once per worker rather than once per program.
+ *
+ * If a worker dies (e.g. because the design called $error), the program it was
+ * running is reported as failed and a fresh worker is forked to continue.
+ *
+ * @return 0 if all programs passed, 1 otherwise
+ */
+static int RunBatch(otbn_top_sim &top, const BatchOptions &opts) {
+  struct Worker {
+    pid_t pid = -1;
+    int task_fd = -1;
+    int result_fd = -1;
+    int idx = -1;
+    std::string buf;
+  };
+
+  // Results go to the original stdout. Workers redirect their own stdout.
+  std::cout.flush();
+  fflush(stdout);
+  size_t next = 0, num_passed = 0, num_done = 0;
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<Worker> workers(std::min<size_t>(opts.jobs, opts.elfs.size()));
+
+  auto send_next = [&](Worker &w) {
+    if (next == opts.elfs.size()) {
+      close(w.task_fd);
+      w.task_fd = -1;
+      w.idx = -1;
+      return;
+    }
+    uint32_t idx = next++;
+    w.idx = idx;
+    if (write(w.task_fd, &idx, sizeof(idx)) != sizeof(idx)) {
+      std::cerr << "ERROR: Failed to send work to batch worker.\n";
+    }
+  };
+
+  auto spawn = [&](Worker &w) -> bool {
+    int task_pipe[2], result_pipe[2];
+    if (pipe(task_pipe) || pipe(result_pipe)) {
+      std::cerr << "ERROR: pipe() failed: " << strerror(errno) << "\n";
+      return false;
+    }
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+      std::cerr << "ERROR: fork() failed: " << strerror(errno) << "\n";
+      return false;
+    }
+    if (pid == 0) {
+      // Only keep our own pipe ends, otherwise other workers never see their
+      // task pipe close. Don't pass them on to the ISS either.
+      for (Worker &other : workers) {
+        if (other.task_fd >= 0) {
+          close(other.task_fd);
+        }
+        if (other.result_fd >= 0) {
+          close(other.result_fd);
+        }
+      }
+      close(task_pipe[1]);
+      close(result_pipe[0]);
+      fcntl(task_pipe[0], F_SETFD, FD_CLOEXEC);
+      fcntl(result_pipe[1], F_SETFD, FD_CLOEXEC);
+      RunBatchWorker(top, opts, task_pipe[0], result_pipe[1]);
+    }
+    close(task_pipe[0]);
+    close(result_pipe[1]);
+    w.pid = pid;
+    w.task_fd = task_pipe[1];
+    w.result_fd = result_pipe[0];
+    w.buf.clear();
+    send_next(w);
+    return true;
+  };
+
+  auto report = [&](const std::string &line) {
+    std::cout << line << std::endl;
+    num_passed += line.find("\"passed\": true") != std::string::npos;
+    ++num_done;
+  };
+
+  for (Worker &w : workers) {
+    if (!spawn(w)) {
+      return 1;
+    }
+  }
+
+  while (num_done < opts.elfs.size()) {
+    std::vector<struct pollfd> fds;
+    for (Worker &w : workers) {
+      if (w.result_fd >= 0) {
+        fds.push_back({w.result_fd, POLLIN, 0});
+      }
+    }
+    if (fds.empty()) {
+      break;
+    }
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      std::cerr << "ERROR: poll() failed: " << strerror(errno) << "\n";
+      return 1;
+    }
+
+    for (Worker &w : workers) {
+      if (w.result_fd < 0) {
+        continue;
+      }
+      auto it = std::find_if(fds.begin(), fds.end(), [&](const pollfd &p) {
+        return p.fd == w.result_fd;
+      });
+      if (it == fds.end() || !it->revents) {
+        continue;
+      }
+
+      char chunk[4096];
+      ssize_t n = read(w.result_fd, chunk, sizeof(chunk));
+      if (n > 0) {
+        w.buf.append(chunk, n);
+        size_t nl;
+        while ((nl = w.buf.find('\n')) != std::string::npos) {
+          report(w.buf.substr(0, nl));
+          w.buf.erase(0, nl + 1);
+          send_next(w);
+        }
+        continue;
+      }
+
+      // The worker has exited. If it was still running a program, that
+      // program failed; start a new worker for the remaining ones.
+      close(w.result_fd);
+      w.result_fd = -1;
+      int status = 0;
+      waitpid(w.pid, &status, 0);
+      if (w.idx >= 0) {
+        std::ostringstream oss;
+        oss << "Simulator exited while running the program (status "
+            << status << ", see log)";
+        report(BatchResultJson(opts.elfs[w.idx], false, 0, 0, oss.str()));
+        if (w.task_fd >= 0) {
+          close(w.task_fd);
+        }
+        w.idx = -1;
+        if (next < opts.elfs.size() && !spawn(w)) {
+          return 1;
+        }
+      }
+    }
+  }
+
+  for (Worker &w : workers) {
+    if (w.task_fd >= 0) {
+      close(w.task_fd);
+    }
+    if (w.result_fd >= 0) {
+      close(w.result_fd);
+      waitpid(w.pid, nullptr, 0);
+    }
+  }
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cerr << num_passed << "/" << opts.elfs.size() << " programs passed in "
+            << elapsed.count() << " s (" << workers.size() << " workers)."
+            << std::endl;
+
+  return num_passed == opts.elfs.size() ? 0 : 1;
+}
+
 int main(int argc, char **argv) {
+  BatchOptions batch_opts;
+  if (!ParseBatchArgs(argc, argv, batch_opts)) {
+    return 1;
+  }
+
+  if (batch_opts.enabled) {
+    otbn_top_sim top;
+    verilator_top = &top;
+
+    // Evaluate the initial blocks (which construct the model and its
+    // OtbnMemUtil), but don't start the ISS yet: that happens on the first
+    // reset in each worker.
+    top.IO_CLK = 0;
+    top.IO_RST_N = 1;
+    top.eval();
+
+    return RunBatch(top, batch_opts);
+  }
+
   VerilatorMemUtil memutil(&otbn_memutil);
   OtbnTraceUtil traceutil;
 
@@ -231,8 +747,6 @@ auto get_loop_counter(LoopControllerT *loop_controller, uint32_t counter_idx)
 // updating the top of the loop stack if necessary to match loop warp symbols
 // in the ELF file.
 extern "C" void OtbnTopApplyLoopWarp() {
-  static std::vector<uint32_t> loop_count_stack;
-
   // See not in OtbnTopInstallLoopWarps for why this upcast is needed.
   Votbn_top_sim &top = *verilator_top;
 
@@ -450,6 +450,7 @@ module otbn_top_sim (
   always_ff @(negedge IO_CLK or negedge IO_RST_N) begin
     if (!IO_RST_N) begin
       warps_installed <= 1'b0;
+      loop_warp_model_err <= 1'b0;
     end else begin
       if (!warps_installed) begin
         if (OtbnTopInstallLoopWarps() != 0) begin
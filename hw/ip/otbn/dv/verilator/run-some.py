@@ -11,7 +11,10 @@ Use this with a command line like
 
 which will generate 10 OTBN binaries, each with up to 1500 instructions in
 their respective traces. It will also build a Verilated model of OTBN (using
-otbn_top_sim) and run the model on each binary.
+otbn_top_sim) and run the model on all binaries in batch mode: the simulator
+is started once and runs the programs in --jobs parallel worker processes.
+Results are written to results.jsonl (one JSON object per binary) and the
+simulation output for binary N to N.log in the destination directory.
 
 '''
 
@@ -46,6 +49,8 @@ def main() -> int:
                         help='Number of binaries to generate and run')
     parser.add_argument('--seed', type=int, default=1)
     parser.add_argument('--size', type=int, default=100)
+    parser.add_argument('--jobs', '-j', type=int, default=os.cpu_count(),
+                        help='Number of parallel simulation workers')
     parser.add_argument('destdir', help='Destination directory')
 
     args = parser.parse_args()
@@ -68,7 +73,8 @@ def main() -> int:
     # Next, we make our own build.ninja, which says how to compile and run the
     # verilated testbench
     with open(os.path.join(args.destdir, 'build.ninja'), 'w') as ninja_handle:
-        write_ninja(ninja_handle, args.destdir, args.seed, args.count)
+        write_ninja(ninja_handle, args.destdir, args.seed, args.count,
+                    args.jobs)
 
     # Finally, use ninja to run everything, continuing on error (so that you
     # can run 100 seeds and see what proportion fails).
@@ -79,7 +85,8 @@ def main() -> int:
 def write_ninja(handle: TextIO,
                 destdir: str,
                 seed: int,
-                count: int) -> None:
+                count: int,
+                jobs: int) -> None:
     handle.write('include build.ninja.gen\n\n')
 
     # Find the project directory, as viewed from destdir
@@ -98,17 +105,22 @@ def write_ninja(handle: TextIO,
     # Collect up all the generated files
     basenames = [str(seed + off) for off in range(count)]
 
-    # Rules to run them
+    # All binaries are run by one invocation of the simulator in batch mode,
+    # which reads the list of binaries from a manifest.
+    with open(os.path.join(destdir, 'manifest.txt'), 'w') as manifest:
+        for name in basenames:
+            manifest.write(f'{name}.elf\n')
+
     handle.write(f'rule run\n'
                  f'  command = REPO_TOP={projdir_from_destdir} '
-                 f'$tb --load-elf $in >$out\n\n')
-    for name in basenames:
-        handle.write(f'build {name}.out: run {name}.elf | $tb\n')
-    handle.write('\n')
+                 f'$tb --otbn-batch-manifest=manifest.txt '
+                 f'--otbn-batch-jobs={jobs} --otbn-batch-log-dir=. '
+                 f'>$out\n\n')
+    elfs = ' '.join([f'{name}.elf' for name in basenames])
+    handle.write(f'build results.jsonl: run manifest.txt | $tb {elfs}\n\n')
 
     # A phony rule to run everything
-    handle.write('build run: phony {}\n\n'
-                 .format(' '.join([f'{name}.out' for name in basenames])))
+    handle.write('build run: phony results.jsonl\n')
 
 
 if __name__ == '__main__':
@@ -152,7 +152,8 @@ package chip_env_pkg;
     SpiFlashSectorErase  = 8'h20,
     SpiFlashPageProgram  = 8'h02,
     SpiFlashEn4B         = 8'hB7,
-    SpiFlashEx4B         = 8'hE9
+    SpiFlashEx4B         = 8'hE9,
+    SpiFlashReset        = 8'h99
   } spi_flash_cmd_e;
 
   // Extracts the address and size of a const symbol in a SW test (supplied as an ELF file).
@@ -371,6 +371,14 @@ class chip_sw_base_vseq extends chip_base_vseq;
     info.write_command = 1;
     agent_cfg.add_cmd_info(info);
 
+    info = spi_flash_cmd_info::type_id::create("info");
+    info.addr_mode = SpiFlashAddrDisabled;
+    info.opcode = SpiFlashReset;
+    info.num_lanes = 0;
+    info.dummy_cycles = 0;
+    info.write_command = 0;
+    agent_cfg.add_cmd_info(info);
+
     agent_cfg.spi_func_mode = SpiModeFlash;
   endfunction
 
@@ -423,8 +431,9 @@ class chip_sw_base_vseq extends chip_base_vseq;
 
   // Load the flash binary specified by the `sw_image` path by sending a chip
   // erase, then programming pages in sequence via the SPI flash interface
-  // presented by the ROM. Afterwards, bring the software straps back to 0,
-  // and issue a power-on reset.
+  // presented by the ROM. Afterwards, send a RESET and wait for the ROM to
+  // reset the chip, bring the software straps back to 0, and issue a power-on
+  // reset.
   // The `sw_image` path should point to an image usable by the
   // `read_sw_frames` task.
   // This task assumes the device was booted with software straps set before
@@ -487,6 +496,15 @@ class chip_sw_base_vseq extends chip_base_vseq;
       byte_cnt += bytes_to_write;
     end
 
+    // The ROM clears the busy bit as soon as it starts programming a page, and
+    // completes the last page only when it receives the next command. RESET
+    // keeps the busy bit set until the page is programmed and the chip is
+    // reset (the ROM re-enters bootstrap since the straps are still driven).
+    `uvm_create_on(m_spi_host_seq, p_sequencer.spi_host_sequencer_h)
+    m_spi_host_seq.opcode = SpiFlashReset;
+    `uvm_send(m_spi_host_seq);
+    spi_host_wait_on_busy();
+
     cfg.chip_vif.sw_straps_if.drive(3'h0);
     assert_por_reset();
   endtask
@@ -2,9 +2,14 @@
 
 import os
 import signal
+import sys
 from pathlib import Path
 from subprocess import Popen, PIPE
 
+sys.path.append(str(Path(__file__).parent.resolve().joinpath(
+    "util", "device_sw_utils")))
+from decode_sw_logs import LogDatabase, LogDecoder  # noqa: E402
+
 BANNER = """
 /////////////////////////////////////////////////////////////////
 //                                                             //
@@ -21,6 +26,9 @@ ROM_PATH = CWD.joinpath("sw", "device", "lib", "testing", "test_rom",
 FLASH_PATH = CWD.joinpath("sw", "device", "tests",
                           "cmod_perftest_prog_sim_verilator.fake_prod_key_0.signed.64.scr.vmem")
 OTP_PATH = CWD.joinpath("hw", "ip", "otp_ctrl", "data", "img_rma.24.vmem")
+# The perftest writes binary log records, which are decoded using its ELF file.
+ELF_PATH = Path(__file__).parent.resolve().joinpath(
+    "bazel-bin", "sw", "device", "tests", "cmod_perftest_prog_sim_verilator.elf")
 
 RESULTS_FILE = "cmod_perftest_results"
 
@@ -79,17 +87,25 @@ def run_perftest():
 
     print("Simulation is running.\n")
 
-    with open(uart0, "r") as log_file:
+    decoder = LogDecoder(LogDatabase(ELF_PATH))
+
+    with open(uart0, "rb", buffering=0) as log_file:
         print("Connected to UART0 to print perftest logging.\n")
 
         results = []
+        text = ""
 
         while sim_running:
-            line = log_file.readline().strip()
+            text += decoder.feed(log_file.read(4096))
+            *lines, text = text.split("\n")
+
+            for line in lines:
+                line = line.strip()
+
+                if line.find("PASS!") != -1:
+                    sim_running = False
+                    break
 
-            if line.find("PASS!") != -1:
-                sim_running = False
-            else:
                 index = line.find("Result: ")
 
                 if index != -1:
@@ -8,12 +8,72 @@
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/random_order.h"
 
-// NOTE: The three hardened_mem* functions have similar contents, but the parts
+enum {
+  /**
+   * Number of words processed per step of the random order.
+   *
+   * Walking the buffers in bursts of consecutive words amortizes the cost of
+   * advancing the random order and of the associated barriers over several
+   * words.
+   */
+  kBurstWords = 4,
+  kBurstBytes = kBurstWords * sizeof(uint32_t),
+};
+
+/**
+ * Set up the traversal of a buffer in bursts.
+ *
+ * @param order The random order of the bursts to initialize.
+ * @param word_len The length of the buffer in words.
+ * @return The word within each burst at which to start, selected at random.
+ */
+static size_t burst_order_init(random_order_t *order, size_t word_len) {
+  random_order_t start;
+  random_order_init(&start, kBurstWords);
+  random_order_init(order, (word_len + kBurstWords - 1) / kBurstWords);
+  return launderw(random_order_advance(&start)) % kBurstWords;
+}
+
+/**
+ * Compute the offset of the `i`th word visited in a burst.
+ *
+ * @param burst_idx The offset of the burst in bytes.
+ * @param start The word within each burst at which to start.
+ * @param i The number of words of the burst visited before.
+ * @return The offset of the word in bytes.
+ */
+static inline size_t burst_word(size_t burst_idx, size_t start, size_t i) {
+  return burst_idx + ((start + i) % kBurstWords) * sizeof(uint32_t);
+}
+
+/**
+ * Branchlessly select the address of a word of a buffer or, if the word lies
+ * past the end of the buffer, the address of a decoy word.
+ *
+ * The result is laundered, so that the compiler cannot delete the loads and
+ * stores through it.
+ *
+ * @param addr The address of the buffer.
+ * @param byte_idx The offset of the word in bytes.
+ * @param byte_len The length of the buffer in bytes.
+ * @param decoy The address of the decoy word.
+ * @return The selected address.
+ */
+static inline void *select_word(uintptr_t addr, size_t byte_idx,
+                                size_t byte_len, uintptr_t decoy) {
+  return (void *)launderw(ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len),
+                                   addr + byte_idx, decoy));
+}
+
+// NOTE: The hardened_mem* functions have similar contents, but the parts
 // that are shared between them are commented only in `memcpy()`.
 void hardened_memcpy(uint32_t *restrict dest, const uint32_t *restrict src,
                      size_t word_len) {
+  // The buffers are traversed in bursts of `kBurstWords`, in a random order,
+  // and each burst starts at the same randomly selected word and wraps
+  // around.
   random_order_t order;
-  random_order_init(&order, word_len);
+  size_t start = burst_order_init(&order, word_len);
 
   size_t count = 0;
   size_t expected_count = random_order_len(&order);
@@ -26,53 +86,50 @@ void hardened_memcpy(uint32_t *restrict dest, const uint32_t *restrict src,
 
   // `decoys` is a small stack array that is filled with uninitialized memory.
   // It is scratch space for us to do "extra" operations, when the number of
-  // iteration indices the chosen random order is different from `word_len`.
+  // iteration indices the chosen random order is different from the number of
+  // bursts, and for the words of the last burst that go off the end of the
+  // buffers.
   //
   // These extra operations also introduce noise that an attacker must do work
   // to filter, such as by applying side-channel analysis to obtain an address
   // trace.
-  uint32_t decoys[8];
+  uint32_t decoys[2 * kBurstWords];
   uintptr_t decoy_addr = (uintptr_t)&decoys;
 
   // We need to launder `count`, so that the SW.LOOP-COMPLETION check is not
   // deleted by the compiler.
   size_t byte_len = word_len * sizeof(uint32_t);
   for (; launderw(count) < expected_count; count = launderw(count) + 1) {
-    // The order values themselves are in units of words, but we need `byte_idx`
-    // to be in units of bytes.
+    // The order values themselves are in units of bursts, but we need
+    // `burst_idx` to be in units of bytes.
     //
     // The value obtained from `advance()` is laundered, to prevent
     // implementation details from leaking across procedures.
-    size_t byte_idx = launderw(random_order_advance(&order)) * sizeof(uint32_t);
+    size_t burst_idx = launderw(random_order_advance(&order)) * kBurstBytes;
 
     // Prevent the compiler from reordering the loop; this ensures a
     // happens-before among indices consistent with `order`.
-    barrierw(byte_idx);
-
-    // Compute putative offsets into `src`, `dest`, and `decoys`. Some of these
-    // may go off the end of `src` and `dest`, but they will not be cast to
-    // pointers in that case. (Note that casting out-of-range addresses to
-    // pointers is UB.)
-    uintptr_t srcp = src_addr + byte_idx;
-    uintptr_t destp = dest_addr + byte_idx;
-    uintptr_t decoy1 = decoy_addr + (byte_idx % sizeof(decoys));
-    uintptr_t decoy2 =
-        decoy_addr + ((byte_idx + sizeof(decoys) / 2) % sizeof(decoys));
-
-    // Branchlessly select whether to do a "real" copy or a decoy copy,
-    // depending on whether we've gone off the end of the array or not.
-    //
-    // Pretty much everything needs to be laundered: we need to launder
-    // `byte_idx` for obvious reasons, and we need to launder the result of the
-    // select, so that the compiler cannot delete the resulting loads and
-    // stores. This is similar to having used `volatile uint32_t *`.
-    void *src = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), srcp, decoy1));
-    void *dest = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), destp, decoy2));
-
-    // Perform the copy, without performing a typed dereference operation.
-    write_32(read_32(src), dest);
+    barrierw(burst_idx);
+
+    for (size_t i = 0; i < kBurstWords; ++i) {
+      size_t byte_idx = burst_word(burst_idx, start, i);
+
+      // Compute putative offsets into `decoys`. The offsets into `src` and
+      // `dest` may go off the end of the buffers, but they will not be cast
+      // to pointers in that case. (Note that casting out-of-range addresses
+      // to pointers is UB.)
+      uintptr_t decoy1 = decoy_addr + (byte_idx % sizeof(decoys));
+      uintptr_t decoy2 =
+          decoy_addr + ((byte_idx + sizeof(decoys) / 2) % sizeof(decoys));
+
+      // Branchlessly select whether to do a "real" copy or a decoy copy,
+      // depending on whether we've gone off the end of the array or not.
+      void *src = select_word(src_addr, byte_idx, byte_len, decoy1);
+      void *dest = select_word(dest_addr, byte_idx, byte_len, decoy2);
+
+      // Perform the copy, without performing a typed dereference operation.
+      write_32(read_32(src), dest);
+    }
   }
 
   HARDENED_CHECK_EQ(count, expected_count);
@@ -84,29 +141,29 @@ uint32_t hardened_memshred_random_word(void) { return 0xcaffe17e; }
 
 void hardened_memshred(uint32_t *dest, size_t word_len) {
   random_order_t order;
-  random_order_init(&order, word_len);
+  size_t start = burst_order_init(&order, word_len);
 
   size_t count = 0;
   size_t expected_count = random_order_len(&order);
 
   uintptr_t data_addr = (uintptr_t)dest;
 
-  uint32_t decoys[8];
+  uint32_t decoys[2 * kBurstWords];
   uintptr_t decoy_addr = (uintptr_t)&decoys;
 
   size_t byte_len = word_len * sizeof(uint32_t);
   for (; count < expected_count; count = launderw(count) + 1) {
-    size_t byte_idx = launderw(random_order_advance(&order)) * sizeof(uint32_t);
-    barrierw(byte_idx);
-
-    uintptr_t datap = data_addr + byte_idx;
-    uintptr_t decoy = decoy_addr + (byte_idx % sizeof(decoys));
+    size_t burst_idx = launderw(random_order_advance(&order)) * kBurstBytes;
+    barrierw(burst_idx);
 
-    void *data = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), datap, decoy));
+    for (size_t i = 0; i < kBurstWords; ++i) {
+      size_t byte_idx = burst_word(burst_idx, start, i);
+      uintptr_t decoy = decoy_addr + (byte_idx % sizeof(decoys));
+      void *data = select_word(data_addr, byte_idx, byte_len, decoy);
 
-    // Write a freshly-generated random word to `*data`.
-    write_32(hardened_memshred_random_word(), data);
+      // Write a freshly-generated random word to `*data`.
+      write_32(hardened_memshred_random_word(), data);
+    }
   }
 
   HARDENED_CHECK_EQ(count, expected_count);
@@ -115,7 +172,7 @@ void hardened_memshred(uint32_t *dest, size_t word_len) {
 hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
                                size_t word_len) {
   random_order_t order;
-  random_order_init(&order, word_len);
+  size_t start = burst_order_init(&order, word_len);
 
   size_t count = 0;
   size_t expected_count = random_order_len(&order);
@@ -126,7 +183,7 @@ hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
   // `decoys` needs to be filled with equal values this time around. It
   // should be filled with values with a Hamming weight of around 16, which is
   // the most common hamming weight among 32-bit words.
-  uint32_t decoys[8] = {
+  uint32_t decoys[2 * kBurstWords] = {
       0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa,
       0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa, 0xaaaaaaaa,
   };
@@ -139,33 +196,32 @@ hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
   // replaced with something else.
   size_t byte_len = word_len * sizeof(uint32_t);
   for (; count < expected_count; count = launderw(count) + 1) {
-    size_t byte_idx = launderw(random_order_advance(&order)) * sizeof(uint32_t);
-    barrierw(byte_idx);
-
-    uintptr_t ap = lhs_addr + byte_idx;
-    uintptr_t bp = rhs_addr + byte_idx;
-    uintptr_t decoy1 = decoy_addr + (byte_idx % sizeof(decoys));
-    uintptr_t decoy2 =
-        decoy_addr + ((byte_idx + sizeof(decoys) / 2) % sizeof(decoys));
-
-    void *av = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), ap, decoy1));
-    void *bv = (void *)launderw(
-        ct_cmovw(ct_sltuw(launderw(byte_idx), byte_len), bp, decoy2));
-
-    uint32_t a = read_32(av);
-    uint32_t b = read_32(bv);
-
-    // Launder one of the operands, so that the compiler cannot cache the result
-    // of the xor for use in the next operation.
-    //
-    // We launder `zeroes` so that compiler cannot learn that `zeroes` has
-    // strictly more bits set at the end of the loop.
-    zeros = launder32(zeros) | (launder32(a) ^ b);
-
-    // Same as above. The compiler can cache the value of `a[offset]`, but it
-    // has no chance to strength-reduce this operation.
-    ones = launder32(ones) & (launder32(a) ^ ~b);
+    size_t burst_idx = launderw(random_order_advance(&order)) * kBurstBytes;
+    barrierw(burst_idx);
+
+    for (size_t i = 0; i < kBurstWords; ++i) {
+      size_t byte_idx = burst_word(burst_idx, start, i);
+      uintptr_t decoy1 = decoy_addr + (byte_idx % sizeof(decoys));
+      uintptr_t decoy2 =
+          decoy_addr + ((byte_idx + sizeof(decoys) / 2) % sizeof(decoys));
+
+      void *av = select_word(lhs_addr, byte_idx, byte_len, decoy1);
+      void *bv = select_word(rhs_addr, byte_idx, byte_len, decoy2);
+
+      uint32_t a = read_32(av);
+      uint32_t b = read_32(bv);
+
+      // Launder one of the operands, so that the compiler cannot cache the
+      // result of the xor for use in the next operation.
+      //
+      // We launder `zeroes` so that compiler cannot learn that `zeroes` has
+      // strictly more bits set at the end of the loop.
+      zeros = launder32(zeros) | (launder32(a) ^ b);
+
+      // Same as above. The compiler can cache the value of `a[offset]`, but it
+      // has no chance to strength-reduce this operation.
+      ones = launder32(ones) & (launder32(a) ^ ~b);
+    }
   }
 
   HARDENED_CHECK_EQ(count, expected_count);
@@ -177,3 +233,40 @@ hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
   HARDENED_CHECK_NE(ones, UINT32_MAX);
   return kHardenedBoolFalse;
 }
+
+void hardened_xor_into(uint32_t *restrict dest, const uint32_t *restrict src,
+                       size_t word_len) {
+  random_order_t order;
+  size_t start = burst_order_init(&order, word_len);
+
+  size_t count = 0;
+  size_t expected_count = random_order_len(&order);
+
+  uintptr_t src_addr = (uintptr_t)src;
+  uintptr_t dest_addr = (uintptr_t)dest;
+
+  uint32_t decoys[2 * kBurstWords];
+  uintptr_t decoy_addr = (uintptr_t)&decoys;
+
+  size_t byte_len = word_len * sizeof(uint32_t);
+  for (; launderw(count) < expected_count; count = launderw(count) + 1) {
+    size_t burst_idx = launderw(random_order_advance(&order)) * kBurstBytes;
+    barrierw(burst_idx);
+
+    for (size_t i = 0; i < kBurstWords; ++i) {
+      size_t byte_idx = burst_word(burst_idx, start, i);
+      uintptr_t decoy1 = decoy_addr + (byte_idx % sizeof(decoys));
+      uintptr_t decoy2 =
+          decoy_addr + ((byte_idx + sizeof(decoys) / 2) % sizeof(decoys));
+
+      void *src = select_word(src_addr, byte_idx, byte_len, decoy1);
+      void *dest = select_word(dest_addr, byte_idx, byte_len, decoy2);
+
+      // Launder the source word so that the compiler cannot combine the xor
+      // with other operations on the (possibly masked) operands.
+      write_32(launder32(read_32(src)) ^ read_32(dest), dest);
+    }
+  }
+
+  HARDENED_CHECK_EQ(count, expected_count);
+}
@@ -83,6 +83,26 @@ void hardened_memshred(uint32_t *dest, size_t word_len);
 hardened_bool_t hardened_memeq(const uint32_t *lhs, const uint32_t *rhs,
                                size_t word_len);
 
+/**
+ * XORs a 32-bit aligned region of memory into another, non-overlapping one.
+ *
+ * This is intended for combining masked values, such as key shares, without
+ * unmasking them word by word in a predictable order. Like the other functions
+ * in this file, it visits the words in a random order, interleaved with decoy
+ * operations.
+ *
+ * Input pointers *MUST* be 32-bit aligned, although they do not need to
+ * actually point to memory declared as `uint32_t` per the C aliasing rules.
+ * Internally, this function is careful to not dereference its operands
+ * directly, and instead uses dedicated load/store intrinsics.
+ *
+ * @param dest The buffer to XOR into; `dest[i] ^= src[i]` for each word.
+ * @param src The buffer to XOR from.
+ * @param word_len The number of words to XOR.
+ */
+void hardened_xor_into(uint32_t *OT_RESTRICT dest,
+                       const uint32_t *OT_RESTRICT src, size_t word_len);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
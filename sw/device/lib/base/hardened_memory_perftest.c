@@ -0,0 +1,131 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/hardened_memory.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/testing/test_framework/ottf_perf.h"
+
+enum {
+  kBufWords = 256,
+  kNumRuns = 10,
+};
+
+typedef struct perf_test {
+  // A human-readable name for this particular test, e.g. "hardened_memcpy".
+  const char *label;
+
+  // A function that exercises the function under test on the given number of
+  // words. This function pointer must not be NULL.
+  void (*func)(uint32_t *buf1, uint32_t *buf2, size_t word_len);
+
+  // Accumulates the performance counters over all runs and lengths, which the
+  // OTTF reports when the test finishes.
+  ottf_perf_region_t region;
+} perf_test_t;
+
+static void test_hardened_memcpy(uint32_t *buf1, uint32_t *buf2,
+                                 size_t word_len) {
+  hardened_memcpy(buf1, buf2, word_len);
+}
+
+static void test_hardened_memshred(uint32_t *buf1, uint32_t *buf2,
+                                   size_t word_len) {
+  hardened_memshred(buf1, word_len);
+}
+
+static void test_hardened_memeq(uint32_t *buf1, uint32_t *buf2,
+                                size_t word_len) {
+  OT_DISCARD(hardened_memeq(buf1, buf2, word_len));
+}
+
+static void test_hardened_xor_into(uint32_t *buf1, uint32_t *buf2,
+                                   size_t word_len) {
+  hardened_xor_into(buf1, buf2, word_len);
+}
+
+static perf_test_t perf_tests[] = {
+    {
+        .label = "hardened_memcpy",
+        .func = &test_hardened_memcpy,
+        .region = OTTF_PERF_REGION("hardened_memcpy"),
+    },
+    {
+        .label = "hardened_memshred",
+        .func = &test_hardened_memshred,
+        .region = OTTF_PERF_REGION("hardened_memshred"),
+    },
+    {
+        .label = "hardened_memeq",
+        .func = &test_hardened_memeq,
+        .region = OTTF_PERF_REGION("hardened_memeq"),
+    },
+    {
+        .label = "hardened_xor_into",
+        .func = &test_hardened_xor_into,
+        .region = OTTF_PERF_REGION("hardened_xor_into"),
+    },
+};
+
+// Lengths to measure, in words. The short ones show the fixed per-call cost,
+// the odd ones the cost of the decoy words in a partially-filled last burst.
+static const size_t kWordLens[] = {4, 7, 16, 64, kBufWords};
+
+static uint32_t buf1[kBufWords];
+static uint32_t buf2[kBufWords];
+
+// Run the given `perf_test_t` on `word_len` words and return the number of
+// cycles it took, summed over `kNumRuns` runs.
+static uint64_t perf_test_run(perf_test_t *test, size_t word_len) {
+  CHECK(test->func != NULL);
+
+  // The region accumulates over all lengths, so only its growth during this
+  // call belongs to `word_len`.
+  const uint64_t start_cycles =
+      ottf_perf_total(&test->region, kOttfPerfCounterCycles);
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    for (size_t j = 0; j < kBufWords; ++j) {
+      buf1[j] = (uint32_t)j * 0x9e3779b9;
+      buf2[j] = buf1[j];
+    }
+
+    ottf_perf_begin(&test->region);
+    test->func(buf1, buf2, word_len);
+    ottf_perf_end(&test->region);
+  }
+
+  return ottf_perf_total(&test->region, kOttfPerfCounterCycles) -
+         start_cycles;
+}
+
+bool test_main(void) {
+  // The hardened functions have no single expected cycle count worth pinning,
+  // as their cost depends on the random order; this test only reports the
+  // average cost per word so that changes to the implementation can be
+  // compared.
+  for (size_t i = 0; i < ARRAYSIZE(perf_tests); ++i) {
+    perf_test_t *test = &perf_tests[i];
+    for (size_t j = 0; j < ARRAYSIZE(kWordLens); ++j) {
+      const uint64_t num_cycles = perf_test_run(test, kWordLens[j]);
+
+      // Cast cycle counts to `uint32_t` before printing because
+      // `base_printf()` cannot print `uint64_t`.
+      CHECK(num_cycles < UINT32_MAX);
+      const uint32_t num_cycles_u32 = (uint32_t)num_cycles;
+      const uint32_t num_words = kNumRuns * kWordLens[j];
+
+      LOG_INFO("%s, %d words: %d cycles, %d.%02d cycles/word", test->label,
+               kWordLens[j], num_cycles_u32 / kNumRuns,
+               num_cycles_u32 / num_words,
+               (100 * (num_cycles_u32 % num_words)) / num_words);
+    }
+  }
+  return true;
+}
@@ -29,6 +29,23 @@ TEST(HardenedMemory, Memcpy) {
   EXPECT_THAT(ys, ElementsAre(0, 1, 2, 3, 4, 5, 6, 7));
 }
 
+TEST(HardenedMemory, MemcpyPartialBursts) {
+  // Exercise lengths that fill zero, one and several bursts, fully and
+  // partially, and check that nothing past the end is touched.
+  for (size_t len = 0; len <= 13; ++len) {
+    std::vector<uint32_t> xs(len);
+    for (size_t i = 0; i < len; ++i) {
+      xs[i] = i + 1;
+    }
+    std::vector<uint32_t> ys(len + 1);
+    hardened_memcpy(ys.data(), xs.data(), len);
+    for (size_t i = 0; i < len; ++i) {
+      EXPECT_EQ(ys[i], i + 1) << "len = " << len;
+    }
+    EXPECT_EQ(ys[len], 0) << "len = " << len;
+  }
+}
+
 constexpr uint32_t kRandomWord = 0xdeadbeef;
 
 // Override whatever the default randomness source is so we can verify it
@@ -53,5 +70,33 @@ TEST(HardenedMemory, MemEq) {
             kHardenedBoolFalse);
 }
 
+TEST(HardenedMemory, MemEqPartialBursts) {
+  for (size_t len = 1; len <= 13; ++len) {
+    std::vector<uint32_t> xs(len, 0x12345678);
+    std::vector<uint32_t> ys = xs;
+    EXPECT_EQ(hardened_memeq(xs.data(), ys.data(), len), kHardenedBoolTrue);
+
+    ys[len - 1] ^= 1;
+    EXPECT_EQ(hardened_memeq(xs.data(), ys.data(), len), kHardenedBoolFalse);
+  }
+}
+
+TEST(HardenedMemory, XorInto) {
+  std::vector<uint32_t> xs = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<uint32_t> ys = {0xf0, 0xf0, 0xf0, 0xf0, 0xf0,
+                              0xf0, 0xf0, 0xf0, 0xf0};
+
+  hardened_xor_into(ys.data(), xs.data(), 0);
+  EXPECT_THAT(ys, Each(0xf0));
+
+  hardened_xor_into(ys.data(), xs.data(), 6);
+  EXPECT_THAT(ys, ElementsAre(0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf0, 0xf0,
+                              0xf0));
+
+  // XORing the same value twice is the identity.
+  hardened_xor_into(ys.data(), xs.data(), 6);
+  EXPECT_THAT(ys, Each(0xf0));
+}
+
 }  // namespace
 }  // namespace hardened_memory_unittest
@@ -14,44 +14,71 @@
 #define OT_PREFIX_IF_NOT_RV32(name) ot_##name
 #endif
 
-static size_t compute_num_leading_bytes(const void *left, const void *right,
-                                        size_t len) {
+static size_t compute_num_leading_bytes(const void *ptr, size_t len) {
   if (len < alignof(uint32_t)) {
     return len;
   }
-  const size_t left_ahead = misalignment32_of((uintptr_t)left);
-  const size_t right_ahead = misalignment32_of((uintptr_t)right);
-  if (right == NULL || left_ahead == right_ahead) {
-    return (4 - left_ahead) & 0x3;
-  }
-  return len;
+  return (4 - misalignment32_of((uintptr_t)ptr)) & 0x3;
 }
 
 /**
- * Compute the bounds of the word-aligned region for the given buffers.
+ * Compute the bounds of the word-aligned region for the given buffer.
  *
  * It's more efficient for our memory functions to operate on `uint32_t` values
  * than individual bytes, but we can only read `uint32_t` values from aligned
- * addresses. This function effectively breaks the given buffers into three
+ * addresses. This function effectively breaks the given buffer into three
  * consecutive chunks: the unaligned "head", the aligned "body", and the
  * unaligned "tail".
  *
- * @param[in] left The memory function's first buffer argument. Cannot be NULL.
- * @param[in] right The memory function's second buffer argument. May be NULL.
- * @param[in] len The length in bytes of both `left` and `right.`
+ * Functions with a second buffer align the body of their first buffer and
+ * read the second one with `merge_words()` if it is aligned differently.
+ *
+ * @param[in] ptr The memory function's first buffer argument. Cannot be NULL.
+ * @param[in] len The length in bytes of `ptr`.
  * @param[out] out_body_offset The start of the body region.
  * @param[out] out_tail_offset The start of the tail region.
  */
-static void compute_alignment(const void *left, const void *right, size_t len,
+static void compute_alignment(const void *ptr, size_t len,
                               size_t *out_body_offset,
                               size_t *out_tail_offset) {
-  const size_t num_leading_bytes = compute_num_leading_bytes(left, right, len);
+  const size_t num_leading_bytes = compute_num_leading_bytes(ptr, len);
   *out_body_offset = num_leading_bytes;
 
   const size_t num_words = (len - num_leading_bytes) / sizeof(uint32_t);
   *out_tail_offset = num_leading_bytes + num_words * sizeof(uint32_t);
 }
 
+/**
+ * Extract a misaligned word from two consecutive aligned words.
+ *
+ * @param lo The aligned word containing the first byte of the result.
+ * @param hi The aligned word following `lo`.
+ * @param shift The misalignment of the result in bits; 8, 16 or 24.
+ * @return The word starting `shift / 8` bytes into `lo`.
+ */
+static inline uint32_t merge_words(uint32_t lo, uint32_t hi, uint32_t shift) {
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "merge_words assumes that the system is little endian.");
+  return lo >> shift | hi << (32 - shift);
+}
+
+/**
+ * Load an aligned word that holds at least one byte of a buffer.
+ *
+ * When the buffers of `memcpy()`, `memcmp()` and `memrcmp()` are aligned
+ * differently, the second one is read in aligned words that may extend past
+ * either end of the buffer. Such a read cannot fault, but ASan flags it, so it
+ * is exempt from instrumentation.
+ */
+__attribute__((no_sanitize("address"))) static inline uint32_t
+read_32_straddling(const unsigned char *ptr) {
+  // Same as `read_32()`, which would be instrumented when not inlined.
+  ptr = __builtin_assume_aligned(ptr, alignof(uint32_t));
+  uint32_t val;
+  __builtin_memcpy(&val, ptr, sizeof(uint32_t));
+  return val;
+}
+
 static uint32_t repeat_byte_to_u32(uint8_t byte) {
   return byte << 24 | byte << 16 | byte << 8 | byte;
 }
@@ -64,14 +91,49 @@ void *OT_PREFIX_IF_NOT_RV32(memcpy)(void *restrict dest,
   unsigned char *dest8 = (unsigned char *)dest;
   const unsigned char *src8 = (const unsigned char *)src;
   size_t body_offset, tail_offset;
-  compute_alignment(dest, src, len, &body_offset, &tail_offset);
+  compute_alignment(dest, len, &body_offset, &tail_offset);
   size_t i = 0;
   for (; i < body_offset; ++i) {
     dest8[i] = src8[i];
   }
-  for (; i < tail_offset; i += sizeof(uint32_t)) {
-    uint32_t word = read_32(&src8[i]);
-    write_32(word, &dest8[i]);
+  const uint32_t shift = misalignment32_of((uintptr_t)&src8[i]) * 8;
+  if (shift == 0) {
+    for (; i + 4 * sizeof(uint32_t) <= tail_offset;
+         i += 4 * sizeof(uint32_t)) {
+      uint32_t word0 = read_32(&src8[i]);
+      uint32_t word1 = read_32(&src8[i + 4]);
+      uint32_t word2 = read_32(&src8[i + 8]);
+      uint32_t word3 = read_32(&src8[i + 12]);
+      write_32(word0, &dest8[i]);
+      write_32(word1, &dest8[i + 4]);
+      write_32(word2, &dest8[i + 8]);
+      write_32(word3, &dest8[i + 12]);
+    }
+    for (; i < tail_offset; i += sizeof(uint32_t)) {
+      write_32(read_32(&src8[i]), &dest8[i]);
+    }
+  } else if (i < tail_offset) {
+    // Read `src` in aligned words and shift each destination word together
+    // from two of them. Every word read contains at least one source byte.
+    const unsigned char *src_word = &src8[i] - shift / 8;
+    uint32_t lo = read_32_straddling(src_word);
+    for (; i + 4 * sizeof(uint32_t) <= tail_offset;
+         i += 4 * sizeof(uint32_t), src_word += 4 * sizeof(uint32_t)) {
+      uint32_t word1 = read_32_straddling(src_word + 4);
+      uint32_t word2 = read_32_straddling(src_word + 8);
+      uint32_t word3 = read_32_straddling(src_word + 12);
+      uint32_t word4 = read_32_straddling(src_word + 16);
+      write_32(merge_words(lo, word1, shift), &dest8[i]);
+      write_32(merge_words(word1, word2, shift), &dest8[i + 4]);
+      write_32(merge_words(word2, word3, shift), &dest8[i + 8]);
+      write_32(merge_words(word3, word4, shift), &dest8[i + 12]);
+      lo = word4;
+    }
+    for (; i < tail_offset; i += sizeof(uint32_t), src_word += 4) {
+      uint32_t hi = read_32_straddling(src_word + 4);
+      write_32(merge_words(lo, hi, shift), &dest8[i]);
+      lo = hi;
+    }
   }
   for (; i < len; ++i) {
     dest8[i] = src8[i];
@@ -84,12 +146,18 @@ void *OT_PREFIX_IF_NOT_RV32(memset)(void *dest, int value, size_t len) {
   const uint8_t value8 = (uint8_t)value;
 
   size_t body_offset, tail_offset;
-  compute_alignment(dest, NULL, len, &body_offset, &tail_offset);
+  compute_alignment(dest, len, &body_offset, &tail_offset);
   size_t i = 0;
   for (; i < body_offset; ++i) {
     dest8[i] = value8;
   }
   const uint32_t value32 = repeat_byte_to_u32(value8);
+  for (; i + 4 * sizeof(uint32_t) <= tail_offset; i += 4 * sizeof(uint32_t)) {
+    write_32(value32, &dest8[i]);
+    write_32(value32, &dest8[i + 4]);
+    write_32(value32, &dest8[i + 8]);
+    write_32(value32, &dest8[i + 12]);
+  }
   for (; i < tail_offset; i += sizeof(uint32_t)) {
     write_32(value32, &dest8[i]);
   }
@@ -105,36 +173,66 @@ enum {
   kMemCmpGt = 42,
 };
 
+static int compare_bytes(uint8_t lhs, uint8_t rhs) {
+  if (lhs < rhs) {
+    return kMemCmpLt;
+  } else if (lhs > rhs) {
+    return kMemCmpGt;
+  }
+  return kMemCmpEq;
+}
+
+/**
+ * Compare two words that differ, interpreting the most significant byte as
+ * the first one.
+ */
+static int compare_words(uint32_t lhs, uint32_t rhs) {
+  return lhs < rhs ? kMemCmpLt : kMemCmpGt;
+}
+
 int OT_PREFIX_IF_NOT_RV32(memcmp)(const void *lhs, const void *rhs,
                                   size_t len) {
   const unsigned char *lhs8 = (const unsigned char *)lhs;
   const unsigned char *rhs8 = (const unsigned char *)rhs;
   size_t body_offset, tail_offset;
-  compute_alignment(lhs, rhs, len, &body_offset, &tail_offset);
+  compute_alignment(lhs, len, &body_offset, &tail_offset);
   size_t i = 0;
   for (; i < body_offset; ++i) {
-    if (lhs8[i] < rhs8[i]) {
-      return kMemCmpLt;
-    } else if (lhs8[i] > rhs8[i]) {
-      return kMemCmpGt;
+    int result = compare_bytes(lhs8[i], rhs8[i]);
+    if (result != kMemCmpEq) {
+      return result;
     }
   }
-  for (; i < tail_offset; i += sizeof(uint32_t)) {
-    uint32_t word_left = __builtin_bswap32(read_32(&lhs8[i]));
-    uint32_t word_right = __builtin_bswap32(read_32(&rhs8[i]));
-    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
-                  "memcmp assumes that the system is little endian.");
-    if (word_left < word_right) {
-      return kMemCmpLt;
-    } else if (word_left > word_right) {
-      return kMemCmpGt;
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "memcmp assumes that the system is little endian.");
+  const uint32_t shift = misalignment32_of((uintptr_t)&rhs8[i]) * 8;
+  if (shift == 0) {
+    for (; i < tail_offset; i += sizeof(uint32_t)) {
+      uint32_t word_left = read_32(&lhs8[i]);
+      uint32_t word_right = read_32(&rhs8[i]);
+      if (word_left != word_right) {
+        return compare_words(__builtin_bswap32(word_left),
+                             __builtin_bswap32(word_right));
+      }
+    }
+  } else if (i < tail_offset) {
+    const unsigned char *rhs_word = &rhs8[i] - shift / 8;
+    uint32_t lo = read_32_straddling(rhs_word);
+    for (; i < tail_offset; i += sizeof(uint32_t), rhs_word += 4) {
+      uint32_t hi = read_32_straddling(rhs_word + 4);
+      uint32_t word_left = read_32(&lhs8[i]);
+      uint32_t word_right = merge_words(lo, hi, shift);
+      if (word_left != word_right) {
+        return compare_words(__builtin_bswap32(word_left),
+                             __builtin_bswap32(word_right));
+      }
+      lo = hi;
     }
   }
   for (; i < len; ++i) {
-    if (lhs8[i] < rhs8[i]) {
-      return kMemCmpLt;
-    } else if (lhs8[i] > rhs8[i]) {
-      return kMemCmpGt;
+    int result = compare_bytes(lhs8[i], rhs8[i]);
+    if (result != kMemCmpEq) {
+      return result;
     }
   }
   return kMemCmpEq;
@@ -144,34 +242,46 @@ int memrcmp(const void *lhs, const void *rhs, size_t len) {
   const unsigned char *lhs8 = (const unsigned char *)lhs;
   const unsigned char *rhs8 = (const unsigned char *)rhs;
   size_t body_offset, tail_offset;
-  compute_alignment(lhs, rhs, len, &body_offset, &tail_offset);
+  compute_alignment(lhs, len, &body_offset, &tail_offset);
   size_t end = len;
   for (; end > tail_offset; --end) {
-    const size_t i = end - 1;
-    if (lhs8[i] < rhs8[i]) {
-      return kMemCmpLt;
-    } else if (lhs8[i] > rhs8[i]) {
-      return kMemCmpGt;
+    int result = compare_bytes(lhs8[end - 1], rhs8[end - 1]);
+    if (result != kMemCmpEq) {
+      return result;
     }
   }
-  for (; end > body_offset; end -= sizeof(uint32_t)) {
-    const size_t i = end - sizeof(uint32_t);
-    uint32_t word_left = read_32(&lhs8[i]);
-    uint32_t word_right = read_32(&rhs8[i]);
-    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
-                  "memrcmp assumes that the system is little endian.");
-    if (word_left < word_right) {
-      return kMemCmpLt;
-    } else if (word_left > word_right) {
-      return kMemCmpGt;
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                "memrcmp assumes that the system is little endian.");
+  const uint32_t shift = misalignment32_of((uintptr_t)&rhs8[end]) * 8;
+  if (shift == 0) {
+    for (; end > body_offset; end -= sizeof(uint32_t)) {
+      const size_t i = end - sizeof(uint32_t);
+      uint32_t word_left = read_32(&lhs8[i]);
+      uint32_t word_right = read_32(&rhs8[i]);
+      if (word_left != word_right) {
+        return compare_words(word_left, word_right);
+      }
+    }
+  } else if (end > body_offset) {
+    // Walk `rhs` backwards in aligned words, `hi` being the one that contains
+    // the last byte of the current word.
+    const unsigned char *rhs_word = &rhs8[end] - shift / 8;
+    uint32_t hi = read_32_straddling(rhs_word);
+    for (; end > body_offset; end -= sizeof(uint32_t), rhs_word -= 4) {
+      const size_t i = end - sizeof(uint32_t);
+      uint32_t lo = read_32_straddling(rhs_word - 4);
+      uint32_t word_left = read_32(&lhs8[i]);
+      uint32_t word_right = merge_words(lo, hi, shift);
+      if (word_left != word_right) {
+        return compare_words(word_left, word_right);
+      }
+      hi = lo;
     }
   }
   for (; end > 0; --end) {
-    const size_t i = end - 1;
-    if (lhs8[i] < rhs8[i]) {
-      return kMemCmpLt;
-    } else if (lhs8[i] > rhs8[i]) {
-      return kMemCmpGt;
+    int result = compare_bytes(lhs8[end - 1], rhs8[end - 1]);
+    if (result != kMemCmpEq) {
+      return result;
     }
   }
   return kMemCmpEq;
@@ -182,7 +292,7 @@ void *OT_PREFIX_IF_NOT_RV32(memchr)(const void *ptr, int value, size_t len) {
   const uint8_t value8 = (uint8_t)value;
 
   size_t body_offset, tail_offset;
-  compute_alignment(ptr, NULL, len, &body_offset, &tail_offset);
+  compute_alignment(ptr, len, &body_offset, &tail_offset);
   size_t i = 0;
   for (; i < body_offset; ++i) {
     if (ptr8[i] == value8) {
@@ -221,7 +331,7 @@ void *OT_PREFIX_IF_NOT_RV32(memrchr)(const void *ptr, int value, size_t len) {
   const uint8_t value8 = (uint8_t)value;
 
   size_t body_offset, tail_offset;
-  compute_alignment(ptr, NULL, len, &body_offset, &tail_offset);
+  compute_alignment(ptr, len, &body_offset, &tail_offset);
 
   size_t end = len;
   for (; end > tail_offset; --end) {
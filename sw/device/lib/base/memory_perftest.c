@@ -8,14 +8,19 @@
 
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
-#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/testing/test_framework/ottf_perf.h"
 
 enum {
   kBufLen = 1000,
   kNumRuns = 10,
+  // Maximum ratio of the cycle counts of a misaligned test and its aligned
+  // counterpart. Going through `merge_words()` makes a word loop about 1.5
+  // times slower, while falling back to a byte loop makes it 4 to 6 times
+  // slower.
+  kMaxMisalignedSlowdown = 3,
 };
 
 typedef struct perf_test {
@@ -32,39 +37,38 @@ typedef struct perf_test {
   // measured.
   void (*func)(uint8_t *buf1, uint8_t *buf2, size_t num_runs);
 
-  // The expected number of CPU cycles that `func` will take to run.
+  // The expected number of CPU cycles that `func` will take to run, or zero if
+  // there is no absolute expectation for this test.
   size_t expected_num_cycles;
+
+  // For a test that runs a function on misaligned buffers, the `func` of the
+  // test that runs it on aligned buffers with the same setup functions, or
+  // NULL. That test must come earlier in `perf_tests`.
+  void (*aligned_func)(uint8_t *buf1, uint8_t *buf2, size_t num_runs);
+
+  // Accumulates the performance counters of `func` over all runs, which the
+  // OTTF reports when the test finishes.
+  ottf_perf_region_t region;
 } perf_test_t;
 
 // Run the given `perf_test_t` and return the number of cycles it took.
-static inline uint64_t perf_test_run(const perf_test_t *test, uint8_t *buf1,
+static inline uint64_t perf_test_run(perf_test_t *test, uint8_t *buf1,
                                      uint8_t *buf2, size_t num_runs) {
   CHECK(test->setup_buf1 != NULL);
   CHECK(test->setup_buf2 != NULL);
   CHECK(test->func != NULL);
 
-  uint64_t total_clock_cycles = 0;
   for (size_t i = 0; i < num_runs; ++i) {
     test->setup_buf1(buf1, kBufLen);
     test->setup_buf2(buf2, kBufLen);
 
-    uint64_t start_cycles = ibex_mcycle_read();
+    ottf_perf_begin(&test->region);
     test->func(buf1, buf2, kBufLen);
-    uint64_t end_cycles = ibex_mcycle_read();
-
-    // Even if the 64-bit cycle counter overflowed while running the test, the
-    // following subtraction would still be well-defined and correct, provided
-    // that the test ran in fewer than 2**64 cycles. Practically, we should
-    // never see it overflow. Even if it took 12 hours to run all the perf
-    // tests, the clock would have to run at 427 THz to overflow the counter
-    // (2**64 cycles / (12 * 60 * 60) seconds).
-    const uint64_t num_cycles = end_cycles - start_cycles;
-
-    CHECK(total_clock_cycles < UINT64_MAX - num_cycles);
-    total_clock_cycles += num_cycles;
+    ottf_perf_end(&test->region);
   }
 
-  return total_clock_cycles;
+  // Each test runs exactly once, so its region holds only these runs.
+  return ottf_perf_total(&test->region, kOttfPerfCounterCycles);
 }
 
 // Fill the buffer with arbitrary, but deterministically-selected bytes.
@@ -110,6 +114,72 @@ OT_NOINLINE void test_memrcmp(uint8_t *buf1, uint8_t *buf2, size_t len) {
   memrcmp(buf1, buf2, len);
 }
 
+// The following functions operate on `len - 3` bytes at various offsets into
+// the buffers so that every alignment of the two buffers is measured.
+#define DEFINE_MISALIGNED_TEST(func_, offset1_, offset2_)  \
+  OT_NOINLINE void test_##func_##_##offset1_##_##offset2_( \
+      uint8_t *buf1, uint8_t *buf2, size_t len) {          \
+    func_(&buf1[offset1_], &buf2[offset2_], len - 3);      \
+  }
+
+DEFINE_MISALIGNED_TEST(memcpy, 0, 1)
+DEFINE_MISALIGNED_TEST(memcpy, 0, 2)
+DEFINE_MISALIGNED_TEST(memcpy, 0, 3)
+DEFINE_MISALIGNED_TEST(memcpy, 1, 0)
+DEFINE_MISALIGNED_TEST(memcpy, 1, 1)
+DEFINE_MISALIGNED_TEST(memcpy, 1, 2)
+DEFINE_MISALIGNED_TEST(memcpy, 1, 3)
+DEFINE_MISALIGNED_TEST(memcpy, 2, 0)
+DEFINE_MISALIGNED_TEST(memcpy, 2, 1)
+DEFINE_MISALIGNED_TEST(memcpy, 2, 2)
+DEFINE_MISALIGNED_TEST(memcpy, 2, 3)
+DEFINE_MISALIGNED_TEST(memcpy, 3, 0)
+DEFINE_MISALIGNED_TEST(memcpy, 3, 1)
+DEFINE_MISALIGNED_TEST(memcpy, 3, 2)
+DEFINE_MISALIGNED_TEST(memcpy, 3, 3)
+DEFINE_MISALIGNED_TEST(memcmp, 0, 1)
+DEFINE_MISALIGNED_TEST(memcmp, 0, 2)
+DEFINE_MISALIGNED_TEST(memcmp, 0, 3)
+DEFINE_MISALIGNED_TEST(memcmp, 1, 0)
+DEFINE_MISALIGNED_TEST(memcmp, 1, 1)
+DEFINE_MISALIGNED_TEST(memcmp, 1, 2)
+DEFINE_MISALIGNED_TEST(memcmp, 1, 3)
+DEFINE_MISALIGNED_TEST(memcmp, 2, 0)
+DEFINE_MISALIGNED_TEST(memcmp, 2, 1)
+DEFINE_MISALIGNED_TEST(memcmp, 2, 2)
+DEFINE_MISALIGNED_TEST(memcmp, 2, 3)
+DEFINE_MISALIGNED_TEST(memcmp, 3, 0)
+DEFINE_MISALIGNED_TEST(memcmp, 3, 1)
+DEFINE_MISALIGNED_TEST(memcmp, 3, 2)
+DEFINE_MISALIGNED_TEST(memcmp, 3, 3)
+DEFINE_MISALIGNED_TEST(memrcmp, 0, 1)
+DEFINE_MISALIGNED_TEST(memrcmp, 0, 2)
+DEFINE_MISALIGNED_TEST(memrcmp, 0, 3)
+DEFINE_MISALIGNED_TEST(memrcmp, 1, 0)
+DEFINE_MISALIGNED_TEST(memrcmp, 1, 1)
+DEFINE_MISALIGNED_TEST(memrcmp, 1, 2)
+DEFINE_MISALIGNED_TEST(memrcmp, 1, 3)
+DEFINE_MISALIGNED_TEST(memrcmp, 2, 0)
+DEFINE_MISALIGNED_TEST(memrcmp, 2, 1)
+DEFINE_MISALIGNED_TEST(memrcmp, 2, 2)
+DEFINE_MISALIGNED_TEST(memrcmp, 2, 3)
+DEFINE_MISALIGNED_TEST(memrcmp, 3, 0)
+DEFINE_MISALIGNED_TEST(memrcmp, 3, 1)
+DEFINE_MISALIGNED_TEST(memrcmp, 3, 2)
+DEFINE_MISALIGNED_TEST(memrcmp, 3, 3)
+
+// Likewise, `memset()` is measured at every alignment of its buffer.
+#define DEFINE_MISALIGNED_MEMSET_TEST(offset_)                         \
+  OT_NOINLINE void test_memset_##offset_(uint8_t *buf1, uint8_t *buf2, \
+                                         size_t len) {                 \
+    const int value = buf2[0];                                         \
+    memset(&buf1[offset_], value, len - 3);                            \
+  }
+
+DEFINE_MISALIGNED_MEMSET_TEST(1)
+DEFINE_MISALIGNED_MEMSET_TEST(2)
+DEFINE_MISALIGNED_MEMSET_TEST(3)
+
 OT_NOINLINE void test_memchr(uint8_t *buf1, uint8_t *buf2, size_t len) {
   const uint8_t value = buf1[len - 1];
   memchr(buf1, value, len);
@@ -122,8 +192,8 @@ OT_NOINLINE void test_memrchr(uint8_t *buf1, uint8_t *buf2, size_t len) {
 
 OTTF_DEFINE_TEST_CONFIG();
 
-// Each value of `expected_num_cycles` was determined experimentally by
-// testing on a CW310 FPGA with the following command:
+// Each value of `expected_num_cycles` was determined experimentally by testing
+// on a CW310 FPGA with the following command:
 //
 //   $ ./bazelisk.sh test --copt -O2 --test_output=all \
 //       //sw/device/lib/base:memory_perftest_fpga_cw310
@@ -141,14 +211,36 @@ OTTF_DEFINE_TEST_CONFIG();
 //   (5) The icache gets turned on prior to test execution.
 //
 // If you observe the cycle count is smaller the hardcoded expectation, that's
-// probably a good thing; please update the expectation!
-static const perf_test_t kPerfTests[] = {
+// probably a good thing; please update the expectation! A test only fails if
+// it takes more cycles than expected.
+//
+// The expectations for memcpy, memset, memcmp and memrcmp were measured before
+// these functions were made to copy and compare word-wise at any alignment, so
+// they are upper bounds until they are measured again.
+//
+// The misaligned tests have no absolute expectation. Instead, each of them
+// fails if it takes more than `kMaxMisalignedSlowdown` times the cycles of the
+// aligned test of the same function.
+#define MISALIGNED_PERF_TEST(func_, offset1_, offset2_, setup_)          \
+  {                                                                      \
+    .label = #func_ "_misaligned_" #offset1_ "_" #offset2_,              \
+    .setup_buf1 = &setup_,                                               \
+    .setup_buf2 = &setup_,                                               \
+    .func = &test_##func_##_##offset1_##_##offset2_,                     \
+    .expected_num_cycles = 0,                                            \
+    .aligned_func = &test_##func_,                                       \
+    .region =                                                            \
+        OTTF_PERF_REGION(#func_ "_misaligned_" #offset1_ "_" #offset2_), \
+  }
+
+static perf_test_t perf_tests[] = {
     {
         .label = "memcpy",
         .setup_buf1 = &fill_buf_deterministic_values,
         .setup_buf2 = &fill_buf_deterministic_values,
         .func = &test_memcpy,
         .expected_num_cycles = 33270,
+        .region = OTTF_PERF_REGION("memcpy"),
     },
     {
         .label = "memcpy_zeroes",
@@ -156,6 +248,7 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memcpy,
         .expected_num_cycles = 33270,
+        .region = OTTF_PERF_REGION("memcpy_zeroes"),
     },
     {
         .label = "memset",
@@ -163,6 +256,7 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_deterministic_values,
         .func = &test_memset,
         .expected_num_cycles = 23200,
+        .region = OTTF_PERF_REGION("memset"),
     },
     {
         .label = "memset_zeroes",
@@ -170,6 +264,7 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memset,
         .expected_num_cycles = 23200,
+        .region = OTTF_PERF_REGION("memset_zeroes"),
     },
     {
         .label = "memcmp_pathological",
@@ -177,6 +272,7 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memcmp,
         .expected_num_cycles = 110740,
+        .region = OTTF_PERF_REGION("memcmp_pathological"),
     },
     {
         .label = "memcmp_zeroes",
@@ -184,6 +280,7 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memcmp,
         .expected_num_cycles = 110740,
+        .region = OTTF_PERF_REGION("memcmp_zeroes"),
     },
     {
         .label = "memrcmp_pathological",
@@ -191,6 +288,7 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_one_then_zeroes,
         .func = &test_memrcmp,
         .expected_num_cycles = 50740,
+        .region = OTTF_PERF_REGION("memrcmp_pathological"),
     },
     {
         .label = "memrcmp_zeroes",
@@ -198,13 +296,87 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memrcmp,
         .expected_num_cycles = 50850,
+        .region = OTTF_PERF_REGION("memrcmp_zeroes"),
+    },
+    {
+        .label = "memset_misaligned_1",
+        .setup_buf1 = &fill_buf_zeroes,
+        .setup_buf2 = &fill_buf_deterministic_values,
+        .func = &test_memset_1,
+        .expected_num_cycles = 0,
+        .aligned_func = &test_memset,
+        .region = OTTF_PERF_REGION("memset_misaligned_1"),
     },
+    {
+        .label = "memset_misaligned_2",
+        .setup_buf1 = &fill_buf_zeroes,
+        .setup_buf2 = &fill_buf_deterministic_values,
+        .func = &test_memset_2,
+        .expected_num_cycles = 0,
+        .aligned_func = &test_memset,
+        .region = OTTF_PERF_REGION("memset_misaligned_2"),
+    },
+    {
+        .label = "memset_misaligned_3",
+        .setup_buf1 = &fill_buf_zeroes,
+        .setup_buf2 = &fill_buf_deterministic_values,
+        .func = &test_memset_3,
+        .expected_num_cycles = 0,
+        .aligned_func = &test_memset,
+        .region = OTTF_PERF_REGION("memset_misaligned_3"),
+    },
+    MISALIGNED_PERF_TEST(memcpy, 0, 1, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 0, 2, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 0, 3, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 1, 0, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 1, 1, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 1, 2, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 1, 3, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 2, 0, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 2, 1, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 2, 2, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 2, 3, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 3, 0, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 3, 1, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 3, 2, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcpy, 3, 3, fill_buf_deterministic_values),
+    MISALIGNED_PERF_TEST(memcmp, 0, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 0, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 0, 3, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 1, 0, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 1, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 1, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 1, 3, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 2, 0, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 2, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 2, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 2, 3, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 3, 0, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 3, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 3, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memcmp, 3, 3, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 0, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 0, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 0, 3, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 1, 0, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 1, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 1, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 1, 3, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 2, 0, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 2, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 2, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 2, 3, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 3, 0, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 3, 1, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 3, 2, fill_buf_zeroes),
+    MISALIGNED_PERF_TEST(memrcmp, 3, 3, fill_buf_zeroes),
     {
         .label = "memchr_pathological",
         .setup_buf1 = &fill_buf_deterministic_values,
         .setup_buf2 = &fill_buf_zeroes,
         .func = &test_memchr,
         .expected_num_cycles = 7250,
+        .region = OTTF_PERF_REGION("memchr_pathological"),
     },
     {
         .label = "memrchr_pathological",
@@ -212,38 +384,80 @@ static const perf_test_t kPerfTests[] = {
         .setup_buf2 = &fill_buf_deterministic_values,
         .func = &test_memrchr,
         .expected_num_cycles = 23850,
+        .region = OTTF_PERF_REGION("memrchr_pathological"),
     },
 };
 
 static uint8_t buf1[kBufLen];
 static uint8_t buf2[kBufLen];
 
+// Find the aligned counterpart of a misaligned test, see `aligned_func`.
+static const perf_test_t *find_aligned_test(const perf_test_t *test) {
+  for (const perf_test_t *other = perf_tests; other < test; ++other) {
+    if (other->func == test->aligned_func &&
+        other->setup_buf1 == test->setup_buf1 &&
+        other->setup_buf2 == test->setup_buf2) {
+      return other;
+    }
+  }
+  CHECK(false, "%s: no aligned test", test->label);
+  return NULL;
+}
+
 bool test_main(void) {
   bool all_expectations_match = true;
-  for (size_t i = 0; i < ARRAYSIZE(kPerfTests); ++i) {
-    const perf_test_t *test = &kPerfTests[i];
+  for (size_t i = 0; i < ARRAYSIZE(perf_tests); ++i) {
+    perf_test_t *test = &perf_tests[i];
 
     const uint64_t num_cycles = perf_test_run(test, buf1, buf2, kNumRuns);
-    if (num_cycles != test->expected_num_cycles) {
-      all_expectations_match = false;
-      // Cast cycle counts to `uint32_t` before printing because `base_printf()`
-      // cannot print `uint64_t`.
+    // Cast cycle counts to `uint32_t` before printing because `base_printf()`
+    // cannot print `uint64_t`.
+    CHECK(num_cycles < UINT32_MAX / 100);
+    const uint32_t num_cycles_u32 = (uint32_t)num_cycles;
+
+    if (test->aligned_func != NULL) {
+      const perf_test_t *aligned = find_aligned_test(test);
+      const uint32_t aligned_num_cycles_u32 =
+          (uint32_t)ottf_perf_total(&aligned->region, kOttfPerfCounterCycles);
+      CHECK(aligned_num_cycles_u32 > 0);
+      const uint32_t percent_change =
+          (100 * num_cycles_u32) / aligned_num_cycles_u32;
+      if (num_cycles_u32 > kMaxMisalignedSlowdown * aligned_num_cycles_u32) {
+        all_expectations_match = false;
+        LOG_WARNING(
+            "%s:\n"
+            "  Aligned:         %10d cycles (%s)\n"
+            "  Actual:          %10d cycles\n"
+            "  Actual/Aligned:  %10d%%\n",
+            test->label, aligned_num_cycles_u32, aligned->label,
+            num_cycles_u32, percent_change);
+      } else {
+        LOG_INFO("%s: %d cycles, %d%% of %s", test->label, num_cycles_u32,
+                 percent_change, aligned->label);
+      }
+    }
+
+    if (test->expected_num_cycles != 0 &&
+        num_cycles != test->expected_num_cycles) {
       CHECK(test->expected_num_cycles < UINT32_MAX);
-      CHECK(num_cycles < UINT32_MAX);
       const uint32_t expected_num_cycles_u32 =
           (uint32_t)test->expected_num_cycles;
-      const uint32_t num_cycles_u32 = (uint32_t)num_cycles;
-
-      CHECK(num_cycles < UINT32_MAX / 100);
       const uint32_t percent_change =
           (100 * num_cycles_u32) / expected_num_cycles_u32;
 
-      LOG_WARNING(
-          "%s:\n"
-          "  Expected:        %10d cycles\n"
-          "  Actual:          %10d cycles\n"
-          "  Actual/Expected: %10d%%\n",
-          test->label, expected_num_cycles_u32, num_cycles_u32, percent_change);
+      if (num_cycles > test->expected_num_cycles) {
+        all_expectations_match = false;
+        LOG_WARNING(
+            "%s:\n"
+            "  Expected:        %10d cycles\n"
+            "  Actual:          %10d cycles\n"
+            "  Actual/Expected: %10d%%\n",
+            test->label, expected_num_cycles_u32, num_cycles_u32,
+            percent_change);
+      } else {
+        LOG_INFO("%s: %d cycles, %d%% of the expectation; please update it",
+                 test->label, num_cycles_u32, percent_change);
+      }
     }
   }
   return all_expectations_match;
@@ -178,6 +178,64 @@ TEST_P(MemCpyTest, VaryDestAlignment) {
   }
 }
 
+TEST_P(MemCpyTest, AllAlignments) {
+  auto memcpy_func = GetParam();
+
+  static constexpr size_t kMaxLen = 40;
+  static constexpr uint8_t kGuard = 0xaa;
+  alignas(uint32_t) uint8_t src[kMaxLen + 4];
+  for (size_t i = 0; i < sizeof(src); ++i) {
+    src[i] = static_cast<uint8_t>(i * 7 + 1);
+  }
+
+  for (size_t dest_offset = 0; dest_offset < 4; ++dest_offset) {
+    for (size_t src_offset = 0; src_offset < 4; ++src_offset) {
+      for (size_t len = 0; len <= kMaxLen; ++len) {
+        SCOPED_TRACE(testing::Message() << "dest_offset=" << dest_offset
+                                        << " src_offset=" << src_offset
+                                        << " len=" << len);
+        alignas(uint32_t) uint8_t dest[kMaxLen + 8];
+        std::fill(std::begin(dest), std::end(dest), kGuard);
+        memcpy_func(&dest[dest_offset], &src[src_offset], len);
+
+        std::vector<uint8_t> expected(sizeof(dest), kGuard);
+        std::copy_n(&src[src_offset], len, &expected[dest_offset]);
+        EXPECT_THAT(dest, ::testing::ElementsAreArray(expected));
+      }
+    }
+  }
+}
+
+TEST_P(MemCmpTest, AllAlignmentsSingleDifference) {
+  auto memcmp_func = GetParam();
+
+  static constexpr size_t kMaxLen = 24;
+  alignas(uint32_t) uint8_t lhs[kMaxLen + 4];
+  alignas(uint32_t) uint8_t rhs[kMaxLen + 4];
+
+  for (size_t lhs_offset = 0; lhs_offset < 4; ++lhs_offset) {
+    for (size_t rhs_offset = 0; rhs_offset < 4; ++rhs_offset) {
+      for (size_t len = 0; len <= kMaxLen; ++len) {
+        for (size_t i = 0; i < len; ++i) {
+          lhs[lhs_offset + i] = static_cast<uint8_t>(i * 7 % 200);
+          rhs[rhs_offset + i] = static_cast<uint8_t>(i * 7 % 200);
+        }
+        EXPECT_EQ(memcmp_func(&lhs[lhs_offset], &rhs[rhs_offset], len), 0);
+
+        for (size_t diff = 0; diff < len; ++diff) {
+          SCOPED_TRACE(testing::Message()
+                       << "lhs_offset=" << lhs_offset << " rhs_offset="
+                       << rhs_offset << " len=" << len << " diff=" << diff);
+          ++rhs[rhs_offset + diff];
+          EXPECT_LT(memcmp_func(&lhs[lhs_offset], &rhs[rhs_offset], len), 0);
+          EXPECT_GT(memcmp_func(&rhs[rhs_offset], &lhs[lhs_offset], len), 0);
+          --rhs[rhs_offset + diff];
+        }
+      }
+    }
+  }
+}
+
 TEST_P(MemCmpTest, NullParam) {
   auto memcmp_func = GetParam();
 
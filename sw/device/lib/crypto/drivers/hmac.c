@@ -41,20 +41,16 @@ hmac_error_t hmac_sha256_update(const void *data, size_t len) {
   }
   const uint8_t *data_sent = (const uint8_t *)data;
 
-  // Individual byte writes are needed if the buffer isn't word aligned.
-  for (; len != 0 && (uintptr_t)data_sent & 3; --len) {
-    abs_mmio_write8(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
-                    *data_sent++);
-  }
-
+  // Send full words regardless of the alignment of `data`; `read_32` assembles
+  // unaligned words in registers, so byte writes are only needed for the
+  // trailing bytes.
   for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
-    uint32_t data_aligned = read_32(data_sent);
     abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
-                     data_aligned);
+                     read_32(data_sent));
     data_sent += sizeof(uint32_t);
   }
 
-  // Handle non-32bit aligned bytes at the end of the buffer.
+  // Handle the remaining bytes at the end of the buffer.
   for (; len != 0; --len) {
     abs_mmio_write8(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
                     *data_sent++);
@@ -87,3 +83,161 @@ hmac_error_t hmac_sha256_final(hmac_digest_t *digest) {
   }
   return kHmacOk;
 }
+
+/**
+ * SHA-256 round constants (FIPS 180-4, section 4.2.2).
+ */
+static const uint32_t kSha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/**
+ * SHA-256 initial hash value (FIPS 180-4, section 5.3.3).
+ */
+static const uint32_t kSha256InitialHash[kHmacDigestNumWords] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+static inline uint32_t rotr32(uint32_t x, uint32_t n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+/**
+ * Run the SHA-256 compression function on one message block.
+ *
+ * @param ctx Context whose intermediate hash is updated.
+ * @param block Message block; any alignment.
+ */
+static void sha256_compress(hmac_sha256_ctx_t *ctx, const uint8_t *block) {
+  uint32_t w[16];
+  for (size_t i = 0; i < ARRAYSIZE(w); ++i) {
+    w[i] = __builtin_bswap32(read_32(block + i * sizeof(uint32_t)));
+  }
+
+  uint32_t a = ctx->state[0];
+  uint32_t b = ctx->state[1];
+  uint32_t c = ctx->state[2];
+  uint32_t d = ctx->state[3];
+  uint32_t e = ctx->state[4];
+  uint32_t f = ctx->state[5];
+  uint32_t g = ctx->state[6];
+  uint32_t h = ctx->state[7];
+  for (size_t i = 0; i < ARRAYSIZE(kSha256RoundConstants); ++i) {
+    // The message schedule is kept in a 16-word circular buffer.
+    if (i >= 16) {
+      uint32_t w15 = w[(i - 15) % 16];
+      uint32_t w2 = w[(i - 2) % 16];
+      uint32_t s0 = rotr32(w15, 7) ^ rotr32(w15, 18) ^ (w15 >> 3);
+      uint32_t s1 = rotr32(w2, 17) ^ rotr32(w2, 19) ^ (w2 >> 10);
+      w[i % 16] += s0 + w[(i - 7) % 16] + s1;
+    }
+    uint32_t t1 = h + (rotr32(e, 6) ^ rotr32(e, 11) ^ rotr32(e, 25)) +
+                  ((e & f) ^ (~e & g)) + kSha256RoundConstants[i] + w[i % 16];
+    uint32_t t2 = (rotr32(a, 2) ^ rotr32(a, 13) ^ rotr32(a, 22)) +
+                  ((a & b) ^ (a & c) ^ (b & c));
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  ctx->state[0] += a;
+  ctx->state[1] += b;
+  ctx->state[2] += c;
+  ctx->state[3] += d;
+  ctx->state[4] += e;
+  ctx->state[5] += f;
+  ctx->state[6] += g;
+  ctx->state[7] += h;
+}
+
+void hmac_sha256_ctx_init(hmac_sha256_ctx_t *ctx) {
+  memcpy(ctx->state, kSha256InitialHash, sizeof(ctx->state));
+  ctx->partial_block_len = 0;
+  ctx->msg_len = 0;
+}
+
+hmac_error_t hmac_sha256_ctx_update(hmac_sha256_ctx_t *ctx, const void *data,
+                                    size_t len) {
+  if (ctx == NULL || (data == NULL && len != 0)) {
+    return kHmacErrorBadArg;
+  }
+  const uint8_t *data_bytes = (const uint8_t *)data;
+  ctx->msg_len += len;
+
+  // Complete a buffered partial block first.
+  if (ctx->partial_block_len != 0) {
+    size_t fill_len = kHmacSha256BlockNumBytes - ctx->partial_block_len;
+    if (fill_len > len) {
+      fill_len = len;
+    }
+    memcpy(ctx->partial_block + ctx->partial_block_len, data_bytes, fill_len);
+    ctx->partial_block_len += fill_len;
+    data_bytes += fill_len;
+    len -= fill_len;
+    if (ctx->partial_block_len < kHmacSha256BlockNumBytes) {
+      return kHmacOk;
+    }
+    sha256_compress(ctx, ctx->partial_block);
+    ctx->partial_block_len = 0;
+  }
+
+  // Compress full blocks directly from the input.
+  for (; len >= kHmacSha256BlockNumBytes; len -= kHmacSha256BlockNumBytes) {
+    sha256_compress(ctx, data_bytes);
+    data_bytes += kHmacSha256BlockNumBytes;
+  }
+
+  memcpy(ctx->partial_block, data_bytes, len);
+  ctx->partial_block_len = len;
+  return kHmacOk;
+}
+
+hmac_error_t hmac_sha256_ctx_final(hmac_sha256_ctx_t *ctx,
+                                   hmac_digest_t *digest) {
+  if (ctx == NULL || digest == NULL) {
+    return kHmacErrorBadArg;
+  }
+
+  // Append the padding: a one bit, zeroes, and the 64-bit big-endian message
+  // length in bits, so that the padded message fills a whole block.
+  uint64_t msg_len_bits = ctx->msg_len * 8;
+  ctx->partial_block[ctx->partial_block_len++] = 0x80;
+  if (ctx->partial_block_len > kHmacSha256BlockNumBytes - sizeof(uint64_t)) {
+    memset(ctx->partial_block + ctx->partial_block_len, 0,
+           kHmacSha256BlockNumBytes - ctx->partial_block_len);
+    sha256_compress(ctx, ctx->partial_block);
+    ctx->partial_block_len = 0;
+  }
+  memset(ctx->partial_block + ctx->partial_block_len, 0,
+         kHmacSha256BlockNumBytes - ctx->partial_block_len);
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    ctx->partial_block[kHmacSha256BlockNumBytes - 1 - i] =
+        (uint8_t)(msg_len_bits >> (8 * i));
+  }
+  sha256_compress(ctx, ctx->partial_block);
+
+  // Match the word order of `hmac_sha256_final`: the least significant word
+  // of the digest comes first.
+  for (size_t i = 0; i < ARRAYSIZE(digest->digest); ++i) {
+    digest->digest[i] = ctx->state[kHmacDigestNumWords - 1 - i];
+  }
+
+  // The context holds no secrets beyond the digest, but must not be reused.
+  hmac_sha256_ctx_init(ctx);
+  return kHmacOk;
+}
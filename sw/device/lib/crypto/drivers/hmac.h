@@ -20,6 +20,8 @@ enum {
   kHmacDigestNumBytes = kHmacDigestNumBits / 8,
   /* Number of words in an HMAC or SHA-256 digest. */
   kHmacDigestNumWords = kHmacDigestNumBytes / sizeof(uint32_t),
+  /* Number of bytes in a SHA-256 message block. */
+  kHmacSha256BlockNumBytes = 512 / 8,
 };
 
 /**
@@ -42,6 +44,36 @@ typedef struct hmac_digest {
   uint32_t digest[kHmacDigestNumWords];
 } hmac_digest_t;
 
+/**
+ * State of a suspendable SHA-256 stream.
+ *
+ * The HMAC block can only run one hash at a time, and its intermediate hash
+ * state can neither be read out nor loaded. Streams that need to be
+ * interleaved with other users of the HMAC block are therefore hashed in
+ * software with this context. The context is self-contained: saving a stream
+ * is copying the struct, and restoring it is continuing with the copy.
+ *
+ * The fields of this struct are private to the driver.
+ */
+typedef struct hmac_sha256_ctx {
+  /**
+   * Intermediate hash value, H0 first.
+   */
+  uint32_t state[kHmacDigestNumWords];
+  /**
+   * Buffered message bytes that do not fill a block yet.
+   */
+  uint8_t partial_block[kHmacSha256BlockNumBytes];
+  /**
+   * Number of valid bytes in `partial_block`.
+   */
+  size_t partial_block_len;
+  /**
+   * Total number of message bytes absorbed so far.
+   */
+  uint64_t msg_len;
+} hmac_sha256_ctx_t;
+
 /**
  * Initializes the HMAC in SHA256 mode.
  *
@@ -58,6 +90,10 @@ void hmac_sha256_init(void);
  * FIFO. Since the this function is meant to run in blocking mode,
  * polling for FIFO status is equivalent to stalling on FIFO write.
  *
+ * `data` may have any alignment: full words are assembled in registers and
+ * written with word writes, and only the last `len % 4` bytes are written
+ * individually.
+ *
  * @param data Buffer to copy data from.
  * @param len size of the `data` buffer in bytes.
  * @return The result of the operation.
@@ -76,6 +112,43 @@ hmac_error_t hmac_sha256_update(const void *data, size_t len);
 OT_WARN_UNUSED_RESULT
 hmac_error_t hmac_sha256_final(hmac_digest_t *digest);
 
+/**
+ * Starts a suspendable SHA-256 stream.
+ *
+ * Does not use the HMAC block, so any number of streams can be in flight at
+ * the same time, interleaved with each other and with the
+ * `hmac_sha256_init`/`update`/`final` stream running on the HMAC block.
+ *
+ * @param[out] ctx Context to initialize.
+ */
+void hmac_sha256_ctx_init(hmac_sha256_ctx_t *ctx);
+
+/**
+ * Absorbs `len` bytes from `data` into a suspendable SHA-256 stream.
+ *
+ * @param ctx Stream context.
+ * @param data Buffer to hash; any alignment.
+ * @param len size of the `data` buffer in bytes.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+hmac_error_t hmac_sha256_ctx_update(hmac_sha256_ctx_t *ctx, const void *data,
+                                    size_t len);
+
+/**
+ * Finalizes a suspendable SHA-256 stream and writes `digest` buffer.
+ *
+ * The digest has the same word order as the output of `hmac_sha256_final`.
+ * The context is reset to an empty stream afterwards.
+ *
+ * @param ctx Stream context.
+ * @param[out] digest Buffer to copy digest to.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+hmac_error_t hmac_sha256_ctx_final(hmac_sha256_ctx_t *ctx,
+                                   hmac_digest_t *digest);
+
 #ifdef __cplusplus
 }
 #endif
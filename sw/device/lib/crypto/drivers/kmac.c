@@ -36,6 +36,10 @@ enum {
   kKmacCfgAddr = kKmacBaseAddr + KMAC_CFG_SHADOWED_REG_OFFSET,
   kKmacKeyShare0Addr = kKmacBaseAddr + KMAC_KEY_SHARE0_0_REG_OFFSET,
   kKmacKeyShare1Addr = kKmacBaseAddr + KMAC_KEY_SHARE1_0_REG_OFFSET,
+  kKmacMsgFifoAddr = kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET,
+  // Capacity of the message FIFO in 32-bit words. The FIFO holds
+  // `kmac_pkg::MsgFifoDepth` = 10 entries of 64 bits each.
+  kKmacMsgFifoNumWords = 2 * 10,
 };
 
 OT_ASSERT_ENUM_VALUE(kKmacSecurityStrength128,
@@ -319,6 +323,171 @@ static kmac_error_t wait_status_bit(uint32_t bit_position, bool bit_value) {
   }
 }
 
+/**
+ * Message FIFO write state.
+ *
+ * Assembles the message into 32-bit words, so that unaligned input does not
+ * need byte-wise MMIO writes, and keeps track of the free space in the message
+ * FIFO so that the status register is polled once per burst rather than once
+ * per word.
+ */
+typedef struct kmac_msg_fifo {
+  /**
+   * Partially assembled word, in message byte order.
+   */
+  uint32_t partial_word;
+  /**
+   * Number of valid bytes in `partial_word`.
+   */
+  size_t partial_word_len;
+  /**
+   * Number of words that can be written without polling the status register.
+   */
+  size_t num_free_words;
+} kmac_msg_fifo_t;
+
+/**
+ * Wait until there is space in the message FIFO.
+ *
+ * Reads `STATUS.FIFO_DEPTH` and updates `fifo->num_free_words` accordingly.
+ * The depth is counted in 64-bit entries, so an entry that holds a single
+ * word is counted as full; writing to a full FIFO would only stall the bus,
+ * so this does not need to be exact.
+ *
+ * @param fifo Message FIFO write state.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static kmac_error_t msg_fifo_wait_space(kmac_msg_fifo_t *fifo) {
+  while (true) {
+    uint32_t reg = abs_mmio_read32(kKmacBaseAddr + KMAC_STATUS_REG_OFFSET);
+    if (bitfield_bit32_read(reg, KMAC_STATUS_ALERT_FATAL_FAULT_BIT) ||
+        bitfield_bit32_read(reg, KMAC_STATUS_ALERT_RECOV_CTRL_UPDATE_ERR_BIT)) {
+      return kKmacInternalError;
+    }
+    uint32_t depth = bitfield_field32_read(reg, KMAC_STATUS_FIFO_DEPTH_FIELD);
+    if (2 * depth < kKmacMsgFifoNumWords) {
+      fifo->num_free_words = kKmacMsgFifoNumWords - 2 * depth;
+      return kKmacOk;
+    }
+  }
+}
+
+/**
+ * Write a full word to the message FIFO.
+ *
+ * @param fifo Message FIFO write state.
+ * @param word Word to write.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static kmac_error_t msg_fifo_write_word(kmac_msg_fifo_t *fifo, uint32_t word) {
+  if (fifo->num_free_words == 0) {
+    kmac_error_t err = msg_fifo_wait_space(fifo);
+    if (err != kKmacOk) {
+      return err;
+    }
+  }
+  abs_mmio_write32(kKmacMsgFifoAddr, word);
+  fifo->num_free_words--;
+  return kKmacOk;
+}
+
+/**
+ * Append bytes to the message.
+ *
+ * Full words are written to the message FIFO in bursts of up to the free FIFO
+ * space; trailing bytes are kept in `fifo->partial_word` until the next call
+ * or `msg_fifo_flush`.
+ *
+ * @param fifo Message FIFO write state.
+ * @param data Input buffer (any alignment).
+ * @param len Number of bytes in `data`.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static kmac_error_t msg_fifo_write(kmac_msg_fifo_t *fifo, const uint8_t *data,
+                                   size_t len) {
+  kmac_error_t err;
+
+  // Complete a partially assembled word first.
+  if (fifo->partial_word_len != 0) {
+    while (len > 0 && fifo->partial_word_len < sizeof(uint32_t)) {
+      fifo->partial_word |= (uint32_t)*data++ << (8 * fifo->partial_word_len);
+      fifo->partial_word_len++;
+      len--;
+    }
+    if (fifo->partial_word_len < sizeof(uint32_t)) {
+      return kKmacOk;
+    }
+    err = msg_fifo_write_word(fifo, fifo->partial_word);
+    if (err != kKmacOk) {
+      return err;
+    }
+    fifo->partial_word = 0;
+    fifo->partial_word_len = 0;
+  }
+
+  // Write full words back-to-back, polling the status once per burst.
+  size_t num_words = len / sizeof(uint32_t);
+  while (num_words > 0) {
+    if (fifo->num_free_words == 0) {
+      err = msg_fifo_wait_space(fifo);
+      if (err != kKmacOk) {
+        return err;
+      }
+    }
+    size_t burst_len = fifo->num_free_words;
+    if (burst_len > num_words) {
+      burst_len = num_words;
+    }
+    for (size_t i = 0; i < burst_len; i++) {
+      abs_mmio_write32(kKmacMsgFifoAddr, read_32(data));
+      data += sizeof(uint32_t);
+    }
+    fifo->num_free_words -= burst_len;
+    num_words -= burst_len;
+  }
+
+  // Keep the remaining bytes for the next call.
+  len %= sizeof(uint32_t);
+  for (size_t i = 0; i < len; i++) {
+    fifo->partial_word |= (uint32_t)data[i] << (8 * i);
+  }
+  fifo->partial_word_len = len;
+  return kKmacOk;
+}
+
+/**
+ * Write the remaining bytes of a partially assembled word.
+ *
+ * Message bytes are appended individually here since the length of the
+ * message is determined by the byte strobes of the writes.
+ *
+ * @param fifo Message FIFO write state.
+ * @return Error code.
+ */
+OT_WARN_UNUSED_RESULT
+static kmac_error_t msg_fifo_flush(kmac_msg_fifo_t *fifo) {
+  if (fifo->partial_word_len == 0) {
+    return kKmacOk;
+  }
+  if (fifo->num_free_words == 0) {
+    kmac_error_t err = msg_fifo_wait_space(fifo);
+    if (err != kKmacOk) {
+      return err;
+    }
+  }
+  for (size_t i = 0; i < fifo->partial_word_len; i++) {
+    abs_mmio_write8(kKmacMsgFifoAddr + i,
+                    (uint8_t)(fifo->partial_word >> (8 * i)));
+  }
+  fifo->num_free_words--;
+  fifo->partial_word = 0;
+  fifo->partial_word_len = 0;
+  return kKmacOk;
+}
+
 /**
  * Encode a given integer as byte array and return its size along with it.
  *
@@ -530,8 +699,7 @@ kmac_error_t kmac_process_msg_blocks(kmac_operation_t operation,
   uint32_t cmd_reg = KMAC_CMD_REG_RESVAL;
   kmac_error_t err;
 
-  // Assumption(1): `data_len` > 0 and `digest_len` > 0
-  // Assumption(2): data % 4 = 0, i.e. the data ptr is 32-bit aligned
+  // Assumption: `digest_len` > 0
 
   err = wait_status_bit(KMAC_STATUS_SHA3_IDLE_BIT, 1);
   // Issue the start command, so that messages written to MSG_FIFO are forwarded
@@ -544,26 +712,14 @@ kmac_error_t kmac_process_msg_blocks(kmac_operation_t operation,
     return err;
   }
 
-  // Begin by writing a word at a time
-  uint32_t *word_ptr = (uint32_t *)data;
-  size_t i = 0;
-  for (; i < data_len / 4; i++) {
-    err = wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0);
-    if (err != kKmacOk) {
-      return err;
-    }
-    abs_mmio_write32(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET, word_ptr[i]);
-  }
-
-  // For the last few bytes, we need to write byte at a time
-  // i = 4*(data_len/4)
-  for (i = 4 * i; i < data_len; i++) {
-    err = wait_status_bit(KMAC_STATUS_FIFO_FULL_BIT, 0);
-    if (err != kKmacOk) {
-      return err;
-    }
-    abs_mmio_write8(kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET + (i % 4),
-                    data[i]);
+  kmac_msg_fifo_t fifo = {
+      .partial_word = 0,
+      .partial_word_len = 0,
+      .num_free_words = 0,
+  };
+  err = msg_fifo_write(&fifo, data, data_len);
+  if (err != kKmacOk) {
+    return err;
   }
 
   // If operation=KMAC, then we need to write `right_encode(digest_len)`
@@ -583,20 +739,24 @@ kmac_error_t kmac_process_msg_blocks(kmac_operation_t operation,
     if (err != kKmacOk) {
       return err;
     }
-    buf[encoding_header] = encoding_header;
 
-    // Because the MSG_FIFO is also little endian we need to write in reverse
-    // order
+    // `little_endian_encode` returns the least significant byte first, but
+    // right_encode is big endian, so reverse the encoding and append
+    // `encoding_header` as the last byte
+    uint8_t encoding[sizeof(uint32_t) + 1];
     for (size_t i = 0; i < encoding_header; i++) {
-      abs_mmio_write8(
-          kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET + ((data_len + i) % 4),
-          buf[encoding_header - i - 1]);
+      encoding[i] = buf[encoding_header - i - 1];
     }
+    encoding[encoding_header] = encoding_header;
+    err = msg_fifo_write(&fifo, encoding, encoding_header + 1);
+    if (err != kKmacOk) {
+      return err;
+    }
+  }
 
-    // Finally write `encoding_header` as the last byte
-    abs_mmio_write8(
-        kKmacBaseAddr + KMAC_MSG_FIFO_REG_OFFSET + ((data_len + i) % 4),
-        buf[encoding_header]);
+  err = msg_fifo_flush(&fifo);
+  if (err != kKmacOk) {
+    return err;
   }
 
   // Issue the process command, so that squeezing phase can start
@@ -623,7 +783,7 @@ kmac_error_t kmac_process_msg_blocks(kmac_operation_t operation,
 
   // Finally, we can read the two shares of digest and XOR them
   // Here the counter i denotes the number of bytes read from Keccak state
-  for (i = 0; i < digest_len; i++) {
+  for (size_t i = 0; i < digest_len; i++) {
     // Do we require additional Keccak rounds?
     if ((i % keccak_rate) == 0 && i > 0) {
       // if we consumed all Keccak state and aren't done yet, run one more
@@ -155,11 +155,15 @@ kmac_error_t kmac_write_key_block(const uint8_t *key, kmac_key_len_t key_len);
  * streaming mode. This decision is in accord with OpenTitan's Crypto Library
  * Specification. Refer to the Hash section of this specification.
  *
+ * The message is written to the message FIFO in bursts: the free FIFO space
+ * is read from `STATUS.FIFO_DEPTH` once and then filled with back-to-back word
+ * writes. `data` may have any alignment; it is assembled into words in
+ * software, so only the last (up to 3) bytes of the message are written with
+ * byte-wise MMIO writes.
+ *
  * Current implementation has few limitiations:
  *
- * 1. `data` pointer is assumed to be word-aligned. The case where `data` is not
- * divisible by 4 is not yet implemented.
- * 2. Currently, there is no error check on consisteny of the input parameters.
+ * 1. Currently, there is no error check on consisteny of the input parameters.
  * For instance, one can invoke SHA-3_224 with digest_len=32, which will produce
  * 256 bits of digest.
  *
@@ -40,6 +40,11 @@ const size_t kOtbnIMemSizeBytes = OTBN_IMEM_SIZE_BYTES;
 
 enum { kBase = TOP_EARLGREY_OTBN_BASE_ADDR };
 
+/**
+ * Tag of the application image in IMEM, 0 if the contents are unknown.
+ */
+static uintptr_t imem_tag = 0;
+
 /**
  * Ensures that `offset_bytes` and `len` are valid for a given `mem_size`.
  */
@@ -88,6 +93,8 @@ otbn_error_t otbn_busy_wait_for_done(void) {
                       kOtbnStatusIdle);
     return res;
   }
+  // OTBN may have wiped or locked its memories.
+  imem_tag = 0;
   return kOtbnErrorExecutionFailed;
 }
 
@@ -132,8 +139,13 @@ uint32_t otbn_instruction_count_get(void) {
   return abs_mmio_read32(kBase + OTBN_INSN_CNT_REG_OFFSET);
 }
 
+uintptr_t otbn_imem_tag_get(void) { return imem_tag; }
+
+void otbn_imem_tag_set(uintptr_t tag) { imem_tag = tag; }
+
 otbn_error_t otbn_imem_sec_wipe(void) {
   OTBN_RETURN_IF_ERROR(otbn_assert_idle());
+  imem_tag = 0;
   abs_mmio_write32(kBase + OTBN_CMD_REG_OFFSET, kOtbnCmdSecWipeImem);
   OTBN_RETURN_IF_ERROR(otbn_busy_wait_for_done());
   return kOtbnErrorOk;
@@ -143,6 +155,7 @@ otbn_error_t otbn_imem_write(uint32_t offset_bytes, const uint32_t *src,
                              size_t num_words) {
   OTBN_RETURN_IF_ERROR(
       check_offset_len(offset_bytes, num_words, kOtbnIMemSizeBytes));
+  imem_tag = 0;
   otbn_write(kBase + OTBN_IMEM_REG_OFFSET + offset_bytes, src, num_words);
   return kOtbnErrorOk;
 }
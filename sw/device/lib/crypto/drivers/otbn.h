@@ -171,6 +171,28 @@ uint32_t otbn_instruction_count_get(void);
  */
 otbn_error_t otbn_imem_sec_wipe(void);
 
+/**
+ * Get the tag of the application image that is resident in IMEM.
+ *
+ * The driver keeps track of whether IMEM still holds the image last tagged
+ * with `otbn_imem_tag_set`. The tag is cleared by everything that may change
+ * IMEM behind the caller's back: writes to IMEM, IMEM secure wipes, and
+ * failed executions (after which OTBN may have wiped or locked its
+ * memories).
+ *
+ * @return Tag of the resident image, or 0 if IMEM contents are unknown.
+ */
+uintptr_t otbn_imem_tag_get(void);
+
+/**
+ * Tag the current IMEM contents.
+ *
+ * Call this after a complete application image has been written to IMEM.
+ *
+ * @param tag Tag identifying the image (must not be 0).
+ */
+void otbn_imem_tag_set(uintptr_t tag);
+
 /**
  * Write an OTBN application into its instruction memory (IMEM)
  *
@@ -12,6 +12,7 @@
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/crypto/drivers/aes.h"
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
 
 enum {
   /* Log2 of the number of bytes in an AES block. */
@@ -19,72 +20,6 @@ enum {
 };
 OT_ASSERT_ENUM_VALUE(kAesBlockNumBytes, 1 << kAesBlockLog2NumBytes);
 
-/**
- * Precomputed modular reduction constants for Galois field multiplication.
- *
- * This implementation uses 4-bit windows. The bytes here represent 12-bit
- * little-endian values.
- *
- * The entry with index i in this table is equal to i * 0xe1, where the bytes i
- * and 0xe1 are interpreted as polynomials in the GCM Galois field. For
- * example, 0xe1 = 0b1110_0001 is the degree-8 polynomial x^8 + x^2 + x + 1.
- *
- * The field modulus for GCM is 2^128 + x^8 + x^2 + x + 1. Therefore, if a
- * field element is shifted, it can be reduced by multiplying the high bits
- * (128 and above) by 0xe1 and adding them to the low bits.
- *
- * There is a size/speed tradeoff in window size. For 8-bit windows, GHASH
- * becomes significantly faster, but the overhead for computing the product
- * table of a given hash subkey becomes higher, so larger windows are slower
- * for smaller inputs but faster for large inputs.
- */
-static const uint16_t kGFReduceTable[16] = {
-    0x0000, 0x201c, 0x4038, 0x6024, 0x8070, 0xa06c, 0xc048, 0xe054,
-    0x00e1, 0x20fd, 0x40d9, 0x60c5, 0x8091, 0xa08d, 0xc0a9, 0xe0b5};
-
-/**
- * Product table for a given hash subkey.
- *
- * See `make_product_table`.
- */
-typedef struct aes_gcm_product_table {
-  aes_block_t products[16];
-} aes_gcm_product_table_t;
-
-/**
- * Performs a bitwise XOR of two blocks.
- *
- * This operation corresponds to addition in the Galois field.
- *
- * @param x First operand block
- * @param y Second operand block
- * @param[out] out Buffer in which to store output; can be the same as one or
- * both operands.
- */
-static inline void block_xor(const aes_block_t *x, const aes_block_t *y,
-                             aes_block_t *out) {
-  for (size_t i = 0; i < kAesBlockNumWords; ++i) {
-    out->data[i] = x->data[i] ^ y->data[i];
-  }
-}
-
-/**
- * Reverse the bits of a 4-bit number.
- *
- * @param byte Input byte.
- * @return byte with lower 4 bits reversed and upper 4 unmodified.
- */
-static uint8_t reverse_bits(uint8_t byte) {
-  /* TODO: replace with rev.n (from 0.93 draft of bitmanip) once bitmanip
-   * extension is enabled. */
-  uint8_t out = 0;
-  for (size_t i = 0; i < 4; ++i) {
-    out <<= 1;
-    out |= (byte >> i) & 1;
-  }
-  return out;
-}
-
 /**
  * Reverse the bytes of a 32-bit word.
  *
@@ -95,51 +30,9 @@ static uint8_t reverse_bits(uint8_t byte) {
  * @param word Input word.
  * @return Word with bytes reversed.
  */
-static uint32_t reverse_bytes(uint32_t word) {
-  /* TODO: replace with rev8 once bitmanip extension is enabled. */
-  uint32_t out = 0;
-  for (size_t i = 0; i < sizeof(uint32_t); ++i) {
-    out <<= 8;
-    out |= (word >> (i << 3)) & 255;
-  }
-  return out;
-}
-
-/**
- * Logical right shift of an AES block.
- *
- * NIST represents AES blocks as big-endian, and a "right shift" in that
- * representation means shifting out the LSB. However, the processor is
- * little-endian, so we need to reverse the bytes before shifting.
- *
- * @param block Input AES block, modified in-place
- * @param nbits Number of bits to shift
- */
-static inline void block_shiftr(aes_block_t *block, size_t nbits) {
-  // To perform a "right shift" with respect to the big-endian block
-  // representation, we traverse the words of the block and, for each word,
-  // reverse the bytes, save the new LSB as `carry`, shift right, set the MSB
-  // to the last block's carry, and then reverse the bytes back.
-  uint32_t carry = 0;
-  for (size_t i = 0; i < kAesBlockNumWords; ++i) {
-    uint32_t rev = reverse_bytes(block->data[i]);
-    uint32_t next_carry = rev & ((1 << nbits) - 1);
-    rev >>= nbits;
-    rev |= carry << (32 - nbits);
-    carry = next_carry;
-    block->data[i] = reverse_bytes(rev);
-  }
-}
-
-/**
- * Retrieve the byte at a given index from the AES block.
- *
- * @param block Input AES block
- * @param index Index of byte to retrieve (must be < `kAesBlockNumBytes`)
- * @return Value of block[index]
- */
-static inline uint8_t block_byte_get(const aes_block_t *block, size_t index) {
-  return (uint8_t)((char *)block->data)[index];
+static inline uint32_t reverse_bytes(uint32_t word) {
+  // Compiles to rev8 if the bitmanip extension is enabled.
+  return __builtin_bswap32(word);
 }
 
 /**
@@ -209,192 +102,20 @@ static inline void block_inc32(aes_block_t *block) {
       word_inc32(block->data[kAesBlockNumWords - 1]);
 }
 
-/**
- * Multiply an element of the GCM Galois field by the polynomial `x`.
- *
- * This corresponds to a shift right in the bit representation, and then
- * reduction with the field modulus.
- *
- * Runs in constant time.
- *
- * @param p Polynomial to be multiplied
- * @param[out] out Buffer for output
- */
-static inline void galois_mulx(const aes_block_t *p, aes_block_t *out) {
-  // Get the very rightmost bit of the input block (coefficient of x^127).
-  uint8_t p127 = block_byte_get(p, kAesBlockNumBytes - 1) & 1;
-  // Set the output to p >> 1.
-  memcpy(out->data, p->data, kAesBlockNumBytes);
-  block_shiftr(out, 1);
-  // If the highest coefficient was 1, then subtract the polynomial that
-  // corresponds to (modulus - 2^128).
-  uint32_t mask = 0 - p127;
-  out->data[0] ^= (0xe1 & mask);
-}
-
-/**
- * Construct a product table for the hash subkey H.
- *
- * The product table entry at index i is equal to i * H, where both i and H are
- * interpreted as Galois field polynomials.
- *
- * @param H Hash subkey
- * @param[out] product_table Buffer for output
- */
-static void make_product_table(const aes_block_t *H,
-                               aes_gcm_product_table_t *tbl) {
-  // Initialize 0 * H = 0.
-  memset(tbl->products[0].data, 0, kAesBlockNumBytes);
-  // Initialize 1 * H = H.
-  memcpy(tbl->products[0x8].data, H->data, kAesBlockNumBytes);
-
-  // To get remaining entries, we use a variant of "shift and add"; in
-  // polynomial terms, a shift is a multiplication by x. Note that, because the
-  // processor represents bytes with the MSB on the left and NIST uses a fully
-  // little-endian polynomial representation with the MSB on the right, we have
-  // to reverse the bits of the indices.
-  for (size_t i = 2; i < 16; i += 2) {
-    // Find the product corresponding to (i >> 1) * H and multiply by x to
-    // shift 1; this will be i * H.
-    galois_mulx(&tbl->products[reverse_bits(i >> 1)],
-                &tbl->products[reverse_bits(i)]);
-
-    // Add H to i * H to get (i + 1) * H.
-    block_xor(&tbl->products[reverse_bits(i)], H,
-              &tbl->products[reverse_bits(i + 1)]);
-  }
-}
-
-/**
- * Computes the "product block" as defined in NIST SP800-38D, section 6.3.
- *
- * The NIST documentation shows a very slow double-and-add algorithm, which
- * iterates through the first operand bit-by-bit. However, since the second
- * operand is always the hash subkey H, we can speed things up significantly
- * with a little precomputation.
- *
- * The `tbl` input should be a precomputed table with the products of H and
- * 256 all possible byte values (see `make_product_table`).
- *
- * This operation corresponds to multiplication in the Galois field with order
- * 2^128, modulo the polynomial x^128 +  x^8 + x^2 + x + 1
- *
- * @param p Polynomial to multiply
- * @param tbl Precomputed product table for the hash subkey
- * @param[out] result Block in which to store output
- */
-static void galois_mul(const aes_block_t *p, const aes_gcm_product_table_t *tbl,
-                       aes_block_t *result) {
-  // Initialize the result to 0.
-  memset(result->data, 0, kAesBlockNumBytes);
-
-  // 4-bit windows, so number of windows is 2x number of bytes.
-  const size_t kNumWindows = kAesBlockNumBytes << 1;
-
-  // To compute the product, we iterate through the bytes of the input block,
-  // considering the most significant (in polynomial terms) first. For each
-  // byte b, we:
-  //   * multiply `result` by x^8 (shift all coefficients to the right)
-  //   * reduce the shifted `result` modulo the field modulus
-  //   * look up the product `b * H` and add it to `result`
-  //
-  // We can skip the shift and reduce steps on the first iteration, since
-  // `result` is 0.
-  for (size_t i = 0; i < kNumWindows; ++i) {
-    if (i != 0) {
-      // Save the most significant half-byte of `result` before shifting.
-      uint8_t overflow = block_byte_get(result, kAesBlockNumBytes - 1) & 0x0f;
-      // Shift `result` to the right, discarding high bits.
-      block_shiftr(result, 4);
-      // Look up the product of `overflow` and the low terms of the modulus in
-      // the precomputed table.
-      uint16_t reduce_term = kGFReduceTable[overflow];
-      // Add (xor) this product to the low bits to complete modular reduction.
-      // This works because (low + x^128 * high) is equivalent to (low + (x^128
-      // - modulus) * high).
-      result->data[0] ^= reduce_term;
-    }
-
-    // Add the product of the next window and H to `result`. We process the
-    // windows starting with the most significant polynomial terms, which means
-    // starting from the last byte and proceeding to the first.
-    uint8_t pi = block_byte_get(p, (kNumWindows - 1 - i) >> 1);
-
-    // Select the less significant 4 bits if i is even, or the more significant
-    // 4 bits if i is odd. This does not need to be constant time, since the
-    // values of i in this loop are constant.
-    if ((i & 1) == 1) {
-      pi >>= 4;
-    } else {
-      pi &= 0x0f;
-    }
-    block_xor(result, &tbl->products[pi], result);
-  }
-}
-
-/**
- * Advances the GHASH state for the given input.
- *
- * This function is convenient for computing the GHASH of large, concatenated
- * buffers. Given a state representing GHASH(A) and a new input B, this
- * function will return a state representing GHASH(A || B || <padding for B>).
- *
- * Pads the input with 0s on the right-hand side if needed so that the input
- * size is a multiple of the block size.
- *
- * The product table should match the format from `make_product_table`.
- *
- * @param tbl Precomputed product table
- * @param input_len Length of input in bytes
- * @param input Input buffer
- * @param state GHASH state, updated in place
- */
-static void aes_gcm_ghash_update(const aes_gcm_product_table_t *tbl,
-                                 const size_t input_len, const uint8_t *input,
-                                 aes_block_t *state) {
-  // Calculate the number of AES blocks needed for the input.
-  size_t nblocks = get_nblocks(input_len);
-
-  // Main loop.
-  for (size_t i = 0; i < nblocks; ++i) {
-    // Construct block i of the input.
-    aes_block_t input_block;
-    if (i == nblocks - 1) {
-      // Last block may be partial; pad with zeroes.
-      size_t nbytes = get_last_block_num_bytes(input_len);
-      memset(input_block.data, 0, kAesBlockNumBytes);
-      memcpy(input_block.data, input, nbytes);
-    } else {
-      // Full block; copy data and advance input pointer.
-      memcpy(input_block.data, input, kAesBlockNumBytes);
-      input += kAesBlockNumBytes;
-    }
-    // XOR `state` with the next input block.
-    block_xor(state, &input_block, state);
-    // Multiply state by H and update.
-    aes_block_t yH;
-    galois_mul(state, tbl, &yH);
-    memcpy(state->data, yH.data, kAesBlockNumBytes);
-  }
-}
-
 aes_error_t aes_gcm_ghash(const aes_block_t *hash_subkey,
                           const size_t input_len, const uint8_t *input,
                           aes_block_t *output) {
-  // Compute the product table for H.
-  aes_gcm_product_table_t tbl;
-  make_product_table(hash_subkey, &tbl);
-
   // If the input length is not a multiple of the block size, fail.
   if (get_last_block_num_bytes(input_len) != kAesBlockNumBytes) {
     return kAesInternalError;
   }
 
-  // Initialize the GHASH state to 0.
-  memset(output->data, 0, kAesBlockNumBytes);
-
-  // Update the GHASH state with the input.
-  aes_gcm_ghash_update(&tbl, input_len, input, output);
+  // Precompute the tables for H and hash the input.
+  ghash_context_t ctx;
+  ghash_init_subkey(hash_subkey->data, &ctx);
+  ghash_init(&ctx);
+  ghash_update(&ctx, input_len, input);
+  ghash_final(&ctx, output->data);
 
   return kAesOk;
 }
@@ -424,11 +145,172 @@ static aes_error_t aes_encrypt_block(const aes_key_t key, const aes_block_t *iv,
   return kAesOk;
 }
 
+/**
+ * Retrieve a block of input for GCTR.
+ *
+ * All blocks are full-size except for the last block, which may be partial.
+ * If the block is partial, the input data will be padded with zeroes.
+ *
+ * @param len Number of bytes in the input
+ * @param input Pointer to input buffer
+ * @param index Index of the block to retrieve (must be < get_nblocks(len))
+ * @param[out] block Destination block
+ */
+static inline void gctr_block_get(const size_t len, const uint8_t *input,
+                                  const size_t index, aes_block_t *block) {
+  size_t nbytes = kAesBlockNumBytes;
+  if (index == get_nblocks(len) - 1) {
+    nbytes = get_last_block_num_bytes(len);
+    memset(block->data, 0, kAesBlockNumBytes);
+  }
+  memcpy(block->data, &input[index * kAesBlockNumBytes], nbytes);
+}
+
+/**
+ * Runs hardware AES-CTR over a span of blocks with no 32-bit counter wrap.
+ *
+ * The hardware is configured once with the counter block as IV, and then all
+ * blocks are streamed through it. The hardware increments the IV as a 128-bit
+ * counter; this matches GCM's inc32() as long as the lower 32 bits of the
+ * counter do not wrap within the span, which the caller must ensure.
+ *
+ * If `ctx` is non-NULL, the ciphertext blocks (the output when
+ * encrypting, the input when decrypting) are also absorbed into its GHASH
+ * state, with the last block padded with zeroes. Block i+1 is pushed into the
+ * hardware before block i is hashed, so that the GHASH multiplication on the
+ * CPU overlaps with the AES computation.
+ *
+ * @param key The AES key
+ * @param cb Counter block for the first block of the span
+ * @param len Number of bytes for input and output, must be nonzero
+ * @param input Pointer to input buffer
+ * @param[out] output Pointer to output buffer (may be the same as input)
+ * @param ctx GCM context whose GHASH state to update, or NULL
+ * @return Error status; OK if no errors
+ */
+static aes_error_t aes_gcm_gctr_span(const aes_key_t key,
+                                     const aes_block_t *cb, const size_t len,
+                                     const uint8_t *input, uint8_t *output,
+                                     aes_gcm_context_t *ctx) {
+  aes_error_t err = aes_encrypt_begin(key, cb);
+  if (err != kAesOk) {
+    return err;
+  }
+
+  // Load the first input block.
+  size_t nblocks = get_nblocks(len);
+  aes_block_t block_in;
+  aes_block_t block_out;
+  uint8_t ghash_batch[kGhashAggregateNumBlocks * kAesBlockNumBytes];
+  size_t ghash_batch_len = 0;
+  gctr_block_get(len, input, 0, &block_in);
+  err = aes_update(/*dest=*/NULL, &block_in);
+  if (err != kAesOk) {
+    return err;
+  }
+
+  for (size_t i = 0; i < nblocks; ++i) {
+    // Keep block i of the input for GHASH before it is replaced.
+    aes_block_t ciphertext_block;
+    memcpy(ciphertext_block.data, block_in.data, kAesBlockNumBytes);
+
+    // Retrieve block i and feed block i+1, if there is one. If the buffers are
+    // the same, block i+1 has already been read by the time block i is
+    // written.
+    const aes_block_t *next = NULL;
+    if (i + 1 < nblocks) {
+      gctr_block_get(len, input, i + 1, &block_in);
+      next = &block_in;
+    }
+    err = aes_update(&block_out, next);
+    if (err != kAesOk) {
+      return err;
+    }
+
+    // Copy the result block into the output buffer, truncating some bytes if
+    // the input block was partial.
+    size_t nbytes = kAesBlockNumBytes;
+    if (i == nblocks - 1) {
+      nbytes = get_last_block_num_bytes(len);
+    }
+    memcpy(&output[i * kAesBlockNumBytes], block_out.data, nbytes);
+
+    // Hash the ciphertext blocks while the hardware works on block i+1. GHASH
+    // processes `kGhashAggregateNumBlocks` blocks at once, so they are
+    // collected first.
+    if (ctx != NULL) {
+      const aes_block_t *ciphertext = &ciphertext_block;
+      if (ctx->is_encrypt == kHardenedBoolTrue) {
+        ciphertext = &block_out;
+      }
+      memcpy(&ghash_batch[ghash_batch_len], ciphertext->data, nbytes);
+      ghash_batch_len += nbytes;
+      if (ghash_batch_len == sizeof(ghash_batch) || i == nblocks - 1) {
+        ghash_update(&ctx->ghash_ctx, ghash_batch_len, ghash_batch);
+        ghash_batch_len = 0;
+      }
+    }
+  }
+
+  return aes_end();
+}
+
+/**
+ * GCTR with an in-place counter block and optional GHASH of the ciphertext.
+ *
+ * The input is split where the lower 32 bits of the counter wrap, and each
+ * part is processed in one hardware CTR-mode session (see
+ * `aes_gcm_gctr_span`). Afterwards, `cb` holds the counter block for the next
+ * block of input.
+ *
+ * @param key The AES key
+ * @param cb Counter block, updated in place
+ * @param len Number of bytes for input and output
+ * @param input Pointer to input buffer
+ * @param[out] output Pointer to output buffer (may be the same as input)
+ * @param ctx GCM context whose GHASH state to update, or NULL
+ * @return Error status; OK if no errors
+ */
+static aes_error_t aes_gcm_gctr_update(const aes_key_t key, aes_block_t *cb,
+                                       size_t len, const uint8_t *input,
+                                       uint8_t *output,
+                                       aes_gcm_context_t *ctx) {
+  while (len > 0) {
+    // Number of blocks until the lower 32 bits of the counter wrap (at least
+    // 1, at most 2^32).
+    uint32_t ctr = reverse_bytes(cb->data[kAesBlockNumWords - 1]);
+    uint64_t blocks_to_wrap = (uint64_t)UINT32_MAX + 1 - ctr;
+
+    // Process everything up to the wrap in one span. If the span ends before
+    // the input does, it consists of full blocks only.
+    size_t span_len = len;
+    if (get_nblocks(len) > blocks_to_wrap) {
+      span_len = (size_t)blocks_to_wrap * kAesBlockNumBytes;
+    }
+    aes_error_t err = aes_gcm_gctr_span(key, cb, span_len, input, output, ctx);
+    if (err != kAesOk) {
+      return err;
+    }
+
+    // Advance the counter with inc32() semantics: the lower 32 bits wrap
+    // around and the rest of the block is unchanged.
+    cb->data[kAesBlockNumWords - 1] =
+        reverse_bytes(ctr + (uint32_t)get_nblocks(span_len));
+    input += span_len;
+    output += span_len;
+    len -= span_len;
+  }
+
+  return kAesOk;
+}
+
 /**
  * Implements the GCTR function as specified in SP800-38D, section 6.5.
  *
  * The block cipher is fixed to AES. Note that the GCTR function is a modified
- * version of the AES-CTR mode of encryption.
+ * version of the AES-CTR mode of encryption: the counter is incremented with
+ * inc32(), i.e. only its lower 32 bits are incremented and they wrap around
+ * independently of the upper 96 bits.
  *
  * Input must be less than 2^32 blocks long; that is, `len` < 2^36, since each
  * block is 16 bytes.
@@ -464,46 +346,10 @@ aes_error_t aes_gcm_gctr(const aes_key_t key, const aes_block_t *icb,
     return kAesInternalError;
   }
 
-  // Initial IV = ICB.
-  aes_block_t iv;
-  memcpy(iv.data, icb->data, kAesBlockNumBytes);
-
-  // Calculate the number of blocks needed to represent the input. Since we
-  // checked for empty input above, nblocks must be at least 1.
-  size_t nblocks = get_nblocks(len);
-  for (size_t i = 0; i < nblocks; ++i) {
-    // Retrieve the next block of input. All blocks are full-size except for
-    // the last block, which may be partial. If the block is partial, the input
-    // data will be padded with zeroes.
-    aes_block_t block_in;
-    size_t nbytes = kAesBlockNumBytes;
-    if (i == nblocks - 1) {
-      // Last block is partial; copy the bytes that exist and set the rest of
-      // the block to 0.
-      nbytes = get_last_block_num_bytes(len);
-      memset(block_in.data, 0, kAesBlockNumBytes);
-      memcpy(block_in.data, &input[i * kAesBlockNumBytes], nbytes);
-    } else {
-      // This block is a full block.
-      memcpy(block_in.data, &input[i * kAesBlockNumBytes], kAesBlockNumBytes);
-    }
-
-    // Run the AES-CTR encryption operation on the next block of input.
-    aes_block_t block_out;
-    aes_error_t err = aes_encrypt_block(key, &iv, &block_in, &block_out);
-    if (err != kAesOk) {
-      return err;
-    }
-
-    // Copy the result block into the output buffer, truncating some bytes if
-    // the input block was partial.
-    memcpy(&output[i * kAesBlockNumBytes], block_out.data, nbytes);
-
-    // Update the counter block with inc32().
-    block_inc32(&iv);
-  }
-
-  return kAesOk;
+  // Initial counter block = ICB.
+  aes_block_t cb;
+  memcpy(cb.data, icb->data, kAesBlockNumBytes);
+  return aes_gcm_gctr_update(key, &cb, len, input, output, /*ctx=*/NULL);
 }
 
 /**
@@ -538,18 +384,18 @@ static hardened_bool_t check_buffer_lengths(const size_t iv_len,
 /**
  * Compute the hash subkey for AES-GCM.
  *
- * This routine computes the hash subkey H and the product table for H; see
- * `make_product_table` for representation details.
+ * This routine computes the hash subkey H and sets up the GHASH context for
+ * it; see `ghash_init_subkey`.
  *
  * If any step in this process fails, the function returns an error and the
  * output should not be used.
  *
  * @param key AES key
- * @param[out] tbl Destination for the output hash subkey product table
+ * @param[out] ctx Destination GHASH context
  * @return OK or error
  */
 static aes_error_t aes_gcm_hash_subkey(const aes_key_t key,
-                                       aes_gcm_product_table_t *tbl) {
+                                       ghash_context_t *ctx) {
   // Compute the initial hash subkey H = AES_K(0). Note that to get this
   // result from AES_CTR, we set both the IV and plaintext to zero; this way,
   // AES-CTR's final XOR with the plaintext does nothing.
@@ -561,8 +407,8 @@ static aes_error_t aes_gcm_hash_subkey(const aes_key_t key,
     return err;
   }
 
-  // Compute the product table for H.
-  make_product_table(&hash_subkey, tbl);
+  // Precompute the tables for H.
+  ghash_init_subkey(hash_subkey.data, ctx);
 
   return kAesOk;
 }
@@ -575,13 +421,12 @@ static aes_error_t aes_gcm_hash_subkey(const aes_key_t key,
  *
  * @param iv_len IV length in bytes
  * @param iv IV value
- * @param tbl Product table for the hash subkey H
+ * @param ctx GHASH context for the hash subkey H (state is clobbered)
  * @param[out] j0 Destination for the output counter block
  * @return OK or error
  */
 static aes_error_t aes_gcm_counter(const size_t iv_len, const uint8_t *iv,
-                                   aes_gcm_product_table_t *tbl,
-                                   aes_block_t *j0) {
+                                   ghash_context_t *ctx, aes_block_t *j0) {
   if (iv_len == 12) {
     // If the IV is 96 bits, then J0 = (IV || {0}^31 || 1).
     memcpy(j0->data, iv, iv_len);
@@ -590,12 +435,13 @@ static aes_error_t aes_gcm_counter(const size_t iv_len, const uint8_t *iv,
   } else if (iv_len == 16) {
     // If the IV is 128 bits, then J0 = GHASH(H, IV || {0}^120 || 0x80), where
     // {0}^120 means 120 zero bits (15 0x00 bytes).
-    memset(j0->data, 0, kAesBlockNumBytes);
-    aes_gcm_ghash_update(tbl, iv_len, iv, j0);
+    ghash_init(ctx);
+    ghash_update(ctx, iv_len, iv);
     uint8_t buffer[kAesBlockNumBytes];
     memset(buffer, 0, kAesBlockNumBytes);
     buffer[kAesBlockNumBytes - 1] = 0x80;
-    aes_gcm_ghash_update(tbl, kAesBlockNumBytes, buffer, j0);
+    ghash_update(ctx, kAesBlockNumBytes, buffer);
+    ghash_final(ctx, j0->data);
   } else {
     // Should not happen; invalid IV length.
     return kAesInternalError;
@@ -605,55 +451,286 @@ static aes_error_t aes_gcm_counter(const size_t iv_len, const uint8_t *iv,
 }
 
 /**
- * Compute the AES-GCM authentication tag.
+ * Start a streaming AES-GCM operation.
+ *
+ * Computes the hash subkey and the counter block J0, and resets the GHASH
+ * state and lengths.
  *
  * @param key AES key
- * @param tbl Product table for the hash subkey H
- * @param ciphertext_len Length of the ciphertext in bytes
- * @param ciphertext Ciphertext value
- * @param aad_len Length of the associated data in bytes
- * @param aad Associated data value
- * @param j0 Counter block (J0 in the NIST specification)
+ * @param iv_len IV length in bytes
+ * @param iv IV value
+ * @param encrypt True for encryption, false for decryption
+ * @param[out] ctx Context to initialize
+ * @return OK or error
+ */
+static aes_error_t aes_gcm_init(const aes_key_t key, const size_t iv_len,
+                                const uint8_t *iv, hardened_bool_t encrypt,
+                                aes_gcm_context_t *ctx) {
+  if (check_buffer_lengths(iv_len, 0, 0) != kHardenedBoolTrue) {
+    return kAesInternalError;
+  }
+
+  // TODO: add support for sideloaded keys.
+  if (key.sideload != kHardenedBoolFalse || key.mode != kAesCipherModeCtr) {
+    return kAesInternalError;
+  }
+
+  ctx->key = key;
+  ctx->is_encrypt = encrypt;
+
+  // Compute the hash subkey H as a product table.
+  aes_error_t err = aes_gcm_hash_subkey(key, &ctx->ghash_ctx);
+  if (err != kAesOk) {
+    return err;
+  }
+
+  // Compute the counter block (called J0 in the NIST specification). The
+  // first block of data is encrypted with inc32(J0).
+  err = aes_gcm_counter(iv_len, iv, &ctx->ghash_ctx,
+                        &ctx->initial_counter_block);
+  if (err != kAesOk) {
+    return err;
+  }
+  memcpy(ctx->cb.data, ctx->initial_counter_block.data, kAesBlockNumBytes);
+  block_inc32(&ctx->cb);
+
+  ghash_init(&ctx->ghash_ctx);
+  ctx->aad_len = 0;
+  ctx->input_len = 0;
+  ctx->partial_block_len = 0;
+  ctx->data_started = kHardenedBoolFalse;
+  return kAesOk;
+}
+
+aes_error_t aes_gcm_encrypt_init(const aes_key_t key, const size_t iv_len,
+                                 const uint8_t *iv, aes_gcm_context_t *ctx) {
+  return aes_gcm_init(key, iv_len, iv, kHardenedBoolTrue, ctx);
+}
+
+aes_error_t aes_gcm_decrypt_init(const aes_key_t key, const size_t iv_len,
+                                 const uint8_t *iv, aes_gcm_context_t *ctx) {
+  return aes_gcm_init(key, iv_len, iv, kHardenedBoolFalse, ctx);
+}
+
+/**
+ * Append input to the partial block buffer of the context.
+ *
+ * @param ctx AES-GCM context
+ * @param len Number of bytes available in `input`
+ * @param input Input buffer
+ * @return Number of bytes taken from `input`
+ */
+static size_t partial_block_fill(aes_gcm_context_t *ctx, const size_t len,
+                                 const uint8_t *input) {
+  size_t nbytes = kAesBlockNumBytes - ctx->partial_block_len;
+  if (nbytes > len) {
+    nbytes = len;
+  }
+  memcpy(&ctx->partial_block[ctx->partial_block_len], input, nbytes);
+  ctx->partial_block_len += nbytes;
+  return nbytes;
+}
+
+aes_error_t aes_gcm_update_aad(aes_gcm_context_t *ctx, size_t aad_len,
+                               const uint8_t *aad) {
+  // All AAD must be provided before any data.
+  if (ctx->data_started != kHardenedBoolFalse) {
+    return kAesInternalError;
+  }
+  if (aad_len == 0) {
+    return kAesOk;
+  }
+  if (aad_len > UINT32_MAX - ctx->aad_len) {
+    return kAesInternalError;
+  }
+  ctx->aad_len += aad_len;
+
+  // Complete a partial block left over from the previous call.
+  if (ctx->partial_block_len > 0) {
+    size_t nbytes = partial_block_fill(ctx, aad_len, aad);
+    aad += nbytes;
+    aad_len -= nbytes;
+    if (ctx->partial_block_len < kAesBlockNumBytes) {
+      return kAesOk;
+    }
+    ghash_update(&ctx->ghash_ctx, kAesBlockNumBytes, ctx->partial_block);
+    ctx->partial_block_len = 0;
+  }
+
+  // Hash all full blocks and keep the rest for later.
+  size_t full_len = aad_len & ~((size_t)kAesBlockNumBytes - 1);
+  if (full_len > 0) {
+    ghash_update(&ctx->ghash_ctx, full_len, aad);
+  }
+  partial_block_fill(ctx, aad_len - full_len, &aad[full_len]);
+  return kAesOk;
+}
+
+/**
+ * Finish the AAD if this has not happened yet.
+ *
+ * GHASH pads the AAD with zeroes to a multiple of the block size, so a
+ * buffered partial AAD block is hashed as soon as the first data (or the end
+ * of the message) is seen.
+ *
+ * @param ctx AES-GCM context
+ */
+static void aes_gcm_aad_finish(aes_gcm_context_t *ctx) {
+  if (ctx->data_started != kHardenedBoolFalse) {
+    return;
+  }
+  if (ctx->partial_block_len > 0) {
+    ghash_update(&ctx->ghash_ctx, ctx->partial_block_len, ctx->partial_block);
+    ctx->partial_block_len = 0;
+  }
+  ctx->data_started = kHardenedBoolTrue;
+}
+
+aes_error_t aes_gcm_update(aes_gcm_context_t *ctx, size_t input_len,
+                           const uint8_t *input, size_t *output_len,
+                           uint8_t *output) {
+  *output_len = 0;
+  aes_gcm_aad_finish(ctx);
+  if (input_len == 0) {
+    return kAesOk;
+  }
+  if (input_len > UINT32_MAX - ctx->input_len) {
+    return kAesInternalError;
+  }
+  ctx->input_len += input_len;
+
+  // Complete a partial block left over from the previous call. Its output is
+  // held back until the rest of the input has been read: if `output` is the
+  // same buffer as `input`, the first output block covers input bytes that
+  // have not been processed yet.
+  uint8_t first_block[kAesBlockNumBytes];
+  hardened_bool_t first_block_ready = kHardenedBoolFalse;
+  if (ctx->partial_block_len > 0) {
+    size_t nbytes = partial_block_fill(ctx, input_len, input);
+    input += nbytes;
+    input_len -= nbytes;
+    if (ctx->partial_block_len < kAesBlockNumBytes) {
+      return kAesOk;
+    }
+    aes_error_t err =
+        aes_gcm_gctr_update(ctx->key, &ctx->cb, kAesBlockNumBytes,
+                            ctx->partial_block, first_block, ctx);
+    if (err != kAesOk) {
+      return err;
+    }
+    ctx->partial_block_len = 0;
+    first_block_ready = kHardenedBoolTrue;
+  }
+
+  // Buffer the trailing partial block before any output is written, since
+  // in-place output runs ahead of the input by up to one block.
+  size_t full_len = input_len & ~((size_t)kAesBlockNumBytes - 1);
+  partial_block_fill(ctx, input_len - full_len, &input[full_len]);
+
+  // Process all full blocks in one pass. `aes_gcm_gctr_span` reads block i+1
+  // before it writes block i, so an output that is less than one block ahead
+  // of the input does not overwrite unread data.
+  uint8_t *full_output = output;
+  if (first_block_ready == kHardenedBoolTrue) {
+    full_output += kAesBlockNumBytes;
+  }
+  if (full_len > 0) {
+    aes_error_t err = aes_gcm_gctr_update(ctx->key, &ctx->cb, full_len, input,
+                                          full_output, ctx);
+    if (err != kAesOk) {
+      return err;
+    }
+    *output_len += full_len;
+  }
+  if (first_block_ready == kHardenedBoolTrue) {
+    memcpy(output, first_block, kAesBlockNumBytes);
+    *output_len += kAesBlockNumBytes;
+  }
+  return kAesOk;
+}
+
+/**
+ * Process the last partial block and compute the authentication tag.
+ *
+ * @param ctx AES-GCM context
+ * @param[out] output_len Number of bytes written to `output`
+ * @param[out] output Output buffer for the last partial block (< 16 bytes)
  * @param[out] tag Buffer for output tag (128 bits)
+ * @return OK or error
  */
-static aes_error_t aes_gcm_compute_tag(const aes_key_t key,
-                                       const aes_gcm_product_table_t *tbl,
-                                       const size_t ciphertext_len,
-                                       const uint8_t *ciphertext,
-                                       const size_t aad_len, const uint8_t *aad,
-                                       const aes_block_t *j0, uint8_t *tag) {
-  // Compute S = GHASH(H, expand(A) || expand(C) || len64(A) || len64(C))
-  // where:
-  //   * A is the aad, C is the ciphertext
-  //   * expand(x) pads x to a multiple of 128 bits by adding zeroes to the
-  //     right-hand side
-  //   * len64(x) is the length of x in bits expressed as a
-  //     big-endian 64-bit integer.
-
-  // Compute GHASH(H, expand(A) || expand(C)).
-  aes_block_t s;
-  memset(s.data, 0, kAesBlockNumBytes);
-  aes_gcm_ghash_update(tbl, aad_len, aad, &s);
-  aes_gcm_ghash_update(tbl, ciphertext_len, ciphertext, &s);
-
-  // Compute len64(A) and len64(C) by computing the length in *bits* (shift by
-  // 3) and then converting to big-endian.
+static aes_error_t aes_gcm_final(aes_gcm_context_t *ctx, size_t *output_len,
+                                 uint8_t *output, uint8_t *tag) {
+  *output_len = 0;
+  aes_gcm_aad_finish(ctx);
+  if (ctx->partial_block_len > 0) {
+    aes_error_t err =
+        aes_gcm_gctr_update(ctx->key, &ctx->cb, ctx->partial_block_len,
+                            ctx->partial_block, output, ctx);
+    if (err != kAesOk) {
+      return err;
+    }
+    *output_len = ctx->partial_block_len;
+    ctx->partial_block_len = 0;
+  }
+
+  // The GHASH state now holds GHASH(H, expand(A) || expand(C)), where A is the
+  // AAD, C is the ciphertext and expand(x) pads x with zeroes to a multiple of
+  // 128 bits. Finish computing
+  //   S = GHASH(H, expand(A) || expand(C) || len64(A) || len64(C)),
+  // where len64(x) is the length of x in bits expressed as a big-endian 64-bit
+  // integer.
   uint64_t last_block[2] = {
-      __builtin_bswap64(((uint64_t)aad_len) * 8),
-      __builtin_bswap64(((uint64_t)ciphertext_len) * 8),
+      __builtin_bswap64(((uint64_t)ctx->aad_len) * 8),
+      __builtin_bswap64(((uint64_t)ctx->input_len) * 8),
   };
 
   // Use memcpy() to avoid violating strict aliasing when converting to bytes.
   uint8_t last_block_bytes[sizeof(last_block)];
   memcpy(last_block_bytes, last_block, sizeof(last_block));
-
-  // Finish computing S by appending (len64(A) || len64(C)).
-  aes_gcm_ghash_update(tbl, kAesBlockNumBytes, last_block_bytes, &s);
+  ghash_update(&ctx->ghash_ctx, kAesBlockNumBytes, last_block_bytes);
 
   // Compute the tag T = GCTR(K, J0, S).
-  uint8_t s_data_bytes[sizeof(s.data)];
-  memcpy(s_data_bytes, s.data, sizeof(s.data));
-  return aes_gcm_gctr(key, j0, kAesBlockNumBytes, s_data_bytes, tag);
+  aes_block_t s_block;
+  ghash_final(&ctx->ghash_ctx, s_block.data);
+  uint8_t s_data_bytes[sizeof(s_block.data)];
+  memcpy(s_data_bytes, s_block.data, sizeof(s_block.data));
+  return aes_gcm_gctr(ctx->key, &ctx->initial_counter_block, kAesBlockNumBytes,
+                      s_data_bytes, tag);
+}
+
+aes_error_t aes_gcm_encrypt_final(aes_gcm_context_t *ctx, size_t *output_len,
+                                  uint8_t *output, uint8_t *tag) {
+  if (ctx->is_encrypt != kHardenedBoolTrue) {
+    return kAesInternalError;
+  }
+  return aes_gcm_final(ctx, output_len, output, tag);
+}
+
+aes_error_t aes_gcm_decrypt_final(aes_gcm_context_t *ctx, const uint8_t *tag,
+                                  size_t *output_len, uint8_t *output,
+                                  hardened_bool_t *success) {
+  *success = kHardenedBoolFalse;
+  if (ctx->is_encrypt != kHardenedBoolFalse) {
+    return kAesInternalError;
+  }
+
+  // Compute the expected authentication tag T.
+  uint8_t expected_tag[kAesGcmTagNumBytes];
+  aes_error_t err = aes_gcm_final(ctx, output_len, output, expected_tag);
+  if (err != kAesOk) {
+    return err;
+  }
+
+  // Copy expected and actual tag to word-size buffers to avoid violating
+  // strict aliasing rules.
+  uint32_t expected_tag_words[kAesGcmTagNumWords];
+  uint32_t tag_words[kAesGcmTagNumWords];
+  memcpy(expected_tag_words, expected_tag, kAesGcmTagNumBytes);
+  memcpy(tag_words, tag, kAesGcmTagNumBytes);
+
+  // Compare the expected tag to the actual tag (in constant time).
+  *success = hardened_memeq(expected_tag_words, tag_words, kAesGcmTagNumWords);
+  return kAesOk;
 }
 
 aes_error_t aes_gcm_encrypt(const aes_key_t key, const size_t iv_len,
@@ -667,34 +744,24 @@ aes_error_t aes_gcm_encrypt(const aes_key_t key, const size_t iv_len,
     return kAesInternalError;
   }
 
-  // Compute the hash subkey H as a product table.
-  aes_gcm_product_table_t Htbl;
-  aes_error_t err = aes_gcm_hash_subkey(key, &Htbl);
+  aes_gcm_context_t ctx;
+  aes_error_t err = aes_gcm_encrypt_init(key, iv_len, iv, &ctx);
   if (err != kAesOk) {
     return err;
   }
-
-  // Compute the counter block (called J0 in the NIST specification).
-  aes_block_t j0;
-  err = aes_gcm_counter(iv_len, iv, &Htbl, &j0);
+  err = aes_gcm_update_aad(&ctx, aad_len, aad);
   if (err != kAesOk) {
     return err;
   }
 
-  // Compute inc32(J0).
-  aes_block_t j0_inc;
-  memcpy(j0_inc.data, j0.data, kAesBlockNumBytes);
-  block_inc32(&j0_inc);
-
-  // Compute ciphertext C = GCTR(K, inc32(J0), plaintext).
-  err = aes_gcm_gctr(key, &j0_inc, plaintext_len, plaintext, ciphertext);
+  // Compute the ciphertext and the GHASH over it in a single pass.
+  size_t len;
+  err = aes_gcm_update(&ctx, plaintext_len, plaintext, &len, ciphertext);
   if (err != kAesOk) {
     return err;
   }
-
-  // Compute the authentication tag T.
-  return aes_gcm_compute_tag(key, &Htbl, plaintext_len, ciphertext, aad_len,
-                             aad, &j0, tag);
+  size_t final_len;
+  return aes_gcm_encrypt_final(&ctx, &final_len, &ciphertext[len], tag);
 }
 
 aes_error_t aes_gcm_decrypt(const aes_key_t key, const size_t iv_len,
@@ -708,45 +775,35 @@ aes_error_t aes_gcm_decrypt(const aes_key_t key, const size_t iv_len,
     return kAesInternalError;
   }
 
-  // Compute the hash subkey H as a product table.
-  aes_gcm_product_table_t Htbl;
-  aes_error_t err = aes_gcm_hash_subkey(key, &Htbl);
+  aes_gcm_context_t ctx;
+  aes_error_t err = aes_gcm_decrypt_init(key, iv_len, iv, &ctx);
   if (err != kAesOk) {
     return err;
   }
-
-  // Compute the counter block (called J0 in the NIST specification).
-  aes_block_t j0;
-  err = aes_gcm_counter(iv_len, iv, &Htbl, &j0);
+  err = aes_gcm_update_aad(&ctx, aad_len, aad);
   if (err != kAesOk) {
     return err;
   }
 
-  // Compute the expected authentication tag T.
-  uint8_t expected_tag[kAesGcmTagNumBytes];
-  err = aes_gcm_compute_tag(key, &Htbl, ciphertext_len, ciphertext, aad_len,
-                            aad, &j0, expected_tag);
+  // Compute the plaintext and the GHASH over the ciphertext in a single pass.
+  size_t len;
+  err = aes_gcm_update(&ctx, ciphertext_len, ciphertext, &len, plaintext);
+  if (err != kAesOk) {
+    return err;
+  }
+  size_t final_len;
+  err = aes_gcm_decrypt_final(&ctx, tag, &final_len, &plaintext[len], success);
   if (err != kAesOk) {
     return err;
   }
 
-  // Copy expected and actual tag to word-size buffers to avoid violating
-  // strict aliasing rules.
-  uint32_t expected_tag_words[kAesGcmTagNumWords];
-  uint32_t tag_words[kAesGcmTagNumWords];
-  memcpy(expected_tag_words, expected_tag, kAesGcmTagNumBytes);
-  memcpy(tag_words, tag, kAesGcmTagNumBytes);
-
-  // Compare the expected tag to the actual tag (in constant time).
-  *success = hardened_memeq(expected_tag_words, tag_words, kAesGcmTagNumWords);
   if (*success != kHardenedBoolTrue) {
-    // If authentication fails, do not proceed to decryption; simply exit
-    // with success = False. We still use `kAesOk` because there was no
-    // internal error during the authentication check.
-    return kAesOk;
+    // If authentication fails, do not release the plaintext. We still use
+    // `kAesOk` because there was no internal error during the authentication
+    // check.
+    if (ciphertext_len > 0) {
+      memset(plaintext, 0, ciphertext_len);
+    }
   }
-
-  // Compute plaintext P = GCTR(K, inc32(J0), ciphertext).
-  block_inc32(&j0);
-  return aes_gcm_gctr(key, &j0, ciphertext_len, ciphertext, plaintext);
+  return kAesOk;
 }
@@ -11,6 +11,7 @@
 #include "sw/device/lib/base/hardened.h"
 #include "sw/device/lib/base/macros.h"
 #include "sw/device/lib/crypto/drivers/aes.h"
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,55 @@ enum {
   kAesGcmTagNumWords = kAesGcmTagNumBytes / sizeof(uint32_t),
 };
 
+/**
+ * State of a streaming AES-GCM operation.
+ *
+ * Initialize with `aes_gcm_encrypt_init` or `aes_gcm_decrypt_init`. The
+ * context only stores pointers to the key shares, so they must stay valid
+ * until the operation is finished.
+ */
+typedef struct aes_gcm_context {
+  /**
+   * AES key.
+   */
+  aes_key_t key;
+  /**
+   * True for encryption, false for decryption.
+   */
+  hardened_bool_t is_encrypt;
+  /**
+   * Whether the first data has been seen (after which no more AAD is
+   * accepted).
+   */
+  hardened_bool_t data_started;
+  /**
+   * Initial counter block (J0 in the NIST specification).
+   */
+  aes_block_t initial_counter_block;
+  /**
+   * Counter block for the next block of data.
+   */
+  aes_block_t cb;
+  /**
+   * GHASH context for the hash subkey H, with the state over the AAD and
+   * ciphertext processed so far.
+   */
+  ghash_context_t ghash_ctx;
+  /**
+   * Total length of the AAD in bytes.
+   */
+  size_t aad_len;
+  /**
+   * Total length of the plaintext/ciphertext in bytes.
+   */
+  size_t input_len;
+  /**
+   * Buffered partial block of AAD or data, and its length in bytes.
+   */
+  uint8_t partial_block[kAesBlockNumBytes];
+  size_t partial_block_len;
+} aes_gcm_context_t;
+
 /**
  * AES-GCM authenticated encryption as defined in NIST SP800-38D, algorithm 4.
  *
@@ -53,6 +103,122 @@ aes_error_t aes_gcm_encrypt(const aes_key_t key, const size_t iv_len,
                             const uint8_t *plaintext, const size_t aad_len,
                             const uint8_t *aad, uint8_t *ciphertext,
                             uint8_t *tag);
+
+/**
+ * Starts a streaming AES-GCM authenticated encryption.
+ *
+ * The streaming interface computes the same result as `aes_gcm_encrypt`
+ * without requiring the whole message to be in memory at once. Call
+ * `aes_gcm_update_aad` for all associated data, then `aes_gcm_update` for all
+ * plaintext, and finally `aes_gcm_encrypt_final`.
+ *
+ * @param key AES key
+ * @param iv_len length of IV in bytes (12 or 16)
+ * @param iv IV value
+ * @param[out] ctx Context to initialize
+ * @return Error status; OK if no errors
+ */
+OT_WARN_UNUSED_RESULT
+aes_error_t aes_gcm_encrypt_init(const aes_key_t key, const size_t iv_len,
+                                 const uint8_t *iv, aes_gcm_context_t *ctx);
+
+/**
+ * Starts a streaming AES-GCM authenticated decryption.
+ *
+ * Call `aes_gcm_update_aad` for all associated data, then `aes_gcm_update`
+ * for all ciphertext, and finally `aes_gcm_decrypt_final`.
+ *
+ * Note that the plaintext is released before the tag has been checked; the
+ * caller must discard all output if `aes_gcm_decrypt_final` reports that
+ * authentication failed.
+ *
+ * @param key AES key
+ * @param iv_len length of IV in bytes (12 or 16)
+ * @param iv IV value
+ * @param[out] ctx Context to initialize
+ * @return Error status; OK if no errors
+ */
+OT_WARN_UNUSED_RESULT
+aes_error_t aes_gcm_decrypt_init(const aes_key_t key, const size_t iv_len,
+                                 const uint8_t *iv, aes_gcm_context_t *ctx);
+
+/**
+ * Adds associated data to a streaming AES-GCM operation.
+ *
+ * May be called any number of times with any lengths, but not after
+ * `aes_gcm_update`. The total length of the AAD must be < 2^32 bytes.
+ *
+ * @param ctx AES-GCM context
+ * @param aad_len length of AAD in bytes
+ * @param aad AAD value (may be NULL if aad_len is 0)
+ * @return Error status; OK if no errors
+ */
+OT_WARN_UNUSED_RESULT
+aes_error_t aes_gcm_update_aad(aes_gcm_context_t *ctx, size_t aad_len,
+                               const uint8_t *aad);
+
+/**
+ * Encrypts or decrypts data in a streaming AES-GCM operation.
+ *
+ * The data is run through the AES hardware in CTR mode and the ciphertext is
+ * absorbed into GHASH in the same pass. Only full blocks are processed; the
+ * remaining bytes are buffered in the context and processed with the next
+ * call. The output buffer must therefore have room for `input_len` rounded up
+ * to the next multiple of the block size, and `output_len` is set to the
+ * number of bytes actually written (a multiple of the block size).
+ *
+ * The output buffer may overlap the input buffer as long as it does not start
+ * after it. In particular, `output` may be the same as `input`, and a message
+ * can be processed in place across several calls by writing the output of
+ * each call directly after the output of the previous one.
+ *
+ * The total length of the data must be < 2^32 bytes.
+ *
+ * @param ctx AES-GCM context
+ * @param input_len length of input in bytes
+ * @param input Plaintext or ciphertext (may be NULL if input_len is 0)
+ * @param[out] output_len Number of bytes written to `output`
+ * @param[out] output Output buffer (may overlap `input`, see above)
+ * @return Error status; OK if no errors
+ */
+OT_WARN_UNUSED_RESULT
+aes_error_t aes_gcm_update(aes_gcm_context_t *ctx, size_t input_len,
+                           const uint8_t *input, size_t *output_len,
+                           uint8_t *output);
+
+/**
+ * Finishes a streaming AES-GCM authenticated encryption.
+ *
+ * Encrypts any buffered data and computes the tag.
+ *
+ * @param ctx AES-GCM context
+ * @param[out] output_len Number of bytes written to `output` (< 16)
+ * @param[out] output Output buffer for the remaining ciphertext
+ * @param[out] tag Output buffer for tag (128 bits)
+ * @return Error status; OK if no errors
+ */
+OT_WARN_UNUSED_RESULT
+aes_error_t aes_gcm_encrypt_final(aes_gcm_context_t *ctx, size_t *output_len,
+                                  uint8_t *output, uint8_t *tag);
+
+/**
+ * Finishes a streaming AES-GCM authenticated decryption.
+ *
+ * Decrypts any buffered data and checks the tag. See `aes_gcm_decrypt` for
+ * the distinction between the return value and `success`.
+ *
+ * @param ctx AES-GCM context
+ * @param tag Authentication tag (128 bits)
+ * @param[out] output_len Number of bytes written to `output` (< 16)
+ * @param[out] output Output buffer for the remaining plaintext
+ * @param[out] success True if authentication was successful, otherwise false
+ * @return Error status; OK if no errors
+ */
+OT_WARN_UNUSED_RESULT
+aes_error_t aes_gcm_decrypt_final(aes_gcm_context_t *ctx, const uint8_t *tag,
+                                  size_t *output_len, uint8_t *output,
+                                  hardened_bool_t *success);
+
 /**
  * GHASH operation as defined in NIST SP800-38D, algorithm 2.
  *
@@ -84,7 +250,7 @@ aes_error_t aes_gcm_ghash(const aes_block_t *hash_subkey,
  * tighter constraint than the length limits in section 5.2.1.1.
  *
  * If authentication fails, this function will return `kHardenedBoolFalse` for
- * the `success` output parameter, and the plaintext should be ignored. Note
+ * the `success` output parameter, and the plaintext buffer is cleared. Note
  * the distinction between the `success` output parameter and the return value
  * (type `aes_error_t`): the return value indicates whether there was an
  * internal error while processing the function, and `success` indicates
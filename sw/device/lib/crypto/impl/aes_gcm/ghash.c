@@ -0,0 +1,423 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+
+/**
+ * Load a block from memory.
+ *
+ * Converts from the byte order of the spec to big-endian words (see
+ * `ghash_block_t`).
+ *
+ * @param src Source buffer, 16 bytes
+ * @param[out] dst Destination block
+ */
+static inline void block_load(const uint8_t *src, ghash_block_t *dst) {
+  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
+    dst->data[i] = __builtin_bswap32(read_32(&src[i * sizeof(uint32_t)]));
+  }
+}
+
+/**
+ * Performs a bitwise XOR of two blocks.
+ *
+ * This operation corresponds to addition in the Galois field.
+ *
+ * @param x First operand block
+ * @param y Second operand block
+ * @param[out] out Buffer in which to store output; can be the same as one or
+ * both operands.
+ */
+static inline void block_xor(const ghash_block_t *x, const ghash_block_t *y,
+                             ghash_block_t *out) {
+  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
+    out->data[i] = x->data[i] ^ y->data[i];
+  }
+}
+
+#if !defined(GHASH_IMPL_CLMUL)
+
+#if defined(GHASH_IMPL_TABLE8)
+enum {
+  /* Number of bits per window. */
+  kWindowNumBits = 8,
+};
+
+/**
+ * Precomputed modular reduction constants for 8-bit windows.
+ *
+ * When an element is multiplied by x^8, the 8 bits shifted out at the bottom
+ * (the coefficients of x^120..x^127) overflow to x^128..x^135. Since
+ * x^128 = x^7 + x^2 + x + 1 in the GCM field, each of them is reduced by
+ * adding a shifted copy of 0xe1 (which represents x^7 + x^2 + x + 1 in the
+ * top byte) to the top 16 bits. Entry i of this table is the sum for the
+ * overflow bits i.
+ */
+static const uint16_t kGFReduceTable[256] = {
+    0x0000, 0x01c2, 0x0384, 0x0246, 0x0708, 0x06ca, 0x048c, 0x054e,
+    0x0e10, 0x0fd2, 0x0d94, 0x0c56, 0x0918, 0x08da, 0x0a9c, 0x0b5e,
+    0x1c20, 0x1de2, 0x1fa4, 0x1e66, 0x1b28, 0x1aea, 0x18ac, 0x196e,
+    0x1230, 0x13f2, 0x11b4, 0x1076, 0x1538, 0x14fa, 0x16bc, 0x177e,
+    0x3840, 0x3982, 0x3bc4, 0x3a06, 0x3f48, 0x3e8a, 0x3ccc, 0x3d0e,
+    0x3650, 0x3792, 0x35d4, 0x3416, 0x3158, 0x309a, 0x32dc, 0x331e,
+    0x2460, 0x25a2, 0x27e4, 0x2626, 0x2368, 0x22aa, 0x20ec, 0x212e,
+    0x2a70, 0x2bb2, 0x29f4, 0x2836, 0x2d78, 0x2cba, 0x2efc, 0x2f3e,
+    0x7080, 0x7142, 0x7304, 0x72c6, 0x7788, 0x764a, 0x740c, 0x75ce,
+    0x7e90, 0x7f52, 0x7d14, 0x7cd6, 0x7998, 0x785a, 0x7a1c, 0x7bde,
+    0x6ca0, 0x6d62, 0x6f24, 0x6ee6, 0x6ba8, 0x6a6a, 0x682c, 0x69ee,
+    0x62b0, 0x6372, 0x6134, 0x60f6, 0x65b8, 0x647a, 0x663c, 0x67fe,
+    0x48c0, 0x4902, 0x4b44, 0x4a86, 0x4fc8, 0x4e0a, 0x4c4c, 0x4d8e,
+    0x46d0, 0x4712, 0x4554, 0x4496, 0x41d8, 0x401a, 0x425c, 0x439e,
+    0x54e0, 0x5522, 0x5764, 0x56a6, 0x53e8, 0x522a, 0x506c, 0x51ae,
+    0x5af0, 0x5b32, 0x5974, 0x58b6, 0x5df8, 0x5c3a, 0x5e7c, 0x5fbe,
+    0xe100, 0xe0c2, 0xe284, 0xe346, 0xe608, 0xe7ca, 0xe58c, 0xe44e,
+    0xef10, 0xeed2, 0xec94, 0xed56, 0xe818, 0xe9da, 0xeb9c, 0xea5e,
+    0xfd20, 0xfce2, 0xfea4, 0xff66, 0xfa28, 0xfbea, 0xf9ac, 0xf86e,
+    0xf330, 0xf2f2, 0xf0b4, 0xf176, 0xf438, 0xf5fa, 0xf7bc, 0xf67e,
+    0xd940, 0xd882, 0xdac4, 0xdb06, 0xde48, 0xdf8a, 0xddcc, 0xdc0e,
+    0xd750, 0xd692, 0xd4d4, 0xd516, 0xd058, 0xd19a, 0xd3dc, 0xd21e,
+    0xc560, 0xc4a2, 0xc6e4, 0xc726, 0xc268, 0xc3aa, 0xc1ec, 0xc02e,
+    0xcb70, 0xcab2, 0xc8f4, 0xc936, 0xcc78, 0xcdba, 0xcffc, 0xce3e,
+    0x9180, 0x9042, 0x9204, 0x93c6, 0x9688, 0x974a, 0x950c, 0x94ce,
+    0x9f90, 0x9e52, 0x9c14, 0x9dd6, 0x9898, 0x995a, 0x9b1c, 0x9ade,
+    0x8da0, 0x8c62, 0x8e24, 0x8fe6, 0x8aa8, 0x8b6a, 0x892c, 0x88ee,
+    0x83b0, 0x8272, 0x8034, 0x81f6, 0x84b8, 0x857a, 0x873c, 0x86fe,
+    0xa9c0, 0xa802, 0xaa44, 0xab86, 0xaec8, 0xaf0a, 0xad4c, 0xac8e,
+    0xa7d0, 0xa612, 0xa454, 0xa596, 0xa0d8, 0xa11a, 0xa35c, 0xa29e,
+    0xb5e0, 0xb422, 0xb664, 0xb7a6, 0xb2e8, 0xb32a, 0xb16c, 0xb0ae,
+    0xbbf0, 0xba32, 0xb874, 0xb9b6, 0xbcf8, 0xbd3a, 0xbf7c, 0xbebe,
+};
+#else
+enum {
+  /* Number of bits per window. */
+  kWindowNumBits = 4,
+};
+
+/**
+ * Precomputed modular reduction constants for 4-bit windows.
+ *
+ * See the 8-bit version above; entry i is the value to add to the top 16 bits
+ * when the 4 bits i are shifted out at the bottom.
+ */
+static const uint16_t kGFReduceTable[16] = {
+    0x0000, 0x1c20, 0x3840, 0x2460, 0x7080, 0x6ca0, 0x48c0, 0x54e0,
+    0xe100, 0xfd20, 0xd940, 0xc560, 0x9180, 0x8da0, 0xa9c0, 0xb5e0};
+#endif
+
+enum {
+  /* Number of entries in a product table. */
+  kTableNumEntries = 1 << kWindowNumBits,
+  /* Mask for a single window. */
+  kWindowMask = kTableNumEntries - 1,
+  /* Number of windows in a block. */
+  kNumWindows = 128 / kWindowNumBits,
+};
+
+/**
+ * Logical right shift of a block by less than 32 bits.
+ *
+ * @param block Input block, modified in-place
+ * @param nbits Number of bits to shift, 0 < nbits < 32
+ */
+static inline void block_shiftr(ghash_block_t *block, size_t nbits) {
+  for (size_t i = kGhashBlockNumWords - 1; i > 0; --i) {
+    block->data[i] =
+        (block->data[i] >> nbits) | (block->data[i - 1] << (32 - nbits));
+  }
+  block->data[0] >>= nbits;
+}
+
+/**
+ * Multiply an element of the GCM Galois field by the polynomial `x`.
+ *
+ * This corresponds to a shift right in the bit representation, and then
+ * reduction with the field modulus.
+ *
+ * Runs in constant time.
+ *
+ * @param p Polynomial to be multiplied
+ * @param[out] out Buffer for output
+ */
+static inline void galois_mulx(const ghash_block_t *p, ghash_block_t *out) {
+  // If the coefficient of x^127 is set, subtract the polynomial that
+  // corresponds to (modulus - 2^128) after shifting.
+  uint32_t mask = 0 - (p->data[kGhashBlockNumWords - 1] & 1);
+  memcpy(out->data, p->data, kGhashBlockNumBytes);
+  block_shiftr(out, 1);
+  out->data[0] ^= 0xe1000000 & mask;
+}
+
+/**
+ * Construct the product table for an element of the field.
+ *
+ * Entry i of the table is i * y, where the most significant bit of the window
+ * value i is the coefficient of x^0.
+ *
+ * @param y Field element
+ * @param[out] tbl Product table, `kTableNumEntries` entries
+ */
+static void make_product_table(const ghash_block_t *y, ghash_block_t *tbl) {
+  memset(tbl[0].data, 0, kGhashBlockNumBytes);
+  // Single bits: y, y * x, y * x^2, ...
+  memcpy(tbl[kTableNumEntries >> 1].data, y->data, kGhashBlockNumBytes);
+  for (size_t i = kTableNumEntries >> 2; i > 0; i >>= 1) {
+    galois_mulx(&tbl[i << 1], &tbl[i]);
+  }
+  // All other entries are sums of the single-bit entries.
+  for (size_t i = 2; i < kTableNumEntries; i <<= 1) {
+    for (size_t j = 1; j < i; ++j) {
+      block_xor(&tbl[i], &tbl[j], &tbl[i + j]);
+    }
+  }
+}
+
+/**
+ * Retrieve a window of coefficients from a block.
+ *
+ * Window 0 holds the lowest-degree coefficients.
+ *
+ * @param block Input block
+ * @param index Index of the window, must be < `kNumWindows`
+ * @return Window value; the most significant bit is the lowest degree.
+ */
+static inline uint32_t window_get(const ghash_block_t *block, size_t index) {
+  size_t bit = index * kWindowNumBits;
+  return (block->data[bit / 32] >> (32 - kWindowNumBits - bit % 32)) &
+         kWindowMask;
+}
+
+/**
+ * Computes the sum of products x[i] * H^(n-i) for i = 0..n-1.
+ *
+ * Horner's rule is applied over the windows of all n operands at once: for
+ * each window, starting with the highest-degree one, the accumulator is
+ * multiplied by x^w and reduced, and then the table entries of all operands
+ * are added. The shift and reduction are therefore shared between the n
+ * products.
+ *
+ * @param ctx GHASH context with the product tables
+ * @param x Operands
+ * @param n Number of operands, at most `kGhashAggregateNumBlocks`
+ * @param[out] result Buffer for the result
+ */
+static void galois_mul_sum(const ghash_context_t *ctx, const ghash_block_t *x,
+                           size_t n, ghash_block_t *result) {
+  const ghash_block_t *tbls = (const ghash_block_t *)ctx->tbl;
+  memset(result->data, 0, kGhashBlockNumBytes);
+  for (size_t i = kNumWindows; i-- > 0;) {
+    if (i != kNumWindows - 1) {
+      // Multiply by x^w and reduce the coefficients shifted out.
+      uint32_t overflow = result->data[kGhashBlockNumWords - 1] & kWindowMask;
+      block_shiftr(result, kWindowNumBits);
+      result->data[0] ^= (uint32_t)kGFReduceTable[overflow] << 16;
+    }
+    for (size_t k = 0; k < n; ++k) {
+      const ghash_block_t *tbl = &tbls[(n - 1 - k) * kTableNumEntries];
+      block_xor(result, &tbl[window_get(&x[k], i)], result);
+    }
+  }
+}
+
+void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx) {
+  ghash_block_t *tbls = (ghash_block_t *)ctx->tbl;
+  ghash_block_t power;
+  block_load((const uint8_t *)hash_subkey, &power);
+  make_product_table(&power, tbls);
+  for (size_t k = 1; k < kGhashAggregateNumBlocks; ++k) {
+    // H^(k+1) = H^k * H, using the table for H.
+    ghash_block_t next;
+    galois_mul_sum(ctx, &power, 1, &next);
+    memcpy(power.data, next.data, kGhashBlockNumBytes);
+    make_product_table(&power, &tbls[k * kTableNumEntries]);
+  }
+}
+
+#else  // defined(GHASH_IMPL_CLMUL)
+
+/**
+ * Carry-less multiplication of two 32-bit words.
+ *
+ * @param a First operand
+ * @param b Second operand
+ * @return 63-bit carry-less product
+ */
+static inline uint64_t clmul32(uint32_t a, uint32_t b) {
+#if (defined(__riscv_zbc) || defined(__riscv_zbkc)) && __riscv_xlen == 32
+  uint32_t lo, hi;
+  asm("clmul %0, %1, %2" : "=r"(lo) : "r"(a), "r"(b));
+  asm("clmulh %0, %1, %2" : "=r"(hi) : "r"(a), "r"(b));
+  return ((uint64_t)hi << 32) | lo;
+#else
+  // Integer multiplication with "holes": each operand is split into four
+  // parts with every fourth bit set, so that the carries of the (at most
+  // eight) terms summed at each bit position never reach the next bit of the
+  // same part.
+  const uint32_t kMask = 0x11111111;
+  uint64_t a0 = a & kMask, a1 = a & (kMask << 1), a2 = a & (kMask << 2),
+           a3 = a & (kMask << 3);
+  uint64_t b0 = b & kMask, b1 = b & (kMask << 1), b2 = b & (kMask << 2),
+           b3 = b & (kMask << 3);
+  uint64_t z0 = (a0 * b0) ^ (a1 * b3) ^ (a2 * b2) ^ (a3 * b1);
+  uint64_t z1 = (a0 * b1) ^ (a1 * b0) ^ (a2 * b3) ^ (a3 * b2);
+  uint64_t z2 = (a0 * b2) ^ (a1 * b1) ^ (a2 * b0) ^ (a3 * b3);
+  uint64_t z3 = (a0 * b3) ^ (a1 * b2) ^ (a2 * b1) ^ (a3 * b0);
+  const uint64_t kMask64 = 0x1111111111111111;
+  return (z0 & kMask64) | (z1 & (kMask64 << 1)) | (z2 & (kMask64 << 2)) |
+         (z3 & (kMask64 << 3));
+#endif
+}
+
+/**
+ * Carry-less multiplication of two 64-bit words (Karatsuba).
+ *
+ * @param a First operand
+ * @param b Second operand
+ * @param[out] hi Upper 64 bits of the product
+ * @param[out] lo Lower 64 bits of the product
+ */
+static inline void clmul64(uint64_t a, uint64_t b, uint64_t *hi,
+                           uint64_t *lo) {
+  uint32_t a0 = (uint32_t)a, a1 = (uint32_t)(a >> 32);
+  uint32_t b0 = (uint32_t)b, b1 = (uint32_t)(b >> 32);
+  uint64_t z0 = clmul32(a0, b0);
+  uint64_t z2 = clmul32(a1, b1);
+  uint64_t z1 = clmul32(a0 ^ a1, b0 ^ b1) ^ z0 ^ z2;
+  *lo = z0 ^ (z1 << 32);
+  *hi = z2 ^ (z1 >> 32);
+}
+
+/**
+ * Adds the unreduced 255-bit product of two blocks to an accumulator.
+ *
+ * Uses one level of Karatsuba on top of `clmul64`, i.e. nine 32-bit
+ * carry-less multiplications.
+ *
+ * @param x First operand
+ * @param y Second operand
+ * @param acc Accumulator, most significant word first, updated in place
+ */
+static inline void clmul128_acc(const ghash_block_t *x, const ghash_block_t *y,
+                                uint64_t acc[4]) {
+  uint64_t x1 = ((uint64_t)x->data[0] << 32) | x->data[1];
+  uint64_t x0 = ((uint64_t)x->data[2] << 32) | x->data[3];
+  uint64_t y1 = ((uint64_t)y->data[0] << 32) | y->data[1];
+  uint64_t y0 = ((uint64_t)y->data[2] << 32) | y->data[3];
+  uint64_t z0h, z0l, z1h, z1l, z2h, z2l;
+  clmul64(x0, y0, &z0h, &z0l);
+  clmul64(x1, y1, &z2h, &z2l);
+  clmul64(x0 ^ x1, y0 ^ y1, &z1h, &z1l);
+  z1h ^= z0h ^ z2h;
+  z1l ^= z0l ^ z2l;
+  acc[0] ^= z2h;
+  acc[1] ^= z2l ^ z1h;
+  acc[2] ^= z0h ^ z1l;
+  acc[3] ^= z0l;
+}
+
+/**
+ * Reduces a 255-bit product modulo the GCM polynomial.
+ *
+ * In the bit-reflected representation, the carry-less product of two
+ * elements has the coefficient of x^i at bit 254 - i. After a shift left by
+ * one, the upper half holds x^0..x^127 and the lower half D holds
+ * x^128..x^255. Since x^128 = x^7 + x^2 + x + 1, the lower half is folded in
+ * as D + D*x + D*x^2 + D*x^7 (right shifts), and the few bits shifted out in
+ * the process are folded in once more.
+ *
+ * @param p Product, most significant word first (clobbered)
+ * @param[out] result Reduced field element
+ */
+static inline void galois_reduce(uint64_t p[4], ghash_block_t *result) {
+  p[0] = (p[0] << 1) | (p[1] >> 63);
+  p[1] = (p[1] << 1) | (p[2] >> 63);
+  p[2] = (p[2] << 1) | (p[3] >> 63);
+  p[3] <<= 1;
+
+  uint64_t dh = p[2], dl = p[3];
+  // Bits of D shifted out by the right shifts below (degree >= 128 again).
+  uint64_t e = (dl << 63) ^ (dl << 62) ^ (dl << 57);
+  uint64_t hi = p[0] ^ dh ^ (dh >> 1) ^ (dh >> 2) ^ (dh >> 7);
+  uint64_t lo = p[1] ^ dl ^ ((dl >> 1) | (dh << 63)) ^
+                ((dl >> 2) | (dh << 62)) ^ ((dl >> 7) | (dh << 57));
+  hi ^= e ^ (e >> 1) ^ (e >> 2) ^ (e >> 7);
+
+  result->data[0] = (uint32_t)(hi >> 32);
+  result->data[1] = (uint32_t)hi;
+  result->data[2] = (uint32_t)(lo >> 32);
+  result->data[3] = (uint32_t)lo;
+}
+
+/**
+ * Computes the sum of products x[i] * H^(n-i) for i = 0..n-1.
+ *
+ * The unreduced products are accumulated and reduced only once.
+ *
+ * @param ctx GHASH context with the powers of H
+ * @param x Operands
+ * @param n Number of operands, at most `kGhashAggregateNumBlocks`
+ * @param[out] result Buffer for the result
+ */
+static void galois_mul_sum(const ghash_context_t *ctx, const ghash_block_t *x,
+                           size_t n, ghash_block_t *result) {
+  uint64_t acc[4] = {0, 0, 0, 0};
+  for (size_t k = 0; k < n; ++k) {
+    clmul128_acc(&x[k], &ctx->powers[n - 1 - k], acc);
+  }
+  galois_reduce(acc, result);
+}
+
+void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx) {
+  block_load((const uint8_t *)hash_subkey, &ctx->powers[0]);
+  for (size_t k = 1; k < kGhashAggregateNumBlocks; ++k) {
+    // H^(k+1) = H^k * H.
+    galois_mul_sum(ctx, &ctx->powers[k - 1], 1, &ctx->powers[k]);
+  }
+}
+
+#endif  // defined(GHASH_IMPL_CLMUL)
+
+void ghash_init(ghash_context_t *ctx) {
+  memset(ctx->state.data, 0, kGhashBlockNumBytes);
+}
+
+void ghash_update(ghash_context_t *ctx, size_t input_len,
+                  const uint8_t *input) {
+  ghash_block_t x[kGhashAggregateNumBlocks];
+  while (input_len > 0) {
+    // Collect up to `kGhashAggregateNumBlocks` blocks; a partial last block is
+    // padded with zeroes.
+    size_t n = 0;
+    for (; n < kGhashAggregateNumBlocks && input_len > 0; ++n) {
+      if (input_len >= kGhashBlockNumBytes) {
+        block_load(input, &x[n]);
+        input += kGhashBlockNumBytes;
+        input_len -= kGhashBlockNumBytes;
+      } else {
+        uint8_t buffer[kGhashBlockNumBytes];
+        memset(buffer, 0, kGhashBlockNumBytes);
+        memcpy(buffer, input, input_len);
+        block_load(buffer, &x[n]);
+        input_len = 0;
+      }
+    }
+
+    // state = (...((state + x[0]) * H + x[1]) * H ... + x[n-1]) * H
+    //       = (state + x[0]) * H^n + x[1] * H^(n-1) + ... + x[n-1] * H
+    block_xor(&x[0], &ctx->state, &x[0]);
+    galois_mul_sum(ctx, x, n, &ctx->state);
+  }
+}
+
+void ghash_final(const ghash_context_t *ctx, uint32_t *result) {
+  for (size_t i = 0; i < kGhashBlockNumWords; ++i) {
+    uint32_t word = __builtin_bswap32(ctx->state.data[i]);
+    memcpy(&result[i], &word, sizeof(word));
+  }
+}
@@ -0,0 +1,144 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_AES_GCM_GHASH_H_
+#define OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_AES_GCM_GHASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+
+/**
+ * @file
+ * @brief GHASH, the universal hash function of GCM (NIST SP800-38D).
+ *
+ * The multiplication backend is selected at compile time:
+ *
+ * - Default: 4-bit (16-entry) product tables for H, H^2, H^3 and H^4 (1 KiB
+ *   per key). Four blocks are processed at once with one shared shift and
+ *   reduction per 4-bit window (aggregated reduction).
+ * - `GHASH_IMPL_TABLE8`: 8-bit (256-entry) product table for H (4 KiB per
+ *   key). Halves the number of shift and reduction steps per block compared
+ *   to 4-bit windows. Tables for further powers of H are not kept, since they
+ *   would take another 12 KiB per key.
+ * - `GHASH_IMPL_CLMUL`: Karatsuba multiplication built from 32x32-bit
+ *   carry-less multiplications, with H, H^2, H^3 and H^4 precomputed (64 bytes
+ *   per key). Four products are accumulated and reduced once. Uses the
+ *   `clmul`/`clmulh` instructions if the compiler targets Zbc or Zbkc, and a
+ *   constant-time software multiplication otherwise.
+ *
+ * Constant-time properties: the table backends index the tables with bits of
+ * the (secret) GHASH state. This is only constant-time on cores without a
+ * data cache, such as Ibex in OpenTitan; on other platforms, use the clmul
+ * backend. The clmul backend has no secret-dependent memory accesses or
+ * branches; its software fallback relies on integer multiplication having a
+ * data-independent latency, which is the case for Ibex.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+enum {
+  /** Number of bytes in a GHASH block. */
+  kGhashBlockNumBytes = 128 / 8,
+  /** Number of 32-bit words in a GHASH block. */
+  kGhashBlockNumWords = kGhashBlockNumBytes / sizeof(uint32_t),
+#if defined(GHASH_IMPL_TABLE8)
+  /** Number of blocks processed at once. */
+  kGhashAggregateNumBlocks = 1,
+#else
+  /** Number of blocks processed at once. */
+  kGhashAggregateNumBlocks = 4,
+#endif
+};
+
+/**
+ * An element of the GCM field.
+ *
+ * GCM stores the coefficient of x^0 in the most significant bit of the first
+ * byte. Elements are therefore kept as 128-bit big-endian integers, with the
+ * most significant word first, so that multiplication by x is a right shift.
+ */
+typedef struct ghash_block {
+  uint32_t data[kGhashBlockNumWords];
+} ghash_block_t;
+
+/**
+ * GHASH context.
+ *
+ * Holds the precomputed multiples or powers of the hash subkey H (depending
+ * on the backend) and the GHASH state.
+ */
+typedef struct ghash_context {
+#if defined(GHASH_IMPL_TABLE8)
+  /**
+   * Product table of H; entry i is i * H, with the most significant bit of i
+   * being the coefficient of x^0.
+   */
+  ghash_block_t tbl[256];
+#elif defined(GHASH_IMPL_CLMUL)
+  /**
+   * Powers of H; entry i is H^(i+1).
+   */
+  ghash_block_t powers[kGhashAggregateNumBlocks];
+#else
+  /**
+   * Product tables of the powers of H; table i holds the products of H^(i+1)
+   * with all 4-bit values.
+   */
+  ghash_block_t tbl[kGhashAggregateNumBlocks][16];
+#endif
+  /**
+   * Current GHASH state.
+   */
+  ghash_block_t state;
+} ghash_context_t;
+
+/**
+ * Precompute the key-dependent tables for the hash subkey H.
+ *
+ * Does not change the GHASH state; call `ghash_init` before hashing.
+ *
+ * @param hash_subkey Hash subkey H, 16 bytes in the byte order of the spec.
+ * @param[out] ctx GHASH context to set up.
+ */
+void ghash_init_subkey(const uint32_t *hash_subkey, ghash_context_t *ctx);
+
+/**
+ * Reset the GHASH state to zero.
+ *
+ * @param ctx GHASH context.
+ */
+void ghash_init(ghash_context_t *ctx);
+
+/**
+ * Absorb input into the GHASH state.
+ *
+ * If the input length is not a multiple of the block size, the last block is
+ * padded with zeroes; the next call then starts with a new block.
+ *
+ * @param ctx GHASH context.
+ * @param input_len Number of bytes in the input.
+ * @param input Input buffer (may be NULL if `input_len` is 0).
+ */
+void ghash_update(ghash_context_t *ctx, size_t input_len, const uint8_t *input);
+
+/**
+ * Read out the GHASH state.
+ *
+ * The state is not modified, so more input may be absorbed afterwards.
+ *
+ * @param ctx GHASH context.
+ * @param[out] result Buffer for the result, 16 bytes in the byte order of the
+ * spec.
+ */
+void ghash_final(const ghash_context_t *ctx, uint32_t *result);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_CRYPTO_IMPL_AES_GCM_GHASH_H_
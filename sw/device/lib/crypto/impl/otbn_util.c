@@ -39,6 +39,21 @@ static bool check_app_address_ranges(const otbn_app_t *app) {
   return true;
 }
 
+/**
+ * Checks whether the IMEM image of `app` is still resident in OTBN.
+ *
+ * @param app the OTBN application to check
+ * @return kHardenedBoolTrue if IMEM holds the image of `app`.
+ */
+static hardened_bool_t app_is_resident(const otbn_app_t *app) {
+  uintptr_t tag = (uintptr_t)app->imem_start;
+  if (launder32(otbn_imem_tag_get()) == tag) {
+    HARDENED_CHECK_EQ(otbn_imem_tag_get(), tag);
+    return kHardenedBoolTrue;
+  }
+  return kHardenedBoolFalse;
+}
+
 otbn_error_t otbn_load_app(otbn_t *ctx, const otbn_app_t app) {
   if (!check_app_address_ranges(&app)) {
     return kOtbnErrorInvalidArgument;
@@ -52,9 +67,16 @@ otbn_error_t otbn_load_app(otbn_t *ctx, const otbn_app_t app) {
 
   ctx->app_is_loaded = kHardenedBoolFalse;
 
-  OTBN_RETURN_IF_ERROR(otbn_imem_sec_wipe());
-  OTBN_RETURN_IF_ERROR(otbn_imem_write(0, app.imem_start, imem_num_words));
+  // IMEM is only written by the driver and is not modified by OTBN, so if the
+  // image of this app is still resident it does not need to be reloaded.
+  if (app_is_resident(&app) != kHardenedBoolTrue) {
+    OTBN_RETURN_IF_ERROR(otbn_imem_sec_wipe());
+    OTBN_RETURN_IF_ERROR(otbn_imem_write(0, app.imem_start, imem_num_words));
+    otbn_imem_tag_set((uintptr_t)app.imem_start);
+  }
 
+  // DMEM may hold data of the previous operation and the initialized data of
+  // the app may have been modified, so always start from a clean DMEM.
   OTBN_RETURN_IF_ERROR(otbn_dmem_sec_wipe());
   if (data_num_words > 0) {
     OTBN_RETURN_IF_ERROR(
@@ -189,6 +189,11 @@ void otbn_init(otbn_t *ctx);
  * Load the application image with both instruction and data segments into
  * OTBN.
  *
+ * The instruction segment is only written if it is not still resident from
+ * a previous load of the same application (see `otbn_imem_tag_get()`), so
+ * repeated operations with the same application only pay for the data
+ * segment. DMEM is always wiped and reinitialized.
+ *
  * This function will return an error if called when OTBN is not idle.
  *
  * @param ctx The context object.
@@ -161,55 +161,60 @@ otbn_error_t rsa_3072_compute_constants(const rsa_3072_public_key_t *public_key,
   return kOtbnErrorOk;
 }
 
-// TODO: This implementation waits while OTBN is processing; it should be
-// modified to be non-blocking.
-otbn_error_t rsa_3072_verify(const rsa_3072_int_t *signature,
-                             const rsa_3072_int_t *message,
-                             const rsa_3072_public_key_t *public_key,
-                             const rsa_3072_constants_t *constants,
-                             hardened_bool_t *result) {
-  // Initially set the result to false in case of early returns due to invalid
-  // arguments.
-  *result = kHardenedBoolFalse;
-
-  // Only the F4 modulus is supported.
-  if (public_key->e != 65537) {
-    return kOtbnErrorInvalidArgument;
-  }
-
-  // Reject the signature if it is too large (n <= sig): RFC 8017, section
-  // 5.2.2, step 1.
-  if (memrcmp(public_key->n.data, signature->data, kRsa3072NumBytes) <= 0) {
-    return kOtbnErrorInvalidArgument;
-  }
-
+/**
+ * Loads the RSA app and writes the key and constants for modexp mode.
+ *
+ * @param otbn The OTBN context object.
+ * @param public_key Key to check signatures against.
+ * @param constants Precomputed Montgomery constants for `public_key`.
+ * @return The result of the operation.
+ */
+static otbn_error_t rsa_3072_verify_setup(
+    otbn_t *otbn, const rsa_3072_public_key_t *public_key,
+    const rsa_3072_constants_t *constants) {
   // Initialize OTBN and load the RSA app.
-  otbn_t otbn;
-  otbn_init(&otbn);
-  OTBN_RETURN_IF_ERROR(otbn_load_app(&otbn, kOtbnAppRsa));
+  otbn_init(otbn);
+  OTBN_RETURN_IF_ERROR(otbn_load_app(otbn, kOtbnAppRsa));
 
   // Set mode to perform modular exponentiation.
   OTBN_RETURN_IF_ERROR(otbn_copy_data_to_otbn(
-      &otbn, kOtbnRsaModeNumWords, &kOtbnRsaModeModexp, kOtbnVarRsaMode));
+      otbn, kOtbnRsaModeNumWords, &kOtbnRsaModeModexp, kOtbnVarRsaMode));
 
   // Set the modulus (n).
   OTBN_RETURN_IF_ERROR(
-      write_rsa_3072_int_to_otbn(&otbn, &public_key->n, kOtbnVarRsaInMod));
-
-  // Set the signature.
-  OTBN_RETURN_IF_ERROR(
-      write_rsa_3072_int_to_otbn(&otbn, signature, kOtbnVarRsaInBuf));
+      write_rsa_3072_int_to_otbn(otbn, &public_key->n, kOtbnVarRsaInMod));
 
   // Set the precomputed constant R^2.
   OTBN_RETURN_IF_ERROR(
-      write_rsa_3072_int_to_otbn(&otbn, &constants->rr, kOtbnVarRsaRR));
+      write_rsa_3072_int_to_otbn(otbn, &constants->rr, kOtbnVarRsaRR));
 
   // Set the precomputed constant m0_inv.
-  OTBN_RETURN_IF_ERROR(otbn_copy_data_to_otbn(
-      &otbn, kOtbnWideWordNumWords, constants->m0_inv, kOtbnVarRsaM0Inv));
+  return otbn_copy_data_to_otbn(otbn, kOtbnWideWordNumWords, constants->m0_inv,
+                                kOtbnVarRsaM0Inv);
+}
+
+/**
+ * Verifies one signature with the key set up by `rsa_3072_verify_setup`.
+ *
+ * The modexp routine only writes the output buffer, so the key and constants
+ * in DMEM can be reused across calls.
+ *
+ * @param otbn The OTBN context object.
+ * @param signature Signature to be verified.
+ * @param message Encoded message representative to check the signature against.
+ * @param[out] result True iff the signature is valid.
+ * @return The result of the operation.
+ */
+static otbn_error_t rsa_3072_verify_one(otbn_t *otbn,
+                                        const rsa_3072_int_t *signature,
+                                        const rsa_3072_int_t *message,
+                                        hardened_bool_t *result) {
+  // Set the signature.
+  OTBN_RETURN_IF_ERROR(
+      write_rsa_3072_int_to_otbn(otbn, signature, kOtbnVarRsaInBuf));
 
   // Start the OTBN routine.
-  OTBN_RETURN_IF_ERROR(otbn_execute_app(&otbn));
+  OTBN_RETURN_IF_ERROR(otbn_execute_app(otbn));
 
   // Spin here waiting for OTBN to complete.
   OTBN_RETURN_IF_ERROR(otbn_busy_wait_for_done());
@@ -217,7 +222,7 @@ otbn_error_t rsa_3072_verify(const rsa_3072_int_t *signature,
   // Read recovered message out of OTBN dmem.
   rsa_3072_int_t recoveredMessage;
   OTBN_RETURN_IF_ERROR(
-      read_rsa_3072_int_from_otbn(&otbn, kOtbnVarRsaOutBuf, &recoveredMessage));
+      read_rsa_3072_int_from_otbn(otbn, kOtbnVarRsaOutBuf, &recoveredMessage));
 
   // TODO: harden this memory comparison
   // Check if recovered message matches expectation
@@ -230,3 +235,63 @@ otbn_error_t rsa_3072_verify(const rsa_3072_int_t *signature,
 
   return kOtbnErrorOk;
 }
+
+// TODO: This implementation waits while OTBN is processing; it should be
+// modified to be non-blocking.
+otbn_error_t rsa_3072_verify(const rsa_3072_int_t *signature,
+                             const rsa_3072_int_t *message,
+                             const rsa_3072_public_key_t *public_key,
+                             const rsa_3072_constants_t *constants,
+                             hardened_bool_t *result) {
+  // Initially set the result to false in case of early returns due to invalid
+  // arguments.
+  *result = kHardenedBoolFalse;
+
+  // Only the F4 modulus is supported.
+  if (public_key->e != 65537) {
+    return kOtbnErrorInvalidArgument;
+  }
+
+  // Reject the signature if it is too large (n <= sig): RFC 8017, section
+  // 5.2.2, step 1.
+  if (memrcmp(public_key->n.data, signature->data, kRsa3072NumBytes) <= 0) {
+    return kOtbnErrorInvalidArgument;
+  }
+
+  otbn_t otbn;
+  OTBN_RETURN_IF_ERROR(rsa_3072_verify_setup(&otbn, public_key, constants));
+  return rsa_3072_verify_one(&otbn, signature, message, result);
+}
+
+otbn_error_t rsa_3072_verify_batch(size_t num_signatures,
+                                   const rsa_3072_int_t *signatures,
+                                   const rsa_3072_int_t *messages,
+                                   const rsa_3072_public_key_t *public_key,
+                                   const rsa_3072_constants_t *constants,
+                                   hardened_bool_t *results) {
+  // Initially set the results to false in case of early returns due to
+  // invalid arguments.
+  for (size_t i = 0; i < num_signatures; i++) {
+    results[i] = kHardenedBoolFalse;
+  }
+
+  // Only the F4 modulus is supported.
+  if (public_key->e != 65537) {
+    return kOtbnErrorInvalidArgument;
+  }
+
+  otbn_t otbn;
+  OTBN_RETURN_IF_ERROR(rsa_3072_verify_setup(&otbn, public_key, constants));
+  for (size_t i = 0; i < num_signatures; i++) {
+    // Reject the signature if it is too large (n <= sig): RFC 8017, section
+    // 5.2.2, step 1.
+    if (memrcmp(public_key->n.data, signatures[i].data, kRsa3072NumBytes) <=
+        0) {
+      continue;
+    }
+    OTBN_RETURN_IF_ERROR(
+        rsa_3072_verify_one(&otbn, &signatures[i], &messages[i], &results[i]));
+  }
+
+  return kOtbnErrorOk;
+}
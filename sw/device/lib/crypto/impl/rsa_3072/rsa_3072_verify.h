@@ -125,6 +125,34 @@ otbn_error_t rsa_3072_verify(const rsa_3072_int_t *signature,
                              const rsa_3072_constants_t *constants,
                              hardened_bool_t *result);
 
+/**
+ * Verifies several RSA-3072 signatures under the same public key.
+ *
+ * The RSA app is loaded and the key and constants are written to OTBN once;
+ * each signature then only costs one signature upload, one OTBN run and one
+ * result readout.
+ *
+ * The key exponent must be 65537; no other exponents are supported.
+ * Signatures that are not smaller than the modulus are rejected (their result
+ * is false) without aborting the batch.
+ *
+ * @param num_signatures Number of signatures to verify.
+ * @param signatures Signatures to be verified (`num_signatures` entries).
+ * @param messages Encoded message representatives to check the signatures
+ * against (`num_signatures` entries).
+ * @param public_key Key to check the signatures against.
+ * @param constants Precomputed Montgomery constants for `public_key`.
+ * @param[out] results Buffer in which to store the outputs (`num_signatures`
+ * entries, true iff the corresponding signature is valid).
+ * @return Result of the operation (OK or error).
+ */
+otbn_error_t rsa_3072_verify_batch(size_t num_signatures,
+                                   const rsa_3072_int_t *signatures,
+                                   const rsa_3072_int_t *messages,
+                                   const rsa_3072_public_key_t *public_key,
+                                   const rsa_3072_constants_t *constants,
+                                   hardened_bool_t *results);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
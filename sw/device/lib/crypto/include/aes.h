@@ -94,6 +94,14 @@ typedef enum aes_padding {
  */
 typedef struct gcm_ghash_context gcm_ghash_context_t;
 
+/**
+ * Context for a streaming AES-GCM operation.
+ *
+ * Representation is internal to the AES-GCM implementation; initialize
+ * with #otcrypto_aes_encrypt_gcm_init.
+ */
+typedef struct gcm_context gcm_context_t;
+
 /**
  * Generates a new AES key.
  *
@@ -171,6 +179,78 @@ crypto_status_t otcrypto_aes_encrypt_gcm(
     crypto_uint8_buf_t iv, crypto_uint8_buf_t aad, aead_gcm_tag_len_t tag_len,
     crypto_uint8_buf_t *ciphertext, crypto_uint8_buf_t *auth_tag);
 
+/**
+ * Starts a streaming AES-GCM authenticated encryption operation.
+ *
+ * The streaming interface produces the same ciphertext and tag as
+ * #otcrypto_aes_encrypt_gcm, but the caller can provide the AAD and
+ * plaintext in pieces instead of buffering the whole message. Call
+ * #otcrypto_aes_encrypt_gcm_update_aad for all AAD, then
+ * #otcrypto_aes_encrypt_gcm_update for all plaintext, and finally
+ * #otcrypto_aes_encrypt_gcm_final.
+ *
+ * The key must remain valid until the operation is finished.
+ *
+ * @param key Pointer to the blinded gcm-key struct.
+ * @param iv Initialization vector for the encryption function.
+ * @param[out] ctx Output GCM context object, caller-allocated.
+ * @return Result of the operation.
+ */
+crypto_status_t otcrypto_aes_encrypt_gcm_init(const crypto_blinded_key_t *key,
+                                              crypto_uint8_buf_t iv,
+                                              gcm_context_t *ctx);
+
+/**
+ * Adds additional authenticated data to a streaming AES-GCM encryption.
+ *
+ * May be called any number of times, but not after
+ * #otcrypto_aes_encrypt_gcm_update.
+ *
+ * @param ctx GCM context object.
+ * @param aad Additional authenticated data.
+ * @return Result of the operation.
+ */
+crypto_status_t otcrypto_aes_encrypt_gcm_update_aad(
+    gcm_context_t *ctx, crypto_const_uint8_buf_t aad);
+
+/**
+ * Encrypts plaintext in a streaming AES-GCM encryption.
+ *
+ * Every block of plaintext is encrypted by the AES hardware and the resulting
+ * ciphertext is authenticated in the same pass. Only whole blocks are
+ * output; a partial block is kept in the context until more data arrives or
+ * the operation is finished. The caller should allocate space for the
+ * `ciphertext` buffer (same length as input, rounded up to the next full
+ * block); the `len` field is set to the number of bytes written.
+ *
+ * @param ctx GCM context object.
+ * @param plaintext Input data to be encrypted and authenticated.
+ * @param[out] ciphertext Encrypted output data.
+ * @return Result of the operation.
+ */
+crypto_status_t otcrypto_aes_encrypt_gcm_update(
+    gcm_context_t *ctx, crypto_const_uint8_buf_t plaintext,
+    crypto_uint8_buf_t *ciphertext);
+
+/**
+ * Finishes a streaming AES-GCM encryption.
+ *
+ * Encrypts any buffered partial block and generates the authentication tag.
+ * The caller should allocate space for the `ciphertext` buffer (one block),
+ * whose `len` field is set to the number of bytes written, and for the
+ * `auth_tag` buffer (same as tag_len).
+ *
+ * @param ctx GCM context object.
+ * @param tag_len Length of authentication tag to be generated.
+ * @param[out] ciphertext Remaining encrypted output data.
+ * @param[out] auth_tag Generated authentication tag.
+ * @return Result of the operation.
+ */
+crypto_status_t otcrypto_aes_encrypt_gcm_final(gcm_context_t *ctx,
+                                               aead_gcm_tag_len_t tag_len,
+                                               crypto_uint8_buf_t *ciphertext,
+                                               crypto_uint8_buf_t *auth_tag);
+
 /**
  * Performs the AES-GCM authenticated decryption operation.
  *
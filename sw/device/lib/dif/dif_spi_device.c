@@ -350,16 +350,14 @@ typedef struct fifo_ptrs {
 } fifo_ptrs_t;
 
 /**
- * Expands read and write FIFO pointers out of `spi`, using the given FIFO
- * parameters.
+ * Expands read and write FIFO pointers out of a FIFO pointer register value,
+ * using the given FIFO parameters.
  *
- * @param spi the SPI device.
+ * @param ptr the FIFO pointer register value.
  * @param params bitfield parameters for the FIFO.
- * @return expanded pointers read out of `spi`.
+ * @return expanded pointers.
  */
-static fifo_ptrs_t decompress_ptrs(const dif_spi_device_handle_t *spi,
-                                   fifo_ptr_params_t params) {
-  uint32_t ptr = mmio_region_read32(spi->dev.base_addr, params.reg_offset);
+static fifo_ptrs_t decompress_ptr_reg(uint32_t ptr, fifo_ptr_params_t params) {
   uint16_t write_val =
       (uint16_t)((ptr >> params.write_offset) & params.write_mask);
   uint16_t read_val =
@@ -378,6 +376,20 @@ static fifo_ptrs_t decompress_ptrs(const dif_spi_device_handle_t *spi,
   };
 }
 
+/**
+ * Expands read and write FIFO pointers out of `spi`, using the given FIFO
+ * parameters.
+ *
+ * @param spi the SPI device.
+ * @param params bitfield parameters for the FIFO.
+ * @return expanded pointers read out of `spi`.
+ */
+static fifo_ptrs_t decompress_ptrs(const dif_spi_device_handle_t *spi,
+                                   fifo_ptr_params_t params) {
+  return decompress_ptr_reg(
+      mmio_region_read32(spi->dev.base_addr, params.reg_offset), params);
+}
+
 /**
  * Writes back read and write FIFO pointers into `spi`, using the given FIFO
  * parameters.
@@ -630,6 +642,102 @@ dif_result_t dif_spi_device_send(dif_spi_device_handle_t *spi, const void *buf,
   return kDifOk;
 }
 
+/**
+ * Computes the regions of a span of `span_len` bytes that starts at `ptr` in
+ * a FIFO.
+ *
+ * @param ptr the FIFO pointer the span starts at.
+ * @param span_len the length of the span, in bytes.
+ * @param fifo_base the offset from start of SRAM for the FIFO.
+ * @param fifo_len the length of the FIFO, in bytes.
+ * @param[out] span the span to fill in.
+ */
+static void fifo_span_regions(fifo_ptr_t ptr, uint16_t span_len,
+                              uint16_t fifo_base, uint16_t fifo_len,
+                              dif_spi_device_fifo_span_t *span) {
+  uint16_t bytes_until_wrap = fifo_len - ptr.offset;
+  uint16_t first_len = span_len;
+  if (first_len > bytes_until_wrap) {
+    first_len = bytes_until_wrap;
+  }
+  span->regions[0] = (dif_spi_device_fifo_region_t){
+      .offset = SPI_DEVICE_BUFFER_REG_OFFSET + fifo_base + ptr.offset,
+      .len = first_len,
+  };
+  span->regions[1] = (dif_spi_device_fifo_region_t){
+      .offset = SPI_DEVICE_BUFFER_REG_OFFSET + fifo_base,
+      .len = span_len - first_len,
+  };
+}
+
+dif_result_t dif_spi_device_rx_span_get(const dif_spi_device_handle_t *spi,
+                                        dif_spi_device_fifo_span_t *span) {
+  if (spi == NULL || span == NULL) {
+    return kDifBadArg;
+  }
+
+  uint16_t fifo_len = spi->config.mode_cfg.generic.rx_fifo_len;
+  span->ptr_reg =
+      mmio_region_read32(spi->dev.base_addr, kRxFifoParams.reg_offset);
+  fifo_ptrs_t ptrs = decompress_ptr_reg(span->ptr_reg, kRxFifoParams);
+  fifo_span_regions(ptrs.read_ptr, fifo_bytes_in_use(ptrs, fifo_len),
+                    /*fifo_base=*/0, fifo_len, span);
+  return kDifOk;
+}
+
+dif_result_t dif_spi_device_rx_span_release(
+    dif_spi_device_handle_t *spi, const dif_spi_device_fifo_span_t *span,
+    size_t len) {
+  if (spi == NULL || span == NULL ||
+      len > span->regions[0].len + span->regions[1].len) {
+    return kDifBadArg;
+  }
+  if (len == 0) {
+    return kDifOk;
+  }
+
+  fifo_ptrs_t ptrs = decompress_ptr_reg(span->ptr_reg, kRxFifoParams);
+  fifo_ptr_increment(&ptrs.read_ptr, (uint16_t)len,
+                     spi->config.mode_cfg.generic.rx_fifo_len);
+  compress_ptrs(spi, kRxFifoParams, ptrs);
+  return kDifOk;
+}
+
+dif_result_t dif_spi_device_tx_span_get(const dif_spi_device_handle_t *spi,
+                                        dif_spi_device_fifo_span_t *span) {
+  if (spi == NULL || span == NULL) {
+    return kDifBadArg;
+  }
+
+  // Start of the TX FIFO is the end of the RX FIFO.
+  uint16_t fifo_base = spi->config.mode_cfg.generic.rx_fifo_len;
+  uint16_t fifo_len = spi->config.mode_cfg.generic.tx_fifo_len;
+  span->ptr_reg =
+      mmio_region_read32(spi->dev.base_addr, kTxFifoParams.reg_offset);
+  fifo_ptrs_t ptrs = decompress_ptr_reg(span->ptr_reg, kTxFifoParams);
+  uint16_t free_len = fifo_len - fifo_bytes_in_use(ptrs, fifo_len);
+  fifo_span_regions(ptrs.write_ptr, free_len, fifo_base, fifo_len, span);
+  return kDifOk;
+}
+
+dif_result_t dif_spi_device_tx_span_commit(
+    dif_spi_device_handle_t *spi, const dif_spi_device_fifo_span_t *span,
+    size_t len) {
+  if (spi == NULL || span == NULL ||
+      len > span->regions[0].len + span->regions[1].len) {
+    return kDifBadArg;
+  }
+  if (len == 0) {
+    return kDifOk;
+  }
+
+  fifo_ptrs_t ptrs = decompress_ptr_reg(span->ptr_reg, kTxFifoParams);
+  fifo_ptr_increment(&ptrs.write_ptr, (uint16_t)len,
+                     spi->config.mode_cfg.generic.tx_fifo_len);
+  compress_ptrs(spi, kTxFifoParams, ptrs);
+  return kDifOk;
+}
+
 dif_result_t dif_spi_device_enable_mailbox(dif_spi_device_handle_t *spi,
                                            uint32_t address) {
   if (spi == NULL) {
@@ -377,6 +377,117 @@ OT_WARN_UNUSED_RESULT
 dif_result_t dif_spi_device_send(dif_spi_device_handle_t *spi, const void *buf,
                                  size_t buf_len, size_t *bytes_sent);
 
+/**
+ * A contiguous region of a generic mode FIFO in the SPI device buffer.
+ */
+typedef struct dif_spi_device_fifo_region {
+  /**
+   * Offset of the region from the base address of the SPI device, for use
+   * with the `mmio_region_*()` functions.
+   */
+  uint32_t offset;
+  /**
+   * Length of the region in bytes.
+   */
+  size_t len;
+} dif_spi_device_fifo_region_t;
+
+/**
+ * The filled part of the RX FIFO or the free part of the TX FIFO.
+ *
+ * Since the FIFOs are circular buffers, a span consists of up to two regions;
+ * the second region is only non-empty if the span wraps around the end of the
+ * FIFO, in which case it starts at the beginning of the FIFO.
+ *
+ * As long as software only consumes and produces multiples of four bytes and
+ * the FIFO lengths are multiples of four bytes, both regions are word aligned
+ * and can be accessed with `mmio_region_read32()` and `mmio_region_write32()`
+ * directly, without read-modify-write.
+ */
+typedef struct dif_spi_device_fifo_span {
+  /**
+   * The regions of the span, in FIFO order.
+   */
+  dif_spi_device_fifo_region_t regions[2];
+  /**
+   * The FIFO pointer register value the span was computed from; private to
+   * the DIF.
+   */
+  uint32_t ptr_reg;
+} dif_spi_device_fifo_span_t;
+
+/**
+ * Gets the data in the RX FIFO that has not been received by software yet,
+ * without copying it.
+ *
+ * Software reads the data in place and then releases it with
+ * `dif_spi_device_rx_span_release()`. Together, these functions access the
+ * FIFO pointer register once per batch of data, instead of once per
+ * `dif_spi_device_recv()` call.
+ *
+ * Applies only to generic mode.
+ *
+ * @param spi A SPI device.
+ * @param[out] span The filled part of the RX FIFO.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_device_rx_span_get(const dif_spi_device_handle_t *spi,
+                                        dif_spi_device_fifo_span_t *span);
+
+/**
+ * Releases the first `len` bytes of a span from
+ * `dif_spi_device_rx_span_get()` back to the hardware.
+ *
+ * Applies only to generic mode.
+ *
+ * @param spi A SPI device.
+ * @param span A span returned by `dif_spi_device_rx_span_get()`, with no other
+ * data released since.
+ * @param len The number of bytes to release; must not exceed the length of
+ * the span.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_device_rx_span_release(
+    dif_spi_device_handle_t *spi, const dif_spi_device_fifo_span_t *span,
+    size_t len);
+
+/**
+ * Gets the free space in the TX FIFO, so that software can write data in
+ * place.
+ *
+ * Software writes the data into the span and then hands it to the hardware
+ * with `dif_spi_device_tx_span_commit()`.
+ *
+ * Applies only to generic mode.
+ *
+ * @param spi A SPI device.
+ * @param[out] span The free part of the TX FIFO.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_device_tx_span_get(const dif_spi_device_handle_t *spi,
+                                        dif_spi_device_fifo_span_t *span);
+
+/**
+ * Commits the first `len` bytes of a span from `dif_spi_device_tx_span_get()`
+ * for transmission.
+ *
+ * Applies only to generic mode.
+ *
+ * @param spi A SPI device.
+ * @param span A span returned by `dif_spi_device_tx_span_get()`, with no other
+ * data committed since.
+ * @param len The number of bytes to commit; must not exceed the length of the
+ * span.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_device_tx_span_commit(
+    dif_spi_device_handle_t *spi, const dif_spi_device_fifo_span_t *span,
+    size_t len);
+
 /**
  * Enable the mailbox region for spi_device flash / passthrough modes.
  *
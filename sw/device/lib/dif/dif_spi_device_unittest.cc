@@ -806,6 +806,89 @@ TEST_F(SendTest, NullArgs) {
   EXPECT_DIF_OK(dif_spi_device_send(&spi_, buf.data(), buf.size(), nullptr));
 }
 
+class SpanTest : public SpiTest {
+  void SetUp() { spi_.config = kDefaultConfig; }
+};
+
+TEST_F(SpanTest, RxWrapped) {
+  EXPECT_READ32(SPI_DEVICE_RXF_PTR_REG_OFFSET,
+                {{SPI_DEVICE_RXF_PTR_WPTR_OFFSET, FifoPtr(0x20, true)},
+                 {SPI_DEVICE_RXF_PTR_RPTR_OFFSET, FifoPtr(0x7f0, false)}});
+
+  dif_spi_device_fifo_span_t span;
+  EXPECT_DIF_OK(dif_spi_device_rx_span_get(&spi_, &span));
+  EXPECT_EQ(span.regions[0].offset, SPI_DEVICE_BUFFER_REG_OFFSET + 0x7f0);
+  EXPECT_EQ(span.regions[0].len, 0x10);
+  EXPECT_EQ(span.regions[1].offset, SPI_DEVICE_BUFFER_REG_OFFSET);
+  EXPECT_EQ(span.regions[1].len, 0x20);
+
+  // Releasing nothing does not touch the hardware.
+  EXPECT_DIF_OK(dif_spi_device_rx_span_release(&spi_, &span, 0));
+
+  EXPECT_WRITE32(SPI_DEVICE_RXF_PTR_REG_OFFSET,
+                 {{SPI_DEVICE_RXF_PTR_WPTR_OFFSET, FifoPtr(0x20, true)},
+                  {SPI_DEVICE_RXF_PTR_RPTR_OFFSET, FifoPtr(0x8, true)}});
+  EXPECT_DIF_OK(dif_spi_device_rx_span_release(&spi_, &span, 0x18));
+}
+
+TEST_F(SpanTest, RxEmpty) {
+  EXPECT_READ32(SPI_DEVICE_RXF_PTR_REG_OFFSET,
+                {{SPI_DEVICE_RXF_PTR_WPTR_OFFSET, FifoPtr(0x5c, false)},
+                 {SPI_DEVICE_RXF_PTR_RPTR_OFFSET, FifoPtr(0x5c, false)}});
+
+  dif_spi_device_fifo_span_t span;
+  EXPECT_DIF_OK(dif_spi_device_rx_span_get(&spi_, &span));
+  EXPECT_EQ(span.regions[0].len, 0);
+  EXPECT_EQ(span.regions[1].len, 0);
+  EXPECT_DIF_BADARG(dif_spi_device_rx_span_release(&spi_, &span, 4));
+}
+
+TEST_F(SpanTest, TxWrapped) {
+  EXPECT_READ32(SPI_DEVICE_TXF_PTR_REG_OFFSET,
+                {{SPI_DEVICE_TXF_PTR_WPTR_OFFSET, FifoPtr(0x100, false)},
+                 {SPI_DEVICE_TXF_PTR_RPTR_OFFSET, FifoPtr(0x80, false)}});
+
+  auto fifo_base =
+      SPI_DEVICE_BUFFER_REG_OFFSET + spi_.config.mode_cfg.generic.rx_fifo_len;
+  dif_spi_device_fifo_span_t span;
+  EXPECT_DIF_OK(dif_spi_device_tx_span_get(&spi_, &span));
+  EXPECT_EQ(span.regions[0].offset, fifo_base + 0x100);
+  EXPECT_EQ(span.regions[0].len, kFifoLen - 0x100);
+  EXPECT_EQ(span.regions[1].offset, fifo_base);
+  EXPECT_EQ(span.regions[1].len, 0x80);
+
+  EXPECT_WRITE32(SPI_DEVICE_TXF_PTR_REG_OFFSET,
+                 {{SPI_DEVICE_TXF_PTR_WPTR_OFFSET, FifoPtr(0x40, true)},
+                  {SPI_DEVICE_TXF_PTR_RPTR_OFFSET, FifoPtr(0x80, false)}});
+  EXPECT_DIF_OK(
+      dif_spi_device_tx_span_commit(&spi_, &span, kFifoLen - 0x100 + 0x40));
+}
+
+TEST_F(SpanTest, TxFull) {
+  EXPECT_READ32(SPI_DEVICE_TXF_PTR_REG_OFFSET,
+                {{SPI_DEVICE_TXF_PTR_WPTR_OFFSET, FifoPtr(0x5c, true)},
+                 {SPI_DEVICE_TXF_PTR_RPTR_OFFSET, FifoPtr(0x5c, false)}});
+
+  dif_spi_device_fifo_span_t span;
+  EXPECT_DIF_OK(dif_spi_device_tx_span_get(&spi_, &span));
+  EXPECT_EQ(span.regions[0].len, 0);
+  EXPECT_EQ(span.regions[1].len, 0);
+  EXPECT_DIF_BADARG(dif_spi_device_tx_span_commit(&spi_, &span, 4));
+}
+
+TEST_F(SpanTest, NullArgs) {
+  dif_spi_device_fifo_span_t span = {};
+
+  EXPECT_DIF_BADARG(dif_spi_device_rx_span_get(nullptr, &span));
+  EXPECT_DIF_BADARG(dif_spi_device_rx_span_get(&spi_, nullptr));
+  EXPECT_DIF_BADARG(dif_spi_device_rx_span_release(nullptr, &span, 0));
+  EXPECT_DIF_BADARG(dif_spi_device_rx_span_release(&spi_, nullptr, 0));
+  EXPECT_DIF_BADARG(dif_spi_device_tx_span_get(nullptr, &span));
+  EXPECT_DIF_BADARG(dif_spi_device_tx_span_get(&spi_, nullptr));
+  EXPECT_DIF_BADARG(dif_spi_device_tx_span_commit(nullptr, &span, 0));
+  EXPECT_DIF_BADARG(dif_spi_device_tx_span_commit(&spi_, nullptr, 0));
+}
+
 class GenericTest : public SpiTest {};
 
 TEST_F(GenericTest, NullArgs) {
@@ -294,22 +294,30 @@ static void issue_opcode(const dif_spi_host_t *spi_host,
                     kDifSpiHostDirectionTx, last_segment);
 }
 
-static void issue_address(const dif_spi_host_t *spi_host,
-                          dif_spi_host_segment_t *segment, bool last_segment) {
-  wait_tx_fifo(spi_host);
+/**
+ * Returns the TX FIFO word of an address segment.
+ *
+ * @param segment An address segment.
+ * @param[out] length The length of the address in bytes.
+ */
+static uint32_t address_word(const dif_spi_host_segment_t *segment,
+                             uint16_t *length) {
   // The address appears on the wire in big-endian order.
   uint32_t address = bitfield_byteswap32(segment->address.address);
-  uint32_t length;
   if (segment->address.mode == kDifSpiHostAddrMode4b) {
-    length = 4;
-    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
-                        address);
-  } else {
-    length = 3;
-    address >>= 8;
-    mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
-                        address);
+    *length = 4;
+    return address;
   }
+  *length = 3;
+  return address >> 8;
+}
+
+static void issue_address(const dif_spi_host_t *spi_host,
+                          dif_spi_host_segment_t *segment, bool last_segment) {
+  wait_tx_fifo(spi_host);
+  uint16_t length;
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                      address_word(segment, &length));
   write_command_reg(spi_host, length, segment->address.width,
                     kDifSpiHostDirectionTx, last_segment);
 }
@@ -410,3 +418,379 @@ dif_result_t dif_spi_host_transaction(const dif_spi_host_t *spi_host,
   }
   return kDifOk;
 }
+
+enum {
+  /** Maximum length of a segment, see COMMAND.LEN. */
+  kSegmentMaxLen = SPI_HOST_COMMAND_LEN_MASK + 1,
+  /** TX FIFO level in words below which the queue refills the TX FIFO. */
+  kQueueTxWatermark = SPI_HOST_PARAM_TX_DEPTH / 2,
+  /** Maximum RX watermark used by the queue in words. */
+  kQueueRxWatermarkMax = SPI_HOST_PARAM_RX_DEPTH / 2,
+};
+
+/**
+ * Gets the COMMAND register fields of a segment.
+ *
+ * @return `kDifBadArg` if the segment type is invalid or the segment does not
+ * fit into a single command.
+ */
+static dif_result_t segment_command(const dif_spi_host_segment_t *segment,
+                                    uint16_t *length,
+                                    dif_spi_host_width_t *width,
+                                    dif_spi_host_direction_t *direction) {
+  size_t len;
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeOpcode:
+      len = 1;
+      *width = kDifSpiHostWidthStandard;
+      *direction = kDifSpiHostDirectionTx;
+      break;
+    case kDifSpiHostSegmentTypeAddress:
+      address_word(segment, length);
+      *width = segment->address.width;
+      *direction = kDifSpiHostDirectionTx;
+      return kDifOk;
+    case kDifSpiHostSegmentTypeDummy:
+      len = segment->dummy.length;
+      *width = segment->dummy.width;
+      *direction = kDifSpiHostDirectionDummy;
+      break;
+    case kDifSpiHostSegmentTypeTx:
+      len = segment->tx.length;
+      *width = segment->tx.width;
+      *direction = kDifSpiHostDirectionTx;
+      break;
+    case kDifSpiHostSegmentTypeRx:
+      len = segment->rx.length;
+      *width = segment->rx.width;
+      *direction = kDifSpiHostDirectionRx;
+      break;
+    case kDifSpiHostSegmentTypeBidirectional:
+      len = segment->bidir.length;
+      *width = segment->bidir.width;
+      *direction = kDifSpiHostDirectionBidirectional;
+      break;
+    default:
+      return kDifBadArg;
+  }
+  if (len == 0 || len > kSegmentMaxLen) {
+    return kDifBadArg;
+  }
+  *length = (uint16_t)len;
+  return kDifOk;
+}
+
+/**
+ * Gets the data that a segment transmits.
+ *
+ * Address segments have no buffer; their data is produced by
+ * `address_word()`.
+ */
+static void segment_tx_buf(const dif_spi_host_segment_t *segment,
+                           const uint8_t **buf, size_t *len) {
+  *buf = NULL;
+  *len = 0;
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeOpcode:
+      *buf = &segment->opcode;
+      *len = 1;
+      break;
+    case kDifSpiHostSegmentTypeAddress: {
+      uint16_t length;
+      address_word(segment, &length);
+      *len = length;
+      break;
+    }
+    case kDifSpiHostSegmentTypeTx:
+      *buf = segment->tx.buf;
+      *len = segment->tx.length;
+      break;
+    case kDifSpiHostSegmentTypeBidirectional:
+      *buf = segment->bidir.txbuf;
+      *len = segment->bidir.length;
+      break;
+    default:
+        /* no data */;
+  }
+}
+
+/**
+ * Gets the buffer that receives the data of a segment.
+ */
+static void segment_rx_buf(const dif_spi_host_segment_t *segment,
+                           uint8_t **buf, size_t *len) {
+  *buf = NULL;
+  *len = 0;
+  switch (segment->type) {
+    case kDifSpiHostSegmentTypeRx:
+      *buf = segment->rx.buf;
+      *len = segment->rx.length;
+      break;
+    case kDifSpiHostSegmentTypeBidirectional:
+      *buf = segment->bidir.rxbuf;
+      *len = segment->bidir.length;
+      break;
+    default:
+        /* no data */;
+  }
+}
+
+static void control_field_write(const dif_spi_host_t *spi_host,
+                                bitfield_field32_t field, uint32_t value) {
+  uint32_t reg =
+      mmio_region_read32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
+  reg = bitfield_field32_write(reg, field, value);
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET, reg);
+}
+
+/**
+ * Hands segments of the queued transactions to the hardware until either all
+ * of them have been issued or the COMMAND or TX FIFO is full.
+ *
+ * The hardware only ever removes entries from these FIFOs, so the free space
+ * in `status` is a lower bound for the actual free space.
+ *
+ * @param status The value of the STATUS register.
+ * @return The EVENT_ENABLE bits of the event to wait for, 0 if done.
+ */
+static uint32_t queue_issue(const dif_spi_host_t *spi_host,
+                            dif_spi_host_queue_t *queue, uint32_t status) {
+  uint32_t cmd_free =
+      SPI_HOST_PARAM_CMD_DEPTH -
+      bitfield_field32_read(status, SPI_HOST_STATUS_CMDQD_FIELD);
+  uint32_t tx_free = SPI_HOST_PARAM_TX_DEPTH -
+                     bitfield_field32_read(status, SPI_HOST_STATUS_TXQD_FIELD);
+
+  while (queue->issue.txn != NULL) {
+    dif_spi_host_txn_t *txn = queue->issue.txn;
+    const dif_spi_host_segment_t *segment =
+        &txn->segments[queue->issue.segment];
+
+    // The command goes first so that the COMMAND FIFO stays primed even if
+    // the data of the segment does not fit into the TX FIFO yet: the
+    // hardware stalls until the data arrives.
+    if (!queue->issue.command_written) {
+      if (cmd_free == 0) {
+        return bitfield_bit32_write(0, SPI_HOST_EVENT_ENABLE_READY_BIT, true);
+      }
+      if (queue->issue.segment == 0) {
+        mmio_region_write32(spi_host->base_addr, SPI_HOST_CSID_REG_OFFSET,
+                            txn->csid);
+      }
+      uint16_t length;
+      dif_spi_host_width_t width;
+      dif_spi_host_direction_t direction;
+      // Segments are validated by `dif_spi_host_queue_submit()`.
+      OT_DISCARD(segment_command(segment, &length, &width, &direction));
+      write_command_reg(spi_host, length, width, direction,
+                        queue->issue.segment == txn->length - 1);
+      --cmd_free;
+      queue->issue.command_written = true;
+    }
+
+    const uint8_t *buf;
+    size_t len;
+    segment_tx_buf(segment, &buf, &len);
+    while (queue->issue.offset < len) {
+      if (tx_free == 0) {
+        return bitfield_bit32_write(0, SPI_HOST_EVENT_ENABLE_TXWM_BIT, true);
+      }
+      if (segment->type == kDifSpiHostSegmentTypeAddress) {
+        uint16_t length;
+        mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                            address_word(segment, &length));
+        queue->issue.offset = len;
+      } else {
+        const uint8_t *src = &buf[queue->issue.offset];
+        if (len - queue->issue.offset >= sizeof(uint32_t) &&
+            misalignment32_of((uintptr_t)src) == 0) {
+          mmio_region_write32(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                              read_32(src));
+          queue->issue.offset += sizeof(uint32_t);
+        } else {
+          mmio_region_write8(spi_host->base_addr, SPI_HOST_TXDATA_REG_OFFSET,
+                             *src);
+          queue->issue.offset += 1;
+        }
+      }
+      --tx_free;
+    }
+
+    queue->issue.offset = 0;
+    queue->issue.command_written = false;
+    if (++queue->issue.segment == txn->length) {
+      queue->issue.txn = txn->next;
+      queue->issue.segment = 0;
+    }
+  }
+  return 0;
+}
+
+/**
+ * Reads the received data of the oldest transactions from the RX FIFO and
+ * completes the transactions that the queue is done with.
+ *
+ * As with the TX FIFO, the data for each receiving segment starts at a word
+ * boundary of the RX FIFO.
+ *
+ * @param status The value of the STATUS register.
+ * @return Whether any transaction completed.
+ */
+static bool queue_drain(const dif_spi_host_t *spi_host,
+                        dif_spi_host_queue_t *queue, uint32_t status) {
+  uint32_t rx_avail = bitfield_field32_read(status, SPI_HOST_STATUS_RXQD_FIELD);
+  bool completed = false;
+
+  while (queue->head != NULL) {
+    dif_spi_host_txn_t *txn = queue->head;
+    for (; queue->drain.segment < txn->length; ++queue->drain.segment) {
+      uint8_t *buf;
+      size_t len;
+      segment_rx_buf(&txn->segments[queue->drain.segment], &buf, &len);
+      while (queue->drain.offset < len) {
+        if (rx_avail == 0) {
+          return completed;
+        }
+        uint32_t word =
+            mmio_region_read32(spi_host->base_addr, SPI_HOST_RXDATA_REG_OFFSET);
+        --rx_avail;
+        size_t n = len - queue->drain.offset;
+        if (n > sizeof(word)) {
+          n = sizeof(word);
+        }
+        memcpy(&buf[queue->drain.offset], &word, n);
+        queue->drain.offset += n;
+      }
+      queue->drain.offset = 0;
+    }
+    if (queue->issue.txn == txn) {
+      return completed;
+    }
+
+    queue->head = txn->next;
+    if (queue->head == NULL) {
+      queue->tail = NULL;
+    }
+    queue->drain.segment = 0;
+    completed = true;
+    if (txn->done != NULL) {
+      txn->done(txn->ctx);
+    }
+  }
+  return completed;
+}
+
+/**
+ * Returns the number of RX FIFO words the oldest transaction still expects.
+ */
+static uint32_t queue_rx_pending(const dif_spi_host_queue_t *queue) {
+  if (queue->head == NULL) {
+    return 0;
+  }
+  uint32_t words = 0;
+  for (size_t i = queue->drain.segment; i < queue->head->length; ++i) {
+    uint8_t *buf;
+    size_t len;
+    segment_rx_buf(&queue->head->segments[i], &buf, &len);
+    words += (len + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+  }
+  return words - queue->drain.offset / sizeof(uint32_t);
+}
+
+dif_result_t dif_spi_host_queue_init(const dif_spi_host_t *spi_host,
+                                     dif_spi_host_queue_t *queue) {
+  if (spi_host == NULL || queue == NULL) {
+    return kDifBadArg;
+  }
+
+  *queue = (dif_spi_host_queue_t){
+      .rx_watermark = kQueueRxWatermarkMax,
+  };
+  uint32_t reg =
+      mmio_region_read32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET);
+  reg = bitfield_field32_write(reg, SPI_HOST_CONTROL_TX_WATERMARK_FIELD,
+                               kQueueTxWatermark);
+  reg = bitfield_field32_write(reg, SPI_HOST_CONTROL_RX_WATERMARK_FIELD,
+                               kQueueRxWatermarkMax);
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_CONTROL_REG_OFFSET, reg);
+  mmio_region_write32(spi_host->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET, 0);
+  return kDifOk;
+}
+
+dif_result_t dif_spi_host_queue_submit(const dif_spi_host_t *spi_host,
+                                       dif_spi_host_queue_t *queue,
+                                       dif_spi_host_txn_t *txn) {
+  if (spi_host == NULL || queue == NULL || txn == NULL ||
+      txn->segments == NULL || txn->length == 0) {
+    return kDifBadArg;
+  }
+  for (size_t i = 0; i < txn->length; ++i) {
+    uint16_t length;
+    dif_spi_host_width_t width;
+    dif_spi_host_direction_t direction;
+    if (segment_command(&txn->segments[i], &length, &width, &direction) !=
+        kDifOk) {
+      return kDifBadArg;
+    }
+  }
+
+  txn->next = NULL;
+  if (queue->tail == NULL) {
+    queue->head = txn;
+  } else {
+    queue->tail->next = txn;
+  }
+  queue->tail = txn;
+  if (queue->issue.txn == NULL) {
+    queue->issue.txn = txn;
+  }
+
+  // When called from a completion callback, `dif_spi_host_queue_poll()` picks
+  // up the new transaction once the callback returns.
+  if (queue->polling) {
+    return kDifOk;
+  }
+  return dif_spi_host_queue_poll(spi_host, queue);
+}
+
+dif_result_t dif_spi_host_queue_poll(const dif_spi_host_t *spi_host,
+                                     dif_spi_host_queue_t *queue) {
+  if (spi_host == NULL || queue == NULL) {
+    return kDifBadArg;
+  }
+
+  queue->polling = true;
+  uint32_t events;
+  bool completed;
+  do {
+    uint32_t status =
+        mmio_region_read32(spi_host->base_addr, SPI_HOST_STATUS_REG_OFFSET);
+    events = queue_issue(spi_host, queue, status);
+    // Completion callbacks may have submitted more transactions.
+    completed = queue_drain(spi_host, queue, status);
+  } while (completed);
+
+  // SPI events are level-sensitive, so only enable those that the queue is
+  // waiting for. The RX watermark is lowered to the end of the oldest
+  // transaction so that its completion is not delayed until more data
+  // arrives.
+  uint32_t rx_pending = queue_rx_pending(queue);
+  if (rx_pending > 0) {
+    events = bitfield_bit32_write(events, SPI_HOST_EVENT_ENABLE_RXWM_BIT, true);
+    uint32_t rx_watermark =
+        rx_pending < kQueueRxWatermarkMax ? rx_pending : kQueueRxWatermarkMax;
+    if (rx_watermark != queue->rx_watermark) {
+      control_field_write(spi_host, SPI_HOST_CONTROL_RX_WATERMARK_FIELD,
+                          rx_watermark);
+      queue->rx_watermark = rx_watermark;
+    }
+  }
+  if (events != queue->events) {
+    mmio_region_write32(spi_host->base_addr, SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                        events);
+    queue->events = events;
+  }
+
+  queue->polling = false;
+  return kDifOk;
+}
@@ -203,6 +203,128 @@ dif_result_t dif_spi_host_transaction(const dif_spi_host_t *spi_host,
                                       dif_spi_host_segment_t *segments,
                                       size_t length);
 
+/**
+ * Completion callback of a queued SPI Host transaction.
+ *
+ * @param ctx The `ctx` field of the completed transaction.
+ */
+typedef void (*dif_spi_host_txn_done_t)(void *ctx);
+
+/**
+ * A SPI Host transaction for the asynchronous transaction queue.
+ *
+ * The caller owns the transaction, its segments and their buffers. None of
+ * them may be modified or reused before `done` has been called.
+ */
+typedef struct dif_spi_host_txn {
+  /** The chip-select ID of the SPI target. */
+  uint32_t csid;
+  /** The SPI segments of this transaction. */
+  dif_spi_host_segment_t *segments;
+  /** The number of SPI segments in this transaction. */
+  size_t length;
+  /**
+   * Called once the queue is done with the buffers of this transaction, i.e.
+   * all of its data has been written to the TX FIFO and all of its received
+   * data has been read from the RX FIFO. May be NULL.
+   */
+  dif_spi_host_txn_done_t done;
+  /** The argument of `done`. */
+  void *ctx;
+  /** The next transaction in the queue. Managed by the queue. */
+  struct dif_spi_host_txn *next;
+} dif_spi_host_txn_t;
+
+/**
+ * State of the asynchronous SPI Host transaction queue.
+ *
+ * All fields are managed by the `dif_spi_host_queue_*()` functions. The queue
+ * is empty, i.e. all submitted transactions have completed, when `head` is
+ * NULL.
+ */
+typedef struct dif_spi_host_queue {
+  /** The oldest transaction that has not completed yet. */
+  dif_spi_host_txn_t *head;
+  /** The most recently submitted transaction. */
+  dif_spi_host_txn_t *tail;
+  /** Position of the next segment to hand to the hardware. */
+  struct {
+    dif_spi_host_txn_t *txn;
+    size_t segment;
+    size_t offset;
+    bool command_written;
+  } issue;
+  /** Position of the next byte to read from the RX FIFO within `head`. */
+  struct {
+    size_t segment;
+    size_t offset;
+  } drain;
+  /** The events the queue currently waits for, see EVENT_ENABLE. */
+  uint32_t events;
+  /** The current RX watermark in words. */
+  uint32_t rx_watermark;
+  /** Whether `dif_spi_host_queue_poll()` is running. */
+  bool polling;
+} dif_spi_host_queue_t;
+
+/**
+ * Initializes an asynchronous SPI Host transaction queue.
+ *
+ * Unlike `dif_spi_host_transaction()`, the queue does not wait for the
+ * hardware: it keeps the COMMAND and TX FIFOs primed with the segments of the
+ * submitted transactions and drains the RX FIFO as data arrives, and it is
+ * driven by calls to `dif_spi_host_queue_poll()`, typically from the handler
+ * of the `spi_event` interrupt. The queue enables exactly the SPI events it
+ * is waiting for; the caller only has to enable the `spi_event` interrupt.
+ *
+ * The queue must not be used concurrently with the other transfer functions
+ * of this DIF.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param[out] queue The queue to initialize.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_queue_init(const dif_spi_host_t *spi_host,
+                                     dif_spi_host_queue_t *queue);
+
+/**
+ * Appends a transaction to an asynchronous SPI Host transaction queue.
+ *
+ * Starts handing the transaction to the hardware right away if the FIFOs
+ * have room for it. Transactions complete in submission order.
+ *
+ * This function may be called from a completion callback. Otherwise, it must
+ * not preempt or be preempted by `dif_spi_host_queue_poll()`, e.g. the
+ * `spi_event` interrupt must be masked around it if the queue is polled from
+ * its handler.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param queue A SPI Host transaction queue.
+ * @param txn The transaction to submit.
+ * @return `kDifBadArg` if a segment is invalid or longer than a single
+ * command can be, the result of the operation otherwise.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_queue_submit(const dif_spi_host_t *spi_host,
+                                       dif_spi_host_queue_t *queue,
+                                       dif_spi_host_txn_t *txn);
+
+/**
+ * Advances an asynchronous SPI Host transaction queue.
+ *
+ * Moves as many segments into the COMMAND and TX FIFOs and as much data out
+ * of the RX FIFO as possible without waiting, calls the callbacks of the
+ * completed transactions and updates the enabled SPI events. Never blocks.
+ *
+ * @param spi_host A SPI Host handle.
+ * @param queue A SPI Host transaction queue.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+dif_result_t dif_spi_host_queue_poll(const dif_spi_host_t *spi_host,
+                                     dif_spi_host_queue_t *queue);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
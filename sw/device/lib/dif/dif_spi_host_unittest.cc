@@ -392,6 +392,243 @@ TEST_F(TransactionTest, MultiSegmentTxRx) {
       dif_spi_host_transaction(&spi_host_, 0, segment, ARRAYSIZE(segment)));
 }
 
+class QueueTest : public SpiHostTest {
+ protected:
+  void InitQueue() {
+    EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET,
+                  {{SPI_HOST_CONTROL_SPIEN_BIT, true}});
+    EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
+                   {
+                       {SPI_HOST_CONTROL_SPIEN_BIT, true},
+                       {SPI_HOST_CONTROL_TX_WATERMARK_OFFSET,
+                        SPI_HOST_PARAM_TX_DEPTH / 2},
+                       {SPI_HOST_CONTROL_RX_WATERMARK_OFFSET,
+                        SPI_HOST_PARAM_RX_DEPTH / 2},
+                   });
+    EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET, 0);
+    EXPECT_DIF_OK(dif_spi_host_queue_init(&spi_host_, &queue_));
+  }
+
+  static void CountDone(void *ctx) { ++*static_cast<int *>(ctx); }
+
+  dif_spi_host_queue_t queue_;
+  int done_ = 0;
+};
+
+// Checks that a read transaction is issued without waiting and that its data
+// is drained once it arrives.
+TEST_F(QueueTest, Read) {
+  InitQueue();
+  uint8_t rxbuf[6] = {0};
+  dif_spi_host_segment_t segments[3];
+  segments[0].type = kDifSpiHostSegmentTypeOpcode;
+  segments[0].opcode = 0x03;
+  segments[1].type = kDifSpiHostSegmentTypeAddress;
+  segments[1].address.width = kDifSpiHostWidthStandard;
+  segments[1].address.mode = kDifSpiHostAddrMode3b;
+  segments[1].address.address = 0x123456;
+  segments[2].type = kDifSpiHostSegmentTypeRx;
+  segments[2].rx.width = kDifSpiHostWidthQuad;
+  segments[2].rx.buf = rxbuf;
+  segments[2].rx.length = sizeof(rxbuf);
+  dif_spi_host_txn_t txn = {
+      .csid = 2,
+      .segments = segments,
+      .length = ARRAYSIZE(segments),
+      .done = CountDone,
+      .ctx = &done_,
+  };
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 2);
+  EXPECT_COMMAND_REG(/*length=*/1, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/false);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 0x03);
+  EXPECT_COMMAND_REG(/*length=*/3, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/false);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x563412);
+  EXPECT_COMMAND_REG(/*length=*/sizeof(rxbuf), /*width=*/kDifSpiHostWidthQuad,
+                     /*direction=*/kDifSpiHostDirectionRx, /*last=*/true);
+  // The RX watermark is lowered to the end of the transaction.
+  EXPECT_READ32(SPI_HOST_CONTROL_REG_OFFSET,
+                {{SPI_HOST_CONTROL_SPIEN_BIT, true}});
+  EXPECT_WRITE32(SPI_HOST_CONTROL_REG_OFFSET,
+                 {
+                     {SPI_HOST_CONTROL_SPIEN_BIT, true},
+                     {SPI_HOST_CONTROL_RX_WATERMARK_OFFSET, 2},
+                 });
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                 {{SPI_HOST_EVENT_ENABLE_RXWM_BIT, true}});
+  EXPECT_DIF_OK(dif_spi_host_queue_submit(&spi_host_, &queue_, &txn));
+  EXPECT_EQ(done_, 0);
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {{SPI_HOST_STATUS_RXQD_OFFSET, 2}});
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x44332211);
+  EXPECT_READ32(SPI_HOST_RXDATA_REG_OFFSET, 0x6655);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET, 0);
+  EXPECT_DIF_OK(dif_spi_host_queue_poll(&spi_host_, &queue_));
+  EXPECT_EQ(done_, 1);
+  EXPECT_THAT(rxbuf, ElementsAre(0x11, 0x22, 0x33, 0x44, 0x55, 0x66));
+  EXPECT_EQ(queue_.head, nullptr);
+}
+
+// Checks that TX data is written as the TX FIFO drains.
+TEST_F(QueueTest, TxBackpressure) {
+  InitQueue();
+  alignas(uint32_t) uint8_t txbuf[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  dif_spi_host_segment_t segment;
+  segment.type = kDifSpiHostSegmentTypeTx;
+  segment.tx.width = kDifSpiHostWidthStandard;
+  segment.tx.buf = txbuf;
+  segment.tx.length = sizeof(txbuf);
+  dif_spi_host_txn_t txn = {
+      .csid = 0,
+      .segments = &segment,
+      .length = 1,
+      .done = CountDone,
+      .ctx = &done_,
+  };
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {{SPI_HOST_STATUS_TXQD_OFFSET, SPI_HOST_PARAM_TX_DEPTH - 2}});
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 0);
+  EXPECT_COMMAND_REG(/*length=*/sizeof(txbuf),
+                     /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/true);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x03020100);
+  EXPECT_WRITE32(SPI_HOST_TXDATA_REG_OFFSET, 0x07060504);
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                 {{SPI_HOST_EVENT_ENABLE_TXWM_BIT, true}});
+  EXPECT_DIF_OK(dif_spi_host_queue_submit(&spi_host_, &queue_, &txn));
+  EXPECT_EQ(done_, 0);
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 8);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 9);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET, 0);
+  EXPECT_DIF_OK(dif_spi_host_queue_poll(&spi_host_, &queue_));
+  EXPECT_EQ(done_, 1);
+}
+
+// Checks that a full COMMAND FIFO defers the transaction.
+TEST_F(QueueTest, CommandFifoFull) {
+  InitQueue();
+  dif_spi_host_segment_t segment;
+  segment.type = kDifSpiHostSegmentTypeOpcode;
+  segment.opcode = 0x06;
+  dif_spi_host_txn_t txn = {
+      .csid = 1,
+      .segments = &segment,
+      .length = 1,
+      .done = CountDone,
+      .ctx = &done_,
+  };
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {{SPI_HOST_STATUS_CMDQD_OFFSET, SPI_HOST_PARAM_CMD_DEPTH}});
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET,
+                 {{SPI_HOST_EVENT_ENABLE_READY_BIT, true}});
+  EXPECT_DIF_OK(dif_spi_host_queue_submit(&spi_host_, &queue_, &txn));
+  EXPECT_EQ(done_, 0);
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET,
+                {{SPI_HOST_STATUS_CMDQD_OFFSET, SPI_HOST_PARAM_CMD_DEPTH - 1}});
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 1);
+  EXPECT_COMMAND_REG(/*length=*/1, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/true);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 0x06);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_EVENT_ENABLE_REG_OFFSET, 0);
+  EXPECT_DIF_OK(dif_spi_host_queue_poll(&spi_host_, &queue_));
+  EXPECT_EQ(done_, 1);
+}
+
+struct Chain {
+  const dif_spi_host_t *spi_host;
+  dif_spi_host_queue_t *queue;
+  dif_spi_host_txn_t *next;
+};
+
+// Checks that a completion callback can submit the next transaction.
+TEST_F(QueueTest, SubmitFromCallback) {
+  InitQueue();
+  dif_spi_host_segment_t segments[2];
+  segments[0].type = kDifSpiHostSegmentTypeOpcode;
+  segments[0].opcode = 0x06;
+  segments[1].type = kDifSpiHostSegmentTypeOpcode;
+  segments[1].opcode = 0x04;
+  dif_spi_host_txn_t second = {
+      .csid = 1,
+      .segments = &segments[1],
+      .length = 1,
+      .done = CountDone,
+      .ctx = &done_,
+  };
+  Chain chain = {&spi_host_, &queue_, &second};
+  dif_spi_host_txn_t first = {
+      .csid = 0,
+      .segments = &segments[0],
+      .length = 1,
+      .done =
+          [](void *ctx) {
+            auto *chain = static_cast<Chain *>(ctx);
+            EXPECT_DIF_OK(dif_spi_host_queue_submit(chain->spi_host,
+                                                    chain->queue, chain->next));
+          },
+      .ctx = &chain,
+  };
+
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 0);
+  EXPECT_COMMAND_REG(/*length=*/1, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/true);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 0x06);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_WRITE32(SPI_HOST_CSID_REG_OFFSET, 1);
+  EXPECT_COMMAND_REG(/*length=*/1, /*width=*/kDifSpiHostWidthStandard,
+                     /*direction=*/kDifSpiHostDirectionTx, /*last=*/true);
+  EXPECT_WRITE8(SPI_HOST_TXDATA_REG_OFFSET, 0x04);
+  EXPECT_READ32(SPI_HOST_STATUS_REG_OFFSET, 0);
+  EXPECT_DIF_OK(dif_spi_host_queue_submit(&spi_host_, &queue_, &first));
+  EXPECT_EQ(done_, 1);
+  EXPECT_EQ(queue_.head, nullptr);
+}
+
+TEST_F(QueueTest, BadArgs) {
+  InitQueue();
+  uint8_t buf[1];
+  dif_spi_host_segment_t segment;
+  segment.type = kDifSpiHostSegmentTypeRx;
+  segment.rx.width = kDifSpiHostWidthStandard;
+  segment.rx.buf = buf;
+  segment.rx.length = SPI_HOST_COMMAND_LEN_MASK + 2;
+  dif_spi_host_txn_t txn = {
+      .csid = 0,
+      .segments = &segment,
+      .length = 1,
+  };
+
+  EXPECT_DIF_BADARG(dif_spi_host_queue_init(nullptr, &queue_));
+  EXPECT_DIF_BADARG(dif_spi_host_queue_init(&spi_host_, nullptr));
+  EXPECT_DIF_BADARG(dif_spi_host_queue_submit(nullptr, &queue_, &txn));
+  EXPECT_DIF_BADARG(dif_spi_host_queue_submit(&spi_host_, nullptr, &txn));
+  EXPECT_DIF_BADARG(dif_spi_host_queue_submit(&spi_host_, &queue_, nullptr));
+  EXPECT_DIF_BADARG(dif_spi_host_queue_poll(nullptr, &queue_));
+  EXPECT_DIF_BADARG(dif_spi_host_queue_poll(&spi_host_, nullptr));
+
+  // Segments longer than a single command are rejected.
+  EXPECT_DIF_BADARG(dif_spi_host_queue_submit(&spi_host_, &queue_, &txn));
+  segment.rx.length = 0;
+  EXPECT_DIF_BADARG(dif_spi_host_queue_submit(&spi_host_, &queue_, &txn));
+  txn.length = 0;
+  segment.rx.length = sizeof(buf);
+  EXPECT_DIF_BADARG(dif_spi_host_queue_submit(&spi_host_, &queue_, &txn));
+  EXPECT_EQ(queue_.head, nullptr);
+}
+
 class FifoTest : public SpiHostTest {};
 
 // Checks that arguments are validated.
@@ -59,18 +59,45 @@ static void uart_reset(const dif_uart_t *uart) {
                       UART_INTR_STATE_MASK);
 }
 
+/**
+ * Returns the number of bytes that can be written to the TX FIFO.
+ *
+ * The hardware only ever drains the TX FIFO, so the result remains a lower
+ * bound until software writes to the FIFO.
+ */
+static size_t uart_tx_fifo_space(const dif_uart_t *uart) {
+  uint32_t reg =
+      mmio_region_read32(uart->base_addr, UART_FIFO_STATUS_REG_OFFSET);
+  return kDifUartFifoSizeBytes -
+         bitfield_field32_read(reg, UART_FIFO_STATUS_TXLVL_FIELD);
+}
+
+/**
+ * Returns the number of bytes in the RX FIFO.
+ *
+ * The hardware only ever fills the RX FIFO, so the result remains a lower
+ * bound until software reads from the FIFO.
+ */
+static size_t uart_rx_fifo_level(const dif_uart_t *uart) {
+  uint32_t reg =
+      mmio_region_read32(uart->base_addr, UART_FIFO_STATUS_REG_OFFSET);
+  return bitfield_field32_read(reg, UART_FIFO_STATUS_RXLVL_FIELD);
+}
+
 /**
  * Write up to `bytes_requested` number of bytes to the TX FIFO.
  */
 static size_t uart_bytes_send(const dif_uart_t *uart, const uint8_t *data,
                               size_t bytes_requested) {
-  size_t bytes_written = 0;
-  while ((bytes_written < bytes_requested) && !uart_tx_full(uart)) {
-    uart_tx_fifo_write(uart, data[bytes_written]);
-    ++bytes_written;
+  size_t space = uart_tx_fifo_space(uart);
+  if (bytes_requested > space) {
+    bytes_requested = space;
+  }
+  for (size_t i = 0; i < bytes_requested; ++i) {
+    uart_tx_fifo_write(uart, data[i]);
   }
 
-  return bytes_written;
+  return bytes_requested;
 }
 
 /**
@@ -78,13 +105,15 @@ static size_t uart_bytes_send(const dif_uart_t *uart, const uint8_t *data,
  */
 static size_t uart_bytes_receive(const dif_uart_t *uart, size_t bytes_requested,
                                  uint8_t *data) {
-  size_t bytes_read = 0;
-  while ((bytes_read < bytes_requested) && !uart_rx_empty(uart)) {
-    data[bytes_read] = uart_rx_fifo_read(uart);
-    ++bytes_read;
+  size_t level = uart_rx_fifo_level(uart);
+  if (bytes_requested > level) {
+    bytes_requested = level;
+  }
+  for (size_t i = 0; i < bytes_requested; ++i) {
+    data[i] = uart_rx_fifo_read(uart);
   }
 
-  return bytes_read;
+  return bytes_requested;
 }
 
 dif_result_t dif_uart_configure(const dif_uart_t *uart,
@@ -261,7 +290,7 @@ dif_result_t dif_uart_byte_send_polled(const dif_uart_t *uart, uint8_t byte) {
   while (uart_tx_full(uart)) {
   }
 
-  (void)uart_bytes_send(uart, &byte, 1);
+  uart_tx_fifo_write(uart, byte);
 
   // Busy wait for the TX FIFO to be drained and for HW to finish processing
   // the last byte.
@@ -281,7 +310,7 @@ dif_result_t dif_uart_byte_receive_polled(const dif_uart_t *uart,
   while (uart_rx_empty(uart)) {
   }
 
-  (void)uart_bytes_receive(uart, 1, byte);
+  *byte = uart_rx_fifo_read(uart);
 
   return kDifOk;
 }
@@ -293,9 +322,7 @@ dif_result_t dif_uart_rx_bytes_available(const dif_uart_t *uart,
   }
 
   // RX FIFO fill level (in bytes).
-  uint32_t reg =
-      mmio_region_read32(uart->base_addr, UART_FIFO_STATUS_REG_OFFSET);
-  *num_bytes = (size_t)bitfield_field32_read(reg, UART_FIFO_STATUS_RXLVL_FIELD);
+  *num_bytes = uart_rx_fifo_level(uart);
 
   return kDifOk;
 }
@@ -306,12 +333,8 @@ dif_result_t dif_uart_tx_bytes_available(const dif_uart_t *uart,
     return kDifBadArg;
   }
 
-  // TX FIFO fill level (in bytes).
-  uint32_t reg =
-      mmio_region_read32(uart->base_addr, UART_FIFO_STATUS_REG_OFFSET);
-  uint32_t fill_bytes =
-      bitfield_field32_read(reg, UART_FIFO_STATUS_TXLVL_FIELD);
-  *num_bytes = kDifUartFifoSizeBytes - fill_bytes;
+  // TX FIFO free space (in bytes).
+  *num_bytes = uart_tx_fifo_space(uart);
 
   return kDifOk;
 }
@@ -175,6 +175,9 @@ dif_result_t dif_uart_watermark_tx_set(const dif_uart_t *uart,
  * the caller. `bytes_written` is optional, NULL should be passed in if the
  * value is not needed.
  *
+ * The free space in the TX FIFO is read once, so that the FIFO is filled
+ * without polling its status after every byte.
+ *
  * @param uart A UART handle.
  * @param data Data to be written.
  * @param bytes_requested Number of bytes requested to be written by the caller.
@@ -195,6 +198,9 @@ dif_result_t dif_uart_bytes_send(const dif_uart_t *uart, const uint8_t *data,
  * `bytes_read` is optional, NULL should be passed in if the value is not
  * needed.
  *
+ * The RX FIFO level is read once, so bytes that arrive during the call are
+ * left in the FIFO.
+ *
  * @param uart A UART handle.
  * @param bytes_requested Number of bytes requested to be read by the caller.
  * @param[out] data Buffer for up to `bytes_requested` bytes of read data.
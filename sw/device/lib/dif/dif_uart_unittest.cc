@@ -175,14 +175,16 @@ class BytesSendTest : public UartTest {
   /**
    * Sets TX bytes expectations.
    *
-   * Every sent byte by the "send bytes" routine is expected to result in the
-   * STATUS read of 0 (FIFO not full), and write to WDATA.
+   * The "send bytes" routine is expected to read the TX FIFO level once, and
+   * then write every sent byte to WDATA.
    */
-  void ExpectSendBytes(int num_elements = kBytesArray.size()) {
+  void ExpectSendBytes(int num_elements = kBytesArray.size(),
+                       uint32_t tx_level = 0) {
     ASSERT_LE(num_elements, kBytesArray.size());
+    EXPECT_READ32(UART_FIFO_STATUS_REG_OFFSET,
+                  {{UART_FIFO_STATUS_TXLVL_OFFSET, tx_level}});
     for (int i = 0; i < num_elements; ++i) {
       uint32_t value = static_cast<uint32_t>(kBytesArray[i]);
-      EXPECT_READ32(UART_STATUS_REG_OFFSET, 0);
       EXPECT_WRITE32(UART_WDATA_REG_OFFSET, value);
     }
   }
@@ -212,8 +214,18 @@ TEST_F(BytesSendTest, TxFifoEmpty) {
   EXPECT_EQ(bytes_written, kBytesArray.size());
 }
 
+TEST_F(BytesSendTest, TxFifoPartiallyFull) {
+  ExpectSendBytes(3, kDifUartFifoSizeBytes - 3);
+
+  size_t bytes_written;
+  EXPECT_DIF_OK(dif_uart_bytes_send(&uart_, kBytesArray.data(),
+                                    kBytesArray.size(), &bytes_written));
+  EXPECT_EQ(bytes_written, 3);
+}
+
 TEST_F(BytesSendTest, TxFifoFull) {
-  EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_TXFULL_BIT, true}});
+  EXPECT_READ32(UART_FIFO_STATUS_REG_OFFSET,
+                {{UART_FIFO_STATUS_TXLVL_OFFSET, kDifUartFifoSizeBytes}});
 
   size_t bytes_written;
   EXPECT_DIF_OK(dif_uart_bytes_send(&uart_, kBytesArray.data(),
@@ -226,13 +238,14 @@ class BytesReceiveTest : public UartTest {
   /**
    * Sets RX bytes expectations.
    *
-   * Every read byte by the "receive bytes" routine is expected to result in the
-   * STATUS read of 0 (FIFO not empty), and read of RDATA.
+   * The "receive bytes" routine is expected to read the RX FIFO level once,
+   * and then read every received byte from RDATA.
    */
   void ExpectReceiveBytes(int num_elements) {
+    EXPECT_READ32(UART_FIFO_STATUS_REG_OFFSET,
+                  {{UART_FIFO_STATUS_RXLVL_OFFSET, num_elements}});
     for (int i = 0; i < num_elements; ++i) {
       uint32_t value = static_cast<uint32_t>(kBytesArray[i]);
-      EXPECT_READ32(UART_STATUS_REG_OFFSET, 0);
       EXPECT_READ32(UART_RDATA_REG_OFFSET, value);
     }
   }
@@ -272,8 +285,21 @@ TEST_F(BytesReceiveTest, RxFifoFull) {
   EXPECT_EQ(receive_bytes, kBytesArray);
 }
 
+TEST_F(BytesReceiveTest, RxFifoPartiallyFull) {
+  ExpectReceiveBytes(3);
+
+  size_t bytes_read;
+  std::vector<uint8_t> receive_bytes(kBytesArray.size());
+  EXPECT_DIF_OK(dif_uart_bytes_receive(&uart_, receive_bytes.size(),
+                                       receive_bytes.data(), &bytes_read));
+  EXPECT_EQ(bytes_read, 3);
+  receive_bytes.resize(bytes_read);
+  EXPECT_EQ(receive_bytes, std::vector<uint8_t>({'0', '1', '2'}));
+}
+
 TEST_F(BytesReceiveTest, RxFifoEmpty) {
-  EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_RXEMPTY_BIT, true}});
+  EXPECT_READ32(UART_FIFO_STATUS_REG_OFFSET,
+                {{UART_FIFO_STATUS_RXLVL_OFFSET, 0}});
 
   uint8_t num_bytes = kBytesArray.size();
 
@@ -298,7 +324,6 @@ TEST_F(BytesSendPolledTest, Success) {
   EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_TXFULL_BIT, false}});
 
   // Set expectations for the byte to be set
-  EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_TXFULL_BIT, false}});
   EXPECT_WRITE32(UART_WDATA_REG_OFFSET, 'X');
 
   // Busy loop 1 iteration (waiting for the byte to be sent out by the HW)
@@ -325,7 +350,6 @@ TEST_F(BytesReceivePolledTest, Success) {
   EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_RXEMPTY_BIT, false}});
 
   // Set expectations for the byte to be read
-  EXPECT_READ32(UART_STATUS_REG_OFFSET, {{UART_STATUS_RXEMPTY_BIT, false}});
   EXPECT_READ32(UART_RDATA_REG_OFFSET, 'X');
 
   uint8_t byte = 'Y';
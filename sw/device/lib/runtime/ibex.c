@@ -26,6 +26,57 @@ uint32_t ibex_mepc_read(void) {
 
 void ibex_mepc_write(uint32_t mepc) { CSR_WRITE(CSR_REG_MEPC, mepc); }
 
+void ibex_hpm_enable(uint32_t events) {
+  CSR_CLEAR_BITS(CSR_REG_MCOUNTINHIBIT, events);
+}
+
+uint32_t ibex_hpm_read(ibex_hpm_event_t event) {
+  // The CSR address must be a constant expression, so each counter needs its
+  // own read.
+  uint32_t value = 0;
+  switch (event) {
+    case kIbexHpmEventCycles:
+      CSR_READ(CSR_REG_MCYCLE, &value);
+      break;
+    case kIbexHpmEventInstrRetired:
+      CSR_READ(CSR_REG_MINSTRET, &value);
+      break;
+    case kIbexHpmEventLsuWait:
+      CSR_READ(CSR_REG_MHPMCOUNTER3, &value);
+      break;
+    case kIbexHpmEventFetchWait:
+      CSR_READ(CSR_REG_MHPMCOUNTER4, &value);
+      break;
+    case kIbexHpmEventLoads:
+      CSR_READ(CSR_REG_MHPMCOUNTER5, &value);
+      break;
+    case kIbexHpmEventStores:
+      CSR_READ(CSR_REG_MHPMCOUNTER6, &value);
+      break;
+    case kIbexHpmEventJumps:
+      CSR_READ(CSR_REG_MHPMCOUNTER7, &value);
+      break;
+    case kIbexHpmEventBranches:
+      CSR_READ(CSR_REG_MHPMCOUNTER8, &value);
+      break;
+    case kIbexHpmEventBranchesTaken:
+      CSR_READ(CSR_REG_MHPMCOUNTER9, &value);
+      break;
+    case kIbexHpmEventCompressedInstrRetired:
+      CSR_READ(CSR_REG_MHPMCOUNTER10, &value);
+      break;
+    case kIbexHpmEventMulWait:
+      CSR_READ(CSR_REG_MHPMCOUNTER11, &value);
+      break;
+    case kIbexHpmEventDivWait:
+      CSR_READ(CSR_REG_MHPMCOUNTER12, &value);
+      break;
+    default:
+      break;
+  }
+  return value;
+}
+
 // `extern` declarations to give the inline functions in the
 // corresponding header a link location.
 
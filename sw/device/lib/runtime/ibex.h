@@ -89,6 +89,59 @@ inline uint64_t ibex_mcycle_read(void) {
   return (uint64_t)cycle_high << 32 | cycle_low;
 }
 
+/**
+ * An Ibex hardware performance monitor (HPM) event.
+ *
+ * On Ibex the event counted by each `mhpmcounter` is fixed: counter `N` counts
+ * the event with index `N`, and the `mhpmevent` registers are read-only. The
+ * cycle and instructions retired events are counted by `mcycle` and `minstret`
+ * respectively.
+ *
+ * Ibex has no branch predictor in the OpenTitan configuration; every taken
+ * branch and jump pays the refetch penalty, so `kIbexHpmEventBranchesTaken`
+ * and `kIbexHpmEventJumps` stand in for mispredicts.
+ *
+ * See https://ibex-core.readthedocs.io/en/latest/03_reference/
+ * performance_counters.html
+ */
+typedef enum ibex_hpm_event {
+  kIbexHpmEventCycles = 0,
+  kIbexHpmEventInstrRetired = 2,
+  /** Cycles spent waiting for data memory (loads and stores). */
+  kIbexHpmEventLsuWait = 3,
+  /** Cycles spent waiting for instruction fetch. */
+  kIbexHpmEventFetchWait = 4,
+  kIbexHpmEventLoads = 5,
+  kIbexHpmEventStores = 6,
+  kIbexHpmEventJumps = 7,
+  kIbexHpmEventBranches = 8,
+  kIbexHpmEventBranchesTaken = 9,
+  kIbexHpmEventCompressedInstrRetired = 10,
+  kIbexHpmEventMulWait = 11,
+  kIbexHpmEventDivWait = 12,
+} ibex_hpm_event_t;
+
+/**
+ * Enables counting of the given HPM events.
+ *
+ * This clears the corresponding bits of `mcountinhibit`; counters that are
+ * already running are unaffected.
+ *
+ * @param events A bitmask with bit `1 << event` set for each event to enable.
+ */
+void ibex_hpm_enable(uint32_t events);
+
+/**
+ * Reads the low 32 bits of the counter for the given HPM event.
+ *
+ * Differences of two readings are correct as long as fewer than 2^32 events
+ * occurred between them.
+ *
+ * @param event The event to read the counter of.
+ * @return The counter value, or zero for events that have no counter.
+ */
+uint32_t ibex_hpm_read(ibex_hpm_event_t event);
+
 /**
  * Reads the mcause register.
  *
@@ -5,20 +5,25 @@
 #include "sw/device/lib/runtime/log.h"
 
 #include <assert.h>
+#include <stdarg.h>
 
 #include "sw/device/lib/arch/device.h"
 #include "sw/device/lib/base/memory.h"
 #include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/status.h"
 #include "sw/device/lib/runtime/print.h"
 
 /**
- * Ensure that log_fields_t is always 20 bytes.
+ * Ensure that log_fields_t is always 20 bytes on the device.
  *
  * The assertion below helps prevent inadvertant changes to the struct.
  * Please see the description of log_fields_t in log.h for more details.
+ * Host builds, which are only used for testing, have wider pointers.
  */
+#ifdef OT_PLATFORM_RV32
 static_assert(sizeof(log_fields_t) == 20,
               "log_fields_t must always be 20 bytes.");
+#endif  // OT_PLATFORM_RV32
 
 /**
  * Converts a severity to a static string.
@@ -39,17 +44,17 @@ static const char *stringify_severity(log_severity_t severity) {
 }
 
 /**
- * Logs `log` and the values that follow to stdout.
+ * Formats `log` and its arguments and writes the result to stdout.
  *
  * @param log the log data to log.
- * @param ... format parameters matching the format string.
+ * @param args format parameters matching the format string.
  */
-void base_log_internal_core(log_fields_t log, ...) {
+static void log_format(const log_fields_t *log, va_list args) {
   size_t file_name_len =
-      ((char *)memchr(log.file_name, '\0', PTRDIFF_MAX)) - log.file_name;
-  const char *base_name = memrchr(log.file_name, '/', file_name_len);
+      ((char *)memchr(log->file_name, '\0', PTRDIFF_MAX)) - log->file_name;
+  const char *base_name = memrchr(log->file_name, '/', file_name_len);
   if (base_name == NULL) {
-    base_name = log.file_name;
+    base_name = log->file_name;
   } else {
     ++base_name;  // Remove the final '/'.
   }
@@ -59,16 +64,283 @@ void base_log_internal_core(log_fields_t log, ...) {
   // nothing was printed for some time.
   static uint16_t global_log_counter = 0;
 
-  base_printf("%s%05d %s:%d] ", stringify_severity(log.severity),
-              global_log_counter, base_name, log.line);
+  base_printf("%s%05d %s:%d] ", stringify_severity(log->severity),
+              global_log_counter, base_name, log->line);
   ++global_log_counter;
 
+  base_vprintf(log->format, args);
+
+  base_printf("\r\n");
+}
+
+/**
+ * Variadic wrapper around `log_format()` for replaying deferred log lines.
+ *
+ * @param log the log data to log.
+ * @param ... format parameters matching the format string.
+ */
+static void log_format_va(const log_fields_t *log, ...) {
   va_list args;
   va_start(args, log);
-  base_vprintf(log.format, args);
+  log_format(log, args);
   va_end(args);
+}
 
-  base_printf("\r\n");
+/**
+ * Storage for deferred log lines, see `base_log_defer_formatting()`.
+ */
+static log_record_t *deferred_records = NULL;
+static size_t deferred_records_len = 0;
+/**
+ * Index of the oldest pending record and the number of pending records.
+ */
+static size_t deferred_records_first = 0;
+static size_t deferred_records_count = 0;
+
+/**
+ * Formats all pending deferred log lines, oldest first.
+ */
+static void log_format_deferred(void) {
+  while (deferred_records_count > 0) {
+    const log_record_t *record = &deferred_records[deferred_records_first];
+    // Every format argument takes up exactly one word on 32-bit targets, and
+    // surplus arguments are ignored, so always passing all of them is safe.
+    static_assert(kLogRecordMaxArgs == 8,
+                  "Update the call below when changing kLogRecordMaxArgs.");
+    log_format_va(&record->fields, record->args[0], record->args[1],
+                  record->args[2], record->args[3], record->args[4],
+                  record->args[5], record->args[6], record->args[7]);
+    ++deferred_records_first;
+    if (deferred_records_first == deferred_records_len) {
+      deferred_records_first = 0;
+    }
+    --deferred_records_count;
+  }
+}
+
+/**
+ * Stores `log` and its arguments for later formatting, if possible.
+ *
+ * @param log the log data to log.
+ * @param args format parameters matching the format string.
+ * @return Whether `log` was deferred.
+ */
+static bool log_defer(const log_fields_t *log, va_list args) {
+  if (deferred_records == NULL || log->severity != kLogSeverityInfo ||
+      log->nargs > kLogRecordMaxArgs) {
+    return false;
+  }
+  if (deferred_records_count == deferred_records_len) {
+    log_format_deferred();
+  }
+  size_t index = deferred_records_first + deferred_records_count;
+  if (index >= deferred_records_len) {
+    index -= deferred_records_len;
+  }
+  log_record_t *record = &deferred_records[index];
+  record->fields = *log;
+  for (size_t i = 0; i < log->nargs; ++i) {
+    record->args[i] = va_arg(args, uint32_t);
+  }
+  ++deferred_records_count;
+  return true;
+}
+
+/**
+ * The current log mode, see `base_log_set_mode()`.
+ */
+static log_mode_t log_mode = kLogModeText;
+
+/**
+ * Staging buffer for binary log records.
+ *
+ * Collects the fixed-size parts of a record, so that they can be passed to
+ * the sink in one call.
+ */
+typedef struct log_encoder {
+  char buf[32];
+  size_t len;
+} log_encoder_t;
+
+/**
+ * Writes the contents of the staging buffer to stdout.
+ */
+static void log_encoder_flush(log_encoder_t *enc) {
+  base_stdout_write(enc->buf, enc->len);
+  enc->len = 0;
+}
+
+/**
+ * Appends a little-endian word to the staging buffer.
+ */
+static void log_encoder_word(log_encoder_t *enc, uint32_t word) {
+  if (enc->len + sizeof(word) > sizeof(enc->buf)) {
+    log_encoder_flush(enc);
+  }
+  for (size_t i = 0; i < sizeof(word); ++i) {
+    enc->buf[enc->len++] = (char)(word >> (8 * i));
+  }
+}
+
+/**
+ * Appends a length-prefixed byte string to the record.
+ */
+static void log_encoder_bytes(log_encoder_t *enc, const char *bytes,
+                              size_t len) {
+  log_encoder_word(enc, (uint32_t)len);
+  log_encoder_flush(enc);
+  base_stdout_write(bytes, len);
+}
+
+/**
+ * Writes `log` and its arguments to stdout as a binary log record.
+ *
+ * The format string is only scanned to find out how many arguments each
+ * specifier consumes, and which of them are strings or buffers. This must
+ * agree with `base_vfprintf()`, which the host decoder mirrors.
+ *
+ * @param id the address of the log metadata in the `.logs.fields` section.
+ * @param log the log data to log.
+ * @param args format parameters matching the format string.
+ */
+static void log_encode(const log_fields_t *id, const log_fields_t *log,
+                       va_list args) {
+  log_encoder_t enc = {.len = 0};
+  enc.buf[enc.len++] = (char)kLogBinaryRecordMarker;
+  log_encoder_word(&enc, (uint32_t)(uintptr_t)id);
+
+  const char *format = log->format;
+  while (true) {
+    while (*format != '\0' && *format != '%') {
+      ++format;
+    }
+    if (*format == '\0') {
+      break;
+    }
+    ++format;
+
+    bool is_nonstd = false;
+    if (*format == '!') {
+      is_nonstd = true;
+      ++format;
+    }
+    // Invalid widths stop formatting, see `consume_format_specifier()`.
+    uint32_t width = 0;
+    bool has_width = false;
+    for (; *format >= '0' && *format <= '9'; ++format) {
+      width = width * 10 + (uint32_t)(*format - '0');
+      has_width = true;
+    }
+    if ((has_width && width == 0) || width > 32) {
+      break;
+    }
+
+    switch (*format++) {
+      case '\0':
+        log_encoder_flush(&enc);
+        return;
+      case '%':
+        break;
+      case 's': {
+        size_t len = 0;
+        if (is_nonstd) {
+          len = va_arg(args, size_t);
+        }
+        const char *value = va_arg(args, const char *);
+        if (!is_nonstd) {
+          len = ((char *)memchr(value, '\0', PTRDIFF_MAX)) - value;
+        }
+        log_encoder_bytes(&enc, value, len);
+        break;
+      }
+      case 'x':
+      case 'X':
+        if (!is_nonstd) {
+          log_encoder_word(&enc, va_arg(args, uint32_t));
+          break;
+        }
+        OT_FALLTHROUGH_INTENDED;
+      case 'y':
+      case 'Y':
+        if (is_nonstd) {
+          size_t len = va_arg(args, size_t);
+          const char *value = va_arg(args, const char *);
+          log_encoder_bytes(&enc, value, len);
+        }
+        break;
+      case 'b':
+        // Bools are promoted to int.
+        log_encoder_word(&enc, is_nonstd ? (uint32_t)va_arg(args, int)
+                                         : va_arg(args, uint32_t));
+        break;
+      case 'r':
+        log_encoder_word(&enc, (uint32_t)va_arg(args, status_t).value);
+        break;
+      case 'h':
+      case 'H':
+        log_encoder_word(&enc, va_arg(args, uint32_t));
+        break;
+      case 'c':
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'o':
+      case 'p':
+        if (!is_nonstd) {
+          log_encoder_word(&enc, va_arg(args, uint32_t));
+        }
+        break;
+      default:
+        break;
+    }
+  }
+  log_encoder_flush(&enc);
+}
+
+void base_log_set_mode(log_mode_t mode) {
+  log_format_deferred();
+  log_mode = mode;
+}
+
+void base_log_defer_formatting(log_record_t *records, size_t num_records) {
+  log_format_deferred();
+  if (num_records == 0) {
+    records = NULL;
+  }
+  deferred_records = records;
+  deferred_records_len = num_records;
+  deferred_records_first = 0;
+  deferred_records_count = 0;
+}
+
+void base_log_flush(void) {
+  log_format_deferred();
+  base_stdout_flush();
+}
+
+/**
+ * Logs `log` and the values that follow to stdout.
+ *
+ * @param id the address of the log metadata in the `.logs.fields` section,
+ *        which identifies the log line in binary mode. Note that this pointer
+ *        is likely to be invalid at runtime, since the pointed-to data will
+ *        have been stripped from the binary.
+ * @param log the log data to log.
+ * @param ... format parameters matching the format string.
+ */
+void base_log_internal_core(const log_fields_t *id, log_fields_t log, ...) {
+  va_list args;
+  va_start(args, log);
+  if (log_mode == kLogModeBinary) {
+    // Encoding is cheap, so binary records are never deferred.
+    log_format_deferred();
+    log_encode(id, &log, args);
+  } else if (!log_defer(&log, args)) {
+    // Keep log lines in order.
+    log_format_deferred();
+    log_format(&log, args);
+  }
+  va_end(args);
 }
 
 /**
@@ -6,6 +6,7 @@
 #define OPENTITAN_SW_DEVICE_LIB_RUNTIME_LOG_H_
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "sw/device/lib/arch/device.h"
@@ -87,12 +88,110 @@ typedef struct log_fields {
   const char *format;
 } log_fields_t;
 
+enum {
+  /**
+   * Maximum number of format arguments of a log line whose formatting can be
+   * deferred.
+   */
+  kLogRecordMaxArgs = 8,
+};
+
+/**
+ * A log line whose formatting has been deferred.
+ *
+ * See `base_log_defer_formatting()`.
+ */
+typedef struct log_record {
+  /**
+   * Log metadata, including the format string.
+   */
+  log_fields_t fields;
+  /**
+   * Format arguments, one 32-bit word each.
+   */
+  uint32_t args[kLogRecordMaxArgs];
+} log_record_t;
+
+/**
+ * Defers the formatting of informational log lines.
+ *
+ * While enabled, `LOG_INFO()` only stores the log metadata and the raw format
+ * arguments in `records`; the lines are formatted and written to stdout by
+ * `base_log_flush()`, or when `records` fills up. Log lines of other
+ * severities, and log lines with more than `kLogRecordMaxArgs` arguments, are
+ * formatted immediately, after all pending records.
+ *
+ * Since only the argument values are stored, any strings or buffers passed to
+ * a deferred log line (e.g. for %s or %!x) must still be valid when it is
+ * flushed. Format arguments are stored as 32-bit words, so this is only
+ * supported on 32-bit targets.
+ *
+ * Pending records are flushed before switching buffers.
+ *
+ * @param records Storage for pending log lines, or `NULL` to disable deferred
+ *        formatting.
+ * @param num_records Number of entries in `records`.
+ */
+void base_log_defer_formatting(log_record_t *records, size_t num_records);
+
+/**
+ * Formats all pending log lines and flushes stdout.
+ *
+ * Tests that defer or buffer their log output must call this before they
+ * finish; the OTTF does so when it reports the test status.
+ */
+void base_log_flush(void);
+
+/**
+ * Log output modes, see `base_log_set_mode()`.
+ */
+typedef enum log_mode {
+  /**
+   * Log lines are formatted on the device and written to stdout as text.
+   */
+  kLogModeText = 0,
+  /**
+   * Log lines are written to stdout as binary records, which are formatted
+   * on the host.
+   */
+  kLogModeBinary,
+} log_mode_t;
+
+enum {
+  /**
+   * First byte of a binary log record.
+   *
+   * This byte never occurs in UTF-8 text, so binary records can be told apart
+   * from text written to the same sink.
+   */
+  kLogBinaryRecordMarker = 0xfe,
+};
+
+/**
+ * Selects how log lines are written to stdout.
+ *
+ * In binary mode, a log line is written as `kLogBinaryRecordMarker`, followed
+ * by the address of its `log_fields_t` in the `.logs.fields` section of the
+ * ELF file and its format arguments. All words are 32-bit little-endian. Most
+ * arguments are written as one word; string and buffer arguments (%s, %!s,
+ * %!x, %!X, %!y and %!Y) are written as their length in bytes, followed by
+ * the bytes themselves. Nothing is formatted on the device:
+ * util/device_sw_utils/decode_sw_logs.py turns the records back into log
+ * lines, using the log metadata and format strings from the ELF file.
+ *
+ * Log lines whose formatting has been deferred are formatted as text before
+ * the mode changes.
+ *
+ * @param mode The new log mode.
+ */
+void base_log_set_mode(log_mode_t mode);
+
 // Internal functions exposed only for access by macros. Their
 // real doxygen can be found in log.c.
 /**
  * Implementation detail.
  */
-void base_log_internal_core(log_fields_t log, ...);
+void base_log_internal_core(const log_fields_t *id, log_fields_t log, ...);
 /**
  * Implementation detail.
  */
@@ -108,25 +207,28 @@ void base_log_internal_dv(const log_fields_t *log, uint32_t nargs, ...);
  *               string literal.
  * @param ... format parameters matching the format string.
  */
-#define LOG(severity, format, ...)                               \
-  do {                                                           \
-    if (kDeviceLogBypassUartAddress != 0) {                      \
-      /* clang-format off */                                     \
-      /* Put DV-only log constants in .logs.* sections, which
-       * the linker will dutifully discard.
-       * Unfortunately, clang-format really mangles these
-       * declarations, so we format them manually. */            \
-      __attribute__((section(".logs.fields")))                   \
-      static const log_fields_t kLogFields =                     \
-          LOG_MAKE_FIELDS_(severity, format, ##__VA_ARGS__);     \
-      base_log_internal_dv(&kLogFields,                          \
+#define LOG(severity, format, ...)                                 \
+  do {                                                             \
+    /* clang-format off */                                         \
+    /* Put log constants in .logs.* sections, which the linker
+     * keeps in the ELF file but not in the image. The address of
+     * `kLogFields` identifies the log line, both in DV and in
+     * binary logs.
+     * Unfortunately, clang-format really mangles these
+     * declarations, so we format them manually. */                \
+    __attribute__((section(".logs.fields")))                       \
+    static const log_fields_t kLogFields =                         \
+        LOG_MAKE_FIELDS_(severity, format, ##__VA_ARGS__);         \
+    if (kDeviceLogBypassUartAddress != 0) {                        \
+      base_log_internal_dv(&kLogFields,                            \
                            OT_VA_ARGS_COUNT(format, ##__VA_ARGS__), \
-                           ##__VA_ARGS__); /* clang-format on */ \
-    } else {                                                     \
-      log_fields_t log_fields =                                  \
-          LOG_MAKE_FIELDS_(severity, format, ##__VA_ARGS__);     \
-      base_log_internal_core(log_fields, ##__VA_ARGS__);         \
-    }                                                            \
+                           ##__VA_ARGS__); /* clang-format on */   \
+    } else {                                                       \
+      log_fields_t log_fields =                                    \
+          LOG_MAKE_FIELDS_(severity, format, ##__VA_ARGS__);       \
+      base_log_internal_core(&kLogFields, log_fields,              \
+                             ##__VA_ARGS__);                       \
+    }                                                              \
   } while (false)
 
 /**
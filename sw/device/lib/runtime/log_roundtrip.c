@@ -0,0 +1,57 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/runtime/print.h"
+
+/**
+ * @file
+ * @brief Host program that writes a fixed set of log lines to stdout.
+ *
+ * Usage: log_roundtrip text|binary
+ *
+ * The log lines cover every format specifier of `base_vfprintf()`. Decoding
+ * the output of the `binary` mode with
+ * util/device_sw_utils/decode_sw_logs.py must reproduce the output of the
+ * `text` mode, see util/device_sw_utils/decode_sw_logs_test.py.
+ */
+
+static size_t stdout_sink(void *data, const char *buf, size_t len) {
+  return fwrite(buf, 1, len, stdout);
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2 ||
+      (strcmp(argv[1], "text") != 0 && strcmp(argv[1], "binary") != 0)) {
+    fprintf(stderr, "Usage: %s text|binary\n", argv[0]);
+    return 1;
+  }
+  base_set_stdout((buffer_sink_t){
+      .data = NULL,
+      .sink = &stdout_sink,
+  });
+  base_log_set_mode(strcmp(argv[1], "binary") == 0 ? kLogModeBinary
+                                                   : kLogModeText);
+
+  const uint8_t kBytes[] = {0x01, 0x02, 0x03, 0xab, 0xcd};
+  LOG_INFO("plain line");
+  // `%p` is left out, since host pointers are wider than device pointers.
+  LOG_INFO("d=%d neg=%d u=%u x=%08x X=%X h=%h c=%c o=%o b=%b %%", 42, -7,
+           3000000000u, 0xbeef, 0xabc, 0x12, 'Z', 8, 5);
+  LOG_WARNING("s=[%s] !s=[%!s] w=%5d", "hello", 3, "abcdef", 17);
+  LOG_ERROR("!x=%!x !X=%!X !y=%!y !Y=%!4Y", sizeof(kBytes), kBytes,
+            sizeof(kBytes), kBytes, sizeof(kBytes), kBytes, 2, kBytes);
+  LOG_INFO("bool=%!b %!b status=%r %!r err=%r", true, false, OK_STATUS(5),
+           OK_STATUS(6), INVALID_ARGUMENT());
+  // Text between records is passed through by the decoder.
+  base_printf("raw text\r\n");
+  LOG_FATAL("bad %0d tail %d", 1, 2);
+  base_log_flush();
+  return 0;
+}
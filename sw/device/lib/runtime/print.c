@@ -66,6 +66,19 @@ void base_set_stdout(buffer_sink_t out) {
   base_stdout = out;
 }
 
+size_t base_stdout_write(const char *buf, size_t len) {
+  if (base_stdout.sink == NULL) {
+    return len;
+  }
+  return base_stdout.sink(base_stdout.data, buf, len);
+}
+
+void base_stdout_flush(void) {
+  if (base_stdout.flush != NULL) {
+    base_stdout.flush(base_stdout.data);
+  }
+}
+
 static size_t base_dev_uart(void *data, const char *buf, size_t len) {
   const dif_uart_t *uart = (const dif_uart_t *)data;
   for (size_t i = 0; i < len; ++i) {
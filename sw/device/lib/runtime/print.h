@@ -36,10 +36,15 @@
  * that buffer's length.
  *
  * The sink function should return the number of bytes actually written.
+ *
+ * Sinks that buffer their output may also provide a flush function, which
+ * must not return until all previously written bytes have left the device.
+ * `flush` may be `NULL` for unbuffered sinks.
  */
 typedef struct buffer_sink {
   void *data;
   size_t (*sink)(void *data, const char *buf, size_t len);
+  void (*flush)(void *data);
 } buffer_sink_t;
 
 /**
@@ -279,6 +284,23 @@ size_t base_fhexdump_with(buffer_sink_t out, base_hexdump_fmt_t fmt,
  */
 void base_set_stdout(buffer_sink_t out);
 
+/**
+ * Writes `len` bytes from `buf` to the "stdout" sink, without formatting.
+ *
+ * @param buf the bytes to write.
+ * @param len the number of bytes to write.
+ * @return the number of bytes written.
+ */
+size_t base_stdout_write(const char *buf, size_t len);
+
+/**
+ * Flushes the "stdout" sink.
+ *
+ * Blocks until all bytes written to stdout so far have been sent, if the
+ * current sink buffers its output; otherwise this function does nothing.
+ */
+void base_stdout_flush(void);
+
 /**
  * Configures UART stdout for `base_print.h` to use.
  *
@@ -0,0 +1,226 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/runtime/uart_ring.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_uart.h"
+
+static bool is_power_of_two(size_t size) {
+  return size != 0 && (size & (size - 1)) == 0;
+}
+
+/**
+ * Moves bytes from the TX ring into the TX FIFO until either the ring is
+ * empty or the FIFO is full.
+ *
+ * Must be called with UART interrupts disabled or from the interrupt handler.
+ * The `tx_watermark` interrupt is edge-triggered, so this function must be
+ * called after every write to the TX ring: if it returns with bytes left in
+ * the ring, the FIFO is full and the interrupt fires once it drains below
+ * the watermark.
+ */
+static status_t tx_fill(uart_ring_t *ring) {
+  if (ring->tx_head == ring->tx_tail) {
+    return OK_STATUS();
+  }
+  // `tx_empty` is only used to detect the end of the transmission in
+  // `uart_ring_flush()`. Acknowledging it before writing to the FIFO ensures
+  // that it is set only once all of the bytes below have been sent.
+  TRY(dif_uart_irq_acknowledge(ring->uart, kDifUartIrqTxEmpty));
+  ring->tx_busy = true;
+  while (ring->tx_head != ring->tx_tail) {
+    uint32_t tail = ring->tx_tail;
+    size_t offset = tail & (ring->tx_size - 1);
+    size_t len = ring->tx_head - tail;
+    if (len > ring->tx_size - offset) {
+      len = ring->tx_size - offset;
+    }
+    size_t written;
+    TRY(dif_uart_bytes_send(ring->uart, &ring->tx_buf[offset], len,
+                            &written));
+    ring->tx_tail = tail + written;
+    if (written < len) {
+      break;
+    }
+  }
+  return OK_STATUS();
+}
+
+/**
+ * Moves bytes from the RX FIFO into the RX ring until either the ring is
+ * full or the FIFO is empty.
+ *
+ * Must be called with UART interrupts disabled or from the interrupt handler.
+ * Bytes that do not fit into the ring stay in the FIFO until
+ * `uart_ring_read()` makes room for them.
+ */
+static status_t rx_drain(uart_ring_t *ring) {
+  while (true) {
+    uint32_t head = ring->rx_head;
+    size_t space = ring->rx_size - (head - ring->rx_tail);
+    if (space == 0) {
+      break;
+    }
+    size_t offset = head & (ring->rx_size - 1);
+    size_t len = ring->rx_size - offset;
+    if (len > space) {
+      len = space;
+    }
+    size_t read;
+    TRY(dif_uart_bytes_receive(ring->uart, len, &ring->rx_buf[offset],
+                               &read));
+    ring->rx_head = head + read;
+    if (read < len) {
+      break;
+    }
+  }
+  return OK_STATUS();
+}
+
+status_t uart_ring_init(uart_ring_t *ring, const dif_uart_t *uart,
+                        uint8_t *tx_buf, size_t tx_size, uint8_t *rx_buf,
+                        size_t rx_size) {
+  bool has_rx = rx_buf != NULL || rx_size != 0;
+  if (ring == NULL || uart == NULL || tx_buf == NULL ||
+      !is_power_of_two(tx_size) ||
+      (has_rx && (rx_buf == NULL || !is_power_of_two(rx_size)))) {
+    return INVALID_ARGUMENT();
+  }
+  *ring = (uart_ring_t){
+      .uart = uart,
+      .tx_buf = tx_buf,
+      .tx_size = tx_size,
+      .rx_buf = rx_buf,
+      .rx_size = rx_size,
+  };
+
+  // Refill the TX FIFO once it is half empty.
+  TRY(dif_uart_watermark_tx_set(uart, kDifUartWatermarkByte16));
+  TRY(dif_uart_irq_acknowledge(uart, kDifUartIrqTxWatermark));
+  TRY(dif_uart_irq_set_enabled(uart, kDifUartIrqTxWatermark,
+                               kDifToggleEnabled));
+  if (!has_rx) {
+    return OK_STATUS();
+  }
+
+  // Drain the RX FIFO once it is half full; the RX timeout picks up the bytes
+  // below the watermark.
+  TRY(dif_uart_watermark_rx_set(uart, kDifUartWatermarkByte16));
+  TRY(dif_uart_enable_rx_timeout(uart, kUartRingRxTimeoutTicks));
+  static const dif_uart_irq_t kRxIrqs[] = {
+      kDifUartIrqRxWatermark,
+      kDifUartIrqRxTimeout,
+  };
+  for (size_t i = 0; i < ARRAYSIZE(kRxIrqs); ++i) {
+    TRY(dif_uart_irq_acknowledge(uart, kRxIrqs[i]));
+    TRY(dif_uart_irq_set_enabled(uart, kRxIrqs[i], kDifToggleEnabled));
+  }
+  return OK_STATUS();
+}
+
+status_t uart_ring_write(uart_ring_t *ring, const void *data, size_t len) {
+  if (ring == NULL || (data == NULL && len > 0)) {
+    return INVALID_ARGUMENT();
+  }
+
+  const uint8_t *bytes = (const uint8_t *)data;
+  dif_uart_irq_enable_snapshot_t snapshot;
+  TRY(dif_uart_irq_disable_all(ring->uart, &snapshot));
+  uint32_t head = ring->tx_head;
+  size_t space = ring->tx_size - (head - ring->tx_tail);
+  if (len > space) {
+    len = space;
+  }
+  for (size_t i = 0; i < len; ++i, ++head) {
+    ring->tx_buf[head & (ring->tx_size - 1)] = bytes[i];
+  }
+  ring->tx_head = head;
+  status_t result = tx_fill(ring);
+  TRY(dif_uart_irq_restore_all(ring->uart, &snapshot));
+  TRY(result);
+  return OK_STATUS((int32_t)len);
+}
+
+status_t uart_ring_flush(uart_ring_t *ring) {
+  if (ring == NULL) {
+    return INVALID_ARGUMENT();
+  }
+
+  dif_uart_irq_enable_snapshot_t snapshot;
+  TRY(dif_uart_irq_disable_all(ring->uart, &snapshot));
+  status_t result = OK_STATUS();
+  while (status_ok(result) && ring->tx_head != ring->tx_tail) {
+    result = tx_fill(ring);
+  }
+  bool tx_empty = !ring->tx_busy;
+  while (status_ok(result) && !tx_empty) {
+    result = INTO_STATUS(
+        dif_uart_irq_is_pending(ring->uart, kDifUartIrqTxEmpty, &tx_empty));
+  }
+  if (status_ok(result)) {
+    ring->tx_busy = false;
+  }
+  TRY(dif_uart_irq_restore_all(ring->uart, &snapshot));
+  TRY(result);
+  return OK_STATUS();
+}
+
+status_t uart_ring_read(uart_ring_t *ring, void *data, size_t len) {
+  if (ring == NULL || (data == NULL && len > 0)) {
+    return INVALID_ARGUMENT();
+  }
+
+  uint8_t *bytes = (uint8_t *)data;
+  dif_uart_irq_enable_snapshot_t snapshot;
+  TRY(dif_uart_irq_disable_all(ring->uart, &snapshot));
+  uint32_t tail = ring->rx_tail;
+  size_t avail = ring->rx_head - tail;
+  if (len > avail) {
+    len = avail;
+  }
+  for (size_t i = 0; i < len; ++i, ++tail) {
+    bytes[i] = ring->rx_buf[tail & (ring->rx_size - 1)];
+  }
+  ring->rx_tail = tail;
+  // Pick up bytes that were left in the FIFO because the ring was full.
+  status_t result = rx_drain(ring);
+  TRY(dif_uart_irq_restore_all(ring->uart, &snapshot));
+  TRY(result);
+  return OK_STATUS((int32_t)len);
+}
+
+status_t uart_ring_isr(uart_ring_t *ring) {
+  if (ring == NULL) {
+    return INVALID_ARGUMENT();
+  }
+
+  dif_uart_irq_state_snapshot_t state;
+  TRY(dif_uart_irq_get_state(ring->uart, &state));
+  bool tx = (state >> kDifUartIrqTxWatermark) & 1;
+  // A TX-only ring leaves the RX interrupts to their owner.
+  bool has_rx = ring->rx_size != 0;
+  bool rx_watermark = has_rx && ((state >> kDifUartIrqRxWatermark) & 1);
+  bool rx_timeout = has_rx && ((state >> kDifUartIrqRxTimeout) & 1);
+
+  if (tx) {
+    TRY(dif_uart_irq_acknowledge(ring->uart, kDifUartIrqTxWatermark));
+    TRY(tx_fill(ring));
+  }
+  if (rx_watermark) {
+    TRY(dif_uart_irq_acknowledge(ring->uart, kDifUartIrqRxWatermark));
+  }
+  if (rx_timeout) {
+    TRY(dif_uart_irq_acknowledge(ring->uart, kDifUartIrqRxTimeout));
+  }
+  if (rx_watermark || rx_timeout) {
+    TRY(rx_drain(ring));
+  }
+  return OK_STATUS(tx || rx_watermark || rx_timeout);
+}
@@ -0,0 +1,146 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_RUNTIME_UART_RING_H_
+#define OPENTITAN_SW_DEVICE_LIB_RUNTIME_UART_RING_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_uart.h"
+
+/**
+ * @file
+ * @brief Interrupt-driven, ring-buffered UART transfers.
+ *
+ * `dif_uart_byte_send_polled()` and `dif_uart_byte_receive_polled()` keep the
+ * CPU spinning on the UART status for every byte. This driver layer moves
+ * data between caller-provided ring buffers and the UART FIFOs from the
+ * `tx_watermark`, `rx_watermark` and `rx_timeout` interrupts instead, so that
+ * `uart_ring_write()` and `uart_ring_read()` never wait for the UART. Every
+ * refill or drain of a FIFO reads the FIFO level once and then moves as many
+ * bytes as fit.
+ *
+ * Routing the UART interrupts to the CPU is left to the caller, whose handler
+ * must call `uart_ring_isr()`.
+ *
+ * A ring without RX buffer only handles the TX direction and leaves the RX
+ * FIFO and its interrupts to other code, e.g. the OTTF console uses it for
+ * buffered output while commands are still received with polled reads.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+enum {
+  /**
+   * RX idle time in bit times after which bytes below the RX watermark are
+   * moved into the RX ring, i.e. about four characters.
+   */
+  kUartRingRxTimeoutTicks = 40,
+};
+
+/**
+ * State of a ring-buffered UART.
+ *
+ * All fields are managed by the `uart_ring_*()` functions. The `head` and
+ * `tail` indices count bytes modulo 2^32 and are masked when indexing the
+ * buffers. The interrupt handler only writes `tx_tail`, `tx_busy` and
+ * `rx_head`. `tx_busy` is set while bytes written to the TX FIFO may still be
+ * in transmission.
+ */
+typedef struct uart_ring {
+  const dif_uart_t *uart;
+  uint8_t *tx_buf;
+  size_t tx_size;
+  volatile uint32_t tx_head;
+  volatile uint32_t tx_tail;
+  volatile bool tx_busy;
+  uint8_t *rx_buf;
+  size_t rx_size;
+  volatile uint32_t rx_head;
+  volatile uint32_t rx_tail;
+} uart_ring_t;
+
+/**
+ * Initializes a ring-buffered UART.
+ *
+ * Configures the FIFO watermarks and the RX timeout of an already configured
+ * UART and enables its `tx_watermark`, `rx_watermark` and `rx_timeout`
+ * interrupts. If `rx_buf` is NULL and `rx_size` is zero, only the TX
+ * direction is configured.
+ *
+ * @param[out] ring The ring-buffered UART to initialize.
+ * @param uart A configured UART handle.
+ * @param tx_buf Storage of the TX ring.
+ * @param tx_size Size of `tx_buf` in bytes, a power of two.
+ * @param rx_buf Storage of the RX ring, or NULL for a TX-only ring.
+ * @param rx_size Size of `rx_buf` in bytes, a power of two, or zero for a
+ * TX-only ring.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t uart_ring_init(uart_ring_t *ring, const dif_uart_t *uart,
+                        uint8_t *tx_buf, size_t tx_size, uint8_t *rx_buf,
+                        size_t rx_size);
+
+/**
+ * Queues bytes for transmission without waiting.
+ *
+ * Copies as many bytes as fit into the TX ring and tops up the TX FIFO.
+ *
+ * @param ring A ring-buffered UART.
+ * @param data The bytes to send.
+ * @param len The number of bytes to send.
+ * @return The number of bytes queued, or an error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t uart_ring_write(uart_ring_t *ring, const void *data, size_t len);
+
+/**
+ * Sends all queued bytes and waits until the transmission has finished.
+ *
+ * Polls the UART with its interrupts disabled, so that it can also be used
+ * from exception handlers or with interrupts disabled at the CPU.
+ *
+ * @param ring A ring-buffered UART.
+ * @return The result of the operation.
+ */
+OT_WARN_UNUSED_RESULT
+status_t uart_ring_flush(uart_ring_t *ring);
+
+/**
+ * Takes received bytes without waiting.
+ *
+ * Copies up to `len` bytes out of the RX ring and refills the ring with any
+ * bytes waiting in the RX FIFO.
+ *
+ * @param ring A ring-buffered UART.
+ * @param[out] data Buffer for the received bytes.
+ * @param len The size of `data`.
+ * @return The number of bytes received, or an error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t uart_ring_read(uart_ring_t *ring, void *data, size_t len);
+
+/**
+ * Services the interrupts of a ring-buffered UART.
+ *
+ * Must be called from the UART interrupt handler.
+ *
+ * @param ring A ring-buffered UART.
+ * @return Whether any of the interrupts serviced by the ring was pending, or
+ * an error.
+ */
+OT_WARN_UNUSED_RESULT
+status_t uart_ring_isr(uart_ring_t *ring);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_RUNTIME_UART_RING_H_
@@ -0,0 +1,217 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/runtime/uart_ring.h"
+
+#include <array>
+#include <cstdint>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/mock_mmio.h"
+
+#include "uart_regs.h"  // Generated.
+
+namespace uart_ring_unittest {
+namespace {
+using mock_mmio::MmioTest;
+using testing::ElementsAre;
+using testing::Test;
+
+class UartRingTest : public Test, public MmioTest {
+ protected:
+  void SetUp() override {
+    // Set up the ring directly, `uart_ring_init()` only configures the UART.
+    ring_ = uart_ring_t{
+        .uart = &uart_,
+        .tx_buf = tx_buf_.data(),
+        .tx_size = tx_buf_.size(),
+        .rx_buf = rx_buf_.data(),
+        .rx_size = rx_buf_.size(),
+    };
+  }
+
+  void ExpectIrqDisable() {
+    EXPECT_READ32(UART_INTR_ENABLE_REG_OFFSET, kIrqEnable);
+    EXPECT_WRITE32(UART_INTR_ENABLE_REG_OFFSET, 0);
+  }
+
+  void ExpectIrqRestore() {
+    EXPECT_WRITE32(UART_INTR_ENABLE_REG_OFFSET, kIrqEnable);
+  }
+
+  void ExpectTxEmptyAck() {
+    EXPECT_WRITE32(UART_INTR_STATE_REG_OFFSET,
+                   {{UART_INTR_STATE_TX_EMPTY_BIT, true}});
+  }
+
+  void ExpectTxLevel(uint32_t level) {
+    EXPECT_READ32(UART_FIFO_STATUS_REG_OFFSET,
+                  {{UART_FIFO_STATUS_TXLVL_OFFSET, level}});
+  }
+
+  void ExpectRxLevel(uint32_t level) {
+    EXPECT_READ32(UART_FIFO_STATUS_REG_OFFSET,
+                  {{UART_FIFO_STATUS_RXLVL_OFFSET, level}});
+  }
+
+  static constexpr uint32_t kIrqEnable = 0x43;
+  dif_uart_t uart_ = {.base_addr = dev().region()};
+  std::array<uint8_t, 8> tx_buf_ = {};
+  std::array<uint8_t, 4> rx_buf_ = {};
+  uart_ring_t ring_;
+};
+
+TEST_F(UartRingTest, InitBadArgs) {
+  EXPECT_FALSE(status_ok(uart_ring_init(nullptr, &uart_, tx_buf_.data(), 8,
+                                        rx_buf_.data(), 4)));
+  EXPECT_FALSE(status_ok(uart_ring_init(&ring_, nullptr, tx_buf_.data(), 8,
+                                        rx_buf_.data(), 4)));
+  EXPECT_FALSE(status_ok(
+      uart_ring_init(&ring_, &uart_, tx_buf_.data(), 6, rx_buf_.data(), 4)));
+  EXPECT_FALSE(status_ok(
+      uart_ring_init(&ring_, &uart_, tx_buf_.data(), 8, rx_buf_.data(), 0)));
+  EXPECT_FALSE(status_ok(
+      uart_ring_init(&ring_, &uart_, tx_buf_.data(), 8, nullptr, 4)));
+}
+
+TEST_F(UartRingTest, InitTxOnly) {
+  // Only the TX watermark is configured and enabled.
+  EXPECT_MASK32(UART_FIFO_CTRL_REG_OFFSET,
+                {{UART_FIFO_CTRL_TXILVL_OFFSET, UART_FIFO_CTRL_TXILVL_MASK,
+                  UART_FIFO_CTRL_TXILVL_VALUE_TXLVL16}});
+  EXPECT_WRITE32(UART_INTR_STATE_REG_OFFSET,
+                 {{UART_INTR_STATE_TX_WATERMARK_BIT, true}});
+  EXPECT_MASK32(UART_INTR_ENABLE_REG_OFFSET,
+                {{UART_INTR_COMMON_TX_WATERMARK_BIT, 1, true}});
+  EXPECT_TRUE(status_ok(
+      uart_ring_init(&ring_, &uart_, tx_buf_.data(), 8, nullptr, 0)));
+
+  // RX interrupts are left to their owner.
+  EXPECT_READ32(UART_INTR_STATE_REG_OFFSET,
+                {{UART_INTR_STATE_RX_WATERMARK_BIT, true},
+                 {UART_INTR_STATE_RX_TIMEOUT_BIT, true}});
+  status_t res = uart_ring_isr(&ring_);
+  EXPECT_TRUE(status_ok(res));
+  EXPECT_EQ(res.value, false);
+}
+
+TEST_F(UartRingTest, Write) {
+  const uint8_t kData[] = "0123456789";
+
+  // Only the ring is filled to capacity, the FIFO has room for five bytes.
+  ExpectIrqDisable();
+  ExpectTxEmptyAck();
+  ExpectTxLevel(kDifUartFifoSizeBytes - 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[i]);
+  }
+  ExpectIrqRestore();
+  status_t res = uart_ring_write(&ring_, kData, 10);
+  EXPECT_TRUE(status_ok(res));
+  EXPECT_EQ(res.value, 8);
+
+  // The TX watermark interrupt moves the rest into the FIFO.
+  EXPECT_READ32(UART_INTR_STATE_REG_OFFSET,
+                {{UART_INTR_STATE_TX_WATERMARK_BIT, true}});
+  EXPECT_WRITE32(UART_INTR_STATE_REG_OFFSET,
+                 {{UART_INTR_STATE_TX_WATERMARK_BIT, true}});
+  ExpectTxEmptyAck();
+  ExpectTxLevel(16);
+  for (int i = 5; i < 8; ++i) {
+    EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[i]);
+  }
+  res = uart_ring_isr(&ring_);
+  EXPECT_TRUE(status_ok(res));
+  EXPECT_EQ(res.value, true);
+
+  // The ring wraps around.
+  ExpectIrqDisable();
+  ExpectTxEmptyAck();
+  ExpectTxLevel(0);
+  EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[8]);
+  EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[9]);
+  ExpectIrqRestore();
+  res = uart_ring_write(&ring_, &kData[8], 2);
+  EXPECT_EQ(res.value, 2);
+}
+
+TEST_F(UartRingTest, Flush) {
+  const uint8_t kData[] = "0123";
+
+  // Nothing has been sent, so there is nothing to wait for.
+  ExpectIrqDisable();
+  ExpectIrqRestore();
+  EXPECT_TRUE(status_ok(uart_ring_flush(&ring_)));
+
+  ExpectIrqDisable();
+  ExpectTxEmptyAck();
+  ExpectTxLevel(kDifUartFifoSizeBytes - 2);
+  EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[0]);
+  EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[1]);
+  ExpectIrqRestore();
+  EXPECT_EQ(uart_ring_write(&ring_, kData, 4).value, 4);
+
+  // The rest is sent by polling, then the flush waits for `tx_empty`.
+  ExpectIrqDisable();
+  ExpectTxEmptyAck();
+  ExpectTxLevel(kDifUartFifoSizeBytes - 1);
+  EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[2]);
+  ExpectTxEmptyAck();
+  ExpectTxLevel(kDifUartFifoSizeBytes - 1);
+  EXPECT_WRITE32(UART_WDATA_REG_OFFSET, kData[3]);
+  EXPECT_READ32(UART_INTR_STATE_REG_OFFSET, 0);
+  EXPECT_READ32(UART_INTR_STATE_REG_OFFSET,
+                {{UART_INTR_STATE_TX_EMPTY_BIT, true}});
+  ExpectIrqRestore();
+  EXPECT_TRUE(status_ok(uart_ring_flush(&ring_)));
+
+  // The transmission has finished, so the next flush does not wait.
+  ExpectIrqDisable();
+  ExpectIrqRestore();
+  EXPECT_TRUE(status_ok(uart_ring_flush(&ring_)));
+}
+
+TEST_F(UartRingTest, Read) {
+  // The RX timeout interrupt fills the ring; the rest stays in the FIFO.
+  EXPECT_READ32(UART_INTR_STATE_REG_OFFSET,
+                {{UART_INTR_STATE_RX_TIMEOUT_BIT, true}});
+  EXPECT_WRITE32(UART_INTR_STATE_REG_OFFSET,
+                 {{UART_INTR_STATE_RX_TIMEOUT_BIT, true}});
+  ExpectRxLevel(6);
+  for (uint32_t byte : {'a', 'b', 'c', 'd'}) {
+    EXPECT_READ32(UART_RDATA_REG_OFFSET, byte);
+  }
+  status_t res = uart_ring_isr(&ring_);
+  EXPECT_EQ(res.value, true);
+
+  // Reading makes room for the bytes left in the FIFO.
+  std::array<uint8_t, 8> data = {};
+  ExpectIrqDisable();
+  ExpectRxLevel(2);
+  EXPECT_READ32(UART_RDATA_REG_OFFSET, 'e');
+  EXPECT_READ32(UART_RDATA_REG_OFFSET, 'f');
+  ExpectIrqRestore();
+  res = uart_ring_read(&ring_, data.data(), 3);
+  EXPECT_EQ(res.value, 3);
+
+  ExpectIrqDisable();
+  ExpectRxLevel(0);
+  ExpectIrqRestore();
+  res = uart_ring_read(&ring_, &data[3], 5);
+  EXPECT_EQ(res.value, 3);
+  EXPECT_THAT(data, ElementsAre('a', 'b', 'c', 'd', 'e', 'f', 0, 0));
+}
+
+TEST_F(UartRingTest, IsrNotPending) {
+  EXPECT_READ32(UART_INTR_STATE_REG_OFFSET,
+                {{UART_INTR_STATE_TX_EMPTY_BIT, true}});
+  status_t res = uart_ring_isr(&ring_);
+  EXPECT_TRUE(status_ok(res));
+  EXPECT_EQ(res.value, false);
+}
+
+}  // namespace
+}  // namespace uart_ring_unittest
@@ -0,0 +1,127 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/test_framework/ottf_console_buffer.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/arch/device.h"
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/mmio.h"
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/dif/dif_rv_plic.h"
+#include "sw/device/lib/dif/dif_uart.h"
+#include "sw/device/lib/runtime/hart.h"
+#include "sw/device/lib/runtime/irq.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/runtime/print.h"
+#include "sw/device/lib/runtime/uart_ring.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_isrs.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/testing/test_framework/status.h"
+
+#include "hw/top_earlgrey/sw/autogen/top_earlgrey.h"
+
+static_assert(
+    (kOttfConsoleBufferNumBytes & (kOttfConsoleBufferNumBytes - 1)) == 0,
+    "kOttfConsoleBufferNumBytes must be a power of two.");
+
+static uint8_t tx_buf[kOttfConsoleBufferNumBytes];
+static uart_ring_t ring;
+static bool enabled;
+
+static log_record_t log_records[kOttfConsoleBufferNumLogRecords];
+
+/**
+ * Fails the test if the UART ring reports an error.
+ *
+ * `CHECK()` cannot be used on the console paths below: it logs through this
+ * console, which would recurse into the failing ring. Instead, the failure is
+ * reported only through the test status device.
+ */
+static void console_check(status_t res) {
+  if (status_ok(res)) {
+    return;
+  }
+  enabled = false;
+  if (kDeviceTestStatusAddress != 0) {
+    mmio_region_write32(mmio_region_from_addr(kDeviceTestStatusAddress), 0x0,
+                        (uint32_t)kTestStatusFailed);
+  }
+  abort();
+}
+
+/**
+ * Sink function for the buffered console.
+ */
+static size_t console_sink(void *data, const char *buf, size_t len) {
+  uart_ring_t *ring = (uart_ring_t *)data;
+  size_t sent = 0;
+  while (sent < len) {
+    // If the ring is full, this busy-waits for the FIFO to drain: every write
+    // tops up the FIFO, so it also makes progress with interrupts disabled.
+    status_t res = uart_ring_write(ring, &buf[sent], len - sent);
+    console_check(res);
+    sent += (size_t)res.value;
+  }
+  return len;
+}
+
+/**
+ * Flush function for the buffered console.
+ *
+ * Does not rely on interrupts, so that it can also be used in exception
+ * handlers.
+ */
+static void console_flush(void *data) {
+  console_check(uart_ring_flush((uart_ring_t *)data));
+}
+
+bool ottf_console_buffer_isr(void) {
+  if (!enabled) {
+    return false;
+  }
+  status_t res = uart_ring_isr(&ring);
+  console_check(res);
+  return res.value != 0;
+}
+
+void ottf_console_buffer_enable(bool defer_logs) {
+  const uint32_t kPlicTarget = kTopEarlgreyPlicTargetIbex0;
+  dif_uart_t *uart = ottf_console();
+
+  // Send everything that has been printed so far before switching sinks.
+  base_log_flush();
+  // The console only buffers output, commands are still received with polled
+  // reads.
+  CHECK(status_ok(uart_ring_init(&ring, uart, tx_buf, sizeof(tx_buf),
+                                 /*rx_buf=*/NULL, /*rx_size=*/0)));
+  enabled = true;
+
+  CHECK_DIF_OK(dif_rv_plic_init(
+      mmio_region_from_addr(TOP_EARLGREY_RV_PLIC_BASE_ADDR), &ottf_plic));
+  CHECK_DIF_OK(dif_rv_plic_irq_set_priority(
+      &ottf_plic, kTopEarlgreyPlicIrqIdUart0TxWatermark,
+      kDifRvPlicMaxPriority));
+  CHECK_DIF_OK(dif_rv_plic_target_set_threshold(&ottf_plic, kPlicTarget,
+                                                kDifRvPlicMinPriority));
+  CHECK_DIF_OK(dif_rv_plic_irq_set_enabled(
+      &ottf_plic, kTopEarlgreyPlicIrqIdUart0TxWatermark, kPlicTarget,
+      kDifToggleEnabled));
+  irq_global_ctrl(true);
+  irq_external_ctrl(true);
+
+  base_set_stdout((buffer_sink_t){
+      .data = &ring,
+      .sink = &console_sink,
+      .flush = &console_flush,
+  });
+  if (defer_logs) {
+    base_log_defer_formatting(log_records, ARRAYSIZE(log_records));
+  }
+}
@@ -0,0 +1,50 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_BUFFER_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_BUFFER_H_
+
+#include <stdbool.h>
+
+/**
+ * @file
+ * @brief Buffered, interrupt-driven output for the OTTF console.
+ *
+ * By default, every character printed to the OTTF console is sent with
+ * `dif_uart_byte_send_polled()`, i.e. each log line stalls the CPU for its
+ * full transmission time. Once buffering is enabled, printed characters are
+ * copied into a `uart_ring_t` TX ring instead and moved into the UART TX FIFO
+ * from the `tx_watermark` interrupt.
+ *
+ * Buffered output must be flushed with `base_log_flush()` before the device
+ * stops; `test_status_set()` does so when the test finishes.
+ */
+
+enum {
+  /**
+   * Size of the console output ring buffer in bytes.
+   */
+  kOttfConsoleBufferNumBytes = 2048,
+  /**
+   * Number of log lines that can be pending when formatting is deferred.
+   */
+  kOttfConsoleBufferNumLogRecords = 32,
+};
+
+/**
+ * Switches the OTTF console to buffered, interrupt-driven output.
+ *
+ * This function configures the UART TX watermark interrupt at the PLIC and
+ * enables interrupts at the CPU.
+ *
+ * If `defer_logs` is true, `LOG_INFO()` only records its arguments and the
+ * log lines are formatted when the console is flushed, see
+ * `base_log_defer_formatting()` for the restrictions that apply. This removes
+ * formatting from timing-sensitive code in addition to the UART transfer.
+ *
+ * @param defer_logs Whether to defer the formatting of informational logs.
+ */
+void ottf_console_buffer_enable(bool defer_logs);
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_CONSOLE_BUFFER_H_
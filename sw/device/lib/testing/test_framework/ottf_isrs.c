@@ -58,6 +58,8 @@ void ottf_generic_fault_print(const char *reason, uint32_t mcause) {
   uint32_t mtval = ibex_mtval_read();
   LOG_ERROR("FAULT: %s. MCAUSE=%08x MEPC=%08x MTVAL=%08x", reason, mcause, mepc,
             mtval);
+  // Make sure that the message leaves the device before it stops.
+  base_log_flush();
 }
 
 static void generic_fault_handler(void) {
@@ -152,6 +154,9 @@ void ottf_timer_isr(void) {
 OT_WEAK
 bool ottf_flow_control_isr(void) { return false; }
 
+OT_WEAK
+bool ottf_console_buffer_isr(void) { return false; }
+
 OT_WEAK
 void ottf_external_isr(void) {
   const uint32_t kPlicTarget = kTopEarlgreyPlicTargetIbex0;
@@ -161,12 +166,16 @@ void ottf_external_isr(void) {
   top_earlgrey_plic_peripheral_t peripheral = (top_earlgrey_plic_peripheral_t)
       top_earlgrey_plic_interrupt_for_peripheral[plic_irq_id];
 
-  if (peripheral == kTopEarlgreyPlicPeripheralUart0 &&
-      ottf_flow_control_isr()) {
-    // Complete the IRQ at PLIC.
-    CHECK_DIF_OK(
-        dif_rv_plic_irq_complete(&ottf_plic, kPlicTarget, plic_irq_id));
-    return;
+  if (peripheral == kTopEarlgreyPlicPeripheralUart0) {
+    // Both handlers must run, since either may have a pending UART interrupt.
+    bool console_handled = ottf_console_buffer_isr();
+    bool flow_control_handled = ottf_flow_control_isr();
+    if (console_handled || flow_control_handled) {
+      // Complete the IRQ at PLIC.
+      CHECK_DIF_OK(
+          dif_rv_plic_irq_complete(&ottf_plic, kPlicTarget, plic_irq_id));
+      return;
+    }
   }
 
   ottf_generic_fault_print("External IRQ", ibex_mcause_read());
@@ -22,6 +22,7 @@
 #include "sw/device/lib/testing/test_framework/FreeRTOSConfig.h"
 #include "sw/device/lib/testing/test_framework/check.h"
 #include "sw/device/lib/testing/test_framework/coverage.h"
+#include "sw/device/lib/testing/test_framework/ottf_perf.h"
 #include "sw/device/lib/testing/test_framework/status.h"
 #include "sw/device/silicon_creator/lib/manifest_def.h"
 
@@ -97,6 +98,7 @@ static void report_test_status(bool result) {
     if (kOttfTestConfig.can_clobber_uart) {
       init_uart();
     }
+    ottf_perf_report();
     LOG_INFO("Finished %s", kOttfTestConfig.file);
     test_coverage_send_buffer();
   }
@@ -0,0 +1,130 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/testing/test_framework/ottf_perf.h"
+
+#include <stddef.h>
+
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+
+/**
+ * The HPM event backing each `ottf_perf_counter_t`.
+ */
+static const ibex_hpm_event_t kCounterEvents[kOttfPerfCounterCount] = {
+    [kOttfPerfCounterCycles] = kIbexHpmEventCycles,
+    [kOttfPerfCounterInstrRetired] = kIbexHpmEventInstrRetired,
+    [kOttfPerfCounterLsuWait] = kIbexHpmEventLsuWait,
+    [kOttfPerfCounterFetchWait] = kIbexHpmEventFetchWait,
+    [kOttfPerfCounterLoads] = kIbexHpmEventLoads,
+    [kOttfPerfCounterStores] = kIbexHpmEventStores,
+    [kOttfPerfCounterBranchesTaken] = kIbexHpmEventBranchesTaken,
+    [kOttfPerfCounterJumps] = kIbexHpmEventJumps,
+};
+
+// Regions that have been entered at least once, in order of first entry.
+static ottf_perf_region_t *regions_head;
+static ottf_perf_region_t *regions_tail;
+
+// The currently active regions, innermost last.
+static ottf_perf_region_t *active[kOttfPerfMaxDepth];
+static size_t active_depth;
+
+static bool counters_enabled;
+
+static void counters_enable(void) {
+  uint32_t events = 0;
+  for (size_t i = 0; i < kOttfPerfCounterCount; ++i) {
+    events |= 1u << kCounterEvents[i];
+  }
+  ibex_hpm_enable(events);
+  counters_enabled = true;
+}
+
+void ottf_perf_begin(ottf_perf_region_t *region) {
+  if (!counters_enabled) {
+    counters_enable();
+  }
+  CHECK(active_depth < kOttfPerfMaxDepth, "Regions nested too deeply");
+  for (size_t i = 0; i < active_depth; ++i) {
+    CHECK(active[i] != region, "Region %s is already active", region->label);
+  }
+
+  if (!region->registered) {
+    region->registered = true;
+    region->depth = active_depth;
+    region->next = NULL;
+    if (regions_tail == NULL) {
+      regions_head = region;
+    } else {
+      regions_tail->next = region;
+    }
+    regions_tail = region;
+  }
+  active[active_depth++] = region;
+
+  // Read the cycle counter last, so that as little of the bookkeeping as
+  // possible is attributed to the region.
+  for (size_t i = kOttfPerfCounterCount; i > 0; --i) {
+    region->start[i - 1] = ibex_hpm_read(kCounterEvents[i - 1]);
+  }
+}
+
+void ottf_perf_end(ottf_perf_region_t *region) {
+  // Read the counters before anything else, cycles first.
+  uint32_t end[kOttfPerfCounterCount];
+  for (size_t i = 0; i < kOttfPerfCounterCount; ++i) {
+    end[i] = ibex_hpm_read(kCounterEvents[i]);
+  }
+
+  CHECK(active_depth > 0 && active[active_depth - 1] == region,
+        "Region %s is not the innermost active region", region->label);
+  --active_depth;
+
+  for (size_t i = 0; i < kOttfPerfCounterCount; ++i) {
+    // Unsigned subtraction handles the low 32 bits of a counter wrapping
+    // around once.
+    region->totals[i] += end[i] - region->start[i];
+  }
+  ++region->runs;
+}
+
+uint64_t ottf_perf_total(const ottf_perf_region_t *region,
+                         ottf_perf_counter_t counter) {
+  CHECK(counter < kOttfPerfCounterCount);
+  return region->totals[counter];
+}
+
+// `base_printf()` cannot print `uint64_t`, so saturate totals for printing.
+static uint32_t saturate32(uint64_t value) {
+  return value > UINT32_MAX ? UINT32_MAX : (uint32_t)value;
+}
+
+void ottf_perf_report(void) {
+  if (regions_head == NULL) {
+    return;
+  }
+  if (active_depth != 0) {
+    LOG_WARNING("Region %s is still active", active[active_depth - 1]->label);
+  }
+
+  for (const ottf_perf_region_t *r = regions_head; r != NULL; r = r->next) {
+    const uint64_t *t = r->totals;
+    uint32_t cycles_per_run =
+        r->runs == 0 ? 0 : saturate32(t[kOttfPerfCounterCycles] / r->runs);
+    LOG_INFO(
+        "PERF region=%s depth=%u runs=%u cycles=%u cycles_per_run=%u "
+        "instrs=%u lsu_wait=%u fetch_wait=%u loads=%u stores=%u "
+        "branches_taken=%u jumps=%u",
+        r->label, r->depth, r->runs, saturate32(t[kOttfPerfCounterCycles]),
+        cycles_per_run, saturate32(t[kOttfPerfCounterInstrRetired]),
+        saturate32(t[kOttfPerfCounterLsuWait]),
+        saturate32(t[kOttfPerfCounterFetchWait]),
+        saturate32(t[kOttfPerfCounterLoads]),
+        saturate32(t[kOttfPerfCounterStores]),
+        saturate32(t[kOttfPerfCounterBranchesTaken]),
+        saturate32(t[kOttfPerfCounterJumps]));
+  }
+}
@@ -0,0 +1,159 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_PERF_H_
+#define OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_PERF_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @file
+ * @brief OTTF profiling of named code regions with the Ibex performance
+ * counters.
+ *
+ * A region is a statically-allocated `ottf_perf_region_t`. Each
+ * `ottf_perf_begin()`/`ottf_perf_end()` pair around the code to measure adds
+ * the number of events of each kind in `ottf_perf_counter_t` to the region's
+ * totals, so a region can be entered many times to average over runs. Regions
+ * may be nested; the counts of an outer region include those of the regions
+ * nested in it, and the overhead of their begin and end calls.
+ *
+ *   static ottf_perf_region_t copy = OTTF_PERF_REGION("memcpy");
+ *
+ *   for (size_t i = 0; i < kNumRuns; ++i) {
+ *     ottf_perf_begin(&copy);
+ *     memcpy(dest, src, len);
+ *     ottf_perf_end(&copy);
+ *   }
+ *
+ * The OTTF prints all regions that have been entered at least once when the
+ * test finishes; see `ottf_perf_report()`.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+/**
+ * The events counted for each region.
+ */
+typedef enum ottf_perf_counter {
+  kOttfPerfCounterCycles,
+  kOttfPerfCounterInstrRetired,
+  /** Cycles stalled waiting for loads and stores to complete. */
+  kOttfPerfCounterLsuWait,
+  /** Cycles stalled waiting for instruction fetch, e.g. after a jump. */
+  kOttfPerfCounterFetchWait,
+  kOttfPerfCounterLoads,
+  kOttfPerfCounterStores,
+  /**
+   * Taken branches. Ibex does not predict branches, so each of these costs a
+   * refetch, just like a mispredict would.
+   */
+  kOttfPerfCounterBranchesTaken,
+  kOttfPerfCounterJumps,
+  kOttfPerfCounterCount,
+} ottf_perf_counter_t;
+
+enum {
+  /**
+   * The maximum nesting depth of regions.
+   */
+  kOttfPerfMaxDepth = 8,
+};
+
+/**
+ * A named code region.
+ *
+ * The fields are private to the implementation; regions should be initialized
+ * with `OTTF_PERF_REGION()`.
+ */
+typedef struct ottf_perf_region {
+  /**
+   * The name of the region in the report.
+   */
+  const char *label;
+  /**
+   * The number of completed begin/end pairs.
+   */
+  uint32_t runs;
+  /**
+   * The nesting depth at which the region was first entered.
+   */
+  uint32_t depth;
+  /**
+   * Whether the region is in the list of regions to report.
+   */
+  bool registered;
+  /**
+   * The counter values at the last `ottf_perf_begin()`.
+   */
+  uint32_t start[kOttfPerfCounterCount];
+  /**
+   * The accumulated counts over all runs.
+   */
+  uint64_t totals[kOttfPerfCounterCount];
+  /**
+   * The next region in the order of first entry.
+   */
+  struct ottf_perf_region *next;
+} ottf_perf_region_t;
+
+/**
+ * Initializer for an `ottf_perf_region_t` with the given label.
+ *
+ * @param label_ A string literal naming the region.
+ */
+#define OTTF_PERF_REGION(label_) \
+  { .label = label_ }
+
+/**
+ * Enters a region.
+ *
+ * The counters used for profiling are enabled on the first call. It is an
+ * error to enter a region that is already active, or to nest regions more than
+ * `kOttfPerfMaxDepth` deep.
+ *
+ * @param region The region to enter.
+ */
+void ottf_perf_begin(ottf_perf_region_t *region);
+
+/**
+ * Leaves a region and adds the counts since the matching `ottf_perf_begin()`
+ * to its totals.
+ *
+ * It is an error to leave a region other than the most recently entered one.
+ *
+ * @param region The region to leave.
+ */
+void ottf_perf_end(ottf_perf_region_t *region);
+
+/**
+ * Returns the accumulated count of one event for a region.
+ *
+ * This allows tests to check their own expectations against the counts.
+ *
+ * @param region The region to query.
+ * @param counter The event to query.
+ * @return The accumulated count.
+ */
+uint64_t ottf_perf_total(const ottf_perf_region_t *region,
+                         ottf_perf_counter_t counter);
+
+/**
+ * Logs the accumulated counts of every region that has been entered, in the
+ * order they were first entered.
+ *
+ * Each region produces one line of `key=value` pairs, prefixed with `PERF` so
+ * that host tooling can pick them out of the console output. The OTTF calls
+ * this when the test finishes, and it does nothing if no region was entered.
+ */
+void ottf_perf_report(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // OPENTITAN_SW_DEVICE_LIB_TESTING_TEST_FRAMEWORK_OTTF_PERF_H_
@@ -25,13 +25,18 @@ static void test_status_device_write(test_status_t test_status) {
 void test_status_set(test_status_t test_status) {
   switch (test_status) {
     case kTestStatusPassed: {
+      // Harnesses match the final status line as text.
+      base_log_set_mode(kLogModeText);
       LOG_INFO("PASS!");
+      base_log_flush();
       test_status_device_write(test_status);
       abort();
       break;
     }
     case kTestStatusFailed: {
+      base_log_set_mode(kLogModeText);
       LOG_INFO("FAIL!");
+      base_log_flush();
       test_status_device_write(test_status);
       abort();
       break;
@@ -31,6 +31,7 @@ ujson_t ujson_ottf_console(void);
     TRY(ujson_putbuf(uj_ctx_, "RESP_OK:", 8)); \
     TRY(responder_(uj_ctx_, data_));           \
     TRY(ujson_putbuf(uj_ctx_, "\r\n", 2));     \
+    TRY(ujson_flush(uj_ctx_));                 \
     OK_STATUS();                               \
   })
 
@@ -60,6 +61,7 @@ ujson_t ujson_ottf_console(void);
       TRY(ujson_putbuf(uj_ctx_, "RESP_ERR:", 9));   \
       TRY(ujson_serialize_status_t(uj_ctx_, &sts)); \
       TRY(ujson_putbuf(uj_ctx_, "\r\n", 2));        \
+      TRY(ujson_flush(uj_ctx_));                    \
     }                                               \
   } while (0)
 
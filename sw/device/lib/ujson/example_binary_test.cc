@@ -0,0 +1,111 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+#include "sw/device/lib/base/status.h"
+#include "sw/device/lib/ujson/example.h"
+#include "sw/device/lib/ujson/test_helpers.h"
+#include "sw/device/lib/ujson/ujson.h"
+
+// These tests run against the example types built with `UJSON_SERDE_BINARY`.
+namespace {
+using test_helpers::SourceSink;
+
+TEST(DeriveBinary, FooRoundtrip) {
+  foo expected = {-5, 150000, "Kilroy was here"};
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_serialize_foo(&uj, &expected)));
+  std::string bytes(reinterpret_cast<const char *>(&expected.foo),
+                    sizeof(expected.foo));
+  bytes.append(reinterpret_cast<const char *>(&expected.bar),
+               sizeof(expected.bar));
+  bytes.append(expected.message, sizeof(expected.message));
+  EXPECT_EQ(ss.Sink(), bytes);
+
+  foo foo{};
+  ss.Reset(bytes);
+  EXPECT_TRUE(status_ok(ujson_deserialize_foo(&uj, &foo)));
+  EXPECT_EQ(memcmp(&foo, &expected, sizeof(foo)), 0);
+}
+
+TEST(DeriveBinary, StringPadding) {
+  foo expected = {1, 2, "Kilroy"};
+  // Bytes behind the NUL are not sent.
+  memset(&expected.message[7], 'x', sizeof(expected.message) - 7);
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_serialize_foo(&uj, &expected)));
+  std::string message = ss.Sink().substr(sizeof(int32_t) + sizeof(uint32_t));
+  EXPECT_EQ(message, std::string("Kilroy") +
+                         std::string(sizeof(expected.message) - 6, '\0'));
+
+  foo foo{};
+  std::string bytes = ss.Sink();
+  ss.Reset(bytes);
+  EXPECT_TRUE(status_ok(ujson_deserialize_foo(&uj, &foo)));
+  EXPECT_STREQ(foo.message, "Kilroy");
+}
+
+TEST(DeriveBinary, StringUnterminated) {
+  foo expected = {1, 2, ""};
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_serialize_foo(&uj, &expected)));
+
+  // A string that fills its buffer without NUL is rejected.
+  std::string bytes = ss.Sink();
+  bytes.replace(bytes.size() - sizeof(expected.message),
+                sizeof(expected.message), sizeof(expected.message), 'x');
+  foo foo{};
+  ss.Reset(bytes);
+  EXPECT_EQ(status_err(ujson_deserialize_foo(&uj, &foo)), kInvalidArgument);
+}
+
+TEST(DeriveBinary, MatrixRoundtrip) {
+  matrix expected = {{
+      {1, 2, 3, 4, 5},
+      {6, 7, 8, 9, 10},
+      {11, 12, 13, 14, 15},
+  }};
+  SourceSink ss;
+  char in[16];
+  char out[64];
+  ujson_t uj = ss.UJsonBuffered(in, sizeof(in), out, sizeof(out));
+  EXPECT_TRUE(status_ok(ujson_serialize_matrix(&uj, &expected)));
+  EXPECT_TRUE(status_ok(ujson_flush(&uj)));
+  EXPECT_EQ(ss.Sink().size(), sizeof(expected));
+
+  matrix m{};
+  std::string bytes = ss.Sink();
+  ss.Reset(bytes);
+  EXPECT_TRUE(status_ok(ujson_deserialize_matrix(&uj, &m)));
+  EXPECT_EQ(memcmp(&m, &expected, sizeof(m)), 0);
+}
+
+TEST(DeriveBinary, DirectionRoundtrip) {
+  direction expected = kDirectionWest;
+  SourceSink ss;
+  ujson_t uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_serialize_direction(&uj, &expected)));
+  EXPECT_EQ(ss.Sink().size(), sizeof(direction));
+
+  direction d = kDirectionNorth;
+  std::string bytes = ss.Sink();
+  ss.Reset(bytes);
+  EXPECT_TRUE(status_ok(ujson_deserialize_direction(&uj, &d)));
+  EXPECT_EQ(d, kDirectionWest);
+}
+
+TEST(DeriveBinary, ShortInput) {
+  foo foo{};
+  SourceSink ss("\x01\x02\x03");
+  ujson_t uj = ss.UJson();
+  EXPECT_EQ(status_err(ujson_deserialize_foo(&uj, &foo)), kResourceExhausted);
+}
+
+}  // namespace
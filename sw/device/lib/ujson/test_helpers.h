@@ -5,6 +5,7 @@
 #ifndef OPENTITAN_SW_DEVICE_LIB_UJSON_TEST_HELPERS_H_
 #define OPENTITAN_SW_DEVICE_LIB_UJSON_TEST_HELPERS_H_
 
+#include <algorithm>
 #include <string>
 
 #include "sw/device/lib/base/status.h"
@@ -18,13 +19,25 @@ class SourceSink {
 
   const std::string &Sink() { return sink_; }
 
+  size_t PutBufCalls() { return putbuf_calls_; }
+  size_t GetBufCalls() { return getbuf_calls_; }
+
   ujson_t UJson() {
     return ujson_init((void *)this, &SourceSink::getc, &SourceSink::putbuf);
   }
 
+  ujson_t UJsonBuffered(char *in_buf, size_t in_size, char *out_buf,
+                        size_t out_size) {
+    return ujson_init_buffered((void *)this, &SourceSink::getbuf,
+                               &SourceSink::putbuf, in_buf, in_size, out_buf,
+                               out_size);
+  }
+
   void Reset() {
     pos_ = 0;
     sink_.clear();
+    putbuf_calls_ = 0;
+    getbuf_calls_ = 0;
   }
 
   void Reset(const std::string &source) {
@@ -40,7 +53,19 @@ class SourceSink {
     }
   }
 
+  status_t GetBuf(char *buf, size_t len) {
+    ++getbuf_calls_;
+    if (pos_ == source_.size()) {
+      return RESOURCE_EXHAUSTED();
+    }
+    len = std::min(len, source_.size() - pos_);
+    source_.copy(buf, len, pos_);
+    pos_ += len;
+    return OK_STATUS(static_cast<int32_t>(len));
+  }
+
   status_t PutBuf(const char *buf, size_t len) {
+    ++putbuf_calls_;
     sink_.append(buf, len);
     return OK_STATUS();
   }
@@ -50,11 +75,17 @@ class SourceSink {
     return static_cast<SourceSink *>(self)->GetChar();
   }
 
+  static status_t getbuf(void *self, char *buf, size_t len) {
+    return static_cast<SourceSink *>(self)->GetBuf(buf, len);
+  }
+
   static status_t putbuf(void *self, const char *buf, size_t len) {
     return static_cast<SourceSink *>(self)->PutBuf(buf, len);
   }
 
   size_t pos_ = 0;
+  size_t putbuf_calls_ = 0;
+  size_t getbuf_calls_ = 0;
   std::string source_;
   std::string sink_;
 };
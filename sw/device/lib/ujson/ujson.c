@@ -21,8 +21,62 @@ ujson_t ujson_init(void *context, status_t (*getc)(void *),
   return u;
 }
 
+ujson_t ujson_init_buffered(void *context,
+                            status_t (*getbuf)(void *, char *, size_t),
+                            status_t (*putbuf)(void *, const char *, size_t),
+                            char *in_buf, size_t in_size, char *out_buf,
+                            size_t out_size) {
+  ujson_t u = UJSON_INIT(context, NULL, putbuf);
+  u.getbuf = getbuf;
+  u.in_buf = in_buf;
+  u.in_size = in_size;
+  u.out_buf = out_buf;
+  u.out_size = out_size;
+  return u;
+}
+
+status_t ujson_flush(ujson_t *uj) {
+  size_t len = uj->out_len;
+  if (len > 0) {
+    uj->out_len = 0;
+    TRY(uj->putbuf(uj->io_context, uj->out_buf, len));
+  }
+  return OK_STATUS();
+}
+
 status_t ujson_putbuf(ujson_t *uj, const char *buf, size_t len) {
-  return uj->putbuf(uj->io_context, buf, len);
+  if (uj->out_buf == NULL) {
+    return uj->putbuf(uj->io_context, buf, len);
+  }
+  while (len > 0) {
+    size_t space = uj->out_size - uj->out_len;
+    if (space == 0) {
+      TRY(ujson_flush(uj));
+      space = uj->out_size;
+    }
+    if (uj->out_len == 0 && len >= space) {
+      // Nothing to gain from copying a buffer that fills the output buffer.
+      return uj->putbuf(uj->io_context, buf, len);
+    }
+    size_t n = len < space ? len : space;
+    memcpy(&uj->out_buf[uj->out_len], buf, n);
+    uj->out_len += n;
+    buf += n;
+    len -= n;
+  }
+  return OK_STATUS();
+}
+
+// Refills the parse window, returning the number of bytes available.
+static status_t fill_window(ujson_t *uj) {
+  if (uj->in_pos == uj->in_len) {
+    uj->in_pos = 0;
+    uj->in_len = TRY(uj->getbuf(uj->io_context, uj->in_buf, uj->in_size));
+    if (uj->in_len == 0) {
+      return RESOURCE_EXHAUSTED();
+    }
+  }
+  return OK_STATUS((int32_t)(uj->in_len - uj->in_pos));
 }
 
 status_t ujson_getc(ujson_t *uj) {
@@ -30,11 +84,36 @@ status_t ujson_getc(ujson_t *uj) {
   if (buffer >= 0) {
     uj->buffer = -1;
     return OK_STATUS(buffer);
+  } else if (uj->in_buf != NULL) {
+    TRY(fill_window(uj));
+    return OK_STATUS((uint8_t)uj->in_buf[uj->in_pos++]);
   } else {
     return uj->getc(uj->io_context);
   }
 }
 
+status_t ujson_getbuf(ujson_t *uj, char *buf, size_t len) {
+  if (len > 0 && uj->buffer >= 0) {
+    *buf++ = (char)uj->buffer;
+    uj->buffer = -1;
+    --len;
+  }
+  while (len > 0) {
+    if (uj->in_buf == NULL) {
+      *buf++ = (char)TRY(uj->getc(uj->io_context));
+      --len;
+      continue;
+    }
+    size_t avail = (size_t)TRY(fill_window(uj));
+    size_t n = len < avail ? len : avail;
+    memcpy(buf, &uj->in_buf[uj->in_pos], n);
+    uj->in_pos += n;
+    buf += n;
+    len -= n;
+  }
+  return OK_STATUS();
+}
+
 status_t ujson_ungetc(ujson_t *uj, char ch) {
   if (uj->buffer >= 0) {
     return FAILED_PRECONDITION();
@@ -227,9 +306,15 @@ static const char hex[] = "0123456789abcdef";
 
 status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
   uint8_t ch;
+  // Characters that need no escaping are written in runs.
+  const char *run = buf;
   TRY(ujson_putbuf(uj, "\"", 1));
   while ((ch = (uint8_t)*buf) != '\0') {
     if (ch < 0x20 || ch == '"' || ch == '\\' || ch >= 0x7f) {
+      if (buf != run) {
+        TRY(ujson_putbuf(uj, run, (size_t)(buf - run)));
+      }
+      run = buf + 1;
       switch (ch) {
         case '"':
           TRY(ujson_putbuf(uj, "\\\"", 2));
@@ -257,11 +342,12 @@ status_t ujson_serialize_string(ujson_t *uj, const char *buf) {
           TRY(ujson_putbuf(uj, esc, sizeof(esc)));
         }
       }
-    } else {
-      TRY(ujson_putbuf(uj, buf, 1));
     }
     ++buf;
   }
+  if (buf != run) {
+    TRY(ujson_putbuf(uj, run, (size_t)(buf - run)));
+  }
   TRY(ujson_putbuf(uj, "\"", 1));
   return OK_STATUS();
 }
@@ -384,10 +470,16 @@ status_t ujson_deserialize_status_t(ujson_t *uj, status_t *value) {
   return OK_STATUS();
 }
 
+// Adapts `ujson_putbuf()` to a `buffer_sink_t` so that formatted output goes
+// through the output buffer of buffered contexts.
+static size_t ujson_sink(void *data, const char *buf, size_t len) {
+  return status_ok(ujson_putbuf((ujson_t *)data, buf, len)) ? len : 0;
+}
+
 status_t ujson_serialize_status_t(ujson_t *uj, const status_t *value) {
   buffer_sink_t out = {
-      .data = uj->io_context,
-      .sink = (size_t(*)(void *, const char *, size_t))uj->putbuf,
+      .data = uj,
+      .sink = ujson_sink,
   };
   base_fprintf(out, "%!r", *value);
   return OK_STATUS();
@@ -23,6 +23,21 @@ typedef struct ujson {
   status_t (*getc)(void *);
   /** An internal single character buffer for ungetting a character. */
   int16_t buffer;
+  /**
+   * An optional pointer to an IO function for reading up to `len` bytes from
+   * the input.  It must read at least one byte and return the number of bytes
+   * read.
+   */
+  status_t (*getbuf)(void *, char *, size_t);
+  /** Optional scratch buffer collecting the output between flushes. */
+  char *out_buf;
+  size_t out_size;
+  size_t out_len;
+  /** Optional parse window holding bytes read ahead from the input. */
+  char *in_buf;
+  size_t in_size;
+  size_t in_pos;
+  size_t in_len;
 } ujson_t;
 
 // clang-format off
@@ -46,6 +61,30 @@ typedef struct ujson {
 ujson_t ujson_init(void *context, status_t (*getc)(void *),
                    status_t (*putbuf)(void *, const char *, size_t));
 
+/**
+ * Initializes and returns a buffered ujson context.
+ *
+ * Output is collected in `out_buf` and only written with `putbuf` once the
+ * buffer is full or `ujson_flush()` is called, so that a whole record is
+ * written at once if it fits.  Input is read with `getbuf` into `in_buf` as
+ * far as it is available and parsed from there.  Bytes read ahead remain in
+ * the context and are parsed by the next deserialization from it.
+ *
+ * @param context An IO context for the `getbuf` and `putbuf` functions.
+ * @param getbuf A function to read a buffer from the input.
+ * @param putbuf A function to write a buffer to the output.
+ * @param in_buf Storage for the parse window.
+ * @param in_size The size of `in_buf`.
+ * @param out_buf Storage for the output buffer.
+ * @param out_size The size of `out_buf`.
+ * @return An initialized ujson_t context.
+ */
+ujson_t ujson_init_buffered(void *context,
+                            status_t (*getbuf)(void *, char *, size_t),
+                            status_t (*putbuf)(void *, const char *, size_t),
+                            char *in_buf, size_t in_size, char *out_buf,
+                            size_t out_size);
+
 /**
  * Gets a single character from the input.
  *
@@ -63,6 +102,16 @@ status_t ujson_getc(ujson_t *uj);
  */
 status_t ujson_ungetc(ujson_t *uj, char ch);
 
+/**
+ * Gets exactly `len` bytes from the input.
+ *
+ * @param uj A ujson IO context.
+ * @param buf A buffer to write the bytes into.
+ * @param len The number of bytes to read.
+ * @return OK or an error.
+ */
+status_t ujson_getbuf(ujson_t *uj, char *buf, size_t len);
+
 /**
  * Writes a buffer to the output.
  *
@@ -73,6 +122,16 @@ status_t ujson_ungetc(ujson_t *uj, char ch);
  */
 status_t ujson_putbuf(ujson_t *uj, const char *buf, size_t len);
 
+/**
+ * Writes the buffered output of a buffered ujson context.
+ *
+ * Does nothing for an unbuffered context.
+ *
+ * @param uj A ujson IO context.
+ * @return OK or an error.
+ */
+status_t ujson_flush(ujson_t *uj);
+
 /**
  * Compares two strings for equality.
  *
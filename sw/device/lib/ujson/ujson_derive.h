@@ -91,9 +91,14 @@
     } \
     TRY(ujson_putbuf(uj, "]", 1));
 
+// Field and enum names are identifiers and never need escaping, so they are
+// written with their quotes in a single `ujson_putbuf()`.
+#define ujson_ser_name(name_, suffix_) \
+    TRY(ujson_putbuf(uj, "\"" #name_ "\"" suffix_, \
+                     sizeof("\"" #name_ "\"" suffix_) - 1))
+
 #define ujson_ser_field(name_, type_, ...) { \
-        TRY(ujson_serialize_string(uj, #name_)); \
-        TRY(ujson_putbuf(uj, ":", 1)); \
+        ujson_ser_name(name_, ":"); \
         OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
         ( /*then*/ \
             TRY(ujson_serialize_##type_(uj, &self->name_)); \
@@ -106,8 +111,7 @@
     }
 
 #define ujson_ser_string(name_, size_, ...) { \
-        TRY(ujson_serialize_string(uj, #name_)); \
-        TRY(ujson_putbuf(uj, ":", 1)); \
+        ujson_ser_name(name_, ":"); \
         OT_IIF(OT_NOT(OT_VA_ARGS_COUNT(dummy, ##__VA_ARGS__))) \
         ( /*then*/ \
             TRY(ujson_serialize_string(uj, self->name_)); \
@@ -131,7 +135,7 @@
 
 #define ujson_ser_enum(formal_name_, name_, ...) \
     case k ##formal_name_ ## name_: \
-        TRY(ujson_serialize_string(uj, #name_)); break;
+        ujson_ser_name(name_, ""); break;
 
 #define UJSON_IMPL_SERIALIZE_ENUM(formal_name_, name_, decl_, ...) \
     status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) { \
@@ -252,14 +256,115 @@
     } \
     extern const int __never_referenced___here_to_eat_a_semicolon[]
 
+//////////////////////////////////////////////////////////////////////
+// Binary Serialize/Deserialize Implementation
+//////////////////////////////////////////////////////////////////////
+// The binary encoding is the in-memory representation of each field, in
+// declaration order and without the padding between fields.  Arrays and
+// nested structs are written whole, so both ends must share the device's data
+// layout.
+#define ujson_ser_binary(name_, ...) \
+    TRY(ujson_putbuf(uj, (const char*)&self->name_, sizeof(self->name_)));
+
+#define ujson_de_binary(name_, ...) \
+    TRY(ujson_getbuf(uj, (char*)&self->name_, sizeof(self->name_)));
+
+// Strings are written up to their NUL and padded with zeros, so that stale
+// bytes behind the NUL never leave the device.  A received string is
+// rejected unless its last byte is NUL.
+#define ujson_ser_binary_string(name_, size_, ...) { \
+        static const char zeros[size_]; \
+        const char *p = (const char*)self->name_; \
+        for (size_t n = 0; n < sizeof(self->name_); n += size_, p += size_) { \
+            size_t len = 0; \
+            while (len < size_ && p[len] != '\0') ++len; \
+            TRY(ujson_putbuf(uj, p, len)); \
+            TRY(ujson_putbuf(uj, zeros, size_ - len)); \
+        } \
+    }
+
+#define ujson_de_binary_string(name_, size_, ...) { \
+        TRY(ujson_getbuf(uj, (char*)self->name_, sizeof(self->name_))); \
+        const char *p = (const char*)self->name_; \
+        for (size_t n = 0; n < sizeof(self->name_); n += size_, p += size_) { \
+            if (p[size_ - 1] != '\0') return INVALID_ARGUMENT(); \
+        } \
+    }
+
+#define UJSON_IMPL_SERIALIZE_STRUCT_BINARY(name_, decl_) \
+    status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) { \
+        decl_(ujson_ser_binary, ujson_ser_binary_string) \
+        return OK_STATUS(); \
+    } \
+    extern const int __never_referenced___here_to_eat_a_semicolon[]
+
+#define UJSON_IMPL_SERIALIZE_ENUM_BINARY(formal_name_, name_, decl_, ...) \
+    status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) { \
+        TRY(ujson_putbuf(uj, (const char*)self, sizeof(*self))); \
+        return OK_STATUS(); \
+    } \
+    extern const int __never_referenced___here_to_eat_a_semicolon[]
+
+#define UJSON_IMPL_DESERIALIZE_STRUCT_BINARY(name_, decl_) \
+    status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) { \
+        decl_(ujson_de_binary, ujson_de_binary_string) \
+        return OK_STATUS(); \
+    } \
+    extern const int __never_referenced___here_to_eat_a_semicolon[]
+
+#define UJSON_IMPL_DESERIALIZE_ENUM_BINARY(formal_name_, name_, decl_, ...) \
+    status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) { \
+        TRY(ujson_getbuf(uj, (char*)self, sizeof(*self))); \
+        return OK_STATUS(); \
+    } \
+    extern const int __never_referenced___here_to_eat_a_semicolon[]
+
 #ifndef UJSON_SERDE_IMPL
 #define UJSON_SERDE_IMPL 0
 #endif
 
+// Define `UJSON_SERDE_BINARY` to 1 for the whole build to replace the JSON
+// encoding of the derived serializers with the compact binary encoding.
+#ifndef UJSON_SERDE_BINARY
+#define UJSON_SERDE_BINARY 0
+#endif
+
+#define UJSON_IMPL_SERIALIZE_STRUCT_SEL(name_, decl_) \
+    OT_IIF(UJSON_SERDE_BINARY) \
+    ( /*then*/ \
+        UJSON_IMPL_SERIALIZE_STRUCT_BINARY(name_, decl_) \
+    , /*else*/ \
+        UJSON_IMPL_SERIALIZE_STRUCT(name_, decl_) \
+    ) /*endif*/
+
+#define UJSON_IMPL_SERIALIZE_ENUM_SEL(formal_name_, name_, decl_, ...) \
+    OT_IIF(UJSON_SERDE_BINARY) \
+    ( /*then*/ \
+        UJSON_IMPL_SERIALIZE_ENUM_BINARY(formal_name_, name_, decl_, ##__VA_ARGS__) \
+    , /*else*/ \
+        UJSON_IMPL_SERIALIZE_ENUM(formal_name_, name_, decl_, ##__VA_ARGS__) \
+    ) /*endif*/
+
+#define UJSON_IMPL_DESERIALIZE_STRUCT_SEL(name_, decl_) \
+    OT_IIF(UJSON_SERDE_BINARY) \
+    ( /*then*/ \
+        UJSON_IMPL_DESERIALIZE_STRUCT_BINARY(name_, decl_) \
+    , /*else*/ \
+        UJSON_IMPL_DESERIALIZE_STRUCT(name_, decl_) \
+    ) /*endif*/
+
+#define UJSON_IMPL_DESERIALIZE_ENUM_SEL(formal_name_, name_, decl_, ...) \
+    OT_IIF(UJSON_SERDE_BINARY) \
+    ( /*then*/ \
+        UJSON_IMPL_DESERIALIZE_ENUM_BINARY(formal_name_, name_, decl_, ##__VA_ARGS__) \
+    , /*else*/ \
+        UJSON_IMPL_DESERIALIZE_ENUM(formal_name_, name_, decl_, ##__VA_ARGS__) \
+    ) /*endif*/
+
 #define UJSON_SERIALIZE_STRUCT(name_, decl_) \
     OT_IIF(UJSON_SERDE_IMPL) \
     ( /*then*/ \
-        UJSON_IMPL_SERIALIZE_STRUCT(name_, decl_) \
+        UJSON_IMPL_SERIALIZE_STRUCT_SEL(name_, decl_) \
     , /*else*/ \
         status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) \
     ) /*endif*/
@@ -267,7 +372,7 @@
 #define UJSON_SERIALIZE_ENUM(formal_name_, name_, decl_, ...) \
     OT_IIF(UJSON_SERDE_IMPL) \
     ( /*then*/ \
-        UJSON_IMPL_SERIALIZE_ENUM(formal_name_, name_, decl_, ##__VA_ARGS__) \
+        UJSON_IMPL_SERIALIZE_ENUM_SEL(formal_name_, name_, decl_, ##__VA_ARGS__) \
     , /*else*/ \
         status_t ujson_serialize_##name_(ujson_t *uj, const name_ *self) \
     ) /*endif*/
@@ -275,7 +380,7 @@
 #define UJSON_DESERIALIZE_STRUCT(name_, decl_) \
     OT_IIF(UJSON_SERDE_IMPL) \
     ( /*then*/ \
-        UJSON_IMPL_DESERIALIZE_STRUCT(name_, decl_) \
+        UJSON_IMPL_DESERIALIZE_STRUCT_SEL(name_, decl_) \
     , /*else*/ \
         status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) \
     ) /*endif*/
@@ -283,7 +388,7 @@
 #define UJSON_DESERIALIZE_ENUM(formal_name_, name_, decl_, ...) \
     OT_IIF(UJSON_SERDE_IMPL) \
     ( /*then*/ \
-        UJSON_IMPL_DESERIALIZE_ENUM(formal_name_, name_, decl_, ##__VA_ARGS__) \
+        UJSON_IMPL_DESERIALIZE_ENUM_SEL(formal_name_, name_, decl_, ##__VA_ARGS__) \
     , /*else*/ \
         status_t ujson_deserialize_##name_(ujson_t *uj, name_ *self) \
     ) /*endif*/
@@ -248,4 +248,62 @@ TEST(UJson, DeerializeStatus) {
   EXPECT_EQ(arg, 77);
 }
 
+TEST(UJson, BufferedPutBuf) {
+  SourceSink ss;
+  char out[16];
+  ujson_t uj = ss.UJsonBuffered(nullptr, 0, out, sizeof(out));
+  uint32_t val = 1234;
+
+  EXPECT_TRUE(status_ok(ujson_serialize_string(&uj, "abc")));
+  EXPECT_TRUE(status_ok(ujson_serialize_uint32_t(&uj, &val)));
+  EXPECT_EQ(ss.PutBufCalls(), 0);
+  EXPECT_TRUE(status_ok(ujson_flush(&uj)));
+  EXPECT_EQ(ss.PutBufCalls(), 1);
+  EXPECT_EQ(ss.Sink(), R"json("abc"1234)json");
+
+  // Output that does not fit is written in multiple chunks.
+  ss.Reset();
+  EXPECT_TRUE(status_ok(ujson_serialize_string(&uj, "0123456789abcdefXYZ")));
+  EXPECT_TRUE(status_ok(ujson_flush(&uj)));
+  EXPECT_EQ(ss.PutBufCalls(), 2);
+  EXPECT_EQ(ss.Sink(), R"json("0123456789abcdefXYZ")json");
+}
+
+TEST(UJson, BufferedGetC) {
+  SourceSink ss(R"json( "Hello" 1234 true)json");
+  char in[8];
+  ujson_t uj = ss.UJsonBuffered(in, sizeof(in), nullptr, 0);
+  char buf[16];
+  uint32_t val;
+  bool b;
+
+  EXPECT_EQ(ujson_parse_qs(&uj, buf, sizeof(buf)).value, 5);
+  EXPECT_EQ(std::string(buf), "Hello");
+  EXPECT_TRUE(status_ok(ujson_deserialize_uint32_t(&uj, &val)));
+  EXPECT_EQ(val, 1234);
+  EXPECT_TRUE(status_ok(ujson_deserialize_bool(&uj, &b)));
+  EXPECT_TRUE(b);
+  EXPECT_EQ(ss.GetBufCalls(), 3);
+  EXPECT_EQ(status_err(ujson_getc(&uj)), kResourceExhausted);
+}
+
+TEST(UJson, GetBuf) {
+  SourceSink ss("abcdefghij");
+  char in[4];
+  ujson_t uj = ss.UJsonBuffered(in, sizeof(in), nullptr, 0);
+  char buf[8] = {0};
+
+  EXPECT_EQ(ujson_getc(&uj).value, 'a');
+  EXPECT_TRUE(status_ok(ujson_ungetc(&uj, 'a')));
+  EXPECT_TRUE(status_ok(ujson_getbuf(&uj, buf, 7)));
+  EXPECT_EQ(std::string(buf), "abcdefg");
+  EXPECT_EQ(status_err(ujson_getbuf(&uj, buf, 4)), kResourceExhausted);
+
+  // Unbuffered contexts read byte by byte.
+  ss.Reset();
+  uj = ss.UJson();
+  EXPECT_TRUE(status_ok(ujson_getbuf(&uj, buf, 3)));
+  EXPECT_EQ(std::string(buf, 3), "abc");
+}
+
 }  // namespace
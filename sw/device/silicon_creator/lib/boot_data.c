@@ -94,8 +94,8 @@ static hardened_bool_t boot_data_is_empty(const void *boot_data) {
 }
 
 /**
- * Returns the `identifier` of the boot data entry at the given page and
- * index after masking it with the words of its `is_valid` field.
+ * Returns the `identifier` of a boot data entry after masking it with the
+ * words of its `is_valid` field.
  *
  * This function can be used to quickly determine if an entry can be empty or
  * valid. Due to the values chosen for valid and invalid entries,
@@ -103,32 +103,16 @@ static hardened_bool_t boot_data_is_empty(const void *boot_data) {
  * empty, `kBootDataIdentifier` for entries that are not invalidated, and `0`
  * for invalidated entries.
  *
- * @param page A boot data page.
- * @param index Index of the entry to read in the given page.
- * @param[out] masked_identifier Identifier masked with the words of `is_valid`.
- * @return The result of the operation.
+ * @param boot_data A boot data entry.
+ * @return Identifier masked with the words of `is_valid`.
  */
-static rom_error_t boot_data_sniff(flash_ctrl_info_page_t page, size_t index,
-                                   uint32_t *masked_identifier) {
+static uint32_t boot_data_masked_identifier(const boot_data_t *boot_data) {
   static_assert(kBootDataValidEntry == UINT64_MAX,
                 "is_valid must be UINT64_MAX for valid entries.");
   static_assert(kBootDataInvalidEntry == 0,
                 "is_valid must be 0 for invalid entries.");
-
-  enum {
-    kIsValidOffset = offsetof(boot_data_t, is_valid),
-    kIdentifierOffset = offsetof(boot_data_t, identifier),
-  };
-  static_assert(
-      kIdentifierOffset - kIsValidOffset == sizeof((boot_data_t){0}.is_valid),
-      "is_valid and identifier must be consecutive.");
-
-  *masked_identifier = 0;
-  uint32_t buf[3];
-  const uint32_t offset = index * sizeof(boot_data_t) + kIsValidOffset;
-  HARDENED_RETURN_IF_ERROR(flash_ctrl_info_read(page, offset, 3, buf));
-  *masked_identifier = buf[0] & buf[1] & buf[2];
-  return kErrorOk;
+  return (uint32_t)boot_data->is_valid &
+         (uint32_t)(boot_data->is_valid >> 32) & boot_data->identifier;
 }
 
 /**
@@ -145,6 +129,24 @@ static rom_error_t boot_data_entry_read(flash_ctrl_info_page_t page,
   return flash_ctrl_info_read(page, offset, kBootDataNumWords, boot_data);
 }
 
+/**
+ * Reads consecutive boot data entries at the given page and index in a single
+ * flash transaction.
+ *
+ * @param page A boot data page.
+ * @param index Index of the first entry to read in the given page.
+ * @param count Number of entries to read.
+ * @param[out] boot_data A buffer that will hold `count` entries.
+ * @return The result of the operation.
+ */
+static rom_error_t boot_data_entries_read(flash_ctrl_info_page_t page,
+                                          size_t index, size_t count,
+                                          boot_data_t *boot_data) {
+  const uint32_t offset = index * sizeof(boot_data_t);
+  return flash_ctrl_info_read(page, offset, count * kBootDataNumWords,
+                              boot_data);
+}
+
 /**
  * Populates the boot data entry at the given page and index.
  *
@@ -300,15 +302,39 @@ typedef struct active_page_info {
   size_t last_valid_index;
 } active_page_info_t;
 
+enum {
+  /**
+   * Maximum number of iterations of the binary search for the first empty
+   * entry, i.e. `ceil(log2(kBootDataEntriesPerPage + 1))`.
+   */
+  kBootDataSearchMaxIterations = 6,
+  /**
+   * Number of entries read in a single transaction after the binary search:
+   * the first empty entry and the two entries before it. The last valid
+   * entry is one of the latter unless more than one write in a row was
+   * interrupted.
+   */
+  kBootDataWindowEntries = 3,
+};
+static_assert(kBootDataEntriesPerPage < (1 << kBootDataSearchMaxIterations),
+              "kBootDataSearchMaxIterations is too small.");
+static_assert(kBootDataEntriesPerPage >= kBootDataWindowEntries,
+              "kBootDataWindowEntries is too large.");
+
 /**
  * Updates the given active page info struct and last valid boot data entry
  * using the given page.
  *
- * This function performs a forward search to find the first empty boot data
- * entry followed by a backward search to find the last valid boot data entry.
- * If the page has an entry that is newer than the one passed in, this function
- * updates `page_info` and `boot_data`. Reads must be enabled for the given page
- * before this function is called, see `boot_data_page_info_get()`.
+ * Since entries are written in order and an entry is never erased without
+ * erasing the whole page, all entries before the first empty entry are
+ * non-empty and all entries after it are empty. This function performs a
+ * binary search to find the first empty boot data entry, reads it together
+ * with the entries before it in a single transaction to check the result of
+ * the search, and then performs a backward search to find the last valid boot
+ * data entry, which stops at the first invalidated entry. If the page has an
+ * entry that is newer than the one passed in, this function updates
+ * `page_info` and `boot_data`. Reads must be enabled for the given page before
+ * this function is called, see `boot_data_page_info_get()`.
  *
  * @param page A boot data page.
  * @param[in,out] page_info Active page info struct. Updated if the given page
@@ -320,56 +346,102 @@ typedef struct active_page_info {
 static rom_error_t boot_data_page_info_update_impl(
     flash_ctrl_info_page_t page, active_page_info_t *page_info,
     boot_data_t *boot_data) {
-  uint32_t sniff_results[kBootDataEntriesPerPage];
-
   boot_data_t buf;
 
-  // Perform a forward search to find the first empty entry.
-  hardened_bool_t has_empty_entry = kHardenedBoolFalse;
-  size_t i = 0;
-  for (; launder32(i) < kBootDataEntriesPerPage; ++i) {
-    // Read and cache the identifier to quickly determine if an entry can be
-    // empty or valid.
-    HARDENED_RETURN_IF_ERROR(boot_data_sniff(page, i, &sniff_results[i]));
+  // Perform a binary search to find the first empty entry. Entries before
+  // `lo` are non-empty, entries at and after `hi` are empty.
+  size_t lo = 0;
+  size_t hi = kBootDataEntriesPerPage;
+  size_t iter = 0;
+  for (; launder32(lo) < hi && launder32(iter) < kBootDataSearchMaxIterations;
+       ++iter) {
+    size_t mid = lo + (hi - lo) / 2;
+    HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, mid, &buf));
     // Check all words of this entry only if it can be empty.
-    if (sniff_results[i] == kFlashCtrlErasedWord) {
-      HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
-      has_empty_entry = boot_data_is_empty(&buf);
-      if (launder32(has_empty_entry) == kHardenedBoolTrue) {
-        HARDENED_CHECK_EQ(has_empty_entry, kHardenedBoolTrue);
-        break;
-      }
-      HARDENED_CHECK_EQ(has_empty_entry, kHardenedBoolFalse);
+    if (boot_data_masked_identifier(&buf) == kFlashCtrlErasedWord &&
+        launder32(boot_data_is_empty(&buf)) == kHardenedBoolTrue) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
     }
   }
-  // At the end of this loop, `i` is the index of the first empty entry if any
-  // and `kBootDataEntriesPerPage` otherwise.
-  HARDENED_CHECK_LE(i, kBootDataEntriesPerPage);
-  size_t first_empty_index = i;
+  HARDENED_CHECK_EQ(lo, hi);
+  HARDENED_CHECK_LE(iter, kBootDataSearchMaxIterations);
+  // `lo` is the index of the first empty entry if any and
+  // `kBootDataEntriesPerPage` otherwise.
+  HARDENED_CHECK_LE(lo, kBootDataEntriesPerPage);
+  size_t first_empty_index = lo;
+
+  // Read the first empty entry, if any, and the entries before it in a single
+  // transaction.
+  boot_data_t window[kBootDataWindowEntries];
+  size_t window_end = first_empty_index < kBootDataEntriesPerPage
+                          ? first_empty_index + 1
+                          : kBootDataEntriesPerPage;
+  size_t window_start = window_end >= kBootDataWindowEntries
+                            ? window_end - kBootDataWindowEntries
+                            : 0;
+  HARDENED_RETURN_IF_ERROR(boot_data_entries_read(
+      page, window_start, window_end - window_start, window));
+
+  // Check the result of the search: the entry at `first_empty_index` must be
+  // empty and the entry before it must not be.
+  hardened_bool_t has_empty_entry = kHardenedBoolFalse;
+  if (launder32(first_empty_index) < kBootDataEntriesPerPage) {
+    HARDENED_CHECK_LT(first_empty_index, kBootDataEntriesPerPage);
+    has_empty_entry =
+        boot_data_is_empty(&window[first_empty_index - window_start]);
+    HARDENED_CHECK_EQ(has_empty_entry, kHardenedBoolTrue);
+  } else {
+    HARDENED_CHECK_EQ(first_empty_index, kBootDataEntriesPerPage);
+  }
+  if (launder32(first_empty_index) > 0) {
+    HARDENED_CHECK_GT(first_empty_index, 0);
+    HARDENED_CHECK_EQ(
+        boot_data_is_empty(&window[first_empty_index - 1 - window_start]),
+        kHardenedBoolFalse);
+  }
 
-  // Perform a backward search to find the last valid entry.
+  // Perform a backward search to find the last valid entry. Entries in the
+  // window are not read again.
   hardened_bool_t has_valid_entry = kHardenedBoolFalse;
-  i = first_empty_index - 1;
+  size_t i = first_empty_index - 1;
   size_t j = 0;
   for (; launder32(i) < first_empty_index && launder32(j) < first_empty_index;
        --i, ++j) {
-    // Check the digest only if this entry can be valid.
-    if (sniff_results[i] == kBootDataIdentifier) {
+    const boot_data_t *entry = &buf;
+    if (i >= window_start) {
+      entry = &window[i - window_start];
+    } else {
       HARDENED_RETURN_IF_ERROR(boot_data_entry_read(page, i, &buf));
-      rom_error_t is_valid = boot_data_check(&buf);
-      if (launder32(is_valid) == kErrorOk) {
-        HARDENED_CHECK_EQ(is_valid, kErrorOk);
+    }
+    // An entry is invalidated only after a newer entry has been written
+    // successfully, either after it or in the other page. Since entries are
+    // written in order, the entries before an invalidated entry cannot be the
+    // newest entry.
+    uint32_t is_valid =
+        (uint32_t)entry->is_valid & (uint32_t)(entry->is_valid >> 32);
+    if (launder32(is_valid) != kFlashCtrlErasedWord) {
+      HARDENED_CHECK_NE(is_valid, kFlashCtrlErasedWord);
+      break;
+    }
+    // Check the digest only if this entry can be valid.
+    if (boot_data_masked_identifier(entry) == kBootDataIdentifier) {
+      rom_error_t check_result = boot_data_check(entry);
+      if (launder32(check_result) == kErrorOk) {
+        HARDENED_CHECK_EQ(check_result, kErrorOk);
         static_assert(kErrorOk == (rom_error_t)kHardenedBoolTrue,
                       "kErrorOk must be equal to kHardenedBoolTrue");
-        has_valid_entry = (hardened_bool_t)is_valid;
+        has_valid_entry = (hardened_bool_t)check_result;
+        buf = *entry;
         break;
       }
-      HARDENED_CHECK_EQ(is_valid, kErrorBootDataInvalid);
+      HARDENED_CHECK_EQ(check_result, kErrorBootDataInvalid);
     }
   }
-  // At the end of this loop, `i` is the index of the last valid entry if any
-  // and `UINT32_MAX`, otherwise. `j` must be less than or equal to
-  // `first_empty_index`.
+  // At the end of this loop, `i` is the index of the last valid entry if
+  // `has_valid_entry` is `kHardenedBoolTrue`. `j` must be less than or equal
+  // to `first_empty_index`.
   HARDENED_CHECK_LE(j, first_empty_index);
 
   if (launder32(has_valid_entry) == kHardenedBoolTrue) {
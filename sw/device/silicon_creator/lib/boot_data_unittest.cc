@@ -0,0 +1,325 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/silicon_creator/lib/boot_data.h"
+
+#include <array>
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_flash_ctrl.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_hmac.h"
+#include "sw/device/silicon_creator/lib/drivers/mock_otp.h"
+#include "sw/device/silicon_creator/lib/error.h"
+#include "sw/device/silicon_creator/testing/rom_test.h"
+
+namespace boot_data_unittest {
+namespace {
+using ::testing::_;
+using ::testing::AnyNumber;
+using ::testing::Invoke;
+using ::testing::Return;
+
+/**
+ * Boot data tests.
+ *
+ * The boot data pages are simulated by `pages_`, which the flash_ctrl mock
+ * reads, programs and erases like real flash: programming can only clear bits.
+ * The HMAC mock computes a simple hash in place of SHA-256, which is enough to
+ * tell intact entries from partially written or invalidated ones.
+ */
+class BootDataTest : public rom_test::Unordered<rom_test::RomTest> {
+ protected:
+  using Page = std::array<boot_data_t, kBootDataEntriesPerPage>;
+
+  void SetUp() override {
+    ErasePages();
+
+    EXPECT_CALL(flash_ctrl_, InfoPermsSet(_, _)).Times(AnyNumber());
+    EXPECT_CALL(flash_ctrl_, InfoRead(_, _, _, _))
+        .Times(AnyNumber())
+        .WillRepeatedly(Invoke(this, &BootDataTest::FlashRead));
+    EXPECT_CALL(flash_ctrl_, InfoWrite(_, _, _, _))
+        .Times(AnyNumber())
+        .WillRepeatedly(Invoke(this, &BootDataTest::FlashWrite));
+    EXPECT_CALL(flash_ctrl_, InfoErase(_, kFlashCtrlEraseTypePage))
+        .Times(AnyNumber())
+        .WillRepeatedly(Invoke(this, &BootDataTest::FlashErase));
+
+    EXPECT_CALL(hmac_, sha256_init()).Times(AnyNumber()).WillRepeatedly([&] {
+      hash_ = 2166136261u;
+    });
+    EXPECT_CALL(hmac_, sha256_update(_, _))
+        .Times(AnyNumber())
+        .WillRepeatedly([&](const void *data, size_t len) {
+          hash_ = Hash(hash_, data, len);
+          return kErrorOk;
+        });
+    EXPECT_CALL(hmac_, sha256_final(_))
+        .Times(AnyNumber())
+        .WillRepeatedly([&](hmac_digest_t *digest) {
+          Finalize(hash_, digest);
+          return kErrorOk;
+        });
+
+    EXPECT_CALL(otp_, read32(_))
+        .Times(AnyNumber())
+        .WillRepeatedly(Return(kHardenedBoolFalse));
+  }
+
+  static uint32_t Hash(uint32_t hash, const void *data, size_t len) {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < len; ++i) {
+      hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+  }
+
+  static void Finalize(uint32_t hash, hmac_digest_t *digest) {
+    for (size_t i = 0; i < kHmacDigestNumWords; ++i) {
+      digest->digest[i] = hash;
+      hash = hash * 16777619u + i;
+    }
+  }
+
+  void ErasePages() {
+    for (auto &page : pages_) {
+      std::memset(page.data(), 0xff, sizeof(Page));
+    }
+  }
+
+  Page &PageOf(flash_ctrl_info_page_t page) {
+    return page == kFlashCtrlInfoPageBootData0 ? pages_[0] : pages_[1];
+  }
+
+  rom_error_t FlashRead(flash_ctrl_info_page_t page, uint32_t offset,
+                        uint32_t word_count, void *data) {
+    EXPECT_LE(offset + word_count * sizeof(uint32_t), sizeof(Page));
+    std::memcpy(data, reinterpret_cast<char *>(PageOf(page).data()) + offset,
+                word_count * sizeof(uint32_t));
+    return kErrorOk;
+  }
+
+  rom_error_t FlashWrite(flash_ctrl_info_page_t page, uint32_t offset,
+                         uint32_t word_count, const void *data) {
+    EXPECT_LE(offset + word_count * sizeof(uint32_t), sizeof(Page));
+    uint8_t *dest = reinterpret_cast<uint8_t *>(PageOf(page).data()) + offset;
+    const uint8_t *src = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < word_count * sizeof(uint32_t); ++i) {
+      dest[i] &= src[i];
+    }
+    return kErrorOk;
+  }
+
+  rom_error_t FlashErase(flash_ctrl_info_page_t page,
+                         flash_ctrl_erase_type_t erase_type) {
+    std::memset(PageOf(page).data(), 0xff, sizeof(Page));
+    return kErrorOk;
+  }
+
+  /**
+   * Returns a valid entry with the given counter.
+   */
+  static boot_data_t Entry(uint32_t counter) {
+    boot_data_t entry{};
+    std::memset(&entry.padding, 0xff, sizeof(entry.padding));
+    entry.is_valid = kBootDataValidEntry;
+    entry.identifier = kBootDataIdentifier;
+    entry.counter = counter;
+    entry.min_security_version_rom_ext = counter * 2;
+    entry.min_security_version_bl0 = counter * 3;
+    uint32_t hash = Hash(2166136261u, &entry.is_valid,
+                         sizeof(entry) - sizeof(entry.digest));
+    Finalize(hash, &entry.digest);
+    return entry;
+  }
+
+  /**
+   * Fills entries `[0, count)` of a page with consecutive counters starting
+   * at `first_counter`, invalidating all but the last one, like a sequence of
+   * successful `boot_data_write()` calls would.
+   */
+  void FillPage(size_t page, size_t count, uint32_t first_counter) {
+    for (size_t i = 0; i < count; ++i) {
+      pages_[page][i] = Entry(first_counter + i);
+      if (i + 1 < count) {
+        pages_[page][i].is_valid = kBootDataInvalidEntry;
+      }
+    }
+  }
+
+  /**
+   * Simulates a write of a new entry at `index` that was interrupted after the
+   * first of its two flash transactions, i.e. only the digest was written.
+   */
+  void InterruptedWrite(size_t page, size_t index, uint32_t counter) {
+    boot_data_t entry = Entry(counter);
+    std::memcpy(&pages_[page][index].digest, &entry.digest,
+                sizeof(entry.digest));
+  }
+
+  rom_test::MockFlashCtrl flash_ctrl_;
+  rom_test::MockHmac hmac_;
+  rom_test::MockOtp otp_;
+  std::array<Page, 2> pages_;
+  uint32_t hash_ = 0;
+};
+
+TEST_F(BootDataTest, ReadEmptyPagesDefault) {
+  boot_data_t boot_data;
+  EXPECT_EQ(boot_data_read(kLcStateDev, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data.counter, kBootDataDefaultCounterVal);
+  EXPECT_EQ(boot_data_check(&boot_data), kErrorOk);
+
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorBootDataNotFound);
+}
+
+TEST_F(BootDataTest, ReadPartiallyWrittenPage) {
+  for (size_t count = 1; count <= kBootDataEntriesPerPage; ++count) {
+    ErasePages();
+    FillPage(0, count, 10);
+
+    boot_data_t boot_data;
+    EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk)
+        << "count = " << count;
+    EXPECT_EQ(boot_data.counter, 10 + count - 1) << "count = " << count;
+    EXPECT_EQ(boot_data_check(&boot_data), kErrorOk);
+  }
+}
+
+TEST_F(BootDataTest, ReadNewestAcrossPages) {
+  // Page 0 is full and its last entry was invalidated after the next entry
+  // was written to page 1.
+  FillPage(0, kBootDataEntriesPerPage, 10);
+  pages_[0].back().is_valid = kBootDataInvalidEntry;
+  FillPage(1, 3, 10 + kBootDataEntriesPerPage);
+
+  boot_data_t boot_data;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data.counter, 10 + kBootDataEntriesPerPage + 2);
+}
+
+TEST_F(BootDataTest, ReadInterruptedInvalidation) {
+  // The new entry was written to page 1, but invalidating the old one in page
+  // 0 was interrupted, so both are valid. The newer one wins.
+  FillPage(0, kBootDataEntriesPerPage, 10);
+  FillPage(1, 1, 10 + kBootDataEntriesPerPage);
+
+  boot_data_t boot_data;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data.counter, 10 + kBootDataEntriesPerPage);
+}
+
+TEST_F(BootDataTest, ReadInterruptedWrites) {
+  // One interrupted write after the last valid entry.
+  FillPage(0, 5, 10);
+  InterruptedWrite(0, 5, 15);
+
+  boot_data_t boot_data;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data.counter, 14);
+
+  // Several interrupted writes in a row put the last valid entry before the
+  // entries that are read together with the first empty entry.
+  InterruptedWrite(0, 6, 15);
+  InterruptedWrite(0, 7, 15);
+  InterruptedWrite(0, 8, 15);
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data.counter, 14);
+
+  // An interrupted write in the last entry of a full page.
+  ErasePages();
+  FillPage(0, kBootDataEntriesPerPage - 1, 10);
+  InterruptedWrite(0, kBootDataEntriesPerPage - 1,
+                   10 + kBootDataEntriesPerPage);
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data.counter, 10 + kBootDataEntriesPerPage - 2);
+}
+
+TEST_F(BootDataTest, ReadInvalidatedEntries) {
+  // Entries before an invalidated entry are older than the entry that
+  // replaced it, even if their own invalidation was interrupted.
+  FillPage(0, 3, 10);
+  pages_[0][0].is_valid = kBootDataValidEntry;
+  pages_[0][2].is_valid = kBootDataInvalidEntry;
+  FillPage(1, 1, 13);
+
+  boot_data_t boot_data;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorOk);
+  EXPECT_EQ(boot_data.counter, 13);
+
+  // A page with only invalidated entries has no valid entry.
+  ErasePages();
+  FillPage(0, 4, 10);
+  pages_[0][3].is_valid = kBootDataInvalidEntry;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &boot_data), kErrorBootDataNotFound);
+}
+
+TEST_F(BootDataTest, WriteEmptyPages) {
+  boot_data_t boot_data = Entry(0);
+  EXPECT_EQ(boot_data_write(&boot_data), kErrorOk);
+  EXPECT_EQ(pages_[0][0].counter, kBootDataDefaultCounterVal + 1);
+  EXPECT_EQ(boot_data_check(&pages_[0][0]), kErrorOk);
+
+  boot_data_t read;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &read), kErrorOk);
+  EXPECT_EQ(read.counter, kBootDataDefaultCounterVal + 1);
+}
+
+TEST_F(BootDataTest, WriteAppendsAndInvalidates) {
+  FillPage(0, 7, 10);
+  InterruptedWrite(0, 7, 17);
+
+  boot_data_t boot_data = Entry(0);
+  boot_data.min_security_version_bl0 = 42;
+  EXPECT_EQ(boot_data_write(&boot_data), kErrorOk);
+
+  // The interrupted entry is not empty, so the new entry goes after it.
+  EXPECT_EQ(pages_[0][6].is_valid, kBootDataInvalidEntry);
+  EXPECT_EQ(pages_[0][8].counter, 17);
+  EXPECT_EQ(boot_data_check(&pages_[0][8]), kErrorOk);
+
+  boot_data_t read;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &read), kErrorOk);
+  EXPECT_EQ(read.counter, 17);
+  EXPECT_EQ(read.min_security_version_bl0, 42);
+}
+
+TEST_F(BootDataTest, WriteFullPage) {
+  FillPage(0, kBootDataEntriesPerPage, 10);
+  FillPage(1, 4, 1);
+  pages_[1][3].is_valid = kBootDataInvalidEntry;
+
+  boot_data_t boot_data = Entry(0);
+  EXPECT_EQ(boot_data_write(&boot_data), kErrorOk);
+
+  // The other page is erased and the new entry is its first entry.
+  EXPECT_EQ(pages_[1][0].counter, 10 + kBootDataEntriesPerPage);
+  EXPECT_EQ(boot_data_check(&pages_[1][0]), kErrorOk);
+  for (size_t i = 1; i < kBootDataEntriesPerPage; ++i) {
+    EXPECT_EQ(pages_[1][i].identifier, kFlashCtrlErasedWord);
+  }
+  EXPECT_EQ(pages_[0].back().is_valid, kBootDataInvalidEntry);
+
+  boot_data_t read;
+  EXPECT_EQ(boot_data_read(kLcStateProd, &read), kErrorOk);
+  EXPECT_EQ(read.counter, 10 + kBootDataEntriesPerPage);
+}
+
+TEST_F(BootDataTest, WriteMany) {
+  // Enough writes to fill both pages and wrap around to the first one.
+  boot_data_t boot_data = Entry(0);
+  for (size_t i = 0; i < 3 * kBootDataEntriesPerPage; ++i) {
+    boot_data.min_security_version_rom_ext = i;
+    ASSERT_EQ(boot_data_write(&boot_data), kErrorOk) << "i = " << i;
+
+    boot_data_t read;
+    ASSERT_EQ(boot_data_read(kLcStateProd, &read), kErrorOk);
+    EXPECT_EQ(read.counter, kBootDataDefaultCounterVal + 1 + i);
+    EXPECT_EQ(read.min_security_version_rom_ext, i);
+  }
+}
+
+}  // namespace
+}  // namespace boot_data_unittest
@@ -12,6 +12,22 @@
 extern "C" {
 #endif  // __cplusplus
 
+/**
+ * @file
+ * @brief CRC32 (IEEE 802.3, as computed by Python's `zlib.crc32()`).
+ *
+ * The implementation is selected at compile time, trading code size against
+ * speed:
+ *
+ * - Default: bit-at-a-time, no tables. Smallest code size.
+ * - `CRC32_IMPL_SLICE4`: slicing-by-4 with four 256-entry tables (4 KiB).
+ * - `CRC32_IMPL_SLICE8`: slicing-by-8 with eight 256-entry tables (8 KiB).
+ * - `CRC32_IMPL_CLMUL`: Barrett reduction of one word at a time with
+ *   carry-less multiplication. Uses `clmul`/`clmulr` if the compiler targets
+ *   Zbc and a (slow) software multiplication otherwise, so it is only useful on
+ *   cores with Zbc.
+ */
+
 /**
  * Initializes the context variable for a CRC32 computation.
  *
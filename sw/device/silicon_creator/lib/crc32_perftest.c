@@ -0,0 +1,59 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/silicon_creator/lib/crc32.h"
+
+enum {
+  kBufLen = 1024,
+  kNumRuns = 8,
+};
+
+static uint8_t buf[kBufLen + 1];
+
+/**
+ * Measures the average number of cycles `crc32` takes for one KiB.
+ */
+static uint32_t measure_cycles_per_kib(const uint8_t *data, uint32_t *crc) {
+  uint64_t total_cycles = 0;
+  for (size_t i = 0; i < kNumRuns; ++i) {
+    uint64_t start_cycles = ibex_mcycle_read();
+    *crc = crc32(data, kBufLen);
+    total_cycles += ibex_mcycle_read() - start_cycles;
+  }
+  return (uint32_t)(total_cycles / kNumRuns);
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+bool test_main(void) {
+  for (size_t i = 0; i < sizeof(buf); ++i) {
+    buf[i] = (uint8_t)(i * 7 + 3);
+  }
+
+  // Known answer, as computed by Python's `zlib.crc32(b'123456789')`.
+  CHECK(crc32("123456789", 9) == 0xcbf43926);
+
+  uint32_t crc_aligned;
+  uint32_t cycles = measure_cycles_per_kib(buf, &crc_aligned);
+  LOG_INFO("crc32, aligned: %u cycles/KiB", cycles);
+
+  // Move the data by one byte so that the same contents are hashed from an
+  // unaligned address.
+  for (size_t i = kBufLen; i > 0; --i) {
+    buf[i] = buf[i - 1];
+  }
+  uint32_t crc_unaligned;
+  cycles = measure_cycles_per_kib(&buf[1], &crc_unaligned);
+  LOG_INFO("crc32, unaligned: %u cycles/KiB", cycles);
+  CHECK(crc_aligned == crc_unaligned);
+
+  return true;
+}
@@ -5,7 +5,9 @@
 #include "sw/device/silicon_creator/lib/crc32.h"
 
 #include <cstring>
+#include <random>
 #include <stdint.h>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -87,5 +89,56 @@ TEST_F(CrcTest, Crc32Add32) {
   EXPECT_EQ(crc32_finish(&ctx), kExpCrc);
 }
 
+/**
+ * Bit-at-a-time reference implementation.
+ *
+ * The library is built with one of several implementations (see crc32.c), so
+ * they are all cross-checked against this one.
+ */
+uint32_t Crc32Reference(const uint8_t *data, size_t len) {
+  uint32_t crc = UINT32_MAX;
+  for (size_t i = 0; i < len; ++i) {
+    crc ^= data[i];
+    for (size_t j = 0; j < 8; ++j) {
+      crc = (crc >> 1) ^ ((crc & 1) ? 0xedb88320 : 0);
+    }
+  }
+  return crc ^ UINT32_MAX;
+}
+
+TEST_F(CrcTest, CrossCheckReference) {
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<uint8_t> data(1024 + sizeof(uint64_t));
+  for (auto &byte : data) {
+    byte = dist(rng);
+  }
+
+  for (size_t offset = 0; offset < sizeof(uint64_t); ++offset) {
+    for (size_t len = 0; len <= 1024; len += (len < 64) ? 1 : 61) {
+      const uint8_t *buf = data.data() + offset;
+      uint32_t exp_crc = Crc32Reference(buf, len);
+      EXPECT_EQ(crc32(buf, len), exp_crc) << "offset " << offset << " len "
+                                          << len;
+
+      // Split the buffer between byte, word and bulk updates.
+      uint32_t ctx;
+      crc32_init(&ctx);
+      size_t i = 0;
+      for (; i < len && i < 3; ++i) {
+        crc32_add8(&ctx, buf[i]);
+      }
+      for (; i + sizeof(uint32_t) <= len && i < 11; i += sizeof(uint32_t)) {
+        uint32_t word;
+        std::memcpy(&word, &buf[i], sizeof(word));
+        crc32_add32(&ctx, word);
+      }
+      crc32_add(&ctx, &buf[i], len - i);
+      EXPECT_EQ(crc32_finish(&ctx), exp_crc) << "offset " << offset << " len "
+                                             << len;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace crc32_unittest
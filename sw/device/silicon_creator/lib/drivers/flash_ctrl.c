@@ -147,16 +147,18 @@ static void fifo_write(size_t word_count, const void *data) {
 }
 
 /**
- * Blocks until the current flash transaction is complete.
+ * Checks whether the current flash transaction is complete without blocking.
  *
+ * @param[out] done Whether the transaction is complete.
  * @param error Error code to return in case of a flash controller error.
  * @return The result of the operation.
  */
-static rom_error_t wait_for_done(rom_error_t error) {
-  uint32_t op_status;
-  do {
-    op_status = abs_mmio_read32(kBase + FLASH_CTRL_OP_STATUS_REG_OFFSET);
-  } while (!bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_DONE_BIT));
+static rom_error_t poll_for_done(bool *done, rom_error_t error) {
+  uint32_t op_status = abs_mmio_read32(kBase + FLASH_CTRL_OP_STATUS_REG_OFFSET);
+  *done = bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_DONE_BIT);
+  if (!*done) {
+    return kErrorOk;
+  }
   abs_mmio_write32(kBase + FLASH_CTRL_OP_STATUS_REG_OFFSET, 0u);
 
   if (bitfield_bit32_read(op_status, FLASH_CTRL_OP_STATUS_ERR_BIT)) {
@@ -165,6 +167,173 @@ static rom_error_t wait_for_done(rom_error_t error) {
   return kErrorOk;
 }
 
+/**
+ * Blocks until the current flash transaction is complete.
+ *
+ * @param error Error code to return in case of a flash controller error.
+ * @return The result of the operation.
+ */
+static rom_error_t wait_for_done(rom_error_t error) {
+  bool done;
+  rom_error_t res;
+  do {
+    res = poll_for_done(&done, error);
+  } while (!done);
+  return res;
+}
+
+enum {
+  /**
+   * Number of words in a flash program window. Program operations can't cross
+   * window boundaries.
+   */
+  kWindowWordCount = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t),
+  /**
+   * Depth of the read and program FIFOs in words.
+   */
+  kFifoDepth = 16,
+  /**
+   * Maximum number of words of a single read operation.
+   */
+  kMaxReadWordCount = FLASH_CTRL_CONTROL_NUM_MASK + 1,
+};
+static_assert(kWindowWordCount <= kFifoDepth,
+              "A program window must fit into the program FIFO.");
+
+/**
+ * Starts the next operation of a split-phase transfer.
+ *
+ * For program operations, this also fills the program FIFO with the whole
+ * window, which never stalls since the FIFO is empty and a window fits into
+ * it.
+ *
+ * @param xfer Transfer state.
+ */
+static void xfer_op_start(flash_ctrl_xfer_t *xfer) {
+  uint32_t op_word_count;
+  switch (xfer->op_type) {
+    case FLASH_CTRL_CONTROL_OP_VALUE_PROG:
+      op_word_count = kWindowWordCount -
+                      ((xfer->addr / sizeof(uint32_t)) % kWindowWordCount);
+      break;
+    case FLASH_CTRL_CONTROL_OP_VALUE_READ:
+      op_word_count = kMaxReadWordCount;
+      break;
+    default:
+      // Erases operate on one page at a time.
+      op_word_count = 1;
+  }
+  if (op_word_count > xfer->word_count_pending) {
+    op_word_count = xfer->word_count_pending;
+  }
+
+  transaction_start((transaction_params_t){
+      .addr = xfer->addr,
+      .op_type = xfer->op_type,
+      .partition = xfer->partition,
+      .word_count = op_word_count,
+      // Does not apply to read and program transactions.
+      .erase_type = kFlashCtrlEraseTypePage,
+  });
+  xfer->word_count_pending -= op_word_count;
+  xfer->op_word_count = op_word_count;
+  xfer->fifo_word_count = 0;
+  xfer->busy = true;
+
+  switch (xfer->op_type) {
+    case FLASH_CTRL_CONTROL_OP_VALUE_PROG:
+      xfer->addr += op_word_count * sizeof(uint32_t);
+      fifo_write(op_word_count, (const void *)xfer->data);
+      xfer->data += op_word_count * sizeof(uint32_t);
+      break;
+    case FLASH_CTRL_CONTROL_OP_VALUE_READ:
+      xfer->addr += op_word_count * sizeof(uint32_t);
+      xfer->fifo_word_count = op_word_count;
+      break;
+    default:
+      xfer->addr += FLASH_CTRL_PARAM_BYTES_PER_PAGE;
+  }
+}
+
+/**
+ * Initializes a split-phase transfer and starts its first operation.
+ *
+ * @param[out] xfer Transfer state.
+ * @param addr Full byte address of the transfer.
+ * @param partition The partition to operate on.
+ * @param op_type Operation type, FLASH_CTRL_CONTROL_OP_VALUE_{READ,PROG,ERASE}.
+ * @param word_count Number of bus words to transfer, or pages to erase.
+ * @param data Buffer to read into or write from, unused for erases.
+ * @param error Error code to return in case of a flash controller error.
+ */
+static void xfer_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                       flash_ctrl_partition_t partition, uint32_t op_type,
+                       uint32_t word_count, uintptr_t data,
+                       rom_error_t error) {
+  *xfer = (flash_ctrl_xfer_t){
+      .word_count_done = 0,
+      .addr = addr,
+      .word_count_pending = word_count,
+      .op_word_count = 0,
+      .fifo_word_count = 0,
+      .data = data,
+      .partition = partition,
+      .op_type = op_type,
+      .error = error,
+      .busy = false,
+  };
+  if (word_count > 0) {
+    xfer_op_start(xfer);
+  }
+}
+
+rom_error_t flash_ctrl_xfer_poll(flash_ctrl_xfer_t *xfer,
+                                 hardened_bool_t *done) {
+  *done = kHardenedBoolFalse;
+  if (xfer->busy) {
+    if (xfer->fifo_word_count > 0) {
+      // Only read the words that are already in the read FIFO to avoid
+      // stalling the bus.
+      uint32_t fifo_lvl = bitfield_field32_read(
+          abs_mmio_read32(kBase + FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET),
+          FLASH_CTRL_CURR_FIFO_LVL_RD_FIELD);
+      if (fifo_lvl > xfer->fifo_word_count) {
+        fifo_lvl = xfer->fifo_word_count;
+      }
+      fifo_read(fifo_lvl, (void *)xfer->data);
+      xfer->data += fifo_lvl * sizeof(uint32_t);
+      xfer->word_count_done += fifo_lvl;
+      xfer->fifo_word_count -= fifo_lvl;
+      if (xfer->fifo_word_count > 0) {
+        return kErrorOk;
+      }
+    }
+    bool op_done;
+    RETURN_IF_ERROR(poll_for_done(&op_done, xfer->error));
+    if (!op_done) {
+      return kErrorOk;
+    }
+    if (xfer->op_type != FLASH_CTRL_CONTROL_OP_VALUE_READ) {
+      xfer->word_count_done += xfer->op_word_count;
+    }
+    xfer->busy = false;
+  }
+  if (xfer->word_count_pending > 0) {
+    xfer_op_start(xfer);
+    return kErrorOk;
+  }
+  *done = kHardenedBoolTrue;
+  return kErrorOk;
+}
+
+rom_error_t flash_ctrl_xfer_wait(flash_ctrl_xfer_t *xfer) {
+  hardened_bool_t done;
+  do {
+    RETURN_IF_ERROR(flash_ctrl_xfer_poll(xfer, &done));
+  } while (done != kHardenedBoolTrue);
+  return kErrorOk;
+}
+
 /**
  * Writes data to the given partition.
  *
@@ -178,37 +347,10 @@ static rom_error_t wait_for_done(rom_error_t error) {
 static rom_error_t write(uint32_t addr, flash_ctrl_partition_t partition,
                          uint32_t word_count, const void *data,
                          rom_error_t error) {
-  enum {
-    kWindowWordCount = FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t)
-  };
-
-  // Find the number of words that can be written in the first window.
-  uint32_t window_word_count =
-      kWindowWordCount - ((addr / sizeof(uint32_t)) % kWindowWordCount);
-  while (word_count > 0) {
-    // Program operations can't cross window boundaries.
-    window_word_count =
-        word_count < window_word_count ? word_count : window_word_count;
-
-    transaction_start((transaction_params_t){
-        .addr = addr,
-        .op_type = FLASH_CTRL_CONTROL_OP_VALUE_PROG,
-        .partition = partition,
-        .word_count = window_word_count,
-        // Does not apply to program transactions.
-        .erase_type = kFlashCtrlEraseTypePage,
-    });
-
-    fifo_write(window_word_count, data);
-    RETURN_IF_ERROR(wait_for_done(error));
-
-    addr += window_word_count * sizeof(uint32_t);
-    data = (const char *)data + window_word_count * sizeof(uint32_t);
-    word_count -= window_word_count;
-    window_word_count = kWindowWordCount;
-  }
-
-  return kErrorOk;
+  flash_ctrl_xfer_t xfer;
+  xfer_start(&xfer, addr, partition, FLASH_CTRL_CONTROL_OP_VALUE_PROG,
+             word_count, (uintptr_t)data, error);
+  return flash_ctrl_xfer_wait(&xfer);
 }
 
 /**
@@ -370,6 +512,27 @@ rom_error_t flash_ctrl_info_read(flash_ctrl_info_page_t info_page,
   return wait_for_done(kErrorFlashCtrlInfoRead);
 }
 
+void flash_ctrl_data_read_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                uint32_t word_count, void *data) {
+  xfer_start(xfer, addr, kFlashCtrlPartitionData,
+             FLASH_CTRL_CONTROL_OP_VALUE_READ, word_count, (uintptr_t)data,
+             kErrorFlashCtrlDataRead);
+}
+
+void flash_ctrl_data_write_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                 uint32_t word_count, const void *data) {
+  xfer_start(xfer, addr, kFlashCtrlPartitionData,
+             FLASH_CTRL_CONTROL_OP_VALUE_PROG, word_count, (uintptr_t)data,
+             kErrorFlashCtrlDataWrite);
+}
+
+void flash_ctrl_data_erase_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                 uint32_t page_count) {
+  xfer_start(xfer, addr, kFlashCtrlPartitionData,
+             FLASH_CTRL_CONTROL_OP_VALUE_ERASE, page_count, 0,
+             kErrorFlashCtrlDataErase);
+}
+
 rom_error_t flash_ctrl_data_write(uint32_t addr, uint32_t word_count,
                                   const void *data) {
   return write(addr, kFlashCtrlPartitionData, word_count, data,
@@ -278,6 +278,144 @@ rom_error_t flash_ctrl_info_write(flash_ctrl_info_page_t info_page,
                                   uint32_t offset, uint32_t word_count,
                                   const void *data);
 
+/**
+ * State of a split-phase flash transfer.
+ *
+ * A split-phase transfer returns control to the caller while the flash
+ * controller is busy, so that the CPU can, e.g., hash the data that has
+ * already been read, or receive the data to program next. See
+ * `flash_ctrl_data_read_start()` and `flash_ctrl_data_write_start()`.
+ *
+ * Except for `word_count_done`, the fields of this struct are private to the
+ * driver.
+ */
+typedef struct flash_ctrl_xfer {
+  /**
+   * Number of words that have been read into or programmed from the buffer,
+   * or number of pages that have been erased.
+   */
+  uint32_t word_count_done;
+  /**
+   * Address of the next operation.
+   */
+  uint32_t addr;
+  /**
+   * Number of words that are not part of an operation yet.
+   */
+  uint32_t word_count_pending;
+  /**
+   * Number of words of the current operation.
+   */
+  uint32_t op_word_count;
+  /**
+   * Number of words of the current operation that have not been moved through
+   * the FIFO yet.
+   */
+  uint32_t fifo_word_count;
+  /**
+   * Next word of the buffer to move through the FIFO.
+   */
+  uintptr_t data;
+  /**
+   * Partition to operate on.
+   */
+  flash_ctrl_partition_t partition;
+  /**
+   * Operation type, one of FLASH_CTRL_CONTROL_OP_VALUE_{READ,PROG,ERASE}.
+   */
+  uint32_t op_type;
+  /**
+   * Error code to return in case of a flash controller error.
+   */
+  rom_error_t error;
+  /**
+   * Whether an operation is in progress.
+   */
+  bool busy;
+} flash_ctrl_xfer_t;
+
+/**
+ * Starts reading data from the data partition.
+ *
+ * Large reads are split into multiple operations. Data is moved from the read
+ * FIFO to `data` by `flash_ctrl_xfer_poll()` and `flash_ctrl_xfer_wait()`,
+ * which only read as many words as are available in the FIFO. The first
+ * `xfer->word_count_done` words of `data` can be used while the rest of the
+ * transfer is in progress:
+ *
+ *   flash_ctrl_xfer_t xfer;
+ *   flash_ctrl_data_read_start(&xfer, addr, word_count, buf);
+ *   hardened_bool_t done = kHardenedBoolFalse;
+ *   uint32_t hashed = 0;
+ *   while (done != kHardenedBoolTrue) {
+ *     RETURN_IF_ERROR(flash_ctrl_xfer_poll(&xfer, &done));
+ *     hmac_sha256_update(&buf[hashed], (xfer.word_count_done - hashed) * 4);
+ *     hashed = xfer.word_count_done;
+ *   }
+ *
+ * Reads must remain enabled until the transfer completes.
+ *
+ * @param[out] xfer Transfer state.
+ * @param addr Address to read from. Must be word aligned.
+ * @param word_count Number of bus words to read.
+ * @param[out] data Buffer to store the read data. Must be word aligned.
+ */
+void flash_ctrl_data_read_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                uint32_t word_count, void *data);
+
+/**
+ * Starts writing data to the data partition.
+ *
+ * Writes are split into one program operation per flash program window.
+ * Subsequent windows are programmed by `flash_ctrl_xfer_poll()` and
+ * `flash_ctrl_xfer_wait()` once the previous window is done; in between, the
+ * CPU is free to do other work. `data` must not be modified until the
+ * transfer completes, and writes must remain enabled.
+ *
+ * @param[out] xfer Transfer state.
+ * @param addr Address to write to. Must be word aligned.
+ * @param word_count Number of bus words to write.
+ * @param data Data to write. Must be word aligned.
+ */
+void flash_ctrl_data_write_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                 uint32_t word_count, const void *data);
+
+/**
+ * Starts erasing pages of the data partition.
+ *
+ * Pages are erased one at a time; subsequent pages are erased by
+ * `flash_ctrl_xfer_poll()` and `flash_ctrl_xfer_wait()` once the previous page
+ * is done. `xfer->word_count_done` counts the erased pages. Erases must remain
+ * enabled until the transfer completes.
+ *
+ * @param[out] xfer Transfer state.
+ * @param addr Address that falls within the first page to erase.
+ * @param page_count Number of pages to erase.
+ */
+void flash_ctrl_data_erase_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                 uint32_t page_count);
+
+/**
+ * Advances a split-phase transfer without blocking.
+ *
+ * Moves as many words through the FIFO as possible without stalling the bus
+ * and starts the next operation once the current one is done.
+ *
+ * @param xfer Transfer state.
+ * @param[out] done Whether the transfer is complete.
+ * @return Result of the operation.
+ */
+rom_error_t flash_ctrl_xfer_poll(flash_ctrl_xfer_t *xfer,
+                                 hardened_bool_t *done);
+
+/**
+ * Blocks until a split-phase transfer is complete.
+ *
+ * @param xfer Transfer state.
+ * @return Result of the operation.
+ */
+rom_error_t flash_ctrl_xfer_wait(flash_ctrl_xfer_t *xfer);
+
 /*
  * Encoding generated with
  * $ ./util/design/sparse-fsm-encode.py -d 5 -m 2 -n 32 \
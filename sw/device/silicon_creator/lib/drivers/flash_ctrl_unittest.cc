@@ -250,6 +250,11 @@ class TransferTest : public FlashCtrlTest {
       EXPECT_ABS_WRITE32(base_ + FLASH_CTRL_PROG_FIFO_REG_OFFSET, val);
     }
   }
+
+  void ExpectReadFifoLvl(uint32_t lvl) {
+    EXPECT_ABS_READ32(base_ + FLASH_CTRL_CURR_FIFO_LVL_REG_OFFSET,
+                      {{FLASH_CTRL_CURR_FIFO_LVL_RD_OFFSET, lvl}});
+  }
 };
 
 TEST_F(TransferTest, ReadDataOk) {
@@ -368,6 +373,121 @@ TEST_F(TransferTest, TransferInternalError) {
             kErrorFlashCtrlDataRead);
 }
 
+TEST_F(TransferTest, ReadStartPoll) {
+  std::vector<uint32_t> words_out(words_.size());
+  hardened_bool_t done;
+  flash_ctrl_xfer_t xfer;
+
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_READ, 0x01234560,
+                      words_.size());
+  flash_ctrl_data_read_start(&xfer, 0x01234560, words_.size(),
+                             &words_out.front());
+
+  // Empty FIFO: nothing to read.
+  ExpectReadFifoLvl(0);
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+  EXPECT_EQ(xfer.word_count_done, 0);
+
+  // Only the words in the FIFO are read.
+  ExpectReadFifoLvl(3);
+  ExpectReadData({words_.begin(), words_.begin() + 3});
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+  EXPECT_EQ(xfer.word_count_done, 3);
+
+  // The FIFO level is capped at the number of words left.
+  ExpectReadFifoLvl(2);
+  ExpectReadData({words_.begin() + 3, words_.end()});
+  ExpectWaitForDone(false, false);
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+  EXPECT_EQ(xfer.word_count_done, words_.size());
+
+  ExpectWaitForDone(true, false);
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolTrue);
+  EXPECT_EQ(words_out, words_);
+}
+
+TEST_F(TransferTest, ProgStartPollAcrossWindows) {
+  static const uint32_t kWinWords =
+      FLASH_CTRL_PARAM_REG_BUS_PGM_RES_BYTES / sizeof(uint32_t);
+  std::vector<uint32_t> many_words(kWinWords);
+  for (uint32_t i = 0; i < many_words.size(); ++i) {
+    many_words[i] = i;
+  }
+  auto half = many_words.begin() + kWinWords / 2;
+  hardened_bool_t done;
+  flash_ctrl_xfer_t xfer;
+
+  // The first window is programmed right away.
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG,
+                      sizeof(uint32_t) * kWinWords / 2, kWinWords / 2);
+  ExpectProgData({many_words.begin(), half});
+  flash_ctrl_data_write_start(&xfer, sizeof(uint32_t) * kWinWords / 2,
+                              many_words.size(), &many_words.front());
+
+  ExpectWaitForDone(false, false);
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+  EXPECT_EQ(xfer.word_count_done, 0);
+
+  // The next window is started once the first one is done.
+  ExpectWaitForDone(true, false);
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG,
+                      sizeof(uint32_t) * kWinWords, kWinWords / 2);
+  ExpectProgData({half, many_words.end()});
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+  EXPECT_EQ(xfer.word_count_done, kWinWords / 2);
+
+  ExpectWaitForDone(false, false);
+  ExpectWaitForDone(true, false);
+  EXPECT_EQ(flash_ctrl_xfer_wait(&xfer), kErrorOk);
+  EXPECT_EQ(xfer.word_count_done, kWinWords);
+}
+
+TEST_F(TransferTest, ProgStartPollError) {
+  hardened_bool_t done;
+  flash_ctrl_xfer_t xfer;
+
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_PROG, 0x01234560,
+                      words_.size());
+  ExpectProgData(words_);
+  flash_ctrl_data_write_start(&xfer, 0x01234560, words_.size(),
+                              &words_.front());
+
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorFlashCtrlDataWrite);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+}
+
+TEST_F(TransferTest, EraseStartPoll) {
+  hardened_bool_t done;
+  flash_ctrl_xfer_t xfer;
+
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_ERASE, 0x01234567,
+                      1);
+  flash_ctrl_data_erase_start(&xfer, 0x01234567, 2);
+
+  ExpectWaitForDone(false, false);
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+  EXPECT_EQ(xfer.word_count_done, 0);
+
+  // The next page is erased once the first one is done.
+  ExpectWaitForDone(true, false);
+  ExpectTransferStart(0, 0, 0, FLASH_CTRL_CONTROL_OP_VALUE_ERASE,
+                      0x01234567 + FLASH_CTRL_PARAM_BYTES_PER_PAGE, 1);
+  EXPECT_EQ(flash_ctrl_xfer_poll(&xfer, &done), kErrorOk);
+  EXPECT_EQ(done, kHardenedBoolFalse);
+  EXPECT_EQ(xfer.word_count_done, 1);
+
+  ExpectWaitForDone(true, true);
+  EXPECT_EQ(flash_ctrl_xfer_wait(&xfer), kErrorFlashCtrlDataErase);
+}
+
 class ExecTest : public FlashCtrlTest {};
 
 TEST_F(ExecTest, Set) {
@@ -38,20 +38,16 @@ void hmac_sha256_init(void) {
 void hmac_sha256_update(const void *data, size_t len) {
   const uint8_t *data_sent = (const uint8_t *)data;
 
-  // Individual byte writes are needed if the buffer isn't word aligned.
-  for (; len != 0 && (uintptr_t)data_sent & 3; --len) {
-    abs_mmio_write8(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
-                    *data_sent++);
-  }
-
+  // Send full words regardless of the alignment of `data`; `read_32` assembles
+  // unaligned words in registers, so byte writes are only needed for the
+  // trailing bytes.
   for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
-    uint32_t data_aligned = read_32(data_sent);
     abs_mmio_write32(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
-                     data_aligned);
+                     read_32(data_sent));
     data_sent += sizeof(uint32_t);
   }
 
-  // Handle non-32bit aligned bytes at the end of the buffer.
+  // Handle the remaining bytes at the end of the buffer.
   for (; len != 0; --len) {
     abs_mmio_write8(TOP_EARLGREY_HMAC_BASE_ADDR + HMAC_MSG_FIFO_REG_OFFSET,
                     *data_sent++);
@@ -43,6 +43,10 @@ void hmac_sha256_init(void);
  * FIFO. Since the this function is meant to run in blocking mode,
  * polling for FIFO status is equivalent to stalling on FIFO write.
  *
+ * `data` may have any alignment: full words are assembled in registers and
+ * written with word writes, and only the last `len % 4` bytes are written
+ * individually.
+ *
  * @param data Buffer to copy data from.
  * @param len size of the `data` buffer.
  */
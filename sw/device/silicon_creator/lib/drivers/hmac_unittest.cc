@@ -53,7 +53,7 @@ TEST_F(Sha256UpdateTest, SendData) {
       0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
   };
 
-  // Trigger 8bit aligned writes.
+  // Trigger 8bit writes for less than a word.
   EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x01);
   EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x02);
   hmac_sha256_update(&kData[1], 2);
@@ -62,13 +62,18 @@ TEST_F(Sha256UpdateTest, SendData) {
   EXPECT_ABS_WRITE32(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x03020100);
   hmac_sha256_update(&kData[0], 4);
 
-  // Trigger 8bit/32bit/8bit sequence.
-  EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x02);
-  EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x03);
-  EXPECT_ABS_WRITE32(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x07060504);
-  EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x08);
-  EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x09);
+  // Unaligned words are still sent with 32bit writes.
+  EXPECT_ABS_WRITE32(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x05040302);
+  EXPECT_ABS_WRITE32(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x09080706);
   hmac_sha256_update(&kData[2], 8);
+
+  // Trigger 32bit/8bit sequence for an unaligned buffer with a tail.
+  EXPECT_ABS_WRITE32(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x04030201);
+  EXPECT_ABS_WRITE32(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x08070605);
+  EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x09);
+  EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x0a);
+  EXPECT_ABS_WRITE8(base_ + HMAC_MSG_FIFO_REG_OFFSET, 0x0b);
+  hmac_sha256_update(&kData[1], 11);
 }
 
 class Sha256FinalTest : public HmacTest {};
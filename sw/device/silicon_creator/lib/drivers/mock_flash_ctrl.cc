@@ -37,6 +37,30 @@ rom_error_t flash_ctrl_info_write(flash_ctrl_info_page_t info_page,
                                              data);
 }
 
+void flash_ctrl_data_read_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                uint32_t word_count, void *data) {
+  MockFlashCtrl::Instance().DataReadStart(xfer, addr, word_count, data);
+}
+
+void flash_ctrl_data_write_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                 uint32_t word_count, const void *data) {
+  MockFlashCtrl::Instance().DataWriteStart(xfer, addr, word_count, data);
+}
+
+void flash_ctrl_data_erase_start(flash_ctrl_xfer_t *xfer, uint32_t addr,
+                                 uint32_t page_count) {
+  MockFlashCtrl::Instance().DataEraseStart(xfer, addr, page_count);
+}
+
+rom_error_t flash_ctrl_xfer_poll(flash_ctrl_xfer_t *xfer,
+                                 hardened_bool_t *done) {
+  return MockFlashCtrl::Instance().XferPoll(xfer, done);
+}
+
+rom_error_t flash_ctrl_xfer_wait(flash_ctrl_xfer_t *xfer) {
+  return MockFlashCtrl::Instance().XferWait(xfer);
+}
+
 rom_error_t flash_ctrl_data_erase(uint32_t addr,
                                   flash_ctrl_erase_type_t erase_type) {
   return MockFlashCtrl::Instance().DataErase(addr, erase_type);
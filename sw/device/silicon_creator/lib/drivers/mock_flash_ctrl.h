@@ -24,6 +24,13 @@ class MockFlashCtrl : public global_mock::GlobalMock<MockFlashCtrl> {
   MOCK_METHOD(rom_error_t, DataWrite, (uint32_t, uint32_t, const void *));
   MOCK_METHOD(rom_error_t, InfoWrite,
               (flash_ctrl_info_page_t, uint32_t, uint32_t, const void *));
+  MOCK_METHOD(void, DataReadStart,
+              (flash_ctrl_xfer_t *, uint32_t, uint32_t, void *));
+  MOCK_METHOD(void, DataWriteStart,
+              (flash_ctrl_xfer_t *, uint32_t, uint32_t, const void *));
+  MOCK_METHOD(void, DataEraseStart, (flash_ctrl_xfer_t *, uint32_t, uint32_t));
+  MOCK_METHOD(rom_error_t, XferPoll, (flash_ctrl_xfer_t *, hardened_bool_t *));
+  MOCK_METHOD(rom_error_t, XferWait, (flash_ctrl_xfer_t *));
   MOCK_METHOD(rom_error_t, DataErase, (uint32_t, flash_ctrl_erase_type_t));
   MOCK_METHOD(rom_error_t, DataEraseVerify,
               (uint32_t, flash_ctrl_erase_type_t));
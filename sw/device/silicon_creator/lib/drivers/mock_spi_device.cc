@@ -13,6 +13,10 @@ rom_error_t spi_device_cmd_get(spi_device_cmd_t *cmd) {
   return MockSpiDevice::Instance().CmdGet(cmd);
 }
 
+hardened_bool_t spi_device_cmd_pending(void) {
+  return MockSpiDevice::Instance().CmdPending();
+}
+
 void spi_device_flash_status_clear(void) {
   MockSpiDevice::Instance().FlashStatusClear();
 }
@@ -18,6 +18,7 @@ class MockSpiDevice : public global_mock::GlobalMock<MockSpiDevice> {
  public:
   MOCK_METHOD(void, Init, ());
   MOCK_METHOD(rom_error_t, CmdGet, (spi_device_cmd_t *));
+  MOCK_METHOD(hardened_bool_t, CmdPending, ());
   MOCK_METHOD(void, FlashStatusClear, ());
   MOCK_METHOD(uint32_t, FlashStatusGet, ());
 };
@@ -661,6 +661,15 @@ rom_error_t spi_device_cmd_get(spi_device_cmd_t *cmd) {
   return kErrorOk;
 }
 
+hardened_bool_t spi_device_cmd_pending(void) {
+  uint32_t reg = abs_mmio_read32(kBase + SPI_DEVICE_INTR_STATE_REG_OFFSET);
+  if (bitfield_bit32_read(
+          reg, SPI_DEVICE_INTR_COMMON_UPLOAD_CMDFIFO_NOT_EMPTY_BIT)) {
+    return kHardenedBoolTrue;
+  }
+  return kHardenedBoolFalse;
+}
+
 void spi_device_flash_status_clear(void) {
   abs_mmio_write32(kBase + SPI_DEVICE_FLASH_STATUS_REG_OFFSET, 0);
 }
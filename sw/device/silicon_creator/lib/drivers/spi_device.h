@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "sw/device/lib/base/hardened.h"
 #include "sw/device/silicon_creator/lib/error.h"
 
 #ifdef __cplusplus
@@ -342,6 +343,17 @@ typedef struct spi_device_cmd {
  */
 rom_error_t spi_device_cmd_get(spi_device_cmd_t *cmd);
 
+/**
+ * Checks whether a SPI flash command that is handled by software has been
+ * received from the host.
+ *
+ * This function does not block. If it returns `kHardenedBoolTrue`, the next
+ * call to `spi_device_cmd_get()` returns without waiting.
+ *
+ * @return Whether a command is pending.
+ */
+hardened_bool_t spi_device_cmd_pending(void);
+
 /**
  * Clears the SPI flash status register.
  *
@@ -183,6 +183,16 @@ TEST_F(SpiDeviceTest, FlashStatusGet) {
   EXPECT_EQ(0xa5, spi_device_flash_status_get());
 }
 
+TEST_F(SpiDeviceTest, CmdPending) {
+  EXPECT_ABS_READ32(base_ + SPI_DEVICE_INTR_STATE_REG_OFFSET,
+                    {{SPI_DEVICE_INTR_STATE_UPLOAD_PAYLOAD_OVERFLOW_BIT, 1}});
+  EXPECT_EQ(spi_device_cmd_pending(), kHardenedBoolFalse);
+
+  EXPECT_ABS_READ32(base_ + SPI_DEVICE_INTR_STATE_REG_OFFSET,
+                    {{SPI_DEVICE_INTR_STATE_UPLOAD_CMDFIFO_NOT_EMPTY_BIT, 1}});
+  EXPECT_EQ(spi_device_cmd_pending(), kHardenedBoolTrue);
+}
+
 struct CmdGetTestCase {
   spi_device_opcode_t opcode;
   uint32_t address;
@@ -4,6 +4,7 @@
 
 #include "sw/device/silicon_creator/lib/sigverify/mod_exp_ibex.h"
 
+#include <assert.h>
 #include <stddef.h>
 
 #include "sw/device/lib/base/macros.h"
@@ -50,22 +51,32 @@ static bool greater_equal_modulus(const sigverify_rsa_key_t *key,
   return true;
 }
 
+static_assert(kSigVerifyRsaNumWords % 4 == 0,
+              "The inner loop of `mont_mul()` is unrolled four times.");
+
 /**
- * Shifts `a` left one bit in-place, i.e. `a <<= 1`.
+ * Performs one step of the inner loop of `mont_mul()`.
  *
- * Since the result may not fit in `a`, this function also returns the most
- * significant bit of the result.
+ * Adds x[i]*y[j] and u[i]*n[j] to the j^th digit of the intermediate result
+ * and writes the sum to the (j-1)^th digit, i.e. the division by `b` in step
+ * 2.2 of the algorithm is folded into the loop.
  *
- * @param[in,out] a Buffer that holds `a`, little-endian.
- * @return Most significant bit of the result.
+ * @param x_i i^th digit of `x`.
+ * @param u_i Reduction factor for the i^th digit of `x`.
+ * @param y_j j^th digit of `y`.
+ * @param n_j j^th digit of the modulus.
+ * @param[in,out] r Buffer that holds the intermediate result.
+ * @param j Index of the digit to process, must be at least 1.
+ * @param[in,out] acc0 Sum of the first two addends and its carry.
+ * @param[in,out] acc1 Sum of all three addends and its carry.
  */
-static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
-  const uint32_t msb = a->data[ARRAYSIZE(a->data) - 1] >> 31;
-  for (size_t i = ARRAYSIZE(a->data) - 1; i > 0; --i) {
-    a->data[i] = (a->data[i] << 1) | (a->data[i - 1] >> 31);
-  }
-  a->data[0] <<= 1;
-  return msb;
+static OT_ALWAYS_INLINE void mont_mul_step(uint32_t x_i, uint32_t u_i,
+                                           uint32_t y_j, uint32_t n_j,
+                                           uint32_t *r, size_t j,
+                                           uint64_t *acc0, uint64_t *acc1) {
+  *acc0 = (uint64_t)x_i * y_j + r[j] + (*acc0 >> 32);
+  *acc1 = (uint64_t)u_i * n_j + (uint32_t)*acc0 + (*acc1 >> 32);
+  r[j - 1] = (uint32_t)*acc1;
 }
 
 /**
@@ -77,7 +88,12 @@ static uint32_t shift_left(sigverify_rsa_buffer_t *a) {
  * - n is the modulus of the key, and
  * - R is 2^`kSigVerifyRsaNumBits`, e.g. 2^3072 for RSA-3072.
  *
- * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36.
+ * See Handbook of Applied Cryptography, Ch. 14, Alg. 14.36. Multiplication and
+ * reduction are interleaved word by word (coarsely integrated operand
+ * scanning), and the inner loop is unrolled four times since it dominates the
+ * run time of `sigverify_mod_exp_ibex()`.
+ *
+ * `x` and `y` may be the same buffer but `result` must not overlap either.
  *
  * @param key An RSA public key.
  * @param x Buffer that holds `x`, little-endian.
@@ -88,9 +104,12 @@ static void mont_mul(const sigverify_rsa_key_t *key,
                      const sigverify_rsa_buffer_t *x,
                      const sigverify_rsa_buffer_t *y,
                      sigverify_rsa_buffer_t *result) {
-  memset(result->data, 0, sizeof(result->data));
+  const uint32_t *n = key->n.data;
+  const uint32_t n0_inv = key->n0_inv[0];
+  uint32_t *OT_RESTRICT r = result->data;
+  memset(r, 0, sizeof(result->data));
 
-  for (size_t i = 0; i < ARRAYSIZE(x->data); ++i) {
+  for (size_t i = 0; i < kSigVerifyRsaNumWords; ++i) {
     // The loop below reads one word ahead of writes to avoid a separate loop
     // for the division by `b` in step 2.2 of the algorithm. Thus, `acc0` and
     // `acc1` are initialized here before the loop. `acc0` holds the sum of
@@ -99,21 +118,30 @@ static void mont_mul(const sigverify_rsa_key_t *key,
     // and `acc1`. `acc0` and `acc1` can safely store these intermediate values,
     // i.e. without wrapping, because UINT32_MAX^2 + 2*UINT32_MAX is
     // 0xffff_ffff_ffff_ffff.
+    const uint32_t x_i = x->data[i];
 
     // Holds the sum of the first two addends in step 2.2.
-    uint64_t acc0 = (uint64_t)x->data[i] * y->data[0] + result->data[0];
-    const uint32_t u_i = (uint32_t)acc0 * key->n0_inv[0];
+    uint64_t acc0 = (uint64_t)x_i * y->data[0] + r[0];
+    const uint32_t u_i = (uint32_t)acc0 * n0_inv;
     // Holds the sum of the all three addends in step 2.2.
-    uint64_t acc1 = (uint64_t)u_i * key->n.data[0] + (uint32_t)acc0;
-
-    // Process the i^th digit of `x`, i.e. `x[i]`.
-    for (size_t j = 1; j < ARRAYSIZE(result->data); ++j) {
-      acc0 = (uint64_t)x->data[i] * y->data[j] + result->data[j] + (acc0 >> 32);
-      acc1 = (uint64_t)u_i * key->n.data[j] + (uint32_t)acc0 + (acc1 >> 32);
-      result->data[j - 1] = (uint32_t)acc1;
+    uint64_t acc1 = (uint64_t)u_i * n[0] + (uint32_t)acc0;
+
+    // Process the i^th digit of `x`, i.e. `x[i]`. Digits 1 to 3 are processed
+    // separately so that the rest of the loop runs in blocks of four.
+    mont_mul_step(x_i, u_i, y->data[1], n[1], r, 1, &acc0, &acc1);
+    mont_mul_step(x_i, u_i, y->data[2], n[2], r, 2, &acc0, &acc1);
+    mont_mul_step(x_i, u_i, y->data[3], n[3], r, 3, &acc0, &acc1);
+    for (size_t j = 4; j < kSigVerifyRsaNumWords; j += 4) {
+      mont_mul_step(x_i, u_i, y->data[j], n[j], r, j, &acc0, &acc1);
+      mont_mul_step(x_i, u_i, y->data[j + 1], n[j + 1], r, j + 1, &acc0,
+                    &acc1);
+      mont_mul_step(x_i, u_i, y->data[j + 2], n[j + 2], r, j + 2, &acc0,
+                    &acc1);
+      mont_mul_step(x_i, u_i, y->data[j + 3], n[j + 3], r, j + 3, &acc0,
+                    &acc1);
     }
     acc0 = (acc0 >> 32) + (acc1 >> 32);
-    result->data[ARRAYSIZE(result->data) - 1] = (uint32_t)acc0;
+    r[kSigVerifyRsaNumWords - 1] = (uint32_t)acc0;
 
     // The intermediate result of this algorithm before the check below is
     // bounded by R + n (Eq. (4) in Montgomery Arithmetic from a Software
@@ -130,40 +158,6 @@ static void mont_mul(const sigverify_rsa_key_t *key,
   }
 }
 
-/**
- * Calculates R^2 mod n, where R = 2^kSigVerifyRsaNumBits.
- *
- * @param key An RSA public key.
- * @param[out] result Buffer to write the result to, little-endian.
- */
-static void calc_r_square(const sigverify_rsa_key_t *key,
-                          sigverify_rsa_buffer_t *result) {
-  sigverify_rsa_buffer_t buf;
-  memset(buf.data, 0, sizeof(result->data));
-  // This subtraction sets buf = -n mod R = R - n, which is equivalent to R
-  // modulo n and ensures that `buf` fits in `kSigVerifyRsaNumWords` going
-  // into the loop.
-  subtract_modulus(key, &buf);
-
-  // Compute (2^96 * R) mod n.
-  // Each run of the loop doubles buf and reduces modulo n.
-  for (size_t i = 0; i < 96; ++i) {
-    uint32_t msb = shift_left(&buf);
-    // Reduce until buf < n. Doing this at every iteration minimizes the
-    // total number of subtractions that we need to perform.
-    while (msb > 0 || greater_equal_modulus(key, &buf)) {
-      msb -= subtract_modulus(key, &buf);
-    }
-  }
-
-  // Perform 5 montgomery squares to get RR = ((2^96)^32 * R) mod n
-  mont_mul(key, &buf, &buf, result);
-  for (size_t i = 0; i < 2; ++i) {
-    mont_mul(key, result, result, &buf);
-    mont_mul(key, &buf, &buf, result);
-  }
-}
-
 rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
                                    const sigverify_rsa_buffer_t *sig,
                                    sigverify_rsa_buffer_t *result) {
@@ -175,10 +169,11 @@ rom_error_t sigverify_mod_exp_ibex(const sigverify_rsa_key_t *key,
 
   sigverify_rsa_buffer_t buf;
 
-  // result = R^2 mod n
-  calc_r_square(key, result);
+  // Fixed addition chain for e = 65537 = 2^16 + 1: one conversion into
+  // Montgomery form, 16 squarings, and one multiplication that also converts
+  // the result back. R^2 mod n is precomputed and stored in the key.
   // buf = sig * R mod n
-  mont_mul(key, sig, result, &buf);
+  mont_mul(key, sig, &key->rr, &buf);
   for (size_t i = 0; i < 8; ++i) {
     // result = sig^{2*4^i} * R mod n (sig's exponent: 2, 8, 32, ..., 32768)
     mont_mul(key, &buf, &buf, result);
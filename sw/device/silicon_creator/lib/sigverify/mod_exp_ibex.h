@@ -23,7 +23,8 @@ extern "C" {
  * - sig is an RSA signature,
  * - e and n are the exponent and the modulus of the key, respectively.
  *
- * The key exponent is always 65537; no other exponents are supported.
+ * The key exponent is always 65537; no other exponents are supported. The key
+ * must carry the precomputed Montgomery constants `n0_inv` and `rr`.
  *
  * @param key An RSA public key.
  * @param sig Buffer that holds the signature, little-endian.
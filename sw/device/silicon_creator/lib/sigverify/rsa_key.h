@@ -52,6 +52,13 @@ typedef struct sigverify_rsa_key {
    * first word, which is equal to -n^-1 mod 2^32.
    */
   uint32_t n0_inv[8];
+  /**
+   * R^2 mod n, where R = 2^`kSigVerifyRsaNumBits`, little-endian.
+   *
+   * Used by the Ibex implementation to convert the signature into Montgomery
+   * form without having to compute this value from the modulus at boot time.
+   */
+  sigverify_rsa_buffer_t rr;
 } sigverify_rsa_key_t;
 
 /**
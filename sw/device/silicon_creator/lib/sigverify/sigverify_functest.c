@@ -86,6 +86,24 @@ static const sigverify_rsa_key_t kKeyExp65537 = {
             0xbe1bc819,
             0x2b421fae,
         },
+    .rr = {{
+        0x801d910d, 0x80b82e51, 0x0693bd8e, 0xe504378f, 0xee7b8dcf, 0xd46ed96e,
+        0x2947a90a, 0x32a22331, 0x10450a5d, 0x5191b02a, 0x5ffe3000, 0xc5b99ee3,
+        0xe5783783, 0xe6b416da, 0xce7ba8ed, 0x752bb7b5, 0x47a98315, 0xb31952a1,
+        0xdac6125f, 0x138a6e2f, 0xbd918f95, 0x661dda95, 0xfea3ef97, 0xe265c457,
+        0x12ee497e, 0x8c54e701, 0xab5f45bc, 0x97d03403, 0x08ecc282, 0xd67c28af,
+        0x7680e1d5, 0xafb107b2, 0xa5d7dcc6, 0x78b545a7, 0x5c327005, 0xe22e96eb,
+        0xead60b03, 0x62148024, 0xaa2295a2, 0x9a32b8b3, 0x0bd3f91f, 0xe7d75213,
+        0x8664627a, 0x6dcc05db, 0x38f9c709, 0x63b7939d, 0x22ceb26c, 0x5d59488f,
+        0xe2dac0ef, 0x6cd0d198, 0x8ed032c9, 0x32ca4a38, 0x26178c9e, 0xa2d5d0a0,
+        0xaa325002, 0x8467c351, 0x74695943, 0x2f8720ea, 0x587a3718, 0xd28bd879,
+        0xab7c1d12, 0x10299814, 0x47416f21, 0xc6705399, 0x71639c47, 0x667a4871,
+        0xc0534500, 0xb1ada3ce, 0x4c3bbfed, 0x88e232bc, 0x3cbe6cbb, 0x6e3bbb4d,
+        0x66669fe5, 0x98bde921, 0x43fcba09, 0xad4b0052, 0x3f725ede, 0xfe73709e,
+        0xdfb5ddf1, 0xc2a35f88, 0x91010518, 0x18924c5d, 0xa18e0907, 0xc94a57c2,
+        0x23127d82, 0x98eab0c7, 0x1ab48ef3, 0xfd34a853, 0x13d4ebd2, 0x28414f3b,
+        0xc27de274, 0xe04f7ea4, 0xffdcf502, 0xf0085483, 0x4738d021, 0x58adcd5d,
+    }},
 };
 
 static const sigverify_rsa_key_t kKeyExp3 = {
@@ -118,6 +136,24 @@ static const sigverify_rsa_key_t kKeyExp3 = {
             0x58022be6,
             0x8f8972c9,
         },
+    .rr = {{
+        0x0326ea23, 0x46cc29a2, 0xa4d41d01, 0xef0981d2, 0x86beb258, 0xcedba143,
+        0xcf27b7e9, 0x432c2e73, 0x57138268, 0x9771655d, 0xdfd5054d, 0x80a69e65,
+        0xd8ca5b11, 0x64222c7f, 0x709e703b, 0x0452dae6, 0x2604c1bf, 0xaf29f6b5,
+        0x2773bf22, 0x83ab42d4, 0x34da57f5, 0xfad6aafc, 0xa23f2798, 0x88ab0542,
+        0x65219ceb, 0xc5fc703c, 0x9bab047a, 0x48749a33, 0x7067f6d5, 0xfcab7cc9,
+        0x878567df, 0x34e07abb, 0x6e5f5247, 0xdd57ed01, 0xd2cdc06e, 0x0b3c509c,
+        0x1c94f373, 0xc07a0024, 0x8c92383b, 0x575b4a5c, 0xd4c086fc, 0x27f19cd7,
+        0x496d70a4, 0x91d4b3cc, 0x73e34ca2, 0xa98f4fd4, 0x02ef38ac, 0xfb0a0675,
+        0xba14f83d, 0x0217c95b, 0xfc62ca77, 0x310b598c, 0x188e68cd, 0xdbcfdf58,
+        0xc783c009, 0xd8abae8c, 0x52d5f747, 0xee2dbda8, 0xd1f5ea87, 0x097f0e5b,
+        0x58407a2a, 0xfa880b9b, 0x528d2962, 0xa805f356, 0x9646688e, 0x2525612b,
+        0x900cacf4, 0xf844b2a4, 0x04007862, 0x96535db6, 0x25d03e7f, 0x4460bedf,
+        0x2961c014, 0x7a25057c, 0xf7bf0721, 0xfed9dbff, 0x7dfee1e2, 0xa6c7bcd3,
+        0x2cef3ab5, 0x7c7ffdf8, 0x4ab94057, 0x04c3cf7c, 0xf1022b35, 0x6cd62eae,
+        0x9e41a3b6, 0x8a31357b, 0x40013d2d, 0x5005f7c7, 0xa3ce1d53, 0xfe99692c,
+        0x8a612703, 0x2734ccde, 0xd115a702, 0x9b6c042c, 0xdd783f38, 0x5713d609,
+    }},
 };
 
 void compute_digest(void) {
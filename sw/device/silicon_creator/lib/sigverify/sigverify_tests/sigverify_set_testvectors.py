@@ -47,6 +47,14 @@ def compute_n0_inv(n):
     return (1 << w) - y
 
 
+def compute_rr(n):
+    '''Compute R^2 mod n, where R = 2^3072, a Montgomery constant.
+
+    Sigverify expects this constant to be precomputed.
+    '''
+    return pow(2, 2 * 3072, n)
+
+
 def encode_message(msg_bytes):
     '''Get the message encoded according to PKCS v1.5.
 
@@ -130,6 +138,7 @@ def main() -> int:
         t['sig_hexwords'] = rsa_3072_int_to_hexwords(t['signature'])
         n0_inv = compute_n0_inv(t['n'])
         t['n0_inv_hexwords'] = int_256_to_hexwords(n0_inv)
+        t['rr_hexwords'] = rsa_3072_int_to_hexwords(compute_rr(t['n']))
 
     # Compute the SHA-256 digest of the message
     for t in testvecs:
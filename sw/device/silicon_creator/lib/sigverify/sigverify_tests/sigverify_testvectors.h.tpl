@@ -41,6 +41,12 @@ static const sigverify_test_vector_t sigverify_tests[${len(tests)}] = {
                               ${', '.join(t["n0_inv_hexwords"][i:i + 4])},
   % endfor
                           },
+                .rr = {.data =
+                           {
+  % for i in range(0, len(t["rr_hexwords"]), 4):
+                               ${', '.join(t["rr_hexwords"][i:i + 4])},
+  % endfor
+                           }},
             },
         .sig =
             {.data =
@@ -81,16 +81,115 @@ static rom_error_t bootstrap_chip_erase(void) {
 }
 
 /**
- * Handles access permissions and erases a 4 KiB region in the data partition of
- * the embedded flash.
+ * Pipelined flash operations of the program state.
+ *
+ * A SECTOR_ERASE or PAGE_PROGRAM command is acknowledged, i.e. the WIP bit of
+ * the SPI flash status register is cleared, as soon as the corresponding flash
+ * operation is started. This lets the host send the next command while the
+ * flash controller is busy. Since the next PAGE_PROGRAM payload is received
+ * while the previous one is being programmed, payloads are double-buffered.
+ *
+ * At most one flash operation is in progress at a time: the operation is
+ * completed before the next command is handled, so errors are reported before
+ * any subsequent command takes effect. Since WIP no longer tells the host when
+ * the last operation is complete, the host must end the session with RESET,
+ * which completes it before resetting the chip (see `bootstrap()`).
+ */
+typedef struct bootstrap_pipeline {
+  /**
+   * Command buffers.
+   */
+  spi_device_cmd_t cmds[2];
+  /**
+   * Index of the buffer to receive the next command into.
+   */
+  size_t next_cmd;
+  /**
+   * State of the flash operation in progress.
+   */
+  flash_ctrl_xfer_t xfer;
+  /**
+   * Whether a flash operation is in progress.
+   */
+  hardened_bool_t busy;
+} bootstrap_pipeline_t;
+
+/**
+ * Disables all access to the data partition of the embedded flash.
+ */
+static void bootstrap_data_perms_disable(void) {
+  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
+      .read = kMultiBitBool4False,
+      .write = kMultiBitBool4False,
+      .erase = kMultiBitBool4False,
+  });
+}
+
+/**
+ * Ends the flash operation in progress.
+ *
+ * @param pipeline Bootstrap pipeline.
+ * @param error Result of the flash operation.
+ * @return Result of the flash operation.
+ */
+static rom_error_t bootstrap_flash_op_end(bootstrap_pipeline_t *pipeline,
+                                          rom_error_t error) {
+  pipeline->busy = kHardenedBoolFalse;
+  bootstrap_data_perms_disable();
+  return error;
+}
+
+/**
+ * Advances the flash operation in progress until the host sends a command.
+ *
+ * Returns right away if there is no flash operation in progress.
+ *
+ * @param pipeline Bootstrap pipeline.
+ * @return Result of the operation.
+ */
+static rom_error_t bootstrap_flash_op_poll(bootstrap_pipeline_t *pipeline) {
+  while (launder32(pipeline->busy) == kHardenedBoolTrue &&
+         spi_device_cmd_pending() != kHardenedBoolTrue) {
+    hardened_bool_t done = kHardenedBoolFalse;
+    rom_error_t error = flash_ctrl_xfer_poll(&pipeline->xfer, &done);
+    if (launder32(error) != kErrorOk || done == kHardenedBoolTrue) {
+      return bootstrap_flash_op_end(pipeline, error);
+    }
+  }
+  return kErrorOk;
+}
+
+/**
+ * Blocks until the flash operation in progress is complete.
+ *
+ * Returns right away if there is no flash operation in progress.
+ *
+ * @param pipeline Bootstrap pipeline.
+ * @return Result of the operation.
+ */
+static rom_error_t bootstrap_flash_op_wait(bootstrap_pipeline_t *pipeline) {
+  if (launder32(pipeline->busy) != kHardenedBoolTrue) {
+    return kErrorOk;
+  }
+  HARDENED_CHECK_EQ(pipeline->busy, kHardenedBoolTrue);
+  return bootstrap_flash_op_end(pipeline,
+                                flash_ctrl_xfer_wait(&pipeline->xfer));
+}
+
+/**
+ * Handles access permissions and starts erasing a 4 KiB region in the data
+ * partition of the embedded flash.
  *
  * Since OpenTitan's flash page size is 2 KiB, this function erases two
- * consecutive pages.
+ * consecutive pages. The erase completes in `bootstrap_flash_op_poll()` or
+ * `bootstrap_flash_op_wait()`.
  *
+ * @param pipeline Bootstrap pipeline, must not have an operation in progress.
  * @param addr Address that falls within the 4 KiB region being deleted.
  * @return Result of the operation.
  */
-static rom_error_t bootstrap_sector_erase(uint32_t addr) {
+static rom_error_t bootstrap_sector_erase_start(bootstrap_pipeline_t *pipeline,
+                                                uint32_t addr) {
   static_assert(FLASH_CTRL_PARAM_BYTES_PER_PAGE == 2048,
                 "Page size must be 2 KiB");
   enum {
@@ -110,26 +209,24 @@ static rom_error_t bootstrap_sector_erase(uint32_t addr) {
       .write = kMultiBitBool4False,
       .erase = kMultiBitBool4True,
   });
-  rom_error_t err_0 = flash_ctrl_data_erase(addr, kFlashCtrlEraseTypePage);
-  rom_error_t err_1 = flash_ctrl_data_erase(
-      addr + FLASH_CTRL_PARAM_BYTES_PER_PAGE, kFlashCtrlEraseTypePage);
-  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
-      .read = kMultiBitBool4False,
-      .write = kMultiBitBool4False,
-      .erase = kMultiBitBool4False,
-  });
-
-  HARDENED_RETURN_IF_ERROR(err_0);
-  return err_1;
+  flash_ctrl_data_erase_start(&pipeline->xfer, addr, 2);
+  pipeline->busy = kHardenedBoolTrue;
+  return kErrorOk;
 }
 
 /**
- * Handles access permissions and programs up to 256 bytes of flash memory
- * starting at `addr`.
+ * Handles access permissions and starts programming up to 256 bytes of flash
+ * memory starting at `addr`.
  *
  * If `byte_count` is not a multiple of flash word size, it's rounded up to next
  * flash word and missing bytes in `data` are set to `0xff`.
  *
+ * If the write wraps around to the start of the 256 byte programming page, the
+ * part before the wrap is programmed right away. The rest completes in
+ * `bootstrap_flash_op_poll()` or `bootstrap_flash_op_wait()`, so `data` must
+ * not be modified until then.
+ *
+ * @param pipeline Bootstrap pipeline, must not have an operation in progress.
  * @param addr Address to write to, must be flash word aligned.
  * @param byte_count Number of bytes to write. Rounded up to next flash word if
  * not a multiple of flash word size. Missing bytes in `data` are set to `0xff`.
@@ -138,8 +235,10 @@ static rom_error_t bootstrap_sector_erase(uint32_t addr) {
  * flash word.
  * @return Result of the operation.
  */
-static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
-                                          uint8_t *data) {
+static rom_error_t bootstrap_page_program_start(bootstrap_pipeline_t *pipeline,
+                                                uint32_t addr,
+                                                size_t byte_count,
+                                                uint8_t *data) {
   static_assert(__builtin_popcount(FLASH_CTRL_PARAM_BYTES_PER_WORD) == 1,
                 "Bytes per flash word must be a power of two.");
   enum {
@@ -180,35 +279,27 @@ static rom_error_t bootstrap_page_program(uint32_t addr, size_t byte_count,
       .write = kMultiBitBool4True,
       .erase = kMultiBitBool4False,
   });
-  // Perform two writes if the start address is not page-aligned (256 bytes).
+  // Perform two writes if the data wraps to the start of the page (256 bytes).
   // Note: Address is flash-word-aligned (8 bytes) due to the check above.
-  rom_error_t err_0 = kErrorOk;
   size_t prog_page_misalignment = addr & kFlashProgPageMask;
-  if (prog_page_misalignment > 0) {
-    size_t word_count =
-        (kFlashProgPageSize - prog_page_misalignment) / sizeof(uint32_t);
-    if (word_count > rem_word_count) {
-      word_count = rem_word_count;
+  size_t word_count =
+      (kFlashProgPageSize - prog_page_misalignment) / sizeof(uint32_t);
+  if (word_count < rem_word_count) {
+    rom_error_t error = flash_ctrl_data_write(addr, word_count, data);
+    if (launder32(error) != kErrorOk) {
+      bootstrap_data_perms_disable();
+      return error;
     }
-    err_0 = flash_ctrl_data_write(addr, word_count, data);
+    HARDENED_CHECK_EQ(error, kErrorOk);
     rem_word_count -= word_count;
     data += word_count * sizeof(uint32_t);
     // Wrap to the beginning of the current page since PAGE_PROGRAM modifies
     // a single page only.
     addr &= ~kFlashProgPageMask;
   }
-  rom_error_t err_1 = kErrorOk;
-  if (rem_word_count > 0) {
-    err_1 = flash_ctrl_data_write(addr, rem_word_count, data);
-  }
-  flash_ctrl_data_default_perms_set((flash_ctrl_perms_t){
-      .read = kMultiBitBool4False,
-      .write = kMultiBitBool4False,
-      .erase = kMultiBitBool4False,
-  });
-
-  HARDENED_RETURN_IF_ERROR(err_0);
-  return err_1;
+  flash_ctrl_data_write_start(&pipeline->xfer, addr, rem_word_count, data);
+  pipeline->busy = kHardenedBoolTrue;
+  return kErrorOk;
 }
 
 /**
@@ -277,9 +368,11 @@ static rom_error_t bootstrap_handle_erase_verify(bootstrap_state_t *state) {
  * Bootstrap state 3: (Erase/)Program loop.
  *
  * @param state Bootstrap state.
+ * @param pipeline Bootstrap pipeline.
  * @return Result of the operation.
  */
-static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
+static rom_error_t bootstrap_handle_program(bootstrap_state_t *state,
+                                            bootstrap_pipeline_t *pipeline) {
   static_assert(alignof(spi_device_cmd_t) >= sizeof(uint32_t) &&
                     offsetof(spi_device_cmd_t, payload) >= sizeof(uint32_t),
                 "Payload must be word aligned.");
@@ -290,25 +383,32 @@ static rom_error_t bootstrap_handle_program(bootstrap_state_t *state) {
 
   HARDENED_CHECK_EQ(*state, kBootstrapStateProgram);
 
-  spi_device_cmd_t cmd;
-  RETURN_IF_ERROR(spi_device_cmd_get(&cmd));
+  // Keep the flash busy while the host sends the next command.
+  HARDENED_RETURN_IF_ERROR(bootstrap_flash_op_poll(pipeline));
+  // The buffer of the command being programmed, if any, is not overwritten.
+  spi_device_cmd_t *cmd = &pipeline->cmds[pipeline->next_cmd];
+  RETURN_IF_ERROR(spi_device_cmd_get(cmd));
   // Erase and program require WREN, ignore if WEL is not set.
-  if (cmd.opcode != kSpiDeviceOpcodeReset &&
+  if (cmd->opcode != kSpiDeviceOpcodeReset &&
       !bitfield_bit32_read(spi_device_flash_status_get(), kSpiDeviceWelBit)) {
     return kErrorOk;
   }
+  // Commands take effect in order.
+  HARDENED_RETURN_IF_ERROR(bootstrap_flash_op_wait(pipeline));
 
   rom_error_t error = kErrorUnknown;
-  switch (cmd.opcode) {
+  switch (cmd->opcode) {
     case kSpiDeviceOpcodeChipErase:
       error = bootstrap_chip_erase();
       break;
     case kSpiDeviceOpcodeSectorErase:
-      error = bootstrap_sector_erase(cmd.address);
+      error = bootstrap_sector_erase_start(pipeline, cmd->address);
       break;
     case kSpiDeviceOpcodePageProgram:
-      error = bootstrap_page_program(cmd.address, cmd.payload_byte_count,
-                                     cmd.payload);
+      error = bootstrap_page_program_start(
+          pipeline, cmd->address, cmd->payload_byte_count, cmd->payload);
+      // Receive the next command into the other buffer.
+      pipeline->next_cmd ^= 1;
       break;
     case kSpiDeviceOpcodeReset:
       rstmgr_reset();
@@ -364,6 +464,10 @@ rom_error_t bootstrap(void) {
 
   // Bootstrap event loop.
   bootstrap_state_t state = kBootstrapStateErase;
+  bootstrap_pipeline_t pipeline = {
+      .next_cmd = 0,
+      .busy = kHardenedBoolFalse,
+  };
   rom_error_t error = kErrorUnknown;
   while (true) {
     switch (launder32(state)) {
@@ -377,7 +481,7 @@ rom_error_t bootstrap(void) {
         break;
       case kBootstrapStateProgram:
         HARDENED_CHECK_EQ(state, kBootstrapStateProgram);
-        error = bootstrap_handle_program(&state);
+        error = bootstrap_handle_program(&state, &pipeline);
         break;
       default:
         error = kErrorBootstrapInvalidState;
@@ -32,6 +32,15 @@ hardened_bool_t bootstrap_requested(void);
  * - Programming the chip (WREN, PAGE_PROGRAM, busy loop ...), and
  * - Resetting the chip (RESET).
  *
+ * Unlike a typical SPI flash, the WIP bit of SECTOR_ERASE and PAGE_PROGRAM
+ * commands is cleared as soon as the corresponding flash operation starts, so
+ * that the host can send the next command while the flash controller is busy.
+ * WIP=0 therefore only means that the next command can be sent: the operation
+ * is completed, and a failure reported, when the next command arrives. Hosts
+ * must end a bootstrap session with RESET, which sets WIP until the last
+ * operation is complete and the chip is reset. Resetting the chip in any other
+ * way may lose the last operation.
+ *
  * This function only returns on error since a successful bootstrap ends with a
  * chip reset.
  *
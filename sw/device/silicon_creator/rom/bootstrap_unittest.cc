@@ -31,6 +31,7 @@ namespace {
 using ::testing::DoAll;
 using ::testing::NotNull;
 using ::testing::Return;
+using ::testing::SaveArg;
 using ::testing::SetArgPointee;
 
 MATCHER_P(HasBytes, bytes, "") {
@@ -66,6 +67,16 @@ class BootstrapTest : public rom_test::RomTest {
         .WillOnce(DoAll(SetArgPointee<0>(cmd), Return(kErrorOk)));
   }
 
+  /**
+   * Sets an expectation for checking whether a SPI flash command is pending.
+   *
+   * @param pending Whether a command is pending.
+   */
+  void ExpectSpiCmdPending(bool pending) {
+    EXPECT_CALL(spi_device_, CmdPending())
+        .WillOnce(Return(pending ? kHardenedBoolTrue : kHardenedBoolFalse));
+  }
+
   /**
    * Sets an expectation for getting the SPI flash status register.
    *
@@ -115,24 +126,26 @@ class BootstrapTest : public rom_test::RomTest {
   }
 
   /**
-   * Sets expectations for a sector erase.
+   * Sets expectations for starting a sector erase.
    *
-   * @param err0 Result of erase for the first page.
-   * @param err1 Result of erase for the second page.
    * @param addr Erase start address.
    */
-  void ExpectFlashCtrlSectorErase(rom_error_t err0, rom_error_t err1,
-                                  uint32_t addr) {
+  void ExpectFlashCtrlSectorEraseStart(uint32_t addr) {
     EXPECT_CALL(flash_ctrl_, DataDefaultPermsSet((flash_ctrl_perms_t){
                                  .read = kMultiBitBool4False,
                                  .write = kMultiBitBool4False,
                                  .erase = kMultiBitBool4True,
                              }));
-    EXPECT_CALL(flash_ctrl_, DataErase(addr, kFlashCtrlEraseTypePage))
-        .WillOnce(Return(err0));
-    EXPECT_CALL(flash_ctrl_, DataErase(addr + FLASH_CTRL_PARAM_BYTES_PER_PAGE,
-                                       kFlashCtrlEraseTypePage))
-        .WillOnce(Return(err1));
+    EXPECT_CALL(flash_ctrl_, DataEraseStart(NotNull(), addr, 2));
+  }
+
+  /**
+   * Sets expectations for waiting for the flash operation in progress.
+   *
+   * @param err Result of the flash operation.
+   */
+  void ExpectFlashCtrlOpWait(rom_error_t err) {
+    EXPECT_CALL(flash_ctrl_, XferWait(NotNull())).WillOnce(Return(err));
     ExpectFlashCtrlAllDisable();
   }
 
@@ -282,13 +295,14 @@ TEST_F(BootstrapTest, BootstrapSimple) {
                                    cmd.payload + cmd.payload_byte_count);
 
   ExpectFlashCtrlWriteEnable();
-  EXPECT_CALL(flash_ctrl_, DataWrite(0, 4, HasBytes(flash_bytes)))
-      .WillOnce(Return(kErrorOk));
-  ExpectFlashCtrlAllDisable();
+  EXPECT_CALL(flash_ctrl_,
+              DataWriteStart(NotNull(), 0, 4, HasBytes(flash_bytes)));
 
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Reset
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
   EXPECT_CALL(rstmgr_, Reset());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
@@ -316,13 +330,14 @@ TEST_F(BootstrapTest, BootstrapOddPayload) {
   }
 
   ExpectFlashCtrlWriteEnable();
-  EXPECT_CALL(flash_ctrl_, DataWrite(cmd.address, 6, HasBytes(flash_bytes)))
-      .WillOnce(Return(kErrorOk));
-  ExpectFlashCtrlAllDisable();
+  EXPECT_CALL(flash_ctrl_,
+              DataWriteStart(NotNull(), cmd.address, 6, HasBytes(flash_bytes)));
 
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Reset
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
   EXPECT_CALL(rstmgr_, Reset());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
@@ -350,13 +365,14 @@ TEST_F(BootstrapTest, BootstrapMisalignedAddrLongPayload) {
   ExpectFlashCtrlWriteEnable();
   EXPECT_CALL(flash_ctrl_, DataWrite(0xfff0, 4, HasBytes(flash_bytes_0)))
       .WillOnce(Return(kErrorOk));
-  EXPECT_CALL(flash_ctrl_, DataWrite(0xff00, 60, HasBytes(flash_bytes_1)))
-      .WillOnce(Return(kErrorOk));
-  ExpectFlashCtrlAllDisable();
+  EXPECT_CALL(flash_ctrl_,
+              DataWriteStart(NotNull(), 0xff00, 60, HasBytes(flash_bytes_1)));
 
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Reset
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
   EXPECT_CALL(rstmgr_, Reset());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
@@ -381,13 +397,14 @@ TEST_F(BootstrapTest, BootstrapMisalignedAddrShortPayload) {
                                    cmd.payload + cmd.payload_byte_count);
 
   ExpectFlashCtrlWriteEnable();
-  EXPECT_CALL(flash_ctrl_, DataWrite(816, 2, HasBytes(flash_bytes)))
-      .WillOnce(Return(kErrorOk));
-  ExpectFlashCtrlAllDisable();
+  EXPECT_CALL(flash_ctrl_,
+              DataWriteStart(NotNull(), 816, 2, HasBytes(flash_bytes)));
 
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Reset
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
   EXPECT_CALL(rstmgr_, Reset());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
@@ -412,15 +429,16 @@ TEST_F(BootstrapTest, BootstrapStartWithSectorErase) {
                                    cmd.payload + cmd.payload_byte_count);
 
   ExpectFlashCtrlWriteEnable();
-  EXPECT_CALL(flash_ctrl_,
-              DataWrite(cmd.address, cmd.payload_byte_count / sizeof(uint32_t),
-                        HasBytes(flash_bytes)))
-      .WillOnce(Return(kErrorOk));
-  ExpectFlashCtrlAllDisable();
+  EXPECT_CALL(flash_ctrl_, DataWriteStart(
+                               NotNull(), cmd.address,
+                               cmd.payload_byte_count / sizeof(uint32_t),
+                               HasBytes(flash_bytes)));
 
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Reset
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
   EXPECT_CALL(rstmgr_, Reset());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
@@ -445,31 +463,104 @@ TEST_F(BootstrapTest, BootstrapProgramWithErase) {
                                    cmd.payload + cmd.payload_byte_count);
 
   ExpectFlashCtrlWriteEnable();
-  EXPECT_CALL(flash_ctrl_,
-              DataWrite(cmd.address, cmd.payload_byte_count / sizeof(uint32_t),
-                        HasBytes(flash_bytes)))
-      .WillOnce(Return(kErrorOk));
-  ExpectFlashCtrlAllDisable();
+  EXPECT_CALL(flash_ctrl_, DataWriteStart(
+                               NotNull(), cmd.address,
+                               cmd.payload_byte_count / sizeof(uint32_t),
+                               HasBytes(flash_bytes)));
 
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Chip erase
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ChipEraseCmd());
   ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlOpWait(kErrorOk);
   ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Sector erase
   ExpectSpiCmd(SectorEraseCmd(0));
   ExpectSpiFlashStatusGet(true);
-  ExpectFlashCtrlSectorErase(kErrorOk, kErrorOk, 0);
+  ExpectFlashCtrlSectorEraseStart(0);
   EXPECT_CALL(spi_device_, FlashStatusClear());
 
   // Reset
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
   EXPECT_CALL(rstmgr_, Reset());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
 }
 
+TEST_F(BootstrapTest, BootstrapPipelined) {
+  // Erase
+  ExpectBootstrapRequestCheck(true);
+  EXPECT_CALL(spi_device_, Init());
+  ExpectSpiCmd(ChipEraseCmd());
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
+  // Verify
+  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Program the first page, acknowledged before it is programmed.
+  auto cmd_0 = PageProgramCmd(0, 256);
+  ExpectSpiCmd(cmd_0);
+  ExpectSpiFlashStatusGet(true);
+  const void *buf_0 = nullptr;
+  ExpectFlashCtrlWriteEnable();
+  EXPECT_CALL(flash_ctrl_, DataWriteStart(NotNull(), 0, 64, NotNull()))
+      .WillOnce(SaveArg<3>(&buf_0));
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // The first page is programmed while the host sends the second one.
+  ExpectSpiCmdPending(false);
+  EXPECT_CALL(flash_ctrl_, XferPoll(NotNull(), NotNull()))
+      .WillOnce(
+          DoAll(SetArgPointee<1>(kHardenedBoolFalse), Return(kErrorOk)));
+  ExpectSpiCmdPending(false);
+  EXPECT_CALL(flash_ctrl_, XferPoll(NotNull(), NotNull()))
+      .WillOnce(DoAll(SetArgPointee<1>(kHardenedBoolTrue), Return(kErrorOk)));
+  ExpectFlashCtrlAllDisable();
+  // The second page is received into the other buffer.
+  auto cmd_1 = PageProgramCmd(256, 256);
+  ExpectSpiCmd(cmd_1);
+  ExpectSpiFlashStatusGet(true);
+  const void *buf_1 = nullptr;
+  ExpectFlashCtrlWriteEnable();
+  EXPECT_CALL(flash_ctrl_, DataWriteStart(NotNull(), 256, 64, NotNull()))
+      .WillOnce(SaveArg<3>(&buf_1));
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Reset
+  ExpectSpiCmdPending(true);
+  ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
+  EXPECT_CALL(rstmgr_, Reset());
+
+  EXPECT_EQ(bootstrap(), kErrorUnknown);
+  EXPECT_NE(buf_0, buf_1);
+}
+
+TEST_F(BootstrapTest, BootstrapPipelinedPollError) {
+  // Erase
+  ExpectBootstrapRequestCheck(true);
+  EXPECT_CALL(spi_device_, Init());
+  ExpectSpiCmd(ChipEraseCmd());
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
+  // Verify
+  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Sector erase
+  ExpectSpiCmd(SectorEraseCmd(0));
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlSectorEraseStart(0);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  ExpectSpiCmdPending(false);
+  EXPECT_CALL(flash_ctrl_, XferPoll(NotNull(), NotNull()))
+      .WillOnce(Return(kErrorFlashCtrlDataErase));
+  ExpectFlashCtrlAllDisable();
+
+  EXPECT_EQ(bootstrap(), kErrorFlashCtrlDataErase);
+}
+
 TEST_F(BootstrapTest, MisalignedEraseAddress) {
   // Erase
   ExpectBootstrapRequestCheck(true);
@@ -483,20 +574,26 @@ TEST_F(BootstrapTest, MisalignedEraseAddress) {
   // Erase with misaligned and aligned addresses
   ExpectSpiCmd(SectorEraseCmd(5));
   ExpectSpiFlashStatusGet(true);
-  ExpectFlashCtrlSectorErase(kErrorOk, kErrorOk, 0);
+  ExpectFlashCtrlSectorEraseStart(0);
   EXPECT_CALL(spi_device_, FlashStatusClear());
 
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(SectorEraseCmd(4096));
   ExpectSpiFlashStatusGet(true);
-  ExpectFlashCtrlSectorErase(kErrorOk, kErrorOk, 4096);
+  ExpectFlashCtrlOpWait(kErrorOk);
+  ExpectFlashCtrlSectorEraseStart(4096);
   EXPECT_CALL(spi_device_, FlashStatusClear());
 
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(SectorEraseCmd(8195));
   ExpectSpiFlashStatusGet(true);
-  ExpectFlashCtrlSectorErase(kErrorOk, kErrorOk, 8192);
+  ExpectFlashCtrlOpWait(kErrorOk);
+  ExpectFlashCtrlSectorEraseStart(8192);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Reset
+  ExpectSpiCmdPending(true);
   ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorOk);
   EXPECT_CALL(rstmgr_, Reset());
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
@@ -596,16 +693,21 @@ TEST_F(BootstrapTest, DataWriteError) {
                                    cmd.payload + cmd.payload_byte_count);
 
   ExpectFlashCtrlWriteEnable();
-  EXPECT_CALL(flash_ctrl_,
-              DataWrite(cmd.address, cmd.payload_byte_count / sizeof(uint32_t),
-                        HasBytes(flash_bytes)))
-      .WillOnce(Return(kErrorUnknown));
-  ExpectFlashCtrlAllDisable();
+  EXPECT_CALL(flash_ctrl_, DataWriteStart(
+                               NotNull(), cmd.address,
+                               cmd.payload_byte_count / sizeof(uint32_t),
+                               HasBytes(flash_bytes)));
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // The error is reported before the next command takes effect.
+  ExpectSpiCmdPending(true);
+  ExpectSpiCmd(PageProgramCmd(16, 16));
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlOpWait(kErrorUnknown);
 
   EXPECT_EQ(bootstrap(), kErrorUnknown);
 }
 
-TEST_F(BootstrapTest, DataWriteErrorMisalignedAddr) {
+TEST_F(BootstrapTest, DataWriteErrorOnReset) {
   // Erase
   ExpectBootstrapRequestCheck(true);
   EXPECT_CALL(spi_device_, Init());
@@ -616,13 +718,43 @@ TEST_F(BootstrapTest, DataWriteErrorMisalignedAddr) {
   ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
   EXPECT_CALL(spi_device_, FlashStatusClear());
   // Program
-  auto cmd = PageProgramCmd(0xf0, 16);
+  auto cmd = PageProgramCmd(0, 16);
   ExpectSpiCmd(cmd);
   ExpectSpiFlashStatusGet(true);
 
   std::vector<uint8_t> flash_bytes(cmd.payload,
                                    cmd.payload + cmd.payload_byte_count);
 
+  ExpectFlashCtrlWriteEnable();
+  EXPECT_CALL(flash_ctrl_,
+              DataWriteStart(NotNull(), 0, 4, HasBytes(flash_bytes)));
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // RESET completes the last operation and reports its error instead of
+  // resetting the chip.
+  ExpectSpiCmdPending(true);
+  ExpectSpiCmd(ResetCmd());
+  ExpectFlashCtrlOpWait(kErrorFlashCtrlDataWrite);
+
+  EXPECT_EQ(bootstrap(), kErrorFlashCtrlDataWrite);
+}
+
+TEST_F(BootstrapTest, DataWriteErrorMisalignedAddr) {
+  // Erase
+  ExpectBootstrapRequestCheck(true);
+  EXPECT_CALL(spi_device_, Init());
+  ExpectSpiCmd(ChipEraseCmd());
+  ExpectSpiFlashStatusGet(true);
+  ExpectFlashCtrlChipErase(kErrorOk, kErrorOk);
+  // Verify
+  ExpectFlashCtrlEraseVerify(kErrorOk, kErrorOk);
+  EXPECT_CALL(spi_device_, FlashStatusClear());
+  // Program
+  auto cmd = PageProgramCmd(0xf0, 32);
+  ExpectSpiCmd(cmd);
+  ExpectSpiFlashStatusGet(true);
+
+  std::vector<uint8_t> flash_bytes(cmd.payload, cmd.payload + 16);
+
   ExpectFlashCtrlWriteEnable();
   EXPECT_CALL(flash_ctrl_, DataWrite(0xf0, 4, HasBytes(flash_bytes)))
       .WillOnce(Return(kErrorUnknown));
@@ -34,5 +34,28 @@
         0x9f8b1a89, 0xd6a6c4f8, 0xfe4396b4, 0xa4abfbd0,                 \
         0xba4ebeb4, 0x7cb40b8c, 0x297e8ec1, 0x2af3bb20,                 \
     },                                                                  \
+    .rr =                                                               \
+        {{                                                              \
+            0xb7a8e412, 0x3417c49a, 0xc0e00839, 0xcc299cb1, 0xf275a999, \
+            0x7a632bc5, 0xa7d22081, 0xa6e29994, 0x5da04d2e, 0x42759b47, \
+            0x3454bc85, 0x412c88ad, 0x620595ea, 0x7403cb01, 0xc689276a, \
+            0x3a7a35e1, 0x933cb988, 0x336f059c, 0xd0c7c582, 0xe7e124e7, \
+            0x64d8f2fc, 0x14e0f24e, 0x39ed8565, 0xa8bfa382, 0xc615a3b0, \
+            0x51c67eac, 0x7b5eac3a, 0xa489f1b7, 0xa4ae1f0d, 0x9fb68312, \
+            0xd04d7b08, 0xfd50ad6d, 0x0fd95959, 0x02f072c9, 0x7569edf7, \
+            0x7bbc0ec1, 0x5b8850ea, 0x40df66cc, 0x220eda23, 0xf623e0ce, \
+            0x10aa56ce, 0x633e0c90, 0x67a75f02, 0xcaa12b8d, 0x2b926094, \
+            0xc8282f69, 0xc21a9217, 0xd5489f57, 0xb195d473, 0xc4cb204f, \
+            0x8b9288c7, 0x119fd7e8, 0x3d4b8b17, 0xd8fa3f4f, 0xd37b514f, \
+            0x13ee64ea, 0xc87a3cd6, 0xf149fd55, 0xff83caec, 0x7f0034c1, \
+            0x97211956, 0x406f911a, 0x8fdd5786, 0x114d12f8, 0x6fbb4280, \
+            0xe3698e07, 0xd24ed2e1, 0x16738f84, 0xbd6947fe, 0x4093c952, \
+            0xd89789d8, 0xf256e250, 0x12106242, 0x32d875af, 0xce47c2f3, \
+            0xa18e0691, 0xbc47e705, 0xa4dbb229, 0xd085159c, 0x05079492, \
+            0x50f4fff5, 0x23b7d4cb, 0x7e6b3ddd, 0x78bef471, 0x1e13d4fb, \
+            0x5c96bb00, 0x3c4f8f0c, 0x135a726d, 0x6573ff9e, 0x8bd6a647, \
+            0xc01b33aa, 0xa328432f, 0x70b627fb, 0xa89eb866, 0xf851ce33, \
+            0x82ca57ba,                                                 \
+        }},                                                             \
   }
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_KEYS_FAKE_DEV_KEY_0_RSA_3072_EXP_F4_H_
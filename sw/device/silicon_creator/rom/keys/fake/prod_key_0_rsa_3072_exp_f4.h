@@ -34,6 +34,29 @@
         0x632c0e4b, 0x6ac43a85, 0x6e681c96, 0x84062bca,                 \
         0x72b12519, 0x46073f6a, 0xc2332e2f, 0xfd8548cb,                 \
     },                                                                  \
+    .rr =                                                               \
+        {{                                                              \
+            0x19bf86f7, 0xce945983, 0x3ba9d5ca, 0x93aa3569, 0xd3a71111, \
+            0x6157deb4, 0xcde6e4ba, 0xf1b81197, 0x08d5b2d2, 0x33a02ace, \
+            0xa2109bd3, 0x70045413, 0x9ca008ff, 0xd5fafb9b, 0x950acc74, \
+            0x3c4c19c4, 0x5d99f43f, 0xdb626b78, 0xf4281e9b, 0x4f9076b8, \
+            0x615879b8, 0xfbf09624, 0x797d8fff, 0x1d9578cb, 0x10755073, \
+            0x3c37d581, 0xf46bdfc6, 0x435e52bf, 0x46b366ce, 0xd4436da2, \
+            0x9e23367a, 0xfc850858, 0x80be3687, 0x7b11b1a4, 0xaf720297, \
+            0x05358c3b, 0xf32576fc, 0x91ddef30, 0x28ebb581, 0x5722b7e6, \
+            0xb7b757a3, 0xceaf2d73, 0x420abf7a, 0x27d9546b, 0xa4201b7a, \
+            0x4fe6ca5f, 0xa89774b0, 0x0909cfa2, 0x4e82dc0e, 0xb70cfea2, \
+            0xef850fc3, 0x9bc2784d, 0x8cff7d76, 0x348dcb4d, 0x120875e8, \
+            0xa9bddeca, 0xa6d2eccf, 0xa71fffc0, 0xbd2b29b9, 0xeacbc057, \
+            0x1c38ff0b, 0xbfa220d9, 0xdd1aac9c, 0x303f527a, 0xfc5d2b76, \
+            0x14120096, 0xc48bedf5, 0x0c0fb3e5, 0x283a9771, 0x427dd3ab, \
+            0xde123ac1, 0x211ef4ca, 0x66ec7ed8, 0xbd6287df, 0x654c8198, \
+            0xc6a69a28, 0xb10bc67a, 0xe091c882, 0x52f73cf7, 0x2f6f2965, \
+            0x243c474b, 0xafda0db5, 0xdd21b760, 0xb878e50e, 0x0fca8d8e, \
+            0xc61f284e, 0xe6649397, 0xdbb87932, 0x333b0555, 0xcb745bf5, \
+            0x1717c8a9, 0x96710e11, 0xced39ee8, 0x0f47cac5, 0xd2d959df, \
+            0x554f4079,                                                 \
+        }},                                                             \
   }
 
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_KEYS_FAKE_PROD_KEY_0_RSA_3072_EXP_F4_H_
@@ -34,6 +34,29 @@
         0x9c9a176b, 0x44d6fa52, 0x71a63ec4, 0xadc94595,                 \
         0x3fd9bc73, 0xa83cdc95, 0xbe1bc819, 0x2b421fae,                 \
     },                                                                  \
+    .rr =                                                               \
+        {{                                                              \
+            0x801d910d, 0x80b82e51, 0x0693bd8e, 0xe504378f, 0xee7b8dcf, \
+            0xd46ed96e, 0x2947a90a, 0x32a22331, 0x10450a5d, 0x5191b02a, \
+            0x5ffe3000, 0xc5b99ee3, 0xe5783783, 0xe6b416da, 0xce7ba8ed, \
+            0x752bb7b5, 0x47a98315, 0xb31952a1, 0xdac6125f, 0x138a6e2f, \
+            0xbd918f95, 0x661dda95, 0xfea3ef97, 0xe265c457, 0x12ee497e, \
+            0x8c54e701, 0xab5f45bc, 0x97d03403, 0x08ecc282, 0xd67c28af, \
+            0x7680e1d5, 0xafb107b2, 0xa5d7dcc6, 0x78b545a7, 0x5c327005, \
+            0xe22e96eb, 0xead60b03, 0x62148024, 0xaa2295a2, 0x9a32b8b3, \
+            0x0bd3f91f, 0xe7d75213, 0x8664627a, 0x6dcc05db, 0x38f9c709, \
+            0x63b7939d, 0x22ceb26c, 0x5d59488f, 0xe2dac0ef, 0x6cd0d198, \
+            0x8ed032c9, 0x32ca4a38, 0x26178c9e, 0xa2d5d0a0, 0xaa325002, \
+            0x8467c351, 0x74695943, 0x2f8720ea, 0x587a3718, 0xd28bd879, \
+            0xab7c1d12, 0x10299814, 0x47416f21, 0xc6705399, 0x71639c47, \
+            0x667a4871, 0xc0534500, 0xb1ada3ce, 0x4c3bbfed, 0x88e232bc, \
+            0x3cbe6cbb, 0x6e3bbb4d, 0x66669fe5, 0x98bde921, 0x43fcba09, \
+            0xad4b0052, 0x3f725ede, 0xfe73709e, 0xdfb5ddf1, 0xc2a35f88, \
+            0x91010518, 0x18924c5d, 0xa18e0907, 0xc94a57c2, 0x23127d82, \
+            0x98eab0c7, 0x1ab48ef3, 0xfd34a853, 0x13d4ebd2, 0x28414f3b, \
+            0xc27de274, 0xe04f7ea4, 0xffdcf502, 0xf0085483, 0x4738d021, \
+            0x58adcd5d,                                                 \
+        }},                                                             \
   }
 
 #endif  // OPENTITAN_SW_DEVICE_SILICON_CREATOR_ROM_KEYS_FAKE_TEST_KEY_0_RSA_3072_EXP_F4_H_
@@ -7,10 +7,11 @@
 #include "sw/device/lib/base/mmio.h"
 #include "sw/device/lib/dif/dif_aes.h"
 #include "sw/device/lib/dif/dif_cmod.h"
-#include "sw/device/lib/runtime/ibex.h"
 #include "sw/device/lib/runtime/log.h"
 #include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_console_buffer.h"
 #include "sw/device/lib/testing/test_framework/ottf_main.h"
+#include "sw/device/lib/testing/test_framework/ottf_perf.h"
 
 #include "aes_regs.h"   // Generated
 #include "cmod_regs.h"  // Generated
@@ -352,17 +353,49 @@ static void aes_read(mmio_region_t base, uint32_t *data) {
                 AES_DATA_OUT_0_REG_OFFSET);
 }
 
+// One region per measured operation. Operations that are measured once per
+// cipher mode and key length accumulate into the same region, so each
+// "Result:" line reports the growth of its region's cycle count.
+static ottf_perf_region_t status_read_region =
+    OTTF_PERF_REGION("cmod_status_read");
+static ottf_perf_region_t ctrl_write_region =
+    OTTF_PERF_REGION("cmod_ctrl_write");
+static ottf_perf_region_t wdata_write_region =
+    OTTF_PERF_REGION("cmod_wdata_write");
+static ottf_perf_region_t rdata_read_region =
+    OTTF_PERF_REGION("cmod_rdata_read");
+static ottf_perf_region_t send_region = OTTF_PERF_REGION("cmod_send");
+static ottf_perf_region_t encrypt_region = OTTF_PERF_REGION("aes_encrypt");
+static ottf_perf_region_t aes_init_region = OTTF_PERF_REGION("aes_init");
+static ottf_perf_region_t aes_end_region = OTTF_PERF_REGION("aes_end");
+static ottf_perf_region_t encrypt_send_region =
+    OTTF_PERF_REGION("aes_encrypt_cmod_send");
+static ottf_perf_region_t receive_decrypt_region =
+    OTTF_PERF_REGION("cmod_receive_aes_decrypt");
+
+/**
+ * Returns the cycles counted in `region` so far.
+ */
+static uint64_t region_cycles(const ottf_perf_region_t *region) {
+  return ottf_perf_total(region, kOttfPerfCounterCycles);
+}
+
 OTTF_DEFINE_TEST_CONFIG();
 
 bool test_main(void) {
   uint32_t total_cycles;
-  uint64_t start_cycles, end_cycles;
+  uint64_t start_cycles;
 
   dif_cmod_t cmod0, cmod1;
   dif_aes_t aes;
   bool res;
   uint8_t data_out[80];
 
+  // Keep UART transfers and log formatting out of the measurements. The
+  // binary log records are decoded by reproduce.py.
+  ottf_console_buffer_enable(/*defer_logs=*/false);
+  base_log_set_mode(kLogModeBinary);
+
   CHECK_DIF_OK(dif_cmod_init(
       mmio_region_from_addr(TOP_EARLGREY_CMOD0_BASE_ADDR), &cmod0));
   CHECK_DIF_OK(dif_cmod_init(
@@ -374,18 +407,15 @@ bool test_main(void) {
   // Read TXFULL bit of the STATUS register //
   ////////////////////////////////////////////
 
-  total_cycles = 0;
-
   for (int i = 0; i < 1000; i++) {
-    start_cycles = ibex_mcycle_read();
+    ottf_perf_begin(&status_read_region);
     res = read_bit_of_register(cmod0.base_addr, CMOD_STATUS_REG_OFFSET,
                                CMOD_STATUS_TXFULL_BIT);
-    end_cycles = ibex_mcycle_read();
-
-    total_cycles += end_cycles - start_cycles;
+    ottf_perf_end(&status_read_region);
     CHECK(res == false);
   }
 
+  total_cycles = (uint32_t)region_cycles(&status_read_region);
   LOG_INFO(
       "Result: Read TXFULL bit of the STATUS register. (1000 times): %u "
       "cycles",
@@ -395,17 +425,14 @@ bool test_main(void) {
   // Set the TXTRIGGER bit of the CTRL register //
   ////////////////////////////////////////////////
 
-  total_cycles = 0;
-
   for (int i = 0; i < 1000; i++) {
-    start_cycles = ibex_mcycle_read();
+    ottf_perf_begin(&ctrl_write_region);
     write_bit_of_register(cmod0.base_addr, CMOD_CTRL_REG_OFFSET,
                           CMOD_CTRL_TXTRIGGER_BIT, true);
-    end_cycles = ibex_mcycle_read();
-
-    total_cycles += end_cycles - start_cycles;
+    ottf_perf_end(&ctrl_write_region);
   }
 
+  total_cycles = (uint32_t)region_cycles(&ctrl_write_region);
   LOG_INFO(
       "Result: Set the TXTRIGGER bit of the CTRL register. (1000 times): %u "
       "cycles",
@@ -415,17 +442,14 @@ bool test_main(void) {
   // Write to the WDATA multiregister //
   //////////////////////////////////////
 
-  total_cycles = 0;
-
   for (int i = 0; i < 5; i++) {
-    start_cycles = ibex_mcycle_read();
+    ottf_perf_begin(&wdata_write_region);
     set_multireg(cmod0.base_addr, (const uint32_t *)&plainText[i * 16],
                  CMOD_WDATA_MULTIREG_COUNT, CMOD_WDATA_0_REG_OFFSET);
-    end_cycles = ibex_mcycle_read();
-
-    total_cycles += end_cycles - start_cycles;
+    ottf_perf_end(&wdata_write_region);
   }
 
+  total_cycles = (uint32_t)region_cycles(&wdata_write_region);
   LOG_INFO("Result: Write to the WDATA multiregister. (5 times): %u cycles",
            total_cycles);
 
@@ -440,15 +464,11 @@ bool test_main(void) {
   // Read from the RDATA multiregister //
   ///////////////////////////////////////
 
-  total_cycles = 0;
-
   for (int i = 0; i < 5; i++) {
-    start_cycles = ibex_mcycle_read();
+    ottf_perf_begin(&rdata_read_region);
     read_multireg(cmod1.base_addr, (uint32_t *)&data_out[i * 16],
                   CMOD_RDATA_MULTIREG_COUNT, CMOD_RDATA_0_REG_OFFSET);
-    end_cycles = ibex_mcycle_read();
-
-    total_cycles += end_cycles - start_cycles;
+    ottf_perf_end(&rdata_read_region);
   }
 
   write_bit_of_register(cmod1.base_addr, CMOD_CTRL_REG_OFFSET,
@@ -456,6 +476,7 @@ bool test_main(void) {
 
   CHECK_ARRAYS_EQ(data_out, plainText, sizeof(data_out));
 
+  total_cycles = (uint32_t)region_cycles(&rdata_read_region);
   LOG_INFO("Result: Read from the RDATA multiregister. (5 times): %u cycles",
            total_cycles);
 
@@ -463,7 +484,8 @@ bool test_main(void) {
   // Send 640 bits //
   ///////////////////
 
-  start_cycles = ibex_mcycle_read();
+  start_cycles = region_cycles(&send_region);
+  ottf_perf_begin(&send_region);
 
   write_bit_of_register(cmod0.base_addr, CMOD_CTRL_REG_OFFSET,
                         CMOD_CTRL_TXTRIGGER_BIT, true);
@@ -484,9 +506,9 @@ bool test_main(void) {
                                CMOD_STATUS_RXVALID_BIT)) {
   }
 
-  end_cycles = ibex_mcycle_read();
+  ottf_perf_end(&send_region);
 
-  total_cycles = end_cycles - start_cycles;
+  total_cycles = (uint32_t)(region_cycles(&send_region) - start_cycles);
   LOG_INFO("Result: Send 640 bits: %u cycles", total_cycles);
 
   bool rxlast = false;
@@ -522,7 +544,8 @@ bool test_main(void) {
 
   for (int cipherModeIndex = 0; cipherModeIndex < 5; cipherModeIndex++) {
     for (int keyIndex = 0; keyIndex < 3; keyIndex++) {
-      start_cycles = ibex_mcycle_read();
+      start_cycles = region_cycles(&encrypt_region);
+      ottf_perf_begin(&encrypt_region);
 
       aes_init(aes.base_addr, encCtrlRegValues[keyIndex][cipherModeIndex],
                ivs[cipherModeIndex], (const uint32_t *)&keyShare0s[keyIndex],
@@ -540,9 +563,9 @@ bool test_main(void) {
 
       aes_end(aes.base_addr);
 
-      end_cycles = ibex_mcycle_read();
+      ottf_perf_end(&encrypt_region);
 
-      total_cycles = end_cycles - start_cycles;
+      total_cycles = (uint32_t)(region_cycles(&encrypt_region) - start_cycles);
       LOG_INFO("Result: Encrypt 640 bits. (%s-%s): %u cycles",
                cipherModes[cipherModeIndex], keyLengths[keyIndex],
                total_cycles);
@@ -560,26 +583,28 @@ bool test_main(void) {
 
   for (int cipherModeIndex = 0; cipherModeIndex < 5; cipherModeIndex++) {
     for (int keyIndex = 0; keyIndex < 3; keyIndex++) {
-      start_cycles = ibex_mcycle_read();
+      start_cycles = region_cycles(&aes_init_region);
+      ottf_perf_begin(&aes_init_region);
 
       aes_init(aes.base_addr, encCtrlRegValues[keyIndex][cipherModeIndex],
                ivs[cipherModeIndex], (const uint32_t *)&keyShare0s[keyIndex],
                (const uint32_t *)&keyShare1s[keyIndex]);
 
-      end_cycles = ibex_mcycle_read();
+      ottf_perf_end(&aes_init_region);
 
-      total_cycles = end_cycles - start_cycles;
+      total_cycles = (uint32_t)(region_cycles(&aes_init_region) - start_cycles);
       LOG_INFO("Result: AES initialization. (%s-%s): %u cycles",
                cipherModes[cipherModeIndex], keyLengths[keyIndex],
                total_cycles);
 
-      start_cycles = ibex_mcycle_read();
+      start_cycles = region_cycles(&aes_end_region);
+      ottf_perf_begin(&aes_end_region);
 
       aes_end(aes.base_addr);
 
-      end_cycles = ibex_mcycle_read();
+      ottf_perf_end(&aes_end_region);
 
-      total_cycles = end_cycles - start_cycles;
+      total_cycles = (uint32_t)(region_cycles(&aes_end_region) - start_cycles);
       LOG_INFO("Result: AES deinitialization. (%s-%s): %u cycles",
                cipherModes[cipherModeIndex], keyLengths[keyIndex],
                total_cycles);
@@ -592,7 +617,8 @@ bool test_main(void) {
 
   for (int cipherModeIndex = 0; cipherModeIndex < 5; cipherModeIndex++) {
     for (int keyIndex = 0; keyIndex < 3; keyIndex++) {
-      start_cycles = ibex_mcycle_read();
+      start_cycles = region_cycles(&encrypt_send_region);
+      ottf_perf_begin(&encrypt_send_region);
 
       write_bit_of_register(cmod0.base_addr, CMOD_CTRL_REG_OFFSET,
                             CMOD_CTRL_TXTRIGGER_BIT, true);
@@ -630,9 +656,10 @@ bool test_main(void) {
                                    CMOD_STATUS_RXVALID_BIT)) {
       }
 
-      end_cycles = ibex_mcycle_read();
+      ottf_perf_end(&encrypt_send_region);
 
-      total_cycles = end_cycles - start_cycles;
+      total_cycles =
+          (uint32_t)(region_cycles(&encrypt_send_region) - start_cycles);
       LOG_INFO("Result: Encrypt and send 640 bits. (%s-%s): %u cycles",
                cipherModes[cipherModeIndex], keyLengths[keyIndex],
                total_cycles);
@@ -644,7 +671,8 @@ bool test_main(void) {
       rxvalid = false;
       rxlast = false;
 
-      start_cycles = ibex_mcycle_read();
+      start_cycles = region_cycles(&receive_decrypt_region);
+      ottf_perf_begin(&receive_decrypt_region);
 
       aes_init(aes.base_addr, decCtrlRegValues[keyIndex][cipherModeIndex],
                ivs[cipherModeIndex], (const uint32_t *)&keyShare0s[keyIndex],
@@ -680,9 +708,10 @@ bool test_main(void) {
 
       aes_end(aes.base_addr);
 
-      end_cycles = ibex_mcycle_read();
+      ottf_perf_end(&receive_decrypt_region);
 
-      total_cycles = end_cycles - start_cycles;
+      total_cycles =
+          (uint32_t)(region_cycles(&receive_decrypt_region) - start_cycles);
       LOG_INFO("Result: Receive and decrypt 640 bits. (%s-%s): %u cycles",
                cipherModes[cipherModeIndex], keyLengths[keyIndex],
                total_cycles);
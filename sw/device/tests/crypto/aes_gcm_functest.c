@@ -18,6 +18,21 @@ bool test_main(void) {
     // Call AES-GCM encrypt.
     uint32_t cycles = call_aes_gcm_encrypt(test);
 
+    // Call streaming AES-GCM encrypt and decrypt with block-aligned and odd
+    // chunks, in separate buffers and in place.
+    cycles = call_aes_gcm_encrypt_streaming(test, /*chunk_len=*/32,
+                                            /*in_place=*/false);
+    cycles = call_aes_gcm_encrypt_streaming(test, /*chunk_len=*/7,
+                                            /*in_place=*/false);
+    cycles = call_aes_gcm_encrypt_streaming(test, /*chunk_len=*/7,
+                                            /*in_place=*/true);
+    cycles = call_aes_gcm_decrypt_streaming(test, /*chunk_len=*/32,
+                                            /*in_place=*/false);
+    cycles = call_aes_gcm_decrypt_streaming(test, /*chunk_len=*/7,
+                                            /*in_place=*/false);
+    cycles = call_aes_gcm_decrypt_streaming(test, /*chunk_len=*/7,
+                                            /*in_place=*/true);
+
     // Call AES-GCM decrypt.
     cycles = call_aes_gcm_decrypt(test, /*tag_valid=*/true);
 
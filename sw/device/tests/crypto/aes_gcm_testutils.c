@@ -101,3 +101,141 @@ uint32_t call_aes_gcm_decrypt(aes_gcm_test_t test, bool tag_valid) {
 
   return cycles;
 }
+
+/**
+ * Pass one chunk of data to `aes_gcm_update()`.
+ *
+ * If `in_place` is true, the chunk is copied into a scratch buffer that is
+ * both the input and the output of the call, and the result is copied to
+ * `output` afterwards.
+ *
+ * @param ctx AES-GCM context
+ * @param len Number of bytes in `input`
+ * @param input Chunk of plaintext or ciphertext
+ * @param in_place Whether to run the update in place
+ * @param[out] output Output buffer
+ * @param[out] output_len Number of bytes written to `output`
+ */
+static void update_chunk(aes_gcm_context_t *ctx, size_t len,
+                         const uint8_t *input, bool in_place, uint8_t *output,
+                         size_t *output_len) {
+  aes_error_t err;
+  if (in_place) {
+    uint8_t buf[len + kAesBlockNumBytes];
+    memcpy(buf, input, len);
+    err = aes_gcm_update(ctx, len, buf, output_len, buf);
+    memcpy(output, buf, *output_len);
+  } else {
+    err = aes_gcm_update(ctx, len, input, output_len, output);
+  }
+  CHECK(err == kAesOk, "AES-GCM update returned an error: %08x", err);
+}
+
+uint32_t call_aes_gcm_encrypt_streaming(aes_gcm_test_t test, size_t chunk_len,
+                                        bool in_place) {
+  // One extra block for the output of the last update call.
+  uint8_t actual_ciphertext[test.plaintext_len + kAesBlockNumBytes];
+  uint8_t actual_tag[kAesGcmTagNumBytes];
+
+  // Construct AES key (see `call_aes_gcm_encrypt`).
+  const uint32_t share1[8] = {0};
+  const aes_key_t test_key = {
+      .mode = kAesCipherModeCtr,
+      .sideload = kHardenedBoolFalse,
+      .key_len = test.key_len,
+      .key_shares = {test.key, share1},
+  };
+
+  // Run the streaming operation with a cycle count timing profile.
+  uint64_t t_start = profile_start();
+  aes_gcm_context_t ctx;
+  aes_error_t err = aes_gcm_encrypt_init(test_key, test.iv_len, test.iv, &ctx);
+  CHECK(err == kAesOk, "AES-GCM init returned an error: %08x", err);
+  for (size_t i = 0; i < test.aad_len; i += chunk_len) {
+    size_t len = test.aad_len - i < chunk_len ? test.aad_len - i : chunk_len;
+    err = aes_gcm_update_aad(&ctx, len, &test.aad[i]);
+    CHECK(err == kAesOk, "AES-GCM AAD update returned an error: %08x", err);
+  }
+  size_t ciphertext_len = 0;
+  for (size_t i = 0; i < test.plaintext_len; i += chunk_len) {
+    size_t len =
+        test.plaintext_len - i < chunk_len ? test.plaintext_len - i : chunk_len;
+    size_t output_len;
+    update_chunk(&ctx, len, &test.plaintext[i], in_place,
+                 &actual_ciphertext[ciphertext_len], &output_len);
+    ciphertext_len += output_len;
+  }
+  size_t output_len;
+  err = aes_gcm_encrypt_final(&ctx, &output_len,
+                              &actual_ciphertext[ciphertext_len], actual_tag);
+  uint32_t cycles = profile_end(t_start);
+  LOG_INFO("streaming AES-GCM encryption (%d-byte chunks%s) took %d cycles",
+           chunk_len, in_place ? ", in place" : "", cycles);
+  ciphertext_len += output_len;
+
+  // Check for errors and that the tag and plaintext match expected values.
+  CHECK(err == kAesOk, "AES-GCM final returned an error: %08x", err);
+  CHECK(ciphertext_len == test.plaintext_len);
+  CHECK_ARRAYS_EQ(actual_tag, test.tag, sizeof(test.tag));
+  if (test.plaintext_len > 0) {
+    int cmp = memcmp(actual_ciphertext, test.ciphertext, test.plaintext_len);
+    CHECK(cmp == 0, "AES-GCM encryption output does not match ciphertext");
+  }
+
+  return cycles;
+}
+
+uint32_t call_aes_gcm_decrypt_streaming(aes_gcm_test_t test, size_t chunk_len,
+                                        bool in_place) {
+  // One extra block for the output of the last update call.
+  uint8_t actual_plaintext[test.plaintext_len + kAesBlockNumBytes];
+
+  // Construct AES key (see `call_aes_gcm_decrypt`).
+  const uint32_t share1[8] = {0};
+  const aes_key_t test_key = {
+      .mode = kAesCipherModeCtr,
+      .sideload = kHardenedBoolFalse,
+      .key_len = test.key_len,
+      .key_shares = {test.key, share1},
+  };
+
+  // Run the streaming operation with a cycle count timing profile.
+  uint64_t t_start = profile_start();
+  aes_gcm_context_t ctx;
+  aes_error_t err = aes_gcm_decrypt_init(test_key, test.iv_len, test.iv, &ctx);
+  CHECK(err == kAesOk, "AES-GCM init returned an error: %08x", err);
+  for (size_t i = 0; i < test.aad_len; i += chunk_len) {
+    size_t len = test.aad_len - i < chunk_len ? test.aad_len - i : chunk_len;
+    err = aes_gcm_update_aad(&ctx, len, &test.aad[i]);
+    CHECK(err == kAesOk, "AES-GCM AAD update returned an error: %08x", err);
+  }
+  size_t plaintext_len = 0;
+  for (size_t i = 0; i < test.plaintext_len; i += chunk_len) {
+    size_t len =
+        test.plaintext_len - i < chunk_len ? test.plaintext_len - i : chunk_len;
+    size_t output_len;
+    update_chunk(&ctx, len, &test.ciphertext[i], in_place,
+                 &actual_plaintext[plaintext_len], &output_len);
+    plaintext_len += output_len;
+  }
+  size_t output_len;
+  hardened_bool_t success;
+  err = aes_gcm_decrypt_final(&ctx, test.tag, &output_len,
+                              &actual_plaintext[plaintext_len], &success);
+  uint32_t cycles = profile_end(t_start);
+  LOG_INFO("streaming AES-GCM decryption (%d-byte chunks%s) took %d cycles",
+           chunk_len, in_place ? ", in place" : "", cycles);
+  plaintext_len += output_len;
+
+  // Check the results.
+  CHECK(err == kAesOk, "AES-GCM final returned an error: %08x", err);
+  CHECK(success == kHardenedBoolTrue,
+        "AES-GCM decryption failed on valid input");
+  CHECK(plaintext_len == test.plaintext_len);
+  if (test.plaintext_len > 0) {
+    int cmp = memcmp(actual_plaintext, test.plaintext, test.plaintext_len);
+    CHECK(cmp == 0, "AES-GCM decryption output does not match plaintext");
+  }
+
+  return cycles;
+}
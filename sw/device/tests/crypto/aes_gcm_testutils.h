@@ -68,6 +68,40 @@ uint32_t call_aes_gcm_encrypt(aes_gcm_test_t test);
  */
 uint32_t call_aes_gcm_decrypt(aes_gcm_test_t test, bool tag_valid);
 
+/**
+ * Call streaming AES-GCM authenticated encryption for the given test vector.
+ *
+ * The AAD and plaintext are passed to the update functions in pieces of
+ * `chunk_len` bytes.
+ *
+ * If `in_place` is true, each update call gets the same buffer as input and
+ * output.
+ *
+ * @param test The test vector to run
+ * @param chunk_len Number of bytes per update call (nonzero)
+ * @param in_place Whether to run the update calls in place
+ * @return Cycle count for the streaming encryption
+ */
+uint32_t call_aes_gcm_encrypt_streaming(aes_gcm_test_t test, size_t chunk_len,
+                                        bool in_place);
+
+/**
+ * Call streaming AES-GCM authenticated decryption for the given test vector.
+ *
+ * The AAD and ciphertext are passed to the update functions in pieces of
+ * `chunk_len` bytes. The tag is expected to be valid.
+ *
+ * If `in_place` is true, each update call gets the same buffer as input and
+ * output.
+ *
+ * @param test The test vector to run
+ * @param chunk_len Number of bytes per update call (nonzero)
+ * @param in_place Whether to run the update calls in place
+ * @return Cycle count for the streaming decryption
+ */
+uint32_t call_aes_gcm_decrypt_streaming(aes_gcm_test_t test, size_t chunk_len,
+                                        bool in_place);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif  // __cplusplus
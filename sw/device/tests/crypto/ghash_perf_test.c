@@ -0,0 +1,87 @@
+// Copyright lowRISC contributors.
+// Licensed under the Apache License, Version 2.0, see LICENSE for details.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "sw/device/lib/base/macros.h"
+#include "sw/device/lib/base/memory.h"
+#include "sw/device/lib/crypto/impl/aes_gcm/ghash.h"
+#include "sw/device/lib/runtime/ibex.h"
+#include "sw/device/lib/runtime/log.h"
+#include "sw/device/lib/testing/test_framework/check.h"
+#include "sw/device/lib/testing/test_framework/ottf_main.h"
+
+// Hash subkey, input and GHASH result from test case 2 of the GCM
+// specification (H, C || len(A) || len(C), and GHASH(H, A, C)).
+static const uint8_t kHashSubkey[kGhashBlockNumBytes] = {
+    0x66, 0xe9, 0x4b, 0xd4, 0xef, 0x8a, 0x2c, 0x3b,
+    0x88, 0x4c, 0xfa, 0x59, 0xca, 0x34, 0x2b, 0x2e,
+};
+static const uint8_t kInput[2 * kGhashBlockNumBytes] = {
+    0x03, 0x88, 0xda, 0xce, 0x60, 0xb6, 0xa3, 0x92, 0xf3, 0x28, 0xc2,
+    0xb9, 0x71, 0xb2, 0xfe, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+};
+static const uint8_t kExpected[kGhashBlockNumBytes] = {
+    0xf3, 0x8c, 0xbb, 0x1a, 0xd6, 0x92, 0x23, 0xdc,
+    0xc3, 0x45, 0x7a, 0xe5, 0xb6, 0xb0, 0xf8, 0x85,
+};
+
+enum {
+  /* Number of bytes hashed for the throughput measurement. */
+  kPerfInputNumBytes = 4096,
+};
+
+static uint8_t perf_input[kPerfInputNumBytes];
+
+// Kept off the stack since it can be large for some backends.
+static ghash_context_t ctx;
+
+/**
+ * Checks the GHASH result against the specification's test vector.
+ */
+static void test_known_answer(void) {
+  uint32_t hash_subkey[kGhashBlockNumWords];
+  memcpy(hash_subkey, kHashSubkey, sizeof(hash_subkey));
+  ghash_init_subkey(hash_subkey, &ctx);
+  ghash_init(&ctx);
+  ghash_update(&ctx, sizeof(kInput), kInput);
+
+  uint32_t result[kGhashBlockNumWords];
+  ghash_final(&ctx, result);
+  CHECK_ARRAYS_EQ((uint8_t *)result, kExpected, sizeof(kExpected));
+}
+
+/**
+ * Measures key setup time and GHASH throughput.
+ */
+static void test_perf(void) {
+  for (size_t i = 0; i < kPerfInputNumBytes; ++i) {
+    perf_input[i] = (uint8_t)(i * 7 + 1);
+  }
+  uint32_t hash_subkey[kGhashBlockNumWords];
+  memcpy(hash_subkey, kHashSubkey, sizeof(hash_subkey));
+
+  uint64_t t_start = ibex_mcycle_read();
+  ghash_init_subkey(hash_subkey, &ctx);
+  uint64_t setup_cycles = ibex_mcycle_read() - t_start;
+
+  ghash_init(&ctx);
+  t_start = ibex_mcycle_read();
+  ghash_update(&ctx, kPerfInputNumBytes, perf_input);
+  uint64_t hash_cycles = ibex_mcycle_read() - t_start;
+
+  // Print cycles per byte with two decimal places.
+  uint32_t cpb_x100 = (uint32_t)(hash_cycles * 100 / kPerfInputNumBytes);
+  LOG_INFO("GHASH key setup: %u cycles", (uint32_t)setup_cycles);
+  LOG_INFO("GHASH throughput: %u cycles for %u bytes (%u.%02u cycles/byte)",
+           (uint32_t)hash_cycles, kPerfInputNumBytes, cpb_x100 / 100,
+           cpb_x100 % 100);
+  LOG_INFO("GHASH context size: %u bytes", sizeof(ctx));
+}
+
+OTTF_DEFINE_TEST_CONFIG();
+bool test_main(void) {
+  test_known_answer();
+  test_perf();
+  return true;
+}
@@ -47,6 +47,21 @@ bool rsa_3072_verify_test(const rsa_3072_verify_test_vector_t *testvec) {
     CHECK(result == kHardenedBoolFalse);
   }
 
+  // Verify the signature twice in one batch; the second run reuses the loaded
+  // app and key, and both results must match the single verification.
+  rsa_3072_int_t signatures[2] = {testvec->signature, testvec->signature};
+  rsa_3072_int_t messages[2] = {encodedMessage, encodedMessage};
+  hardened_bool_t results[2];
+  err = rsa_3072_verify_batch(ARRAYSIZE(signatures), signatures, messages,
+                              &testvec->publicKey, &constants, results);
+  if (testvec->valid) {
+    CHECK(err == kOtbnErrorOk);
+  } else {
+    CHECK(err == kOtbnErrorOk || err == kOtbnErrorInvalidArgument);
+  }
+  CHECK(results[0] == result);
+  CHECK(results[1] == result);
+
   return true;
 }
 
@@ -48,7 +48,11 @@ impl UpdateProtocol for Eeprom {
         let flash = SpiFlash::from_spi(&*spi)?;
         flash.chip_erase(&*spi)?;
         flash.program_with_progress(&*spi, 0, payload, progress)?;
+        // The ROM completes the last page program only when it receives the
+        // next command, and keeps WIP set after a RESET until it has done so
+        // and reset the chip.
         SpiFlash::chip_reset(&*spi)?;
+        SpiFlash::wait_for_busy_clear(&*spi)?;
         Ok(())
     }
 }
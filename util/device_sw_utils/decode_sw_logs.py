@@ -0,0 +1,347 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Decoder for binary device logs.
+
+In binary log mode (see `base_log_set_mode()` in sw/device/lib/runtime/log.h),
+the device does not format its log lines. Instead, each log line is sent as a
+record that consists of a marker byte, the address of the log_fields_t struct
+of the log line in the `.logs.fields` section of the ELF file, and the raw
+format arguments:
+
+- 0xfe (a byte that never occurs in UTF-8 text).
+- The log fields address, a 32-bit little-endian word.
+- One 32-bit little-endian word per format argument, except that strings and
+  buffers (%s, %!s, %!x, %!X, %!y and %!Y) are sent as a word holding their
+  length, followed by their bytes.
+
+This script reads the log fields and format strings from the ELF file and
+formats the records the same way the device would have, see
+sw/device/lib/runtime/print.c. Any other output of the device is passed
+through unchanged.
+
+Usage: decode_sw_logs.py --elf-file <elf> [<log file>]
+"""
+
+import argparse
+import codecs
+import os
+import struct
+import sys
+
+from elftools.elf import elffile
+
+from extract_sw_logs import LOGS_FIELDS_SECTION, LOGS_FIELDS_SIZE
+
+RECORD_MARKER = 0xfe
+
+SEVERITIES = ['I', 'W', 'E', 'F']
+
+STATUS_CODES = [
+    "Ok", "Cancelled", "Unknown", "InvalidArgument", "DeadlineExceeded",
+    "NotFound", "AlreadyExists", "PermissionDenied", "ResourceExhausted",
+    "FailedPrecondition", "Aborted", "OutOfRange", "Unimplemented",
+    "Internal", "Unavailable", "DataLoss", "Unauthenticated"
+] + ["Undefined{}".format(i) for i in range(17, 32)] + ["ErrorError"]
+
+DIGITS_LOW = '0123456789abcdef'
+DIGITS_HIGH = '0123456789ABCDEF'
+
+
+class LogField:
+    '''Metadata of a single log line, see log_fields_t.'''
+
+    def __init__(self, severity, file_name, line, fmt):
+        self.severity = severity
+        self.file_name = file_name
+        self.line = line
+        self.format = fmt
+
+
+class LogDatabase:
+    '''Log metadata of a device binary, indexed by log fields address.'''
+
+    def __init__(self, elf_file):
+        self.fields = {}
+        with open(elf_file, 'rb') as f:
+            elf = elffile.ELFFile(f)
+            sections = []
+            for section in elf.iter_sections():
+                if section.header['sh_type'] != 'SHT_PROGBITS':
+                    continue
+                if section.name.startswith('.debug'):
+                    continue
+                sections.append(
+                    (int(section.header['sh_addr']), section.data()))
+
+            section = elf.get_section_by_name(LOGS_FIELDS_SECTION)
+            if section is None:
+                raise ValueError("{} section not found in {}".format(
+                    LOGS_FIELDS_SECTION, elf_file))
+            # Host builds of the log library, which are only used for
+            # testing, have 64-bit pointers; their records still carry the
+            # low 32 bits of the log fields address.
+            if elf.elfclass == 64:
+                fields_format, fields_size = '<IxxxxQIIQ', 32
+            else:
+                fields_format, fields_size = '<IIIII', LOGS_FIELDS_SIZE
+            base_addr = int(section.header['sh_addr'])
+            data = section.data()
+            for start in range(0, len(data) - fields_size + 1, fields_size):
+                severity, file_addr, line, _, format_addr = struct.unpack(
+                    fields_format, data[start:start + fields_size])
+                self.fields[(base_addr + start) & 0xffffffff] = LogField(
+                    severity, _read_c_string(sections, file_addr), line,
+                    _read_c_string(sections, format_addr))
+
+    def get(self, addr):
+        return self.fields.get(addr)
+
+
+def _read_c_string(sections, addr):
+    '''Returns the NUL-terminated string at `addr`.'''
+    for base_addr, data in sections:
+        if base_addr <= addr < base_addr + len(data):
+            start = addr - base_addr
+            end = data.find(b'\0', start)
+            if end == -1:
+                end = len(data)
+            return data[start:end].decode('utf-8', errors='replace')
+    raise KeyError("string at addr {:x} not found".format(addr))
+
+
+class _Incomplete(Exception):
+    '''Raised when a record has not been fully received yet.'''
+
+
+class _Reader:
+    '''Reads words and byte strings from a partially received record.'''
+
+    def __init__(self, data, pos):
+        self.data = data
+        self.pos = pos
+
+    def bytes(self, length):
+        if self.pos + length > len(self.data):
+            raise _Incomplete()
+        value = self.data[self.pos:self.pos + length]
+        self.pos += length
+        return value
+
+    def word(self):
+        return struct.unpack('<I', self.bytes(4))[0]
+
+
+def _write_digits(value, width, padding, base, glyphs):
+    '''Mirrors `write_digits()` in print.c.'''
+    digits = ''
+    while True:
+        digits = glyphs[value % base] + digits
+        value //= base
+        if value == 0:
+            break
+    width = min(max(width, 1), 32)
+    return digits.rjust(width, padding)
+
+
+def _hex_dump(data, width, padding, big_endian, glyphs):
+    '''Mirrors `hex_dump()` in print.c.'''
+    result = padding * (width - len(data)) if len(data) < width else ''
+    if big_endian:
+        data = data[::-1]
+    for byte in data:
+        result += glyphs[byte >> 4] + glyphs[byte & 0xf]
+    return result
+
+
+def _write_status(value, as_json):
+    '''Mirrors `write_status()` in print.c.'''
+    err = value & 0x1f if value & 0x80000000 else 0
+    if value & 0x80000000 and err == 0:
+        err = len(STATUS_CODES) - 1
+    code = STATUS_CODES[err]
+    result = '{"' + code + '"' if as_json else code
+    result += ':'
+    if err:
+        arg = (value >> 5) & 0x7ff
+        module_id = (value >> 16) & 0x7fff
+        mod = ''.join(
+            chr(0x40 + ((module_id >> shift) & 0x1f)) for shift in (0, 5, 10))
+        result += '["{}",{}]'.format(mod, arg)
+    else:
+        result += str(value)
+    return result + ('}' if as_json else '')
+
+
+def _format(fmt, reader):
+    '''Formats `fmt` with arguments from `reader`, like `base_vfprintf()`.'''
+    result = ''
+    i = 0
+    while i < len(fmt):
+        c = fmt[i]
+        i += 1
+        if c != '%':
+            result += c
+            continue
+
+        is_nonstd = i < len(fmt) and fmt[i] == '!'
+        if is_nonstd:
+            i += 1
+        width = 0
+        padding = ''
+        while i < len(fmt) and fmt[i].isdigit():
+            if padding == '':
+                padding = '0' if fmt[i] == '0' else ' '
+                if fmt[i] == '0':
+                    i += 1
+                    continue
+            width = width * 10 + int(fmt[i])
+            i += 1
+        if i == len(fmt):
+            return result + '%<unexpected nul>'
+        if (width == 0 and padding != '') or width > 32:
+            return result + '%<bad width>'
+        # Without a width, no padding is ever needed.
+        padding = padding or ' '
+        spec = fmt[i]
+        i += 1
+
+        bad_spec = '%<unknown spec>'
+        if spec == '%':
+            result += bad_spec if is_nonstd else '%'
+        elif spec == 'c':
+            result += bad_spec if is_nonstd else chr(reader.word() & 0xff)
+        elif spec == 's':
+            data = reader.bytes(reader.word())
+            result += data.decode('utf-8', errors='replace')
+        elif spec in 'di':
+            if is_nonstd:
+                result += bad_spec
+                continue
+            value = reader.word()
+            if value & 0x80000000:
+                result += '-'
+                value = (-value) & 0xffffffff
+            result += _write_digits(value, width, padding, 10, DIGITS_LOW)
+        elif spec == 'o':
+            result += bad_spec if is_nonstd else _write_digits(
+                reader.word(), width, padding, 8, DIGITS_LOW)
+        elif spec == 'p':
+            result += bad_spec if is_nonstd else '0x' + _write_digits(
+                reader.word(), 8, '0', 16, DIGITS_LOW)
+        elif spec in 'xXhH':
+            glyphs = DIGITS_HIGH if spec in 'XH' else DIGITS_LOW
+            if is_nonstd and spec in 'xX':
+                result += _hex_dump(reader.bytes(reader.word()), width,
+                                    padding, True, glyphs)
+            else:
+                result += _write_digits(reader.word(), width, padding, 16,
+                                        glyphs)
+        elif spec in 'yY':
+            glyphs = DIGITS_HIGH if spec == 'Y' else DIGITS_LOW
+            result += _hex_dump(reader.bytes(reader.word()), width, padding,
+                                False, glyphs) if is_nonstd else bad_spec
+        elif spec == 'u':
+            result += bad_spec if is_nonstd else _write_digits(
+                reader.word(), width, padding, 10, DIGITS_LOW)
+        elif spec == 'b':
+            if is_nonstd:
+                result += 'true' if reader.word() != 0 else 'false'
+            else:
+                result += _write_digits(reader.word(), width, padding, 2,
+                                        DIGITS_LOW)
+        elif spec == 'r':
+            result += _write_status(reader.word(), is_nonstd)
+        else:
+            result += bad_spec
+    return result
+
+
+class LogDecoder:
+    '''Turns a stream of device output into text.
+
+    Binary log records are formatted into log lines; all other bytes are
+    decoded as UTF-8 text.
+    '''
+
+    def __init__(self, database):
+        self.database = database
+        self.pending = b''
+        self.counter = 0
+        self.text_decoder = codecs.getincrementaldecoder('utf-8')(
+            errors='replace')
+
+    def feed(self, data):
+        '''Decodes `data` and returns the resulting text.
+
+        Partially received records and UTF-8 sequences are kept until the
+        next call.
+        '''
+        self.pending += data
+        result = ''
+        while self.pending:
+            marker = self.pending.find(bytes([RECORD_MARKER]))
+            if marker != 0:
+                text_len = len(self.pending) if marker == -1 else marker
+                result += self.text_decoder.decode(self.pending[:text_len])
+                self.pending = self.pending[text_len:]
+                continue
+            try:
+                line, length = self._decode_record()
+            except _Incomplete:
+                break
+            result += line
+            self.pending = self.pending[length:]
+        return result
+
+    def _decode_record(self):
+        '''Decodes the record at the start of `self.pending`.
+
+        Returns the log line and the length of the record.
+        '''
+        reader = _Reader(self.pending, 1)
+        addr = reader.word()
+        field = self.database.get(addr)
+        if field is None:
+            # The record does not belong to this ELF file, so its length is
+            # unknown; resynchronize at the next marker byte.
+            return ('<unknown log record {:#x}>\r\n'.format(addr), 1)
+        message = _format(field.format, reader)
+        severity = SEVERITIES[field.severity] if field.severity < len(
+            SEVERITIES) else '?'
+        line = '{}{:05d} {}:{}] {}\r\n'.format(severity, self.counter,
+                                               os.path.basename(
+                                                   field.file_name),
+                                               field.line, message)
+        self.counter = (self.counter + 1) & 0xffff
+        return (line, reader.pos)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--elf-file',
+                        '-e',
+                        required=True,
+                        help="ELF file of the device software.")
+    parser.add_argument('log_file',
+                        nargs='?',
+                        help="File to decode; defaults to stdin.")
+    args = parser.parse_args()
+
+    decoder = LogDecoder(LogDatabase(args.elf_file))
+    if args.log_file:
+        log = open(args.log_file, 'rb')
+    else:
+        log = sys.stdin.buffer
+    with log:
+        while True:
+            data = log.read1(4096)
+            if not data:
+                break
+            sys.stdout.write(decoder.feed(data))
+            sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
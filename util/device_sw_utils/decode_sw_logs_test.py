@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+# Copyright lowRISC contributors.
+# Licensed under the Apache License, Version 2.0, see LICENSE for details.
+# SPDX-License-Identifier: Apache-2.0
+"""Round-trip tests for decode_sw_logs.py.
+
+The log lines are produced by sw/device/lib/runtime/log_roundtrip.c, a host
+build of the device log library, whose path is passed in the `LOG_ROUNDTRIP`
+environment variable.
+"""
+
+import os
+import subprocess
+import unittest
+
+from decode_sw_logs import RECORD_MARKER, LogDatabase, LogDecoder
+
+
+def run_roundtrip(mode):
+    return subprocess.run([os.environ['LOG_ROUNDTRIP'], mode],
+                          stdout=subprocess.PIPE,
+                          check=True).stdout
+
+
+class DecodeSwLogsTest(unittest.TestCase):
+
+    def setUp(self):
+        self.database = LogDatabase(os.environ['LOG_ROUNDTRIP'])
+        self.records = run_roundtrip('binary')
+
+    def test_records_are_binary(self):
+        self.assertEqual(self.records[0], RECORD_MARKER)
+        self.assertNotIn(b'plain line', self.records)
+
+    def test_known_record(self):
+        lines = LogDecoder(self.database).feed(self.records).split('\r\n')
+        self.assertRegex(
+            lines[1], r'^I00001 log_roundtrip\.c:\d+\] d=42 neg=-7 '
+            r'u=3000000000 x=0000beef X=ABC h=12 c=Z o=10 b=101 %$')
+        self.assertRegex(
+            lines[3], r'^E00003 log_roundtrip\.c:\d+\] !x=cdab030201 '
+            r'!X=CDAB030201 !y=010203abcd !Y=  0102$')
+        self.assertEqual(lines[5], 'raw text')
+
+    def test_matches_text_mode(self):
+        decoded = LogDecoder(self.database).feed(self.records)
+        self.assertEqual(decoded, run_roundtrip('text').decode('utf-8'))
+
+    def test_partial_records(self):
+        decoder = LogDecoder(self.database)
+        decoded = ''.join(
+            decoder.feed(self.records[i:i + 1])
+            for i in range(len(self.records)))
+        self.assertEqual(decoded, run_roundtrip('text').decode('utf-8'))
+
+
+if __name__ == '__main__':
+    unittest.main()